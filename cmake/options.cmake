@@ -12,6 +12,7 @@
 option(SERVERS          "Build worldserver and authserver"                            ON)
 option(SCRIPTS          "Build core with scripts included"                            ON)
 option(TOOLS            "Build map/vmap extraction/assembler tools"                   ON)
+option(BENCHMARKS       "Build micro-benchmarks and the bot load generator"           OFF)
 option(USE_SCRIPTPCH    "Use precompiled headers when compiling scripts"              ON)
 option(USE_COREPCH      "Use precompiled headers when compiling servers"              ON)
 option(WITH_WARNINGS    "Show all warnings during compile"                            OFF)
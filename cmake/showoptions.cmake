@@ -75,6 +75,12 @@ else()
   ShowOption("Build map extractors   :" "No  (default)")
 endif()
 
+if( BENCHMARKS )
+  ShowOption("Build benchmarks       :" "Yes")
+else()
+  ShowOption("Build benchmarks       :" "No  (default)")
+endif()
+
 message("")
 
 if( USE_COREPCH )
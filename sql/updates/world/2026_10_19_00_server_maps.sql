@@ -0,0 +1,3 @@
+DELETE FROM `command` WHERE `name` = 'server maps';
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('server maps', 3, 'Syntax: .server maps [#count]\r\n\r\nList the #count (default 10) maps and instances with the most expensive updates, with the moving average of their update time and of the time they waited for a map update thread.');
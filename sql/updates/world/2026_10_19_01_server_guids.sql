@@ -0,0 +1,3 @@
+DELETE FROM `command` WHERE `name` = 'server guids';
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('server guids', 3, 'Syntax: .server guids\r\n\r\nShow for creatures, pets, gameobjects and dynamic objects how much of the guid range is used, how many guids of deleted temporary objects wait to be reused and how many were reused.');
@@ -0,0 +1,3 @@
+DELETE FROM `command` WHERE `name` = 'server bgqueues';
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('server bgqueues', 2, 'Syntax: .server bgqueues\r\n\r\nShow for every battleground and arena queue type (BattlegroundQueueTypeId) and level bracket how many groups were invited since startup, and the average and longest time they waited for their first invite.');
@@ -0,0 +1,273 @@
+/*
+ * This file is part of the OregonCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Compares EventMap with the former std::multimap based implementation on
+// the call patterns of boss and creature scripts. Both implementations are
+// driven with the same pseudo random sequence, the executed event checksums
+// must match.
+
+#include "Utilities/EventMap.h"
+
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <vector>
+
+// EventMap as it was before the flat storage, kept here as the baseline
+class LegacyEventMap
+{
+    typedef std::multimap<uint32, uint32> EventStore;
+
+public:
+    LegacyEventMap() : _time(0), _phase(0), _lastEvent(0) { }
+
+    void Update(uint32 time) { _time += time; }
+    bool Empty() const { return _eventMap.empty(); }
+
+    void SetPhase(uint8 phase)
+    {
+        if (!phase)
+            _phase = 0;
+        else if (phase <= 8)
+            _phase = uint8(1 << (phase - 1));
+    }
+
+    void ScheduleEvent(uint32 eventId, uint32 time, uint32 group = 0, uint8 phase = 0)
+    {
+        if (group && group <= 8)
+            eventId |= (1 << (group + 15));
+
+        if (phase && phase <= 8)
+            eventId |= (1 << (phase + 23));
+
+        _eventMap.insert(EventStore::value_type(_time + time, eventId));
+    }
+
+    void RescheduleEvent(uint32 eventId, uint32 time, uint32 group = 0, uint8 phase = 0)
+    {
+        CancelEvent(eventId);
+        ScheduleEvent(eventId, time, group, phase);
+    }
+
+    void Repeat(uint32 time)
+    {
+        _eventMap.insert(EventStore::value_type(_time + time, _lastEvent));
+    }
+
+    uint32 ExecuteEvent()
+    {
+        while (!Empty())
+        {
+            EventStore::iterator itr = _eventMap.begin();
+
+            if (itr->first > _time)
+                return 0;
+            else if (_phase && (itr->second & 0xFF000000) && !((itr->second >> 24) & _phase))
+                _eventMap.erase(itr);
+            else
+            {
+                uint32 eventId = (itr->second & 0x0000FFFF);
+                _lastEvent = itr->second;
+                _eventMap.erase(itr);
+                return eventId;
+            }
+        }
+
+        return 0;
+    }
+
+    void DelayEvents(uint32 delay, uint32 group)
+    {
+        if (!group || group > 8 || Empty())
+            return;
+
+        EventStore delayed;
+
+        for (EventStore::iterator itr = _eventMap.begin(); itr != _eventMap.end();)
+        {
+            if (itr->second & (1 << (group + 15)))
+            {
+                delayed.insert(EventStore::value_type(itr->first + delay, itr->second));
+                _eventMap.erase(itr++);
+            }
+            else
+                ++itr;
+        }
+
+        _eventMap.insert(delayed.begin(), delayed.end());
+    }
+
+    void CancelEvent(uint32 eventId)
+    {
+        for (EventStore::iterator itr = _eventMap.begin(); itr != _eventMap.end();)
+        {
+            if (eventId == (itr->second & 0x0000FFFF))
+                _eventMap.erase(itr++);
+            else
+                ++itr;
+        }
+    }
+
+    void CancelEventGroup(uint32 group)
+    {
+        if (!group || group > 8 || Empty())
+            return;
+
+        for (EventStore::iterator itr = _eventMap.begin(); itr != _eventMap.end();)
+        {
+            if (itr->second & (1 << (group + 15)))
+                _eventMap.erase(itr++);
+            else
+                ++itr;
+        }
+    }
+
+private:
+    uint32 _time;
+    uint8 _phase;
+    EventStore _eventMap;
+    uint32 _lastEvent;
+};
+
+// deterministic generator, both implementations must see the same numbers
+class Lcg
+{
+    public:
+        explicit Lcg(uint32 seed) : m_state(seed) { }
+
+        uint32 Next(uint32 min, uint32 max)
+        {
+            m_state = m_state * 1664525 + 1013904223;
+            return min + (m_state >> 8) % (max - min + 1);
+        }
+
+    private:
+        uint32 m_state;
+};
+
+#define SCRIPT_DIFF 100                                     // creature AI update interval
+
+// Boss encounter: a dozen timers in three phases, grouped abilities, enrage
+// rescheduled on every hit, phase transitions cancel and delay groups.
+template<class Map>
+uint64 RunBoss(uint32 bosses, uint32 ticks)
+{
+    std::vector<Map> events(bosses);
+    Lcg rnd(1);
+    uint64 checksum = 0;
+
+    for (uint32 b = 0; b < bosses; ++b)
+    {
+        events[b].SetPhase(1);
+        for (uint32 id = 1; id <= 12; ++id)
+            events[b].ScheduleEvent(id, rnd.Next(2000, 30000), id % 3 + 1, id % 4);
+    }
+
+    for (uint32 tick = 0; tick < ticks; ++tick)
+    {
+        for (uint32 b = 0; b < bosses; ++b)
+        {
+            Map& map = events[b];
+            map.Update(SCRIPT_DIFF);
+
+            if (tick % 5 == 0)
+                map.RescheduleEvent(20, 10000);
+
+            if (tick % 600 == 599)
+            {
+                map.SetPhase(tick / 600 % 3 + 1);
+                map.CancelEventGroup(3);
+                map.DelayEvents(5000, 2);
+                for (uint32 id = 3; id <= 12; id += 3)
+                    map.ScheduleEvent(id, rnd.Next(1000, 5000), 3, tick / 600 % 3 + 1);
+            }
+
+            while (uint32 id = map.ExecuteEvent())
+            {
+                checksum = checksum * 31 + id;
+                if (id == 20)
+                    map.ScheduleEvent(20, 10000);
+                else
+                    map.Repeat(rnd.Next(5000, 25000));
+            }
+        }
+    }
+
+    return checksum;
+}
+
+// Trash pack: many creatures with two or three plain repeating timers
+template<class Map>
+uint64 RunTrash(uint32 creatures, uint32 ticks)
+{
+    std::vector<Map> events(creatures);
+    Lcg rnd(2);
+    uint64 checksum = 0;
+
+    for (uint32 c = 0; c < creatures; ++c)
+        for (uint32 id = 1; id <= 2 + c % 2; ++id)
+            events[c].ScheduleEvent(id, rnd.Next(1000, 8000));
+
+    for (uint32 tick = 0; tick < ticks; ++tick)
+    {
+        for (uint32 c = 0; c < creatures; ++c)
+        {
+            Map& map = events[c];
+            map.Update(SCRIPT_DIFF);
+
+            while (uint32 id = map.ExecuteEvent())
+            {
+                checksum = checksum * 31 + id;
+                map.Repeat(rnd.Next(4000, 12000));
+            }
+        }
+    }
+
+    return checksum;
+}
+
+double Measure(uint64 (*run)(uint32, uint32), uint32 count, uint32 ticks, uint64& checksum)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    checksum = run(count, ticks);
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+void Compare(char const* name, uint64 (*legacy)(uint32, uint32), uint64 (*flat)(uint32, uint32), uint32 count, uint32 ticks, bool& ok)
+{
+    uint64 legacySum, flatSum;
+    double legacyMs = Measure(legacy, count, ticks, legacySum);
+    double flatMs = Measure(flat, count, ticks, flatSum);
+
+    printf("%-8s %6u maps %6u ticks: multimap %9.2f ms, flat %9.2f ms, speedup %5.2fx %s\n",
+        name, count, ticks, legacyMs, flatMs, flatMs > 0.0 ? legacyMs / flatMs : 0.0,
+        legacySum == flatSum ? "" : "CHECKSUM MISMATCH");
+
+    if (legacySum != flatSum)
+        ok = false;
+}
+
+int main()
+{
+    bool ok = true;
+
+    Compare("boss", &RunBoss<LegacyEventMap>, &RunBoss<EventMap>, 50, 20000, ok);
+    Compare("trash", &RunTrash<LegacyEventMap>, &RunTrash<EventMap>, 5000, 2000, ok);
+
+    return ok ? 0 : 1;
+}
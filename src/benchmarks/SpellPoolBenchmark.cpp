@@ -0,0 +1,259 @@
+/*
+ * This file is part of the OregonCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Compares the allocations of a spell cast from the heap with the thread
+// caches of PacketBufferPool, which Spell, SpellValue, SpellEvent and the
+// target lists use. The game objects need the whole world to exist, so the
+// casts are modelled by objects of their size (x86-64) doing the same
+// allocations: the spell, its values, its event, one list node per target and
+// the triggered spells. Dummy units cast a mix of melee procs, area spells and
+// missiles, both runs must produce the same checksum.
+
+#include "Utilities/PacketBufferPool.h"
+
+#include <chrono>
+#include <cstdio>
+#include <list>
+#include <memory>
+#include <vector>
+
+#define SPELL_SIZE          560                             // sizeof(Spell)
+#define SPELL_VALUE_SIZE    24                              // sizeof(SpellValue)
+#define SPELL_EVENT_SIZE    104                             // sizeof(SpellEvent)
+
+struct HeapPolicy
+{
+    static void* Allocate(size_t size) { return ::operator new(size); }
+    static void Deallocate(void* ptr, size_t /*size*/) { ::operator delete(ptr); }
+
+    template<class T> struct Allocator { typedef std::allocator<T> Type; };
+};
+
+struct PoolPolicy
+{
+    static void* Allocate(size_t size) { return PacketBufferPool::Allocate(size); }
+    static void Deallocate(void* ptr, size_t size) { PacketBufferPool::Deallocate(ptr, size); }
+
+    template<class T> struct Allocator { typedef PacketBufferAllocator<T> Type; };
+};
+
+template<class Policy>
+struct MockSpellValue
+{
+    static void* operator new(size_t size) { return Policy::Allocate(size); }
+    static void operator delete(void* ptr, size_t size) { Policy::Deallocate(ptr, size); }
+
+    int32 basePoints[3];
+    uint8 pad[SPELL_VALUE_SIZE - 12];
+};
+
+template<class Policy>
+struct MockSpell
+{
+    // same layout as Spell::TargetInfo
+    struct TargetInfo
+    {
+        uint64 targetGUID;
+        uint64 timeDelay;
+        uint8 effectMask;
+        bool processed;
+        int32 damage;
+        bool crit;
+    };
+
+    typedef std::list<TargetInfo, typename Policy::template Allocator<TargetInfo>::Type> TargetInfoList;
+    typedef std::vector<uint32, typename Policy::template Allocator<uint32>::Type> TriggerSpells;
+
+    static void* operator new(size_t size) { return Policy::Allocate(size); }
+    static void operator delete(void* ptr, size_t size) { Policy::Deallocate(ptr, size); }
+
+    explicit MockSpell(uint32 id) : spellId(id), value(new MockSpellValue<Policy>())
+    {
+        value->basePoints[0] = int32(id % 1000);
+    }
+
+    ~MockSpell() { delete value; }
+
+    uint32 spellId;
+    MockSpellValue<Policy>* value;
+    TargetInfoList targets;
+    TriggerSpells triggers;
+    uint8 pad[SPELL_SIZE - sizeof(uint32) - sizeof(void*) - sizeof(TargetInfoList) - sizeof(TriggerSpells)];
+};
+
+template<class Policy>
+struct MockSpellEvent
+{
+    static void* operator new(size_t size) { return Policy::Allocate(size); }
+    static void operator delete(void* ptr, size_t size) { Policy::Deallocate(ptr, size); }
+
+    MockSpellEvent(MockSpell<Policy>* spell, uint32 time) : spell(spell), executeTime(time) { }
+
+    MockSpell<Policy>* spell;
+    uint32 executeTime;
+    uint8 pad[SPELL_EVENT_SIZE - sizeof(void*) - sizeof(uint32)];
+};
+
+// deterministic generator, both runs must see the same numbers
+class Lcg
+{
+    public:
+        explicit Lcg(uint32 seed) : m_state(seed) { }
+
+        uint32 Next(uint32 min, uint32 max)
+        {
+            m_state = m_state * 1664525 + 1013904223;
+            return min + (m_state >> 8) % (max - min + 1);
+        }
+
+    private:
+        uint32 m_state;
+};
+
+#define DUMMY_UNITS         200                             // targets around the casters
+#define MAX_TRIGGER_DEPTH   2                               // procs of procs
+
+template<class Policy>
+class CastRunner
+{
+        typedef MockSpell<Policy> Spell;
+        typedef MockSpellEvent<Policy> SpellEvent;
+
+    public:
+        CastRunner() : m_rnd(3), m_checksum(0) { }
+
+        uint64 Run(uint32 casters, uint32 ticks)
+        {
+            std::vector<std::vector<SpellEvent*> > events(casters);
+
+            for (uint32 tick = 0; tick < ticks; ++tick)
+            {
+                for (uint32 c = 0; c < casters; ++c)
+                {
+                    std::vector<SpellEvent*>& pending = events[c];
+
+                    uint32 roll = m_rnd.Next(1, 100);
+                    if (roll <= 70)                         // melee swing with a proc
+                        pending.push_back(Cast(m_rnd.Next(1, 2000), 1, tick, 0));
+                    else if (roll <= 90)                    // area spell
+                        pending.push_back(Cast(m_rnd.Next(2001, 3000), m_rnd.Next(5, 15), tick, 0));
+                    else                                    // missile hitting in a later tick
+                        pending.push_back(Cast(m_rnd.Next(3001, 4000), 1, tick + m_rnd.Next(1, 3), 0));
+
+                    Process(pending, tick);
+                }
+            }
+
+            for (uint32 c = 0; c < casters; ++c)
+                Process(events[c], ticks + MAX_TRIGGER_DEPTH + 3);
+
+            return m_checksum;
+        }
+
+    private:
+        SpellEvent* Cast(uint32 spellId, uint32 targetCount, uint32 executeTime, uint32 depth)
+        {
+            Spell* spell = new Spell(spellId);
+
+            uint32 first = m_rnd.Next(0, DUMMY_UNITS - 1);
+            for (uint32 i = 0; i < targetCount; ++i)
+            {
+                typename Spell::TargetInfo target;
+                target.targetGUID = (first + i) % DUMMY_UNITS + 1;
+                target.timeDelay = 0;
+                target.effectMask = 1;
+                target.processed = false;
+                target.damage = spell->value->basePoints[0] + int32(m_rnd.Next(0, 100));
+                target.crit = m_rnd.Next(1, 100) <= 5;
+                spell->targets.push_back(target);
+            }
+
+            if (depth < MAX_TRIGGER_DEPTH && m_rnd.Next(1, 100) <= 30)
+                spell->triggers.push_back(m_rnd.Next(4001, 5000));
+
+            return new SpellEvent(spell, executeTime);
+        }
+
+        void Process(std::vector<SpellEvent*>& pending, uint32 tick)
+        {
+            for (uint32 i = 0; i < pending.size();)
+            {
+                SpellEvent* event = pending[i];
+                if (event->executeTime > tick)
+                {
+                    ++i;
+                    continue;
+                }
+
+                Spell* spell = event->spell;
+                for (typename Spell::TargetInfoList::iterator itr = spell->targets.begin(); itr != spell->targets.end(); ++itr)
+                    m_checksum = m_checksum * 31 + itr->targetGUID * (itr->crit ? 2 : 1) * uint64(itr->damage);
+
+                // triggered spells are cast on the first target, executed in the next tick
+                for (typename Spell::TriggerSpells::const_iterator itr = spell->triggers.begin(); itr != spell->triggers.end(); ++itr)
+                    pending.push_back(Cast(*itr, 1, tick + 1, MAX_TRIGGER_DEPTH));
+
+                delete spell;
+                delete event;
+
+                pending[i] = pending.back();
+                pending.pop_back();
+            }
+        }
+
+        Lcg m_rnd;
+        uint64 m_checksum;
+};
+
+template<class Policy>
+uint64 RunCasts(uint32 casters, uint32 ticks)
+{
+    CastRunner<Policy> runner;
+    return runner.Run(casters, ticks);
+}
+
+double Measure(uint64 (*run)(uint32, uint32), uint32 count, uint32 ticks, uint64& checksum)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    checksum = run(count, ticks);
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+void Compare(char const* name, uint32 count, uint32 ticks, bool& ok)
+{
+    uint64 heapSum, poolSum;
+    double heapMs = Measure(&RunCasts<HeapPolicy>, count, ticks, heapSum);
+    double poolMs = Measure(&RunCasts<PoolPolicy>, count, ticks, poolSum);
+
+    printf("%-8s %6u casters %6u ticks: heap %9.2f ms, pool %9.2f ms, speedup %5.2fx %s\n",
+        name, count, ticks, heapMs, poolMs, poolMs > 0.0 ? heapMs / poolMs : 0.0,
+        heapSum == poolSum ? "" : "CHECKSUM MISMATCH");
+
+    if (heapSum != poolSum)
+        ok = false;
+}
+
+int main()
+{
+    bool ok = true;
+
+    Compare("raid", 40, 100000, ok);
+    Compare("world", 2000, 2000, ok);
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,1080 @@
+/*
+ * This file is part of the OregonCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "BotSession.h"
+#include "BotWorker.h"
+#include "Auth/AuthCrypt.h"
+#include "Auth/Sha1.h"
+#include "Log.h"
+#include "Timer.h"
+#include "Utilities/Util.h"
+
+#include <ace/Reactor.h>
+#include <ace/SOCK_Connector.h>
+#include <ace/os_include/netinet/os_tcp.h>
+
+#include <algorithm>
+
+// The client the bots pretend to be
+#define CLIENT_BUILD            8606                        // 2.4.3
+
+#define BOT_PROBE_TIMEOUT       10000                       // ms until an unanswered request is given up
+#define BOT_HEARTBEAT_INTERVAL  500
+#define BOT_RUN_SPEED           7.0f
+
+// Realm server commands, values as in oregonrealm/AuthCodes.h
+enum BotRealmCommands
+{
+    CMD_AUTH_LOGON_CHALLENGE    = 0x00,
+    CMD_AUTH_LOGON_PROOF        = 0x01,
+    CMD_REALM_LIST              = 0x10
+};
+
+// Opcodes used by the bots, values as in game/Opcodes.h
+enum BotOpcodes
+{
+    CMSG_CHAR_CREATE            = 0x036,
+    CMSG_CHAR_ENUM              = 0x037,
+    SMSG_CHAR_CREATE            = 0x03A,
+    SMSG_CHAR_ENUM              = 0x03B,
+    CMSG_PLAYER_LOGIN           = 0x03D,
+    CMSG_MESSAGECHAT            = 0x095,
+    SMSG_MESSAGECHAT            = 0x096,
+    MSG_MOVE_START_FORWARD      = 0x0B5,
+    MSG_MOVE_STOP               = 0x0B7,
+    MSG_MOVE_HEARTBEAT          = 0x0EE,
+    CMSG_CAST_SPELL             = 0x12E,
+    SMSG_CAST_FAILED            = 0x130,
+    SMSG_SPELL_START            = 0x131,
+    CMSG_QUERY_TIME             = 0x1CE,
+    SMSG_QUERY_TIME_RESPONSE    = 0x1CF,
+    CMSG_PING                   = 0x1DC,
+    SMSG_PONG                   = 0x1DD,
+    SMSG_AUTH_CHALLENGE         = 0x1EC,
+    CMSG_AUTH_SESSION           = 0x1ED,
+    SMSG_AUTH_RESPONSE          = 0x1EE,
+    SMSG_LOGIN_VERIFY_WORLD     = 0x236,
+    CMSG_AUCTION_LIST_ITEMS     = 0x258,
+    SMSG_AUCTION_LIST_RESULT    = 0x25C
+};
+
+// Values as in game/SharedDefines.h and game/Object.h
+#define AUTH_OK                 0x0C
+#define AUTH_WAIT_QUEUE         0x1B
+#define CHAR_CREATE_SUCCESS     0x2F
+#define CHAT_MSG_SYSTEM         0x00
+#define CHAT_MSG_SAY            0x01
+#define LANG_ORCISH             1
+#define LANG_COMMON             7
+#define MOVEMENTFLAG_FORWARD    0x00000001
+
+static bool IsDue(uint32 now, uint32 time)
+{
+    return int32(now - time) >= 0;
+}
+
+void BotCrypt::Init(BigNumber* K)
+{
+    AuthCrypt::GenerateKey(m_key, K);
+    m_send_i = m_send_j = m_recv_i = m_recv_j = 0;
+    m_initialized = true;
+}
+
+// the client encrypts what AuthCrypt::DecryptRecv decrypts and the other way around
+void BotCrypt::EncryptSend(uint8* data, size_t len)
+{
+    if (!m_initialized)
+        return;
+
+    for (size_t t = 0; t < len; ++t)
+    {
+        m_send_i %= sizeof(m_key);
+        uint8 x = (data[t] ^ m_key[m_send_i]) + m_send_j;
+        ++m_send_i;
+        data[t] = m_send_j = x;
+    }
+}
+
+void BotCrypt::DecryptRecv(uint8* data, size_t len)
+{
+    if (!m_initialized)
+        return;
+
+    for (size_t t = 0; t < len; ++t)
+    {
+        m_recv_i %= sizeof(m_key);
+        uint8 x = (data[t] - m_recv_j) ^ m_key[m_recv_i];
+        ++m_recv_i;
+        m_recv_j = data[t];
+        data[t] = x;
+    }
+}
+
+BotSession::BotSession(BotWorker* worker, BotConfig const& config, uint32 index) :
+    m_worker(worker),
+    m_config(config),
+    m_index(index),
+    m_state(BOT_STATE_IDLE),
+    m_stateTime(0),
+    m_reconnectTime(getMSTime()),
+    m_registered(false),
+    m_writeScheduled(false),
+    m_haveHeader(false),
+    m_packetSize(0),
+    m_packetOpcode(0),
+    m_guid(0),
+    m_language(LANG_COMMON),
+    m_mapId(0),
+    m_homeX(0.0f), m_homeY(0.0f), m_homeZ(0.0f),
+    m_x(0.0f), m_y(0.0f), m_z(0.0f), m_o(0.0f),
+    m_targetX(0.0f), m_targetY(0.0f),
+    m_moving(false),
+    m_lastMove(0),
+    m_nextMove(0),
+    m_nextHeartbeat(0),
+    m_nextChat(0),
+    m_nextCast(0),
+    m_nextAuction(0),
+    m_nextPing(0),
+    m_nextQueryTime(0),
+    m_nextServerInfo(0),
+    m_pingCounter(0),
+    m_castCount(0)
+{
+    std::ostringstream account;
+    account << config.accountPrefix << (config.accountStart + index);
+    m_account = account.str();
+    std::transform(m_account.begin(), m_account.end(), m_account.begin(), ::toupper);
+
+    memset(m_probeStart, 0, sizeof(m_probeStart));
+}
+
+BotSession::~BotSession()
+{
+    Disconnect();
+}
+
+bool BotSession::Connect(ACE_INET_Addr const& address)
+{
+    ACE_SOCK_Connector connector;
+    ACE_Time_Value timeout(5);
+
+    if (connector.connect(m_peer, address, &timeout) == -1)
+        return false;
+
+    m_peer.enable(ACE_NONBLOCK);
+
+    int nodelay = 1;
+    m_peer.set_option(ACE_IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+
+    if (m_worker->GetReactor()->register_handler(this, ACE_Event_Handler::READ_MASK) == -1)
+    {
+        m_peer.close();
+        return false;
+    }
+
+    m_registered = true;
+    return true;
+}
+
+void BotSession::Disconnect()
+{
+    if (m_registered)
+    {
+        m_worker->GetReactor()->remove_handler(this, ACE_Event_Handler::ALL_EVENTS_MASK | ACE_Event_Handler::DONT_CALL);
+        m_registered = false;
+    }
+
+    m_peer.close();
+    m_writeScheduled = false;
+    m_inBuffer.clear();
+    m_outBuffer.clear();
+    m_crypt.Reset();
+    m_haveHeader = false;
+}
+
+void BotSession::Fail(char const* reason)
+{
+    DEBUG_LOG("Bot %s: %s", m_account.c_str(), reason);
+
+    ++m_worker->GetStats().failures;
+
+    Disconnect();
+
+    m_state = BOT_STATE_IDLE;
+    m_reconnectTime = getMSTime() + m_config.reconnectDelay;
+    m_moving = false;
+    memset(m_probeStart, 0, sizeof(m_probeStart));
+}
+
+void BotSession::SetState(BotState state, uint32 now)
+{
+    m_state = state;
+    m_stateTime = now;
+}
+
+void BotSession::Write(uint8 const* data, size_t len)
+{
+    m_outBuffer.insert(m_outBuffer.end(), data, data + len);
+    m_worker->GetStats().bytesOut += len;
+}
+
+bool BotSession::Flush()
+{
+    while (!m_outBuffer.empty())
+    {
+        #ifdef MSG_NOSIGNAL
+        ssize_t n = m_peer.send(&m_outBuffer[0], m_outBuffer.size(), MSG_NOSIGNAL);
+        #else
+        ssize_t n = m_peer.send(&m_outBuffer[0], m_outBuffer.size());
+        #endif // MSG_NOSIGNAL
+
+        if (n <= 0)
+        {
+            if (n == -1 && (errno == EWOULDBLOCK || errno == EAGAIN))
+            {
+                // the rest goes out from handle_output
+                if (!m_writeScheduled)
+                {
+                    m_writeScheduled = true;
+                    m_worker->GetReactor()->schedule_wakeup(this, ACE_Event_Handler::WRITE_MASK);
+                }
+                return true;
+            }
+
+            return false;
+        }
+
+        m_outBuffer.erase(m_outBuffer.begin(), m_outBuffer.begin() + n);
+    }
+
+    if (m_writeScheduled)
+    {
+        m_writeScheduled = false;
+        m_worker->GetReactor()->cancel_wakeup(this, ACE_Event_Handler::WRITE_MASK);
+    }
+
+    return true;
+}
+
+void BotSession::SendPacket(uint16 opcode, ByteBuffer const& payload)
+{
+    if (!m_registered)
+        return;
+
+    // size is big endian and counts the opcode, only the header is encrypted
+    uint16 size = uint16(payload.size() + 4);
+    uint8 header[6];
+    header[0] = uint8(size >> 8);
+    header[1] = uint8(size & 0xFF);
+    header[2] = uint8(opcode & 0xFF);
+    header[3] = uint8(opcode >> 8);
+    header[4] = 0;
+    header[5] = 0;
+
+    m_crypt.EncryptSend(header, sizeof(header));
+
+    Write(header, sizeof(header));
+    if (payload.size())
+        Write(payload.contents(), payload.size());
+
+    ++m_worker->GetStats().packetsOut;
+
+    if (!Flush())
+        Fail("send failed");
+}
+
+int BotSession::handle_input(ACE_HANDLE)
+{
+    uint8 buffer[4096];
+
+    ssize_t n = m_peer.recv(buffer, sizeof(buffer));
+    if (n == 0)
+    {
+        Fail("connection closed by server");
+        return 0;
+    }
+
+    if (n < 0)
+    {
+        if (errno != EWOULDBLOCK && errno != EAGAIN)
+            Fail("receive failed");
+        return 0;
+    }
+
+    m_worker->GetStats().bytesIn += n;
+    m_inBuffer.insert(m_inBuffer.end(), buffer, buffer + n);
+
+    uint32 now = getMSTime();
+
+    switch (m_state)
+    {
+        case BOT_STATE_REALM_CHALLENGE:
+        case BOT_STATE_REALM_PROOF:
+        case BOT_STATE_REALM_LIST:
+            HandleRealmInput(now);
+            break;
+        case BOT_STATE_IDLE:
+            break;
+        default:
+            HandleWorldInput(now);
+            break;
+    }
+
+    return 0;
+}
+
+int BotSession::handle_output(ACE_HANDLE)
+{
+    if (!Flush())
+        Fail("send failed");
+
+    return 0;
+}
+
+void BotSession::Update(uint32 now)
+{
+    switch (m_state)
+    {
+        case BOT_STATE_IDLE:
+            if (IsDue(now, m_reconnectTime))
+                SendLogonChallenge(now);
+            return;
+        case BOT_STATE_IN_WORLD:
+            break;
+        default:
+            if (getMSTimeDiff(m_stateTime, now) > m_config.stateTimeout)
+                Fail("login timed out");
+            return;
+    }
+
+    for (uint8 i = 0; i < MAX_LOAD_PROBES; ++i)
+    {
+        if (m_probeStart[i] && getMSTimeDiff(m_probeStart[i], now) > BOT_PROBE_TIMEOUT)
+        {
+            m_probeStart[i] = 0;
+            ++m_worker->GetStats().probeTimeouts;
+        }
+    }
+
+    UpdateMovement(now);
+
+    if (m_config.pingInterval && IsDue(now, m_nextPing) && !IsProbePending(PROBE_PING))
+    {
+        m_nextPing = now + m_config.pingInterval;
+
+        ByteBuffer data(8);
+        data << uint32(++m_pingCounter);
+        data << uint32(m_config.pingInterval);
+        StartProbe(PROBE_PING, now);
+        SendPacket(CMSG_PING, data);
+    }
+
+    if (m_config.queryTimeInterval && IsDue(now, m_nextQueryTime) && !IsProbePending(PROBE_QUERY_TIME))
+    {
+        m_nextQueryTime = now + m_config.queryTimeInterval;
+
+        StartProbe(PROBE_QUERY_TIME, now);
+        SendPacket(CMSG_QUERY_TIME, ByteBuffer(0));
+    }
+
+    if (m_config.chatInterval && IsDue(now, m_nextChat) && !IsProbePending(PROBE_CHAT))
+    {
+        m_nextChat = now + m_config.chatInterval;
+
+        StartProbe(PROBE_CHAT, now);
+        SendChat("load test");
+    }
+
+    if (m_config.castInterval && m_config.castSpell && IsDue(now, m_nextCast) && !IsProbePending(PROBE_CAST))
+    {
+        m_nextCast = now + m_config.castInterval;
+
+        ByteBuffer data(9);
+        data << uint32(m_config.castSpell);
+        data << uint8(++m_castCount);
+        data << uint32(0);                                  // target mask, self
+        StartProbe(PROBE_CAST, now);
+        SendPacket(CMSG_CAST_SPELL, data);
+    }
+
+    if (m_config.auctionInterval && m_config.auctioneer && IsDue(now, m_nextAuction) && !IsProbePending(PROBE_AUCTION))
+    {
+        m_nextAuction = now + m_config.auctionInterval;
+
+        ByteBuffer data(40);
+        data << uint64(m_config.auctioneer);
+        data << uint32(0);                                  // list from
+        data << "";                                         // searched name
+        data << uint8(0) << uint8(0);                       // level min, max
+        data << uint32(0xFFFFFFFF);                         // slot
+        data << uint32(0xFFFFFFFF);                         // main category
+        data << uint32(0xFFFFFFFF);                         // sub category
+        data << uint32(0xFFFFFFFF);                         // quality
+        data << uint8(0);                                   // usable
+        data << uint8(0);
+        data << uint8(0);                                   // sort columns
+        StartProbe(PROBE_AUCTION, now);
+        SendPacket(CMSG_AUCTION_LIST_ITEMS, data);
+    }
+
+    // one bot polls the server update time
+    if (m_config.serverInfoInterval && !m_index && IsDue(now, m_nextServerInfo))
+    {
+        m_nextServerInfo = now + m_config.serverInfoInterval;
+        SendChat(".server info");
+    }
+}
+
+void BotSession::StartProbe(LoadProbe probe, uint32 now)
+{
+    m_probeStart[probe] = now ? now : 1;
+}
+
+void BotSession::FinishProbe(LoadProbe probe, uint32 now)
+{
+    if (!m_probeStart[probe])
+        return;
+
+    m_worker->GetStats().latency[probe].Add(getMSTimeDiff(m_probeStart[probe], now));
+    m_probeStart[probe] = 0;
+}
+
+// ---------------------------------------------------------------------------
+// Realm server
+
+void BotSession::SendLogonChallenge(uint32 now)
+{
+    if (!Connect(m_config.realmAddress))
+    {
+        Fail("cannot connect to the realm server");
+        return;
+    }
+
+    // strings are sent with reversed byte order, as little endian four character codes
+    ByteBuffer pkt(64);
+    pkt << uint8(CMD_AUTH_LOGON_CHALLENGE);
+    pkt << uint8(0);
+    pkt << uint16(29 + m_account.size());                   // size of the rest
+    pkt.append("WoW", 4);
+    pkt << uint8(2) << uint8(4) << uint8(3);
+    pkt << uint16(CLIENT_BUILD);
+    pkt.append("68x", 4);                                   // platform
+    pkt.append("niW", 4);                                   // os
+    pkt.append("SUne", 4);                                  // country
+    pkt << uint32(0);                                       // timezone bias
+    pkt << uint32(0x0100007F);                              // ip
+    pkt << uint8(m_account.size());
+    pkt.append(m_account.c_str(), m_account.size());
+
+    Write(pkt.contents(), pkt.size());
+
+    SetState(BOT_STATE_REALM_CHALLENGE, now);
+    StartProbe(PROBE_REALM_LOGON, now);
+
+    if (!Flush())
+        Fail("send failed");
+}
+
+bool BotSession::HandleRealmInput(uint32 now)
+{
+    switch (m_state)
+    {
+        case BOT_STATE_REALM_CHALLENGE:
+            if (m_inBuffer.size() < 3)
+                return true;
+            if (m_inBuffer[2] != 0)
+            {
+                Fail("logon challenge refused");
+                return false;
+            }
+            // cmd, unk, result, B[32], g_len, g, N_len, N[32], s[32], unk3[16], security flags
+            if (m_inBuffer.size() < 119)
+                return true;
+            return HandleLogonChallenge(now);
+        case BOT_STATE_REALM_PROOF:
+            if (m_inBuffer.size() < 2)
+                return true;
+            if (m_inBuffer[1] != 0)
+            {
+                Fail("logon proof refused, wrong password or unknown account");
+                return false;
+            }
+            // cmd, error, M2[20], unk1, unk2, unk3
+            if (m_inBuffer.size() < 32)
+                return true;
+            return HandleLogonProof(now);
+        case BOT_STATE_REALM_LIST:
+        {
+            if (m_inBuffer.size() < 3)
+                return true;
+            uint16 size = uint16(m_inBuffer[1] | (m_inBuffer[2] << 8));
+            if (m_inBuffer.size() < size_t(3 + size))
+                return true;
+
+            FinishProbe(PROBE_REALM_LIST, now);
+
+            // the client would pick the world server from the list, the bots use the configured one
+            Disconnect();
+            if (!Connect(m_config.worldAddress))
+            {
+                Fail("cannot connect to the world server");
+                return false;
+            }
+
+            SetState(BOT_STATE_WORLD_CHALLENGE, now);
+            return true;
+        }
+        default:
+            return true;
+    }
+}
+
+bool BotSession::HandleLogonChallenge(uint32 now)
+{
+    if (m_inBuffer[118] != 0)
+    {
+        Fail("account requires a pin, matrix or token");
+        return false;
+    }
+
+    BigNumber B, g, N, s;
+    B.SetBinary(&m_inBuffer[3], 32);
+    g.SetBinary(&m_inBuffer[36], 1);
+    N.SetBinary(&m_inBuffer[38], 32);
+    s.SetBinary(&m_inBuffer[70], 32);
+
+    m_inBuffer.clear();
+
+    // same steps as AuthSocket, from the client side
+    std::string password = m_config.password;
+    std::transform(password.begin(), password.end(), password.begin(), ::toupper);
+
+    Sha1Hash sha;
+    sha.UpdateData(m_account);
+    sha.UpdateData(":");
+    sha.UpdateData(password);
+    sha.Finalize();
+
+    uint8 credentials[SHA_DIGEST_LENGTH];
+    memcpy(credentials, sha.GetDigest(), SHA_DIGEST_LENGTH);
+
+    sha.Initialize();
+    sha.UpdateData(s.AsByteArray(), s.GetNumBytes());
+    sha.UpdateData(credentials, SHA_DIGEST_LENGTH);
+    sha.Finalize();
+    BigNumber x;
+    x.SetBinary(sha.GetDigest(), sha.GetLength());
+
+    BigNumber a;
+    a.SetRand(19 * 8);
+    m_A = g.ModExp(a, N);
+
+    sha.Initialize();
+    sha.UpdateBigNumbers(&m_A, &B, NULL);
+    sha.Finalize();
+    BigNumber u;
+    u.SetBinary(sha.GetDigest(), 20);
+
+    // S = (B - 3 * g^x) ^ (a + u * x), kept positive
+    BigNumber gx = g.ModExp(x, N);
+    BigNumber kgx = (gx * BigNumber(3)) % N;
+    BigNumber base = ((B + N) - kgx) % N;
+    BigNumber S = base.ModExp(a + u * x, N);
+
+    uint8 t[32];
+    uint8 t1[16];
+    uint8 vK[40];
+    memcpy(t, S.AsByteArray(32), 32);
+    for (int i = 0; i < 16; ++i)
+        t1[i] = t[i * 2];
+    sha.Initialize();
+    sha.UpdateData(t1, 16);
+    sha.Finalize();
+    for (int i = 0; i < 20; ++i)
+        vK[i * 2] = sha.GetDigest()[i];
+    for (int i = 0; i < 16; ++i)
+        t1[i] = t[i * 2 + 1];
+    sha.Initialize();
+    sha.UpdateData(t1, 16);
+    sha.Finalize();
+    for (int i = 0; i < 20; ++i)
+        vK[i * 2 + 1] = sha.GetDigest()[i];
+    m_K.SetBinary(vK, 40);
+
+    uint8 hash[20];
+    sha.Initialize();
+    sha.UpdateBigNumbers(&N, NULL);
+    sha.Finalize();
+    memcpy(hash, sha.GetDigest(), 20);
+    sha.Initialize();
+    sha.UpdateBigNumbers(&g, NULL);
+    sha.Finalize();
+    for (int i = 0; i < 20; ++i)
+        hash[i] ^= sha.GetDigest()[i];
+    BigNumber t3;
+    t3.SetBinary(hash, 20);
+
+    sha.Initialize();
+    sha.UpdateData(m_account);
+    sha.Finalize();
+    uint8 t4[SHA_DIGEST_LENGTH];
+    memcpy(t4, sha.GetDigest(), SHA_DIGEST_LENGTH);
+
+    sha.Initialize();
+    sha.UpdateBigNumbers(&t3, NULL);
+    sha.UpdateData(t4, SHA_DIGEST_LENGTH);
+    sha.UpdateBigNumbers(&s, &m_A, &B, &m_K, NULL);
+    sha.Finalize();
+    m_M.SetBinary(sha.GetDigest(), 20);
+
+    ByteBuffer pkt(75);
+    pkt << uint8(CMD_AUTH_LOGON_PROOF);
+    pkt.append(m_A.AsByteArray(32), 32);
+    pkt.append(sha.GetDigest(), 20);                        // M1
+    for (int i = 0; i < 20; ++i)
+        pkt << uint8(0);                                    // crc hash, not checked
+    pkt << uint8(0);                                        // number of keys
+    pkt << uint8(0);                                        // security flags
+
+    Write(pkt.contents(), pkt.size());
+    SetState(BOT_STATE_REALM_PROOF, now);
+
+    if (!Flush())
+    {
+        Fail("send failed");
+        return false;
+    }
+
+    return true;
+}
+
+bool BotSession::HandleLogonProof(uint32 now)
+{
+    Sha1Hash sha;
+    sha.UpdateBigNumbers(&m_A, &m_M, &m_K, NULL);
+    sha.Finalize();
+
+    if (memcmp(sha.GetDigest(), &m_inBuffer[2], 20))
+    {
+        Fail("realm server proof does not match");
+        return false;
+    }
+
+    m_inBuffer.clear();
+    FinishProbe(PROBE_REALM_LOGON, now);
+
+    uint8 pkt[5] = { CMD_REALM_LIST, 0, 0, 0, 0 };
+    Write(pkt, sizeof(pkt));
+    SetState(BOT_STATE_REALM_LIST, now);
+    StartProbe(PROBE_REALM_LIST, now);
+
+    if (!Flush())
+    {
+        Fail("send failed");
+        return false;
+    }
+
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// World server
+
+bool BotSession::HandleWorldInput(uint32 now)
+{
+    while (m_state != BOT_STATE_IDLE)
+    {
+        if (!m_haveHeader)
+        {
+            if (m_inBuffer.size() < 4)
+                return true;
+
+            // size is big endian and counts the opcode
+            m_crypt.DecryptRecv(&m_inBuffer[0], 4);
+            m_packetSize = uint16((m_inBuffer[0] << 8) | m_inBuffer[1]);
+            m_packetOpcode = uint16(m_inBuffer[2] | (m_inBuffer[3] << 8));
+            m_inBuffer.erase(m_inBuffer.begin(), m_inBuffer.begin() + 4);
+            m_haveHeader = true;
+
+            if (m_packetSize < 2)
+            {
+                Fail("malformed packet header");
+                return false;
+            }
+        }
+
+        size_t size = m_packetSize - 2;
+        if (m_inBuffer.size() < size)
+            return true;
+
+        ByteBuffer data(size);
+        if (size)
+            data.append(&m_inBuffer[0], size);
+        m_inBuffer.erase(m_inBuffer.begin(), m_inBuffer.begin() + size);
+        m_haveHeader = false;
+
+        ++m_worker->GetStats().packetsIn;
+
+        try
+        {
+            HandleWorldPacket(m_packetOpcode, data, now);
+        }
+        catch (ByteBufferException const&)
+        {
+            Fail("malformed packet");
+            return false;
+        }
+    }
+
+    return false;
+}
+
+void BotSession::HandleWorldPacket(uint16 opcode, ByteBuffer& data, uint32 now)
+{
+    switch (opcode)
+    {
+        case SMSG_AUTH_CHALLENGE:
+            HandleAuthChallenge(data, now);
+            break;
+        case SMSG_AUTH_RESPONSE:
+            HandleAuthResponse(data, now);
+            break;
+        case SMSG_CHAR_ENUM:
+            HandleCharEnum(data, now);
+            break;
+        case SMSG_CHAR_CREATE:
+        {
+            uint8 result;
+            data >> result;
+            FinishProbe(PROBE_CHAR_CREATE, now);
+
+            if (result != CHAR_CREATE_SUCCESS)
+            {
+                Fail("character creation failed");
+                break;
+            }
+
+            StartProbe(PROBE_CHAR_ENUM, now);
+            SetState(BOT_STATE_CHAR_ENUM, now);
+            SendPacket(CMSG_CHAR_ENUM, ByteBuffer(0));
+            break;
+        }
+        case SMSG_LOGIN_VERIFY_WORLD:
+            HandleLoginVerifyWorld(data, now);
+            break;
+        case SMSG_PONG:
+            FinishProbe(PROBE_PING, now);
+            break;
+        case SMSG_QUERY_TIME_RESPONSE:
+            FinishProbe(PROBE_QUERY_TIME, now);
+            break;
+        case SMSG_MESSAGECHAT:
+            HandleMessageChat(data, now);
+            break;
+        case SMSG_SPELL_START:
+            HandleSpellStart(data, now);
+            break;
+        case SMSG_CAST_FAILED:                              // only sent to the caster
+            FinishProbe(PROBE_CAST, now);
+            break;
+        case SMSG_AUCTION_LIST_RESULT:
+            FinishProbe(PROBE_AUCTION, now);
+            break;
+        default:
+            break;
+    }
+}
+
+void BotSession::HandleAuthChallenge(ByteBuffer& data, uint32 now)
+{
+    if (m_state != BOT_STATE_WORLD_CHALLENGE)
+        return;
+
+    uint32 serverSeed;
+    data >> serverSeed;
+
+    uint32 clientSeed = rand32();
+    uint32 t = 0;
+
+    Sha1Hash sha;
+    sha.UpdateData(m_account);
+    sha.UpdateData((uint8*)&t, 4);
+    sha.UpdateData((uint8*)&clientSeed, 4);
+    sha.UpdateData((uint8*)&serverSeed, 4);
+    sha.UpdateBigNumbers(&m_K, NULL);
+    sha.Finalize();
+
+    // no addon data, the server skips the addon answer then
+    ByteBuffer pkt(64);
+    pkt << uint32(CLIENT_BUILD);
+    pkt << uint32(0);
+    pkt << m_account;
+    pkt << uint32(clientSeed);
+    pkt.append(sha.GetDigest(), 20);
+
+    StartProbe(PROBE_WORLD_AUTH, now);
+    SetState(BOT_STATE_WORLD_AUTH, now);
+    SendPacket(CMSG_AUTH_SESSION, pkt);
+
+    // the server answers with encrypted headers from here on
+    m_crypt.Init(&m_K);
+}
+
+void BotSession::HandleAuthResponse(ByteBuffer& data, uint32 now)
+{
+    if (m_state != BOT_STATE_WORLD_AUTH)
+        return;
+
+    uint8 result;
+    data >> result;
+
+    if (result == AUTH_WAIT_QUEUE)
+    {
+        // queue position updates keep the bot waiting
+        m_stateTime = now;
+        return;
+    }
+
+    FinishProbe(PROBE_WORLD_AUTH, now);
+
+    if (result != AUTH_OK)
+    {
+        Fail("world server refused the session");
+        return;
+    }
+
+    StartProbe(PROBE_CHAR_ENUM, now);
+    SetState(BOT_STATE_CHAR_ENUM, now);
+    SendPacket(CMSG_CHAR_ENUM, ByteBuffer(0));
+}
+
+void BotSession::HandleCharEnum(ByteBuffer& data, uint32 now)
+{
+    if (m_state != BOT_STATE_CHAR_ENUM)
+        return;
+
+    FinishProbe(PROBE_CHAR_ENUM, now);
+
+    uint8 count;
+    data >> count;
+
+    if (!count)
+    {
+        // letters only, like the name checks of the server want them
+        std::string name = "Bot";
+        uint32 number = m_config.accountStart + m_index;
+        do
+        {
+            name += char('a' + number % 26);
+            number /= 26;
+        }
+        while (number);
+
+        ByteBuffer pkt(32);
+        pkt << name;
+        pkt << uint8(m_config.race);
+        pkt << uint8(m_config.class_);
+        pkt << uint8(0);                                    // gender
+        pkt << uint8(0) << uint8(0);                        // skin, face
+        pkt << uint8(0) << uint8(0) << uint8(0);            // hair style, hair color, facial hair
+        pkt << uint8(0);                                    // outfit
+
+        StartProbe(PROBE_CHAR_CREATE, now);
+        SetState(BOT_STATE_CHAR_CREATE, now);
+        SendPacket(CMSG_CHAR_CREATE, pkt);
+        return;
+    }
+
+    // the first character is used, everything after its race is ignored
+    std::string name;
+    uint8 race;
+    data >> m_guid;
+    data >> name;
+    data >> race;
+
+    switch (race)
+    {
+        case 1: case 3: case 4: case 7: case 11:            // alliance
+            m_language = LANG_COMMON;
+            break;
+        default:
+            m_language = LANG_ORCISH;
+            break;
+    }
+
+    ByteBuffer pkt(8);
+    pkt << uint64(m_guid);
+
+    StartProbe(PROBE_PLAYER_LOGIN, now);
+    SetState(BOT_STATE_LOGIN, now);
+    SendPacket(CMSG_PLAYER_LOGIN, pkt);
+}
+
+void BotSession::HandleLoginVerifyWorld(ByteBuffer& data, uint32 now)
+{
+    if (m_state != BOT_STATE_LOGIN)
+        return;
+
+    FinishProbe(PROBE_PLAYER_LOGIN, now);
+
+    data >> m_mapId;
+    data >> m_homeX >> m_homeY >> m_homeZ >> m_o;
+
+    m_x = m_homeX;
+    m_y = m_homeY;
+    m_z = m_homeZ;
+    m_moving = false;
+
+    ++m_worker->GetStats().logins;
+    SetState(BOT_STATE_IN_WORLD, now);
+
+    // spread the behaviours of bots that logged in at the same time
+    m_nextMove = now + urand(0, 2000);
+    m_nextChat = now + urand(0, m_config.chatInterval);
+    m_nextCast = now + urand(0, m_config.castInterval);
+    m_nextAuction = now + urand(0, m_config.auctionInterval);
+    m_nextPing = now + urand(0, m_config.pingInterval);
+    m_nextQueryTime = now + urand(0, m_config.queryTimeInterval);
+    m_nextServerInfo = now;
+}
+
+void BotSession::HandleMessageChat(ByteBuffer& data, uint32 now)
+{
+    uint8 type;
+    uint32 language;
+    uint64 sender;
+    uint64 target;
+    uint32 length;
+    std::string text;
+
+    data >> type;
+    if (type != CHAT_MSG_SAY && type != CHAT_MSG_SYSTEM)
+        return;
+
+    data >> language >> sender;
+    data.read_skip<uint32>();
+    data >> target >> length >> text;
+
+    if (type == CHAT_MSG_SAY)
+    {
+        if (sender == m_guid)
+            FinishProbe(PROBE_CHAT, now);
+        return;
+    }
+
+    // answer to .server info, "Update time diff: %u" in the default strings
+    if (m_index)
+        return;
+
+    std::string::size_type pos = text.find("diff");
+    if (pos == std::string::npos)
+        return;
+
+    pos = text.find_first_of("0123456789", pos);
+    if (pos != std::string::npos)
+        m_worker->GetStats().serverDiff.Add(atoi(text.c_str() + pos));
+}
+
+void BotSession::HandleSpellStart(ByteBuffer& data, uint32 now)
+{
+    // caster item or caster, then caster, spells of others nearby are seen as well
+    data.readPackGUID();
+    if (data.readPackGUID() == m_guid)
+        FinishProbe(PROBE_CAST, now);
+}
+
+// ---------------------------------------------------------------------------
+// Behaviours
+
+void BotSession::SendChat(char const* text)
+{
+    ByteBuffer data(32);
+    data << uint32(CHAT_MSG_SAY);
+    data << uint32(m_language);
+    data << text;
+    SendPacket(CMSG_MESSAGECHAT, data);
+}
+
+void BotSession::NextWaypoint()
+{
+    float angle = frand(0.0f, 2.0f * float(M_PI));
+    float distance = frand(0.0f, m_config.moveRadius);
+
+    m_targetX = m_homeX + cos(angle) * distance;
+    m_targetY = m_homeY + sin(angle) * distance;
+
+    m_o = atan2(m_targetY - m_y, m_targetX - m_x);
+    if (m_o < 0.0f)
+        m_o += 2.0f * float(M_PI);
+}
+
+void BotSession::SendMovement(uint16 opcode, uint32 now)
+{
+    ByteBuffer data(32);
+    data << uint32(m_moving ? MOVEMENTFLAG_FORWARD : 0);
+    data << uint8(0);
+    data << uint32(now);
+    data << m_x << m_y << m_z << m_o;
+    data << uint32(0);                                      // fall time
+    SendPacket(opcode, data);
+}
+
+void BotSession::UpdateMovement(uint32 now)
+{
+    if (m_config.moveRadius <= 0.0f)
+        return;
+
+    if (!m_moving)
+    {
+        if (!IsDue(now, m_nextMove))
+            return;
+
+        NextWaypoint();
+        m_moving = true;
+        m_lastMove = now;
+        m_nextHeartbeat = now + BOT_HEARTBEAT_INTERVAL;
+        SendMovement(MSG_MOVE_START_FORWARD, now);
+        return;
+    }
+
+    float step = BOT_RUN_SPEED * getMSTimeDiff(m_lastMove, now) / 1000.0f;
+    m_lastMove = now;
+
+    float dx = m_targetX - m_x;
+    float dy = m_targetY - m_y;
+    float distance = sqrt(dx * dx + dy * dy);
+
+    if (step >= distance)
+    {
+        m_x = m_targetX;
+        m_y = m_targetY;
+        m_moving = false;
+        m_nextMove = now + urand(1000, 5000);
+        SendMovement(MSG_MOVE_STOP, now);
+        return;
+    }
+
+    m_x += dx / distance * step;
+    m_y += dy / distance * step;
+
+    if (IsDue(now, m_nextHeartbeat))
+    {
+        m_nextHeartbeat = now + BOT_HEARTBEAT_INTERVAL;
+        SendMovement(MSG_MOVE_HEARTBEAT, now);
+    }
+}
@@ -0,0 +1,207 @@
+/*
+ * This file is part of the OregonCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _BOTSESSION_H
+#define _BOTSESSION_H
+
+#include "Common.h"
+#include "ByteBuffer.h"
+#include "Auth/BigNumber.h"
+#include "LoadStats.h"
+
+#include <ace/Event_Handler.h>
+#include <ace/SOCK_Stream.h>
+#include <ace/INET_Addr.h>
+
+#include <vector>
+
+class BotWorker;
+
+// Settings shared by all bots, read once from the configuration file
+struct BotConfig
+{
+    ACE_INET_Addr realmAddress;
+    ACE_INET_Addr worldAddress;
+
+    std::string accountPrefix;
+    std::string password;
+    uint32 accountStart;
+
+    uint8 race;
+    uint8 class_;
+
+    float moveRadius;                                       // 0 disables movement
+    uint32 chatInterval;                                    // all intervals in ms, 0 disables the behaviour
+    uint32 castInterval;
+    uint32 castSpell;
+    uint32 auctionInterval;
+    uint64 auctioneer;
+    uint32 pingInterval;
+    uint32 queryTimeInterval;
+    uint32 serverInfoInterval;                              // only sent by the first bot
+
+    uint32 stateTimeout;
+    uint32 reconnectDelay;
+};
+
+enum BotState
+{
+    BOT_STATE_IDLE,                                         // not connected, waiting for (re)connect
+    BOT_STATE_REALM_CHALLENGE,
+    BOT_STATE_REALM_PROOF,
+    BOT_STATE_REALM_LIST,
+    BOT_STATE_WORLD_CHALLENGE,
+    BOT_STATE_WORLD_AUTH,
+    BOT_STATE_CHAR_ENUM,
+    BOT_STATE_CHAR_CREATE,
+    BOT_STATE_LOGIN,
+    BOT_STATE_IN_WORLD
+};
+
+// Header encryption as seen from the client side, the mirror of AuthCrypt
+class BotCrypt
+{
+    public:
+        BotCrypt() : m_send_i(0), m_send_j(0), m_recv_i(0), m_recv_j(0), m_initialized(false) { }
+
+        void Init(BigNumber* K);
+        void Reset() { m_initialized = false; }
+
+        void EncryptSend(uint8* data, size_t len);
+        void DecryptRecv(uint8* data, size_t len);
+
+    private:
+        uint8 m_key[20];
+        uint8 m_send_i, m_send_j, m_recv_i, m_recv_j;
+        bool m_initialized;
+};
+
+/**
+ * One simulated client.
+ *
+ * Runs the realm SRP6 logon like the game client does, connects to the
+ * world server with the session key, creates a character if the account
+ * has none and enters the world. In the world it walks between random
+ * waypoints around its spawn point and periodically chats, casts, pings
+ * and searches the auction house, measuring the round trip of every
+ * request. All methods are called from the owning worker thread only.
+ */
+class BotSession : public ACE_Event_Handler
+{
+    public:
+        BotSession(BotWorker* worker, BotConfig const& config, uint32 index);
+        ~BotSession();
+
+        // drives timeouts and behaviours, called every worker tick
+        void Update(uint32 now);
+
+        BotState GetState() const { return m_state; }
+
+        // ACE_Event_Handler
+        ACE_HANDLE get_handle() const override { return m_peer.get_handle(); }
+        int handle_input(ACE_HANDLE = ACE_INVALID_HANDLE) override;
+        int handle_output(ACE_HANDLE = ACE_INVALID_HANDLE) override;
+
+    private:
+        bool Connect(ACE_INET_Addr const& address);
+        void Disconnect();
+        void Fail(char const* reason);
+        void SetState(BotState state, uint32 now);
+
+        // raw output, flushed right away and buffered if the socket would block
+        void Write(uint8 const* data, size_t len);
+        void SendPacket(uint16 opcode, ByteBuffer const& payload);
+        bool Flush();
+
+        // realm server
+        void SendLogonChallenge(uint32 now);
+        bool HandleRealmInput(uint32 now);
+        bool HandleLogonChallenge(uint32 now);
+        bool HandleLogonProof(uint32 now);
+
+        // world server
+        bool HandleWorldInput(uint32 now);
+        void HandleWorldPacket(uint16 opcode, ByteBuffer& data, uint32 now);
+        void HandleAuthChallenge(ByteBuffer& data, uint32 now);
+        void HandleAuthResponse(ByteBuffer& data, uint32 now);
+        void HandleCharEnum(ByteBuffer& data, uint32 now);
+        void HandleLoginVerifyWorld(ByteBuffer& data, uint32 now);
+        void HandleMessageChat(ByteBuffer& data, uint32 now);
+        void HandleSpellStart(ByteBuffer& data, uint32 now);
+
+        // behaviours
+        void UpdateMovement(uint32 now);
+        void SendMovement(uint16 opcode, uint32 now);
+        void NextWaypoint();
+        void SendChat(char const* text);
+
+        void StartProbe(LoadProbe probe, uint32 now);
+        void FinishProbe(LoadProbe probe, uint32 now);
+        bool IsProbePending(LoadProbe probe) const { return m_probeStart[probe] != 0; }
+
+        BotWorker* m_worker;
+        BotConfig const& m_config;
+        uint32 m_index;
+        std::string m_account;                              // upper case, like the client sends it
+
+        BotState m_state;
+        uint32 m_stateTime;                                 // when the current state was entered
+        uint32 m_reconnectTime;
+
+        ACE_SOCK_Stream m_peer;
+        bool m_registered;
+        bool m_writeScheduled;
+        std::vector<uint8> m_inBuffer;
+        std::vector<uint8> m_outBuffer;
+
+        // SRP6
+        BigNumber m_A;
+        BigNumber m_M;
+        BigNumber m_K;
+
+        // world connection
+        BotCrypt m_crypt;
+        bool m_haveHeader;                                  // decrypted header of the next packet is known
+        uint16 m_packetSize;
+        uint16 m_packetOpcode;
+        uint64 m_guid;
+        uint32 m_language;                                  // of the character's faction, for chat
+
+        // position and movement
+        uint32 m_mapId;
+        float m_homeX, m_homeY, m_homeZ;
+        float m_x, m_y, m_z, m_o;
+        float m_targetX, m_targetY;
+        bool m_moving;
+        uint32 m_lastMove;
+        uint32 m_nextMove;
+        uint32 m_nextHeartbeat;
+
+        // next time a behaviour runs
+        uint32 m_nextChat;
+        uint32 m_nextCast;
+        uint32 m_nextAuction;
+        uint32 m_nextPing;
+        uint32 m_nextQueryTime;
+        uint32 m_nextServerInfo;
+        uint32 m_pingCounter;
+        uint8 m_castCount;
+
+        uint32 m_probeStart[MAX_LOAD_PROBES];               // 0 if no request is outstanding
+};
+
+#endif
@@ -0,0 +1,150 @@
+/*
+ * This file is part of the OregonCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "BotWorker.h"
+#include "BotSession.h"
+#include "Timer.h"
+
+#include <ace/Reactor.h>
+#include <ace/Reactor_Impl.h>
+#include <ace/TP_Reactor.h>
+#include <ace/Dev_Poll_Reactor.h>
+#include <ace/Guard_T.h>
+
+#include <algorithm>
+
+BotWorker::BotWorker(BotConfig const& config, float loginRate) :
+    m_config(config),
+    m_reactor(NULL),
+    m_loginRate(loginRate),
+    m_loginBudget(1.0f),
+    m_lastUpdate(0),
+    m_lastHandOver(0),
+    m_sharedOnline(0)
+{
+    ACE_Reactor_Impl* imp = 0;
+
+    #if defined (ACE_HAS_EVENT_POLL) || defined (ACE_HAS_DEV_POLL)
+
+    imp = new ACE_Dev_Poll_Reactor(ACE::max_handles());
+    imp->restart(1);
+
+    #else
+
+    imp = new ACE_TP_Reactor();
+
+    #endif
+
+    m_reactor = new ACE_Reactor(imp, 1);
+}
+
+BotWorker::~BotWorker()
+{
+    Stop();
+    Wait();
+
+    for (std::vector<BotSession*>::iterator itr = m_bots.begin(); itr != m_bots.end(); ++itr)
+        delete *itr;
+
+    delete m_reactor;
+}
+
+void BotWorker::AddBot(uint32 index)
+{
+    m_indexes.push_back(index);
+}
+
+int BotWorker::Start()
+{
+    // bots are started in order, the first account is popped last
+    std::reverse(m_indexes.begin(), m_indexes.end());
+
+    m_lastUpdate = m_lastHandOver = getMSTime();
+
+    if (m_reactor->schedule_timer(this, NULL, ACE_Time_Value::zero, ACE_Time_Value(0, BOT_WORKER_TICK * 1000)) == -1)
+        return -1;
+
+    return activate();
+}
+
+void BotWorker::Stop()
+{
+    m_reactor->end_reactor_event_loop();
+}
+
+void BotWorker::Wait()
+{
+    ACE_Task_Base::wait();
+}
+
+void BotWorker::CollectStats(LoadStats& total, uint32& online)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_sharedLock);
+
+    total.Merge(m_sharedStats);
+    m_sharedStats.Reset();
+    online += m_sharedOnline;
+}
+
+int BotWorker::svc()
+{
+    while (!m_reactor->reactor_event_loop_done())
+        if (m_reactor->run_reactor_event_loop() == -1)
+            break;
+
+    return 0;
+}
+
+int BotWorker::handle_timeout(ACE_Time_Value const& /*current_time*/, void const* /*act*/)
+{
+    uint32 now = getMSTime();
+    uint32 diff = getMSTimeDiff(m_lastUpdate, now);
+    m_lastUpdate = now;
+
+    // ramp up, never start more than one tick worth of bots at once
+    m_loginBudget += m_loginRate * diff / 1000.0f;
+    while (m_loginBudget >= 1.0f && !m_indexes.empty())
+    {
+        m_bots.push_back(new BotSession(this, m_config, m_indexes.back()));
+        m_indexes.pop_back();
+        m_loginBudget -= 1.0f;
+    }
+
+    if (m_indexes.empty())
+        m_loginBudget = 0.0f;
+
+    uint32 online = 0;
+    for (std::vector<BotSession*>::iterator itr = m_bots.begin(); itr != m_bots.end(); ++itr)
+    {
+        (*itr)->Update(now);
+        if ((*itr)->GetState() == BOT_STATE_IN_WORLD)
+            ++online;
+    }
+
+    if (getMSTimeDiff(m_lastHandOver, now) >= 1000)
+    {
+        m_lastHandOver = now;
+
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_sharedLock, 0);
+
+        m_sharedStats.Merge(m_stats);
+        m_sharedOnline = online;
+        m_stats.Reset();
+    }
+
+    return 0;
+}
@@ -0,0 +1,85 @@
+/*
+ * This file is part of the OregonCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _BOTWORKER_H
+#define _BOTWORKER_H
+
+#include "Common.h"
+#include "LoadStats.h"
+
+#include <ace/Task.h>
+#include <ace/Thread_Mutex.h>
+
+#include <vector>
+
+class ACE_Reactor;
+class BotSession;
+struct BotConfig;
+
+// Tick interval of the bot behaviours in ms
+#define BOT_WORKER_TICK 50
+
+/**
+ * Thread running a reactor for a share of the bots.
+ *
+ * Bots are started gradually at the configured login rate and updated
+ * from a reactor timer, so every bot is only ever touched by the thread
+ * that owns it. Statistics are collected thread locally and handed over
+ * to the main thread once per second.
+ */
+class BotWorker : protected ACE_Task_Base
+{
+    public:
+        BotWorker(BotConfig const& config, float loginRate);
+        ~BotWorker();
+
+        void AddBot(uint32 index);
+
+        int Start();
+        void Stop();
+        void Wait();
+
+        ACE_Reactor* GetReactor() { return m_reactor; }
+        LoadStats& GetStats() { return m_stats; }
+
+        // merges the stats handed over since the last call into total, called from the main thread
+        void CollectStats(LoadStats& total, uint32& online);
+
+    protected:
+        int svc() override;
+        int handle_timeout(ACE_Time_Value const& current_time, void const* act = 0) override;
+
+    private:
+        BotConfig const& m_config;
+        ACE_Reactor* m_reactor;
+
+        std::vector<uint32> m_indexes;                      // accounts to start
+        std::vector<BotSession*> m_bots;                    // started bots
+        float m_loginRate;                                  // bots started per second
+        float m_loginBudget;
+
+        uint32 m_lastUpdate;
+        uint32 m_lastHandOver;
+
+        LoadStats m_stats;                                  // worker thread only
+
+        ACE_Thread_Mutex m_sharedLock;
+        LoadStats m_sharedStats;
+        uint32 m_sharedOnline;
+};
+
+#endif
@@ -0,0 +1,250 @@
+/*
+ * This file is part of the OregonCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+* @file LoadGenerator.cpp
+* @brief Headless client load generator
+*
+* Logs in a configurable number of bots through the realm and world server
+* and reports the request latencies and throughput they see, to find the
+* capacity of a server build without real clients.
+*/
+
+#include "Common.h"
+#include "Database/DatabaseEnv.h"
+#include "Config/Config.h"
+#include "Log.h"
+#include "Auth/Sha1.h"
+#include "SystemConfig.h"
+#include "BotSession.h"
+#include "BotWorker.h"
+
+#include <ace/Get_Opt.h>
+#include <ace/OS_NS_unistd.h>
+
+#include <algorithm>
+#include <iomanip>
+
+#ifndef _OREGON_LOADGEN_CONFIG
+# define _OREGON_LOADGEN_CONFIG  "loadgen.conf"
+#endif
+
+// needed by the shared library
+DatabaseType LoginDatabase;
+uint32 realmID = 0;
+
+bool stopEvent = false;                                     // Setting it to true stops the bots
+
+void usage(const char* prog)
+{
+    sLog.outString("Usage: \n %s [<options>]\n"
+                   "    -c config_file           use config_file as configuration file\n\r"
+                   "    -s                       print the SQL creating the bot accounts and exit\n\r"
+                   , prog);
+}
+
+void OnSignal(int s)
+{
+    switch (s)
+    {
+    case SIGINT:
+    case SIGTERM:
+        stopEvent = true;
+        break;
+    }
+
+    signal(s, OnSignal);
+}
+
+// Accounts are created like the .account create command does, with the expansion set
+void PrintAccountSql(BotConfig const& config, uint32 bots)
+{
+    std::string password = config.password;
+    std::transform(password.begin(), password.end(), password.begin(), ::toupper);
+
+    printf("INSERT IGNORE INTO account (username, sha_pass_hash, expansion) VALUES\n");
+    for (uint32 i = 0; i < bots; ++i)
+    {
+        std::ostringstream name;
+        name << config.accountPrefix << (config.accountStart + i);
+        std::string account = name.str();
+        std::transform(account.begin(), account.end(), account.begin(), ::toupper);
+
+        Sha1Hash sha;
+        sha.UpdateData(account);
+        sha.UpdateData(":");
+        sha.UpdateData(password);
+        sha.Finalize();
+
+        std::ostringstream hash;
+        for (int j = 0; j < SHA_DIGEST_LENGTH; ++j)
+            hash << std::hex << std::uppercase << std::setw(2) << std::setfill('0') << uint32(sha.GetDigest()[j]);
+
+        printf("('%s', '%s', 1)%s\n", account.c_str(), hash.str().c_str(), i + 1 < bots ? "," : ";");
+    }
+}
+
+/// Launch the load generator
+extern int main(int argc, char** argv)
+{
+    char const* cfg_file = _OREGON_LOADGEN_CONFIG;
+    bool printSql = false;
+
+    ACE_Get_Opt cmd_opts(argc, argv, ":c:s");
+
+    int option;
+    while ((option = cmd_opts()) != EOF)
+    {
+        switch (option)
+        {
+        case 'c':
+            cfg_file = cmd_opts.opt_arg();
+            break;
+        case 's':
+            printSql = true;
+            break;
+        case ':':
+            sLog.outError("Runtime-Error: -%c option requires an input argument", cmd_opts.opt_opt());
+            usage(argv[0]);
+            return 1;
+        default:
+            sLog.outError("Runtime-Error: bad format of commandline arguments");
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (!sConfig.SetSource(cfg_file))
+    {
+        sLog.outError("Invalid or missing configuration file : %s", cfg_file);
+        sLog.outError("Verify that the file exists and has \'[loadgen]\' written in the top of the file!");
+        return 1;
+    }
+
+    BotConfig config;
+    config.accountPrefix = sConfig.GetStringDefault("AccountPrefix", "BOT");
+    config.accountStart = sConfig.GetIntDefault("AccountStart", 1);
+    config.password = sConfig.GetStringDefault("Password", "bot");
+    config.race = sConfig.GetIntDefault("Race", 1);
+    config.class_ = sConfig.GetIntDefault("Class", 1);
+
+    uint32 bots = sConfig.GetIntDefault("Bots", 100);
+
+    if (printSql)
+    {
+        PrintAccountSql(config, bots);
+        return 0;
+    }
+
+    sLog.Initialize();
+
+    sLog.outString("%s [load generator]", _FULLVERSION);
+    sLog.outString("<Ctrl-C> to stop.\n");
+    sLog.outString("Using configuration file %s.", cfg_file);
+
+    std::string realmAddress = sConfig.GetStringDefault("RealmAddress", "127.0.0.1");
+    std::string worldAddress = sConfig.GetStringDefault("WorldAddress", "127.0.0.1");
+    if (config.realmAddress.set(sConfig.GetIntDefault("RealmPort", 3724), realmAddress.c_str()) == -1 ||
+        config.worldAddress.set(sConfig.GetIntDefault("WorldPort", 8085), worldAddress.c_str()) == -1)
+    {
+        sLog.outError("Cannot resolve the realm or world server address.");
+        return 1;
+    }
+
+    config.moveRadius = sConfig.GetFloatDefault("Behaviour.MoveRadius", 30.0f);
+    config.chatInterval = sConfig.GetIntDefault("Behaviour.ChatInterval", 20000);
+    config.castInterval = sConfig.GetIntDefault("Behaviour.CastInterval", 15000);
+    config.castSpell = sConfig.GetIntDefault("Behaviour.CastSpell", 2457);
+    config.auctionInterval = sConfig.GetIntDefault("Behaviour.AuctionInterval", 0);
+    config.auctioneer = strtoull(sConfig.GetStringDefault("Behaviour.Auctioneer", "0").c_str(), NULL, 0);
+    config.pingInterval = sConfig.GetIntDefault("Behaviour.PingInterval", 30000);
+    config.queryTimeInterval = sConfig.GetIntDefault("Behaviour.QueryTimeInterval", 5000);
+    config.serverInfoInterval = sConfig.GetIntDefault("Behaviour.ServerInfoInterval", 10000);
+    config.stateTimeout = sConfig.GetIntDefault("StateTimeout", 30000);
+    config.reconnectDelay = sConfig.GetIntDefault("ReconnectDelay", 5000);
+
+    uint32 threads = std::max(1, sConfig.GetIntDefault("Threads", 4));
+    float loginRate = std::max(1.0f, sConfig.GetFloatDefault("LoginRate", 50.0f));
+    uint32 reportInterval = std::max(1, sConfig.GetIntDefault("ReportInterval", 10));
+    uint32 duration = sConfig.GetIntDefault("Duration", 0);
+
+    sLog.outString("Starting %u bots in %u threads, %.0f logins/s.", bots, threads, loginRate);
+
+    std::vector<BotWorker*> workers;
+    for (uint32 i = 0; i < threads; ++i)
+        workers.push_back(new BotWorker(config, loginRate / threads));
+
+    for (uint32 i = 0; i < bots; ++i)
+        workers[i % threads]->AddBot(i);
+
+    for (std::vector<BotWorker*>::iterator itr = workers.begin(); itr != workers.end(); ++itr)
+    {
+        if ((*itr)->Start() == -1)
+        {
+            sLog.outError("Cannot start the bot threads.");
+            return 1;
+        }
+    }
+
+    signal(SIGINT, OnSignal);
+    signal(SIGTERM, OnSignal);
+
+    LoadStats interval;
+    LoadStats total;
+    uint32 elapsed = 0;
+    uint32 sinceReport = 0;
+
+    while (!stopEvent && (!duration || elapsed < duration))
+    {
+        ACE_OS::sleep(1);
+        ++elapsed;
+
+        uint32 online = 0;
+        for (std::vector<BotWorker*>::iterator itr = workers.begin(); itr != workers.end(); ++itr)
+            (*itr)->CollectStats(interval, online);
+
+        if (++sinceReport >= reportInterval)
+        {
+            interval.Print(float(sinceReport), bots, online);
+            total.Merge(interval);
+            interval.Reset();
+            sinceReport = 0;
+        }
+    }
+
+    signal(SIGINT, 0);
+    signal(SIGTERM, 0);
+
+    for (std::vector<BotWorker*>::iterator itr = workers.begin(); itr != workers.end(); ++itr)
+        (*itr)->Stop();
+
+    uint32 online = 0;
+    for (std::vector<BotWorker*>::iterator itr = workers.begin(); itr != workers.end(); ++itr)
+    {
+        (*itr)->Wait();
+        (*itr)->CollectStats(interval, online);
+    }
+    total.Merge(interval);
+
+    sLog.outString("Totals after %u seconds:", elapsed);
+    total.Print(float(elapsed), bots, online);
+
+    for (std::vector<BotWorker*>::iterator itr = workers.begin(); itr != workers.end(); ++itr)
+        delete *itr;
+
+    return 0;
+}
@@ -0,0 +1,149 @@
+/*
+ * This file is part of the OregonCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "LoadStats.h"
+#include "Log.h"
+
+void LatencyHistogram::Reset()
+{
+    memset(m_buckets, 0, sizeof(m_buckets));
+    m_count = 0;
+    m_sum = 0;
+    m_max = 0;
+}
+
+void LatencyHistogram::Add(uint32 ms)
+{
+    ++m_buckets[ms < LATENCY_BUCKETS ? ms : LATENCY_BUCKETS - 1];
+    ++m_count;
+    m_sum += ms;
+    if (ms > m_max)
+        m_max = ms;
+}
+
+void LatencyHistogram::Merge(LatencyHistogram const& right)
+{
+    if (!right.m_count)
+        return;
+
+    for (uint32 i = 0; i < LATENCY_BUCKETS; ++i)
+        m_buckets[i] += right.m_buckets[i];
+
+    m_count += right.m_count;
+    m_sum += right.m_sum;
+    if (right.m_max > m_max)
+        m_max = right.m_max;
+}
+
+uint32 LatencyHistogram::GetPercentile(float fraction) const
+{
+    if (!m_count)
+        return 0;
+
+    uint32 wanted = uint32(fraction * m_count);
+    if (wanted < 1)
+        wanted = 1;
+
+    uint32 seen = 0;
+    for (uint32 i = 0; i < LATENCY_BUCKETS - 1; ++i)
+    {
+        seen += m_buckets[i];
+        if (seen >= wanted)
+            return i;
+    }
+
+    return m_max;
+}
+
+void LoadStats::Reset()
+{
+    for (uint8 i = 0; i < MAX_LOAD_PROBES; ++i)
+        latency[i].Reset();
+    serverDiff.Reset();
+
+    packetsIn = packetsOut = 0;
+    bytesIn = bytesOut = 0;
+    logins = failures = probeTimeouts = 0;
+}
+
+void LoadStats::Merge(LoadStats const& right)
+{
+    for (uint8 i = 0; i < MAX_LOAD_PROBES; ++i)
+        latency[i].Merge(right.latency[i]);
+    serverDiff.Merge(right.serverDiff);
+
+    packetsIn += right.packetsIn;
+    packetsOut += right.packetsOut;
+    bytesIn += right.bytesIn;
+    bytesOut += right.bytesOut;
+    logins += right.logins;
+    failures += right.failures;
+    probeTimeouts += right.probeTimeouts;
+}
+
+char const* LoadStats::GetProbeName(LoadProbe probe)
+{
+    switch (probe)
+    {
+        case PROBE_REALM_LOGON:     return "realm logon";
+        case PROBE_REALM_LIST:      return "realm list";
+        case PROBE_WORLD_AUTH:      return "CMSG_AUTH_SESSION";
+        case PROBE_CHAR_ENUM:       return "CMSG_CHAR_ENUM";
+        case PROBE_CHAR_CREATE:     return "CMSG_CHAR_CREATE";
+        case PROBE_PLAYER_LOGIN:    return "CMSG_PLAYER_LOGIN";
+        case PROBE_PING:            return "CMSG_PING";
+        case PROBE_QUERY_TIME:      return "CMSG_QUERY_TIME";
+        case PROBE_CHAT:            return "CMSG_MESSAGECHAT";
+        case PROBE_CAST:            return "CMSG_CAST_SPELL";
+        case PROBE_AUCTION:         return "CMSG_AUCTION_LIST_ITEMS";
+        default:                    return "unknown";
+    }
+}
+
+void LoadStats::Print(float seconds, uint32 bots, uint32 online) const
+{
+    if (seconds <= 0.0f)
+        seconds = 1.0f;
+
+    sLog.outString("==== %u/%u bots in world, %u logins, %u failures, %u unanswered requests ====",
+                   online, bots, logins, failures, probeTimeouts);
+    sLog.outString("throughput: in %.0f packets/s %.1f KB/s, out %.0f packets/s %.1f KB/s",
+                   packetsIn / seconds, bytesIn / seconds / 1024.0f, packetsOut / seconds, bytesOut / seconds / 1024.0f);
+
+    if (serverDiff.GetCount())
+        sLog.outString("server update diff: avg %.1f ms, p95 %u ms, max %u ms",
+                       serverDiff.GetAverage(), serverDiff.GetPercentile(0.95f), serverDiff.GetMax());
+
+    // CMSG_PING is answered by the network thread, CMSG_QUERY_TIME waits for the next world update
+    LatencyHistogram const& ping = latency[PROBE_PING];
+    LatencyHistogram const& query = latency[PROBE_QUERY_TIME];
+    if (ping.GetCount() && query.GetCount())
+        sLog.outString("world queue delay: %.1f ms (CMSG_QUERY_TIME - CMSG_PING round trip)",
+                       query.GetAverage() - ping.GetAverage());
+
+    sLog.outString("%-24s %8s %8s %8s %8s %8s %8s", "request", "count", "avg ms", "p50", "p95", "p99", "max");
+    for (uint8 i = 0; i < MAX_LOAD_PROBES; ++i)
+    {
+        LatencyHistogram const& histogram = latency[i];
+        if (!histogram.GetCount())
+            continue;
+
+        sLog.outString("%-24s %8u %8.1f %8u %8u %8u %8u", GetProbeName(LoadProbe(i)), histogram.GetCount(),
+                       histogram.GetAverage(), histogram.GetPercentile(0.5f), histogram.GetPercentile(0.95f),
+                       histogram.GetPercentile(0.99f), histogram.GetMax());
+    }
+}
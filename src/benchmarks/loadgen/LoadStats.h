@@ -0,0 +1,91 @@
+/*
+ * This file is part of the OregonCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _LOADSTATS_H
+#define _LOADSTATS_H
+
+#include "Common.h"
+
+// Request/response pairs whose round trip is measured
+enum LoadProbe
+{
+    PROBE_REALM_LOGON           = 0,                        // logon challenge until logon proof answer
+    PROBE_REALM_LIST            = 1,
+    PROBE_WORLD_AUTH            = 2,                        // CMSG_AUTH_SESSION
+    PROBE_CHAR_ENUM             = 3,
+    PROBE_CHAR_CREATE           = 4,
+    PROBE_PLAYER_LOGIN          = 5,
+    PROBE_PING                  = 6,                        // answered by the network thread
+    PROBE_QUERY_TIME            = 7,                        // answered by the world thread
+    PROBE_CHAT                  = 8,
+    PROBE_CAST                  = 9,
+    PROBE_AUCTION               = 10,
+    MAX_LOAD_PROBES
+};
+
+// 1 ms buckets, slower samples are counted in the last one
+#define LATENCY_BUCKETS 2000
+
+class LatencyHistogram
+{
+    public:
+        LatencyHistogram() { Reset(); }
+
+        void Reset();
+        void Add(uint32 ms);
+        void Merge(LatencyHistogram const& right);
+
+        uint32 GetCount() const { return m_count; }
+        uint32 GetMax() const { return m_max; }
+        float GetAverage() const { return m_count ? float(double(m_sum) / m_count) : 0.0f; }
+
+        // upper bound of the bucket holding the given fraction (0..1] of the samples
+        uint32 GetPercentile(float fraction) const;
+
+    private:
+        uint32 m_buckets[LATENCY_BUCKETS];
+        uint32 m_count;
+        uint64 m_sum;
+        uint32 m_max;
+};
+
+struct LoadStats
+{
+    LoadStats() { Reset(); }
+
+    void Reset();
+    void Merge(LoadStats const& right);
+
+    // prints one report block, seconds is the time the stats were collected over
+    void Print(float seconds, uint32 bots, uint32 online) const;
+
+    static char const* GetProbeName(LoadProbe probe);
+
+    LatencyHistogram latency[MAX_LOAD_PROBES];
+    LatencyHistogram serverDiff;                            // world update time reported by .server info
+
+    uint64 packetsIn;
+    uint64 packetsOut;
+    uint64 bytesIn;
+    uint64 bytesOut;
+
+    uint32 logins;                                          // bots that entered the world
+    uint32 failures;                                        // connections dropped because of an error or timeout
+    uint32 probeTimeouts;                                   // requests that were never answered
+};
+
+#endif
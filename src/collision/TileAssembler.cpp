@@ -24,6 +24,12 @@
 #include <iomanip>
 #include <sstream>
 
+#include <ace/Task.h>
+#include <ace/Activation_Queue.h>
+#include <ace/Method_Request.h>
+#include <ace/Atomic_Op.h>
+#include <ace/Guard_T.h>
+
 using G3D::Vector3;
 using G3D::AABox;
 using G3D::inf;
@@ -51,10 +57,74 @@ Vector3 ModelPosition::transform(const Vector3& pIn) const
 
     //=================================================================
 
+class MapConvertRequest : public ACE_Method_Request
+{
+    public:
+        MapConvertRequest(TileAssembler& assembler, uint32 mapID, MapSpawns* spawns)
+            : iAssembler(assembler), iMapID(mapID), iSpawns(spawns) {}
+
+        virtual int call() { return iAssembler.convertMap(iMapID, iSpawns) ? 0 : -1; }
+
+    private:
+        TileAssembler& iAssembler;
+        uint32 iMapID;
+        MapSpawns* iSpawns;
+};
+
+class ModelConvertRequest : public ACE_Method_Request
+{
+    public:
+        ModelConvertRequest(TileAssembler& assembler, const std::string& modelFilename)
+            : iAssembler(assembler), iModelFilename(modelFilename) {}
+
+        virtual int call()
+        {
+            printf("Converting %s\n", iModelFilename.c_str());
+            if (iAssembler.convertRawFile(iModelFilename))
+                return 0;
+
+            printf("error converting %s\n", iModelFilename.c_str());
+            return -1;
+        }
+
+    private:
+        TileAssembler& iAssembler;
+        std::string iModelFilename;
+};
+
+// Works off a list of queued requests, stops handing out new ones after the first failure
+class AssemblerThreads : public ACE_Task_Base
+{
+    public:
+        AssemblerThreads() : iFailed(0) {}
+
+        void enqueue(ACE_Method_Request* request) { iQueue.enqueue(request); }
+
+        int svc()
+        {
+            // the queue is filled before the threads start, so don't wait on an empty queue
+            ACE_Time_Value timeout = ACE_Time_Value::zero;
+            while (ACE_Method_Request* request = iQueue.dequeue(&timeout))
+            {
+                if (!iFailed.value() && request->call() == -1)
+                    iFailed = 1;
+                delete request;
+            }
+            return 0;
+        }
+
+        bool failed() const { return iFailed.value() != 0; }
+
+    private:
+        ACE_Activation_Queue iQueue;
+        ACE_Atomic_Op<ACE_Thread_Mutex, uint32> iFailed;
+};
+
 TileAssembler::TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName)
 {
     iCurrentUniqueNameId = 0;
     iFilterMethod = NULL;
+    iThreads = 1;
     iSrcDir = pSrcDirName;
     iDestDir = pDestDirName;
     //mkdir(iDestDir);
@@ -72,129 +142,148 @@ bool TileAssembler::convertWorld2()
     if (!success)
         return false;
 
-    // export Map data
-    for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end() && success; ++map_iter)
-    {
-        // build global map tree
-        std::vector<ModelSpawn*> mapSpawns;
-        UniqueEntryMap::iterator entry;
-        printf("Calculating model bounds for map %u...\n", map_iter->first);
-        for (entry = map_iter->second->UniqueEntries.begin(); entry != map_iter->second->UniqueEntries.end(); ++entry)
-        {
-            // M2 models don't have a bound set in WDT/ADT placement data, i still think they're not used for LoS at all on retail
-            if (entry->second.flags & MOD_M2)
-            {
-                if (!calculateTransformedBound(entry->second))
-                    break;
-            }
-            else if (entry->second.flags & MOD_WORLDSPAWN) // WMO maps and terrain maps use different origin, so we need to adapt :/
-            {
-                // @todo: remove extractor hack and uncomment below line:
-                //entry->second.iPos += Vector3(533.33333f*32, 533.33333f*32, 0.f);
-                entry->second.iBound = entry->second.iBound + Vector3(533.33333f * 32, 533.33333f * 32, 0.f);
-            }
-            mapSpawns.push_back(&(entry->second));
-            spawnedModelFiles.insert(entry->second.name);
-        }
+    // export Map data, every map is independent of the others
+    std::vector<ACE_Method_Request*> requests;
+    for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end(); ++map_iter)
+        requests.push_back(new MapConvertRequest(*this, map_iter->first, map_iter->second));
+    success = runRequests(requests);
 
-        printf("Creating map tree for map %u...\n", map_iter->first);
-        BIH pTree;
-        pTree.build(mapSpawns, BoundsTrait<ModelSpawn*>::getBounds);
+    // add an object models, listed in temp_gameobject_models file
+    exportGameobjectModels();
+    // export objects
+    std::cout << "\nConverting Model Files" << std::endl;
+    for (std::set<std::string>::iterator mfile = spawnedModelFiles.begin(); mfile != spawnedModelFiles.end(); ++mfile)
+        requests.push_back(new ModelConvertRequest(*this, *mfile));
+    if (!runRequests(requests))
+        success = false;
 
-        // ===> possibly move this code to StaticMapTree class
-        std::map<uint32, uint32> modelNodeIdx;
-        for (uint32 i = 0; i < mapSpawns.size(); ++i)
-            modelNodeIdx.insert(pair<uint32, uint32>(mapSpawns[i]->ID, i));
+    //cleanup:
+    for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end(); ++map_iter)
+        delete map_iter->second;
+
+    return success;
+}
+
+bool TileAssembler::runRequests(std::vector<ACE_Method_Request*>& requests)
+{
+    AssemblerThreads workers;
+    for (std::vector<ACE_Method_Request*>::iterator itr = requests.begin(); itr != requests.end(); ++itr)
+        workers.enqueue(*itr);
+    requests.clear();
+
+    if (workers.activate(THR_NEW_LWP | THR_JOINABLE, iThreads) == -1)
+        workers.svc();                                      // no threads available, run in this one
+    else
+        workers.wait();
+
+    return !workers.failed();
+}
+
+bool TileAssembler::convertMap(uint32 mapID, MapSpawns* spawns)
+{
+    bool success = true;
 
-        // write map tree file
-        std::stringstream mapfilename;
-        mapfilename << iDestDir << '/' << std::setfill('0') << std::setw(3) << map_iter->first << ".vmtree";
-        FILE* mapfile = fopen(mapfilename.str().c_str(), "wb");
-        if (!mapfile)
+    // build global map tree
+    std::vector<ModelSpawn*> mapSpawns;
+    std::set<std::string> modelFiles;
+    UniqueEntryMap::iterator entry;
+    printf("Calculating model bounds for map %u...\n", mapID);
+    for (entry = spawns->UniqueEntries.begin(); entry != spawns->UniqueEntries.end(); ++entry)
+    {
+        // M2 models don't have a bound set in WDT/ADT placement data, i still think they're not used for LoS at all on retail
+        if (entry->second.flags & MOD_M2)
         {
-            success = false;
-            printf("Cannot open %s\n", mapfilename.str().c_str());
-            break;
+            if (!calculateTransformedBound(entry->second))
+                break;
         }
-
-        //general info
-        if (success && fwrite(VMAP_MAGIC, 1, 8, mapfile) != 8) success = false;
-        uint32 globalTileID = StaticMapTree::packTileID(65, 65);
-        pair<TileMap::iterator, TileMap::iterator> globalRange = map_iter->second->TileEntries.equal_range(globalTileID);
-        char isTiled = globalRange.first == globalRange.second; // only maps without terrain (tiles) have global WMO
-        if (success && fwrite(&isTiled, sizeof(char), 1, mapfile) != 1) success = false;
-        // Nodes
-        if (success && fwrite("NODE", 4, 1, mapfile) != 1) success = false;
-        if (success) success = pTree.writeToFile(mapfile);
-        // global map spawns (WDT), if any (most instances)
-        if (success && fwrite("GOBJ", 4, 1, mapfile) != 1) success = false;
-
-        for (TileMap::iterator glob = globalRange.first; glob != globalRange.second && success; ++glob)
-            success = ModelSpawn::writeToFile(mapfile, map_iter->second->UniqueEntries[glob->second]);
-
-        fclose(mapfile);
-
-        // <====
-
-        // write map tile files, similar to ADT files, only with extra BSP tree node info
-        TileMap& tileEntries = map_iter->second->TileEntries;
-        TileMap::iterator tile;
-        for (tile = tileEntries.begin(); tile != tileEntries.end(); ++tile)
+        else if (entry->second.flags & MOD_WORLDSPAWN) // WMO maps and terrain maps use different origin, so we need to adapt :/
         {
-            const ModelSpawn& spawn = map_iter->second->UniqueEntries[tile->second];
-            if (spawn.flags & MOD_WORLDSPAWN) // WDT spawn, saved as tile 65/65 currently...
-                continue;
-            uint32 nSpawns = tileEntries.count(tile->first);
-            std::stringstream tilefilename;
-            tilefilename.fill('0');
-            tilefilename << iDestDir << '/' << std::setw(3) << map_iter->first << '_';
-            uint32 x, y;
-            StaticMapTree::unpackTileID(tile->first, x, y);
-            tilefilename << std::setw(2) << x << '_' << std::setw(2) << y << ".vmtile";
-            FILE* tilefile = fopen(tilefilename.str().c_str(), "wb");
-            // file header
-            if (success && fwrite(VMAP_MAGIC, 1, 8, tilefile) != 8) success = false;
-            // write number of tile spawns
-            if (success && fwrite(&nSpawns, sizeof(uint32), 1, tilefile) != 1) success = false;
-            // write tile spawns
-            for (uint32 s = 0; s < nSpawns; ++s)
-            {
-                if (s)
-                {
-                    ++tile;
-                    if (tile == tileEntries.end())
-                        break;
-                }
-                const ModelSpawn& spawn2 = map_iter->second->UniqueEntries[tile->second];
-                success = success && ModelSpawn::writeToFile(tilefile, spawn2);
-                // MapTree nodes to update when loading tile:
-                std::map<uint32, uint32>::iterator nIdx = modelNodeIdx.find(spawn2.ID);
-                if (success && fwrite(&nIdx->second, sizeof(uint32), 1, tilefile) != 1) success = false;
-            }
-            fclose(tilefile);
+            // @todo: remove extractor hack and uncomment below line:
+            //entry->second.iPos += Vector3(533.33333f*32, 533.33333f*32, 0.f);
+            entry->second.iBound = entry->second.iBound + Vector3(533.33333f * 32, 533.33333f * 32, 0.f);
         }
-            // break; //test, extract only first map; TODO: remvoe this line
+        mapSpawns.push_back(&(entry->second));
+        modelFiles.insert(entry->second.name);
     }
 
-    // add an object models, listed in temp_gameobject_models file
-    exportGameobjectModels();
-    // export objects
-    std::cout << "\nConverting Model Files" << std::endl;
-    for (std::set<std::string>::iterator mfile = spawnedModelFiles.begin(); mfile != spawnedModelFiles.end(); ++mfile)
+    printf("Creating map tree for map %u...\n", mapID);
+    BIH pTree;
+    pTree.build(mapSpawns, BoundsTrait<ModelSpawn*>::getBounds);
+
+    // ===> possibly move this code to StaticMapTree class
+    std::map<uint32, uint32> modelNodeIdx;
+    for (uint32 i = 0; i < mapSpawns.size(); ++i)
+        modelNodeIdx.insert(pair<uint32, uint32>(mapSpawns[i]->ID, i));
+
+    // write map tree file
+    std::stringstream mapfilename;
+    mapfilename << iDestDir << '/' << std::setfill('0') << std::setw(3) << mapID << ".vmtree";
+    FILE* mapfile = fopen(mapfilename.str().c_str(), "wb");
+    if (!mapfile)
+    {
+        printf("Cannot open %s\n", mapfilename.str().c_str());
+        return false;
+    }
+
+    //general info
+    if (success && fwrite(VMAP_MAGIC, 1, 8, mapfile) != 8) success = false;
+    uint32 globalTileID = StaticMapTree::packTileID(65, 65);
+    pair<TileMap::iterator, TileMap::iterator> globalRange = spawns->TileEntries.equal_range(globalTileID);
+    char isTiled = globalRange.first == globalRange.second; // only maps without terrain (tiles) have global WMO
+    if (success && fwrite(&isTiled, sizeof(char), 1, mapfile) != 1) success = false;
+    // Nodes
+    if (success && fwrite("NODE", 4, 1, mapfile) != 1) success = false;
+    if (success) success = pTree.writeToFile(mapfile);
+    // global map spawns (WDT), if any (most instances)
+    if (success && fwrite("GOBJ", 4, 1, mapfile) != 1) success = false;
+
+    for (TileMap::iterator glob = globalRange.first; glob != globalRange.second && success; ++glob)
+        success = ModelSpawn::writeToFile(mapfile, spawns->UniqueEntries[glob->second]);
+
+    fclose(mapfile);
+
+    // <====
+
+    // write map tile files, similar to ADT files, only with extra BSP tree node info
+    TileMap& tileEntries = spawns->TileEntries;
+    TileMap::iterator tile;
+    for (tile = tileEntries.begin(); tile != tileEntries.end(); ++tile)
     {
-        std::cout << "Converting " << *mfile << std::endl;
-        if (!convertRawFile(*mfile))
+        const ModelSpawn& spawn = spawns->UniqueEntries[tile->second];
+        if (spawn.flags & MOD_WORLDSPAWN) // WDT spawn, saved as tile 65/65 currently...
+            continue;
+        uint32 nSpawns = tileEntries.count(tile->first);
+        std::stringstream tilefilename;
+        tilefilename.fill('0');
+        tilefilename << iDestDir << '/' << std::setw(3) << mapID << '_';
+        uint32 x, y;
+        StaticMapTree::unpackTileID(tile->first, x, y);
+        tilefilename << std::setw(2) << x << '_' << std::setw(2) << y << ".vmtile";
+        FILE* tilefile = fopen(tilefilename.str().c_str(), "wb");
+        // file header
+        if (success && fwrite(VMAP_MAGIC, 1, 8, tilefile) != 8) success = false;
+        // write number of tile spawns
+        if (success && fwrite(&nSpawns, sizeof(uint32), 1, tilefile) != 1) success = false;
+        // write tile spawns
+        for (uint32 s = 0; s < nSpawns; ++s)
         {
-            std::cout << "error converting " << *mfile << std::endl;
-            success = false;
-            break;
+            if (s)
+            {
+                ++tile;
+                if (tile == tileEntries.end())
+                    break;
+            }
+            const ModelSpawn& spawn2 = spawns->UniqueEntries[tile->second];
+            success = success && ModelSpawn::writeToFile(tilefile, spawn2);
+            // MapTree nodes to update when loading tile:
+            std::map<uint32, uint32>::iterator nIdx = modelNodeIdx.find(spawn2.ID);
+            if (success && fwrite(&nIdx->second, sizeof(uint32), 1, tilefile) != 1) success = false;
         }
+        fclose(tilefile);
     }
 
-    //cleanup:
-    for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end(); ++map_iter)
-        delete map_iter->second;
-
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, iSpawnedModelFilesLock, false);
+    spawnedModelFiles.insert(modelFiles.begin(), modelFiles.end());
     return success;
 }
 
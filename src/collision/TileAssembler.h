@@ -22,10 +22,13 @@
 #include <G3D/Matrix3.h>
 #include <map>
 #include <set>
+#include <ace/Thread_Mutex.h>
 
 #include "ModelInstance.h"
 #include "WorldModel.h"
 
+class ACE_Method_Request;
+
 namespace VMAP
 {
 /**
@@ -97,17 +100,23 @@ class TileAssembler
         unsigned int iCurrentUniqueNameId;
         MapData mapData;
         std::set<std::string> spawnedModelFiles;
+        ACE_Thread_Mutex iSpawnedModelFilesLock;
+        uint32 iThreads;
+
+        bool runRequests(std::vector<ACE_Method_Request*>& requests);
 
     public:
         TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName);
         virtual ~TileAssembler();
 
         bool convertWorld2();
+        bool convertMap(uint32 mapID, MapSpawns* spawns);
         bool readMapSpawns();
         bool calculateTransformedBound(ModelSpawn& spawn);
         void exportGameobjectModels();
 
         bool convertRawFile(const std::string& pModelFilename);
+        void setThreads(uint32 threads) { iThreads = threads ? threads : 1; }
         void setModelNameFilterMethod(bool (*pFilterMethod)(char *pName)) { iFilterMethod = pFilterMethod; }
         std::string getDirEntryNameFromModName(unsigned int pMapId, const std::string& pModPosName);
 };
@@ -461,11 +461,12 @@ void ArenaTeam::SetStats(uint32 stat_type, uint32 value)
 
 void ArenaTeam::BroadcastPacket(WorldPacket* packet)
 {
+    WorldPacket_AutoPtr shared;
     for (MemberList::const_iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
     {
         Player* player = sObjectMgr.GetPlayer(itr->guid);
         if (player)
-            player->GetSession()->SendPacket(packet);
+            player->GetSession()->SendPacket(packet, shared);
     }
 }
 
@@ -18,6 +18,7 @@
 #include "ObjectMgr.h"
 #include "AuctionHouseMgr.h"
 #include "AuctionHouseBot.h"
+#include "Database/SqlBatch.h"
 #include <vector>
 
 INSTANTIATE_SINGLETON_1(AuctionHouseBot);
@@ -191,6 +192,10 @@ void AuctionHouseBot::addNewAuctions(Player* AHBplayer, AHBConfig* config)
 
     if (debug_Out) sLog.outString("AHSeller: Current Auctineer GUID is %u", AuctioneerGUID);
 
+    // the new items and auctions are written in one transaction per tick
+    CharacterDatabase.BeginTransaction();
+    SqlBatch auctionRows(CharacterDatabase, "INSERT INTO auctionhouse (id,auctioneerguid,itemguid,item_template,itemowner,buyoutprice,time,buyguid,lastbid,startbid,deposit) VALUES ");
+
     uint32 greyTGcount = config->GetPercents(AHB_GREY_TG);
     uint32 whiteTGcount = config->GetPercents(AHB_WHITE_TG);
     uint32 greenTGcount = config->GetPercents(AHB_GREEN_TG);
@@ -442,7 +447,10 @@ void AuctionHouseBot::addNewAuctions(Player* AHBplayer, AHBConfig* config)
             item->RemoveFromUpdateQueueOf(AHBplayer);
             sAuctionMgr->AddAItem(item);
             auctionHouse->AddAuction(auctionEntry);
-            auctionEntry->SaveToDB();
+            auctionRows.AddRow("('%u', '%u', '%u', '%u', '%u', '%u', '" UI64FMTD "', '%u', '%u', '%u', '%u')",
+                               auctionEntry->Id, auctionEntry->auctioneer, auctionEntry->item_guidlow, auctionEntry->item_template,
+                               auctionEntry->owner, auctionEntry->buyout, (uint64)auctionEntry->expire_time, auctionEntry->bidder,
+                               auctionEntry->bid, auctionEntry->startbid, auctionEntry->deposit);
 
             switch (itemColor)
             {
@@ -493,6 +501,9 @@ void AuctionHouseBot::addNewAuctions(Player* AHBplayer, AHBConfig* config)
             }
         }
     }
+
+    auctionRows.Flush();
+    CharacterDatabase.CommitTransaction();
 }
 void AuctionHouseBot::addNewAuctionBuyerBotBid(Player* AHBplayer, AHBConfig* config, WorldSession* session)
 {
@@ -502,48 +513,42 @@ void AuctionHouseBot::addNewAuctionBuyerBotBid(Player* AHBplayer, AHBConfig* con
         return;
     }
 
-    QueryResult_AutoPtr result = CharacterDatabase.PQuery("SELECT id FROM auctionhouse WHERE itemowner<>%u AND buyguid<>%u", AHBplayerGUID, AHBplayerGUID);
-
-    if (!result)
-        return;
-
-    if (result->GetRowCount() == 0)
-        return;
-
     // Fetches content of selected AH
     AuctionHouseObject* auctionHouse = sAuctionMgr->GetAuctionsMap(config->GetAHFID());
-    vector<uint32> possibleBids;
+    uint32 bids = config->GetBidsPerInterval();
 
-    do
-    {
-        uint32 tmpdata = result->Fetch()->GetUInt32();
-        possibleBids.push_back(tmpdata);
-    }
-    while (result->NextRow());
+    // Choose random auctions of other owners not yet bid on by the bot, every
+    // auction is picked with the same chance in one pass over the auction house
+    vector<AuctionEntry*> possibleBids;
+    possibleBids.reserve(bids);
+    uint32 seen = 0;
 
-    for (uint32 count = 1; count <= config->GetBidsPerInterval(); ++count)
+    for (AuctionHouseObject::AuctionEntryMap::const_iterator itr = auctionHouse->GetAuctionsBegin(); itr != auctionHouse->GetAuctionsEnd(); ++itr)
     {
-        // Do we have anything to bid? If not, stop here.
-        if (possibleBids.empty())
-        {
-            //if (debug_Out) sLog.outString("AHBuyer: I have no items to bid on.");
-            count = config->GetBidsPerInterval();
+        AuctionEntry* auction = itr->second;
+        if (auction->owner == AHBplayerGUID || auction->bidder == AHBplayerGUID)
             continue;
-        }
 
-        // Choose random auction from possible auctions
-        uint32 vectorPos = urand(0, possibleBids.size() - 1);
-        vector<uint32>::iterator iter = possibleBids.begin();
-        advance(iter, vectorPos);
+        if (possibleBids.size() < bids)
+            possibleBids.push_back(auction);
+        else
+        {
+            uint32 pos = urand(0, seen);
+            if (pos < bids)
+                possibleBids[pos] = auction;
+        }
+        ++seen;
+    }
 
-        // from auctionhousehandler.cpp, creates auction pointer & player pointer
-        AuctionEntry* auction = auctionHouse->GetAuction(*iter);
+    if (possibleBids.empty())
+        return;
 
-        // Erase the auction from the vector to prevent bidding on item in next iteration.
-        possibleBids.erase(iter);
+    // the bids are written together once all mails are sent
+    vector<string> bidUpdates;
 
-        if (!auction)
-            continue;
+    for (vector<AuctionEntry*>::const_iterator iter = possibleBids.begin(); iter != possibleBids.end(); ++iter)
+    {
+        AuctionEntry* auction = *iter;
 
         // get exact item information
         Item* pItem = sAuctionMgr->GetAItem(auction->item_guidlow);
@@ -675,7 +680,9 @@ void AuctionHouseBot::addNewAuctionBuyerBotBid(Player* AHBplayer, AHBConfig* con
             auction->bid = bidprice;
 
             // Saving auction into database
-            CharacterDatabase.PExecute("UPDATE auctionhouse SET buyguid = '%u',lastbid = '%u' WHERE id = '%u'", auction->bidder, auction->bid, auction->Id);
+            ostringstream ss;
+            ss << "UPDATE auctionhouse SET buyguid = '" << auction->bidder << "',lastbid = '" << auction->bid << "' WHERE id = '" << auction->Id << "'";
+            bidUpdates.push_back(ss.str());
         }
         else
         {
@@ -695,6 +702,14 @@ void AuctionHouseBot::addNewAuctionBuyerBotBid(Player* AHBplayer, AHBConfig* con
             auctionHouse->RemoveAuction(auction, item_template);
         }
     }
+
+    if (bidUpdates.empty())
+        return;
+
+    CharacterDatabase.BeginTransaction();
+    for (vector<string>::const_iterator itr = bidUpdates.begin(); itr != bidUpdates.end(); ++itr)
+        CharacterDatabase.Execute(itr->c_str());
+    CharacterDatabase.CommitTransaction();
 }
 
 void AuctionHouseBot::Update()
@@ -1642,69 +1657,49 @@ void AuctionHouseBot::Commands(uint32 command, uint32 ahMapID, uint32 col, char*
 
 void AuctionHouseBot::LoadValues(AHBConfig* config)
 {
-    if (debug_Out) sLog.outString("Start Settings for %s Auctionhouses:", CharacterDatabase.PQuery("SELECT name FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetString());
+    QueryResult_AutoPtr result = CharacterDatabase.PQuery("SELECT name, minitems, maxitems, "
+        "percentgreytradegoods, percentwhitetradegoods, percentgreentradegoods, percentbluetradegoods, percentpurpletradegoods, percentorangetradegoods, percentyellowtradegoods, "
+        "percentgreyitems, percentwhiteitems, percentgreenitems, percentblueitems, percentpurpleitems, percentorangeitems, percentyellowitems, exludeItemsIds, "
+        "minpricegrey, maxpricegrey, minpricewhite, maxpricewhite, minpricegreen, maxpricegreen, minpriceblue, maxpriceblue, "
+        "minpricepurple, maxpricepurple, minpriceorange, maxpriceorange, minpriceyellow, maxpriceyellow, "
+        "minbidpricegrey, maxbidpricegrey, minbidpricewhite, maxbidpricewhite, minbidpricegreen, maxbidpricegreen, minbidpriceblue, maxbidpriceblue, "
+        "minbidpricepurple, maxbidpricepurple, minbidpriceorange, maxbidpriceorange, minbidpriceyellow, maxbidpriceyellow, "
+        "maxstackgrey, maxstackwhite, maxstackgreen, maxstackblue, maxstackpurple, maxstackorange, maxstackyellow, "
+        "buyerpricegrey, buyerpricewhite, buyerpricegreen, buyerpriceblue, buyerpricepurple, buyerpriceorange, buyerpriceyellow, "
+        "buyerbiddinginterval, buyerbidsperinterval FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID());
+
+    if (!result)
+    {
+        sLog.outError("AuctionHouseBot: no settings for auction house %u in table auctionhousebot", config->GetAHID());
+        return;
+    }
+
+    Field* fields = result->Fetch();
+    std::string name = fields[0].GetCppString();
+
+    if (debug_Out) sLog.outString("Start Settings for %s Auctionhouses:", name.c_str());
     if (AHBSeller)
     {
         //load min and max items
-        config->SetMinItems(CharacterDatabase.PQuery("SELECT minitems FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxItems(CharacterDatabase.PQuery("SELECT maxitems FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
+        config->SetMinItems(fields[1].GetUInt32());
+        config->SetMaxItems(fields[2].GetUInt32());
         //load percentages
-        uint32 greytg = CharacterDatabase.PQuery("SELECT percentgreytradegoods FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32();
-        uint32 whitetg = CharacterDatabase.PQuery("SELECT percentwhitetradegoods FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32();
-        uint32 greentg = CharacterDatabase.PQuery("SELECT percentgreentradegoods FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32();
-        uint32 bluetg = CharacterDatabase.PQuery("SELECT percentbluetradegoods FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32();
-        uint32 purpletg = CharacterDatabase.PQuery("SELECT percentpurpletradegoods FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32();
-        uint32 orangetg = CharacterDatabase.PQuery("SELECT percentorangetradegoods FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32();
-        uint32 yellowtg = CharacterDatabase.PQuery("SELECT percentyellowtradegoods FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32();
-        uint32 greyi = CharacterDatabase.PQuery("SELECT percentgreyitems FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32();
-        uint32 whitei = CharacterDatabase.PQuery("SELECT percentwhiteitems FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32();
-        uint32 greeni = CharacterDatabase.PQuery("SELECT percentgreenitems FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32();
-        uint32 bluei = CharacterDatabase.PQuery("SELECT percentblueitems FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32();
-        uint32 purplei = CharacterDatabase.PQuery("SELECT percentpurpleitems FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32();
-        uint32 orangei = CharacterDatabase.PQuery("SELECT percentorangeitems FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32();
-        uint32 yellowi = CharacterDatabase.PQuery("SELECT percentyellowitems FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32();
-        std::string XcludeItemsIds;
-        if (QueryResult_AutoPtr result = CharacterDatabase.PQuery("SELECT exludeItemsIds FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID()))
-            XcludeItemsIds = result->Fetch()[0].GetCppString();
-        config->SetPercentages(greytg, whitetg, greentg, bluetg, purpletg, orangetg, yellowtg, greyi, whitei, greeni, bluei, purplei, orangei, yellowi);
-        //load min and max prices
-        config->SetMinPrice(AHB_GREY, CharacterDatabase.PQuery("SELECT minpricegrey FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxPrice(AHB_GREY, CharacterDatabase.PQuery("SELECT maxpricegrey FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMinPrice(AHB_WHITE, CharacterDatabase.PQuery("SELECT minpricewhite FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxPrice(AHB_WHITE, CharacterDatabase.PQuery("SELECT maxpricewhite FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMinPrice(AHB_GREEN, CharacterDatabase.PQuery("SELECT minpricegreen FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxPrice(AHB_GREEN, CharacterDatabase.PQuery("SELECT maxpricegreen FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMinPrice(AHB_BLUE, CharacterDatabase.PQuery("SELECT minpriceblue FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxPrice(AHB_BLUE, CharacterDatabase.PQuery("SELECT maxpriceblue FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMinPrice(AHB_PURPLE, CharacterDatabase.PQuery("SELECT minpricepurple FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxPrice(AHB_PURPLE, CharacterDatabase.PQuery("SELECT maxpricepurple FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMinPrice(AHB_ORANGE, CharacterDatabase.PQuery("SELECT minpriceorange FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxPrice(AHB_ORANGE, CharacterDatabase.PQuery("SELECT maxpriceorange FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMinPrice(AHB_YELLOW, CharacterDatabase.PQuery("SELECT minpriceyellow FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxPrice(AHB_YELLOW, CharacterDatabase.PQuery("SELECT maxpriceyellow FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        //load min and max bid prices
-        config->SetMinBidPrice(AHB_GREY, CharacterDatabase.PQuery("SELECT minbidpricegrey FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxBidPrice(AHB_GREY, CharacterDatabase.PQuery("SELECT maxbidpricegrey FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMinBidPrice(AHB_WHITE, CharacterDatabase.PQuery("SELECT minbidpricewhite FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxBidPrice(AHB_WHITE, CharacterDatabase.PQuery("SELECT maxbidpricewhite FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMinBidPrice(AHB_GREEN, CharacterDatabase.PQuery("SELECT minbidpricegreen FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxBidPrice(AHB_GREEN, CharacterDatabase.PQuery("SELECT maxbidpricegreen FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMinBidPrice(AHB_BLUE, CharacterDatabase.PQuery("SELECT minbidpriceblue FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxBidPrice(AHB_BLUE, CharacterDatabase.PQuery("SELECT maxbidpriceblue FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMinBidPrice(AHB_PURPLE, CharacterDatabase.PQuery("SELECT minbidpricepurple FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxBidPrice(AHB_PURPLE, CharacterDatabase.PQuery("SELECT maxbidpricepurple FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMinBidPrice(AHB_ORANGE, CharacterDatabase.PQuery("SELECT minbidpriceorange FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxBidPrice(AHB_ORANGE, CharacterDatabase.PQuery("SELECT maxbidpriceorange FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMinBidPrice(AHB_YELLOW, CharacterDatabase.PQuery("SELECT minbidpriceyellow FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxBidPrice(AHB_YELLOW, CharacterDatabase.PQuery("SELECT maxbidpriceyellow FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        //load max stacks
-        config->SetMaxStack(AHB_GREY, CharacterDatabase.PQuery("SELECT maxstackgrey FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxStack(AHB_WHITE, CharacterDatabase.PQuery("SELECT maxstackwhite FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxStack(AHB_GREEN, CharacterDatabase.PQuery("SELECT maxstackgreen FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxStack(AHB_BLUE, CharacterDatabase.PQuery("SELECT maxstackblue FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxStack(AHB_PURPLE, CharacterDatabase.PQuery("SELECT maxstackpurple FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxStack(AHB_ORANGE, CharacterDatabase.PQuery("SELECT maxstackorange FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetMaxStack(AHB_YELLOW, CharacterDatabase.PQuery("SELECT maxstackyellow FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
+        config->SetPercentages(fields[3].GetUInt32(), fields[4].GetUInt32(), fields[5].GetUInt32(), fields[6].GetUInt32(),
+                               fields[7].GetUInt32(), fields[8].GetUInt32(), fields[9].GetUInt32(), fields[10].GetUInt32(),
+                               fields[11].GetUInt32(), fields[12].GetUInt32(), fields[13].GetUInt32(), fields[14].GetUInt32(),
+                               fields[15].GetUInt32(), fields[16].GetUInt32());
+        std::string XcludeItemsIds = fields[17].GetCppString();
+        for (uint32 quality = AHB_GREY; quality <= AHB_MAX_QUALITY; ++quality)
+        {
+            //load min and max prices
+            config->SetMinPrice(quality, fields[18 + quality * 2].GetUInt32());
+            config->SetMaxPrice(quality, fields[19 + quality * 2].GetUInt32());
+            //load min and max bid prices
+            config->SetMinBidPrice(quality, fields[32 + quality * 2].GetUInt32());
+            config->SetMaxBidPrice(quality, fields[33 + quality * 2].GetUInt32());
+            //load max stacks
+            config->SetMaxStack(quality, fields[46 + quality].GetUInt32());
+        }
         // ignore these items
         config->IgnoreItemsIds(XcludeItemsIds);
 
@@ -1831,7 +1826,7 @@ void AuctionHouseBot::LoadValues(AHBConfig* config)
         }
         if (debug_Out)
         {
-            sLog.outString("Current Items in %s Auctionhouses:", CharacterDatabase.PQuery("SELECT name FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetString());
+            sLog.outString("Current Items in %s Auctionhouses:", name.c_str());
             sLog.outString("Grey Trade Goods\t%u\tGrey Items\t%u", config->GetItemCounts(AHB_GREY_TG), config->GetItemCounts(AHB_GREY_I));
             sLog.outString("White Trade Goods\t%u\tWhite Items\t%u", config->GetItemCounts(AHB_WHITE_TG), config->GetItemCounts(AHB_WHITE_I));
             sLog.outString("Green Trade Goods\t%u\tGreen Items\t%u", config->GetItemCounts(AHB_GREEN_TG), config->GetItemCounts(AHB_GREEN_I));
@@ -1844,17 +1839,12 @@ void AuctionHouseBot::LoadValues(AHBConfig* config)
     if (AHBBuyer)
     {
         //load buyer bid prices
-        config->SetBuyerPrice(AHB_GREY, CharacterDatabase.PQuery("SELECT buyerpricegrey FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetBuyerPrice(AHB_WHITE, CharacterDatabase.PQuery("SELECT buyerpricewhite FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetBuyerPrice(AHB_GREEN, CharacterDatabase.PQuery("SELECT buyerpricegreen FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetBuyerPrice(AHB_BLUE, CharacterDatabase.PQuery("SELECT buyerpriceblue FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetBuyerPrice(AHB_PURPLE, CharacterDatabase.PQuery("SELECT buyerpricepurple FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetBuyerPrice(AHB_ORANGE, CharacterDatabase.PQuery("SELECT buyerpriceorange FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
-        config->SetBuyerPrice(AHB_YELLOW, CharacterDatabase.PQuery("SELECT buyerpriceyellow FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
+        for (uint32 quality = AHB_GREY; quality <= AHB_MAX_QUALITY; ++quality)
+            config->SetBuyerPrice(quality, fields[53 + quality].GetUInt32());
         //load bidding interval
-        config->SetBiddingInterval(CharacterDatabase.PQuery("SELECT buyerbiddinginterval FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
+        config->SetBiddingInterval(fields[60].GetUInt32());
         //load bids per interval
-        config->SetBidsPerInterval(CharacterDatabase.PQuery("SELECT buyerbidsperinterval FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetUInt32());
+        config->SetBidsPerInterval(fields[61].GetUInt32());
         if (debug_Out)
         {
             sLog.outString("buyerPriceGrey          = %u", config->GetBuyerPrice(AHB_GREY));
@@ -1868,6 +1858,6 @@ void AuctionHouseBot::LoadValues(AHBConfig* config)
             sLog.outString("buyerBidsPerInterval    = %u", config->GetBidsPerInterval());
         }
     }
-    if (debug_Out) sLog.outString("End Settings for %s Auctionhouses:", CharacterDatabase.PQuery("SELECT name FROM auctionhousebot WHERE auctionhouse = %u", config->GetAHID())->Fetch()->GetString());
+    if (debug_Out) sLog.outString("End Settings for %s Auctionhouses:", name.c_str());
 }
 
@@ -486,6 +486,7 @@ void Battleground::SetTeamStartLoc(uint32 TeamID, float X, float Y, float Z, flo
 
 void Battleground::SendPacketToAll(WorldPacket* packet)
 {
+    WorldPacket_AutoPtr shared;
     for (std::map<uint64, BattlegroundPlayer>::iterator itr = m_Players.begin(); itr != m_Players.end(); ++itr)
     {
         if (itr->second.LastOnlineTime)
@@ -493,7 +494,7 @@ void Battleground::SendPacketToAll(WorldPacket* packet)
 
         Player* plr = sObjectMgr.GetPlayer(itr->first);
         if (plr)
-            plr->GetSession()->SendPacket(packet);
+            plr->GetSession()->SendPacket(packet, shared);
         else
             sLog.outError("Battleground: Player (GUID: %u) not found!", GUID_LOPART(itr->first));
     }
@@ -501,6 +502,7 @@ void Battleground::SendPacketToAll(WorldPacket* packet)
 
 void Battleground::SendPacketToTeam(uint32 TeamID, WorldPacket* packet, Player* sender, bool self)
 {
+    WorldPacket_AutoPtr shared;
     for (std::map<uint64, BattlegroundPlayer>::iterator itr = m_Players.begin(); itr != m_Players.end(); ++itr)
     {
         if (itr->second.LastOnlineTime)
@@ -521,7 +523,7 @@ void Battleground::SendPacketToTeam(uint32 TeamID, WorldPacket* packet, Player*
         if (!team) team = plr->GetTeam();
 
         if (team == TeamID)
-            plr->GetSession()->SendPacket(packet);
+            plr->GetSession()->SendPacket(packet, shared);
     }
 }
 
@@ -1043,11 +1045,9 @@ void Battleground::RemovePlayerAtLeave(uint64 guid, bool Transport, bool SendPac
                 // summon old pet if there was one and there isn't a current pet
                 if (!player->GetGuardianPet() && player->GetTemporaryUnsummonedPetNumber())
                 {
-                    Pet* NewPet = new Pet(player);
-                    if (!NewPet->LoadPetFromDB(player, 0, (player)->GetTemporaryUnsummonedPetNumber(), true))
-                        delete NewPet;
-
-                    (player)->SetTemporaryUnsummonedPetNumber(0);
+                    uint32 petnumber = player->GetTemporaryUnsummonedPetNumber();
+                    player->SetTemporaryUnsummonedPetNumber(0);
+                    Pet::LoadPetFromDBAsync(player, PET_LOAD_ORIGIN_RESUMMON, 0, petnumber, true);
                 }
 
                 if (isRated() && GetStatus() == STATUS_IN_PROGRESS)
@@ -44,12 +44,12 @@ INSTANTIATE_SINGLETON_1(BattlegroundMgr);
 BattlegroundQueue::BattlegroundQueue()
 {
     //queues are empty, we don't have to call clear()
-    /*   for (int i = 0; i < MAX_BATTLEGROUND_QUEUES; i++)
-        {
-            //m_QueuedPlayers[i].Horde = 0;
-            //m_QueuedPlayers[i].Alliance = 0;
-            //m_QueuedPlayers[i].AverageTime = 0;
-        }*/
+    for (int i = 0; i < MAX_BATTLEGROUND_QUEUES; i++)
+    {
+        m_WaitTimeSum[i] = 0;
+        m_WaitTimeCount[i] = 0;
+        m_WaitTimeMax[i] = 0;
+    }
 }
 
 BattlegroundQueue::~BattlegroundQueue()
@@ -60,38 +60,66 @@ BattlegroundQueue::~BattlegroundQueue()
         for (QueuedGroupsList::iterator itr = m_QueuedGroups[i].begin(); itr != m_QueuedGroups[i].end(); ++itr)
             delete (*itr);
         m_QueuedGroups[i].clear();
+        m_RatedGroups[i].clear();
     }
 }
 
+static bool IsEligibleGroup(GroupQueueInfo const* ginfo, uint32 BgTypeId, uint32 side, uint32 MaxPlayers, uint8 ArenaType, bool IsRated, uint32 excludeTeam)
+{
+    return ginfo->BgTypeId == BgTypeId &&       // bg type must match
+           ginfo->ArenaType == ArenaType &&     // arena type must match
+           ginfo->IsRated == IsRated &&         // israted must match
+           ginfo->IsInvitedToBGInstanceGUID == 0 && // leave out already invited groups
+           ginfo->Team == side &&               // match side
+           ginfo->Players.size() <= MaxPlayers &&   // the group must fit in the bg
+           (!excludeTeam || ginfo->ArenaTeamId != excludeTeam) &&   // if excludeTeam is specified, leave out those arena team ids
+           (!IsRated || ginfo->Players.size() == MaxPlayers);       // if rated, then pass only if the player count is exact NEEDS TESTING! (but now this should never happen)
+}
+
+static bool JoinedBefore(GroupQueueInfo const* a, GroupQueueInfo const* b)
+{
+    return a->JoinTime < b->JoinTime;
+}
+
 // initialize eligible groups from the given source matching the given specifications
-void BattlegroundQueue::EligibleGroups::Init(BattlegroundQueue::QueuedGroupsList* source, uint32 BgTypeId, uint32 side, uint32 MaxPlayers, uint8 ArenaType, bool IsRated, uint32 MinRating, uint32 MaxRating, uint32 DisregardTime, uint32 excludeTeam)
+void BattlegroundQueue::EligibleGroups::Init(BattlegroundQueue::QueuedGroupsList* source, BattlegroundQueue::RatedGroupsIndex* ratedSource, uint32 BgTypeId, uint32 side, uint32 MaxPlayers, uint8 ArenaType, bool IsRated, uint32 MinRating, uint32 MaxRating, uint32 DisregardTime, uint32 excludeTeam)
 {
     // clear from prev initialization
     clear();
-    BattlegroundQueue::QueuedGroupsList::iterator itr, next;
-    // iterate through the source
-    for (itr = source->begin(); itr != source->end(); itr = next)
+
+    if (!IsRated || !DisregardTime)
     {
-        next = itr;
-        ++next;
-        if ((*itr)->BgTypeId == BgTypeId &&     // bg type must match
-            (*itr)->ArenaType == ArenaType &&   // arena type must match
-            (*itr)->IsRated == IsRated &&       // israted must match
-            (*itr)->IsInvitedToBGInstanceGUID == 0 && // leave out already invited groups
-            (*itr)->Team == side &&             // match side
-            (*itr)->Players.size() <= MaxPlayers &&   // the group must fit in the bg
-            (!excludeTeam || (*itr)->ArenaTeamId != excludeTeam) && // if excludeTeam is specified, leave out those arena team ids
-            (!IsRated || (*itr)->Players.size() == MaxPlayers) &&   // if rated, then pass only if the player count is exact NEEDS TESTING! (but now this should never happen)
-            (!DisregardTime || (*itr)->JoinTime <= DisregardTime              // pass if disregard time is greater than join time
-             || (*itr)->ArenaTeamRating == 0                 // pass if no rating info
-             || ((*itr)->ArenaTeamRating >= MinRating       // pass if matches the rating range
-                 && (*itr)->ArenaTeamRating <= MaxRating)))
+        // no rating window, iterate through the whole source
+        for (BattlegroundQueue::QueuedGroupsList::iterator itr = source->begin(); itr != source->end(); ++itr)
         {
             // the group matches the conditions
             // using push_back for proper selecting when inviting
-            push_back((*itr));
+            if (IsEligibleGroup(*itr, BgTypeId, side, MaxPlayers, ArenaType, IsRated, excludeTeam))
+                push_back((*itr));
         }
+        return;
     }
+
+    // groups that joined before the disregard time pass regardless of their rating,
+    // the source is in join order so they are all at its front
+    for (BattlegroundQueue::QueuedGroupsList::iterator itr = source->begin(); itr != source->end() && (*itr)->JoinTime <= DisregardTime; ++itr)
+        if (IsEligibleGroup(*itr, BgTypeId, side, MaxPlayers, ArenaType, IsRated, excludeTeam))
+            push_back((*itr));
+
+    // the others pass if they have no rating info or match the rating range
+    BattlegroundQueue::RatedGroupsIndex::iterator itr, end;
+    if (MinRating > 0)
+    {
+        for (itr = ratedSource->lower_bound(0), end = ratedSource->upper_bound(0); itr != end; ++itr)
+            if (itr->second->JoinTime > DisregardTime && IsEligibleGroup(itr->second, BgTypeId, side, MaxPlayers, ArenaType, IsRated, excludeTeam))
+                push_back(itr->second);
+    }
+    for (itr = ratedSource->lower_bound(MinRating), end = ratedSource->upper_bound(MaxRating); itr != end; ++itr)
+        if (itr->second->JoinTime > DisregardTime && IsEligibleGroup(itr->second, BgTypeId, side, MaxPlayers, ArenaType, IsRated, excludeTeam))
+            push_back(itr->second);
+
+    // keep the join order for proper selecting when inviting
+    sort(JoinedBefore);
 }
 
 // selection pool initialization, used to clean up from prev selection
@@ -149,6 +177,8 @@ GroupQueueInfo* BattlegroundQueue::AddGroup(Player* leader, uint32 BgTypeId, uin
     ginfo->Players.clear();
 
     m_QueuedGroups[queue_id].push_back(ginfo);
+    if (isRated)
+        m_RatedGroups[queue_id].insert(RatedGroupsIndex::value_type(arenaRating, ginfo));
 
     // return ginfo, because it is needed to add players to this group info
     return ginfo;
@@ -320,6 +350,8 @@ void BattlegroundQueue::RemovePlayer(uint64 guid, bool decreaseInvitedCount)
         if (group->Players.empty())
         {
             m_QueuedGroups[queue_id].erase(group_itr);
+            if (group->IsRated)
+                RemoveRatedGroup(queue_id, group);
             delete group;
         }
         // NEEDS TESTING!
@@ -345,6 +377,20 @@ void BattlegroundQueue::RemovePlayer(uint64 guid, bool decreaseInvitedCount)
     }
 }
 
+void BattlegroundQueue::RemoveRatedGroup(uint32 queue_id, GroupQueueInfo* ginfo)
+{
+    RatedGroupsIndex::iterator itr = m_RatedGroups[queue_id].lower_bound(ginfo->ArenaTeamRating);
+    RatedGroupsIndex::iterator end = m_RatedGroups[queue_id].upper_bound(ginfo->ArenaTeamRating);
+    for (; itr != end; ++itr)
+    {
+        if (itr->second == ginfo)
+        {
+            m_RatedGroups[queue_id].erase(itr);
+            return;
+        }
+    }
+}
+
 bool BattlegroundQueue::InviteGroupToBG(GroupQueueInfo* ginfo, Battleground* bg, uint32 side)
 {
     // set side if needed
@@ -356,6 +402,18 @@ bool BattlegroundQueue::InviteGroupToBG(GroupQueueInfo* ginfo, Battleground* bg,
         // not yet invited
         // set invitation
         ginfo->IsInvitedToBGInstanceGUID = bg->GetInstanceID();
+
+        // queue time metrics
+        uint32 queue_id = bg->GetQueueType();
+        if (queue_id < MAX_BATTLEGROUND_QUEUES)
+        {
+            uint32 waitTime = getMSTimeDiff(ginfo->JoinTime, getMSTime());
+            m_WaitTimeSum[queue_id] += waitTime;
+            ++m_WaitTimeCount[queue_id];
+            if (waitTime > m_WaitTimeMax[queue_id])
+                m_WaitTimeMax[queue_id] = waitTime;
+            sLog.outDebug("Battleground: group invited after %u ms in queue, bracket %u average %u ms, max %u ms", waitTime, queue_id, GetAverageWaitTime(queue_id), m_WaitTimeMax[queue_id]);
+        }
         uint32 bgQueueTypeId = sBattlegroundMgr.BGQueueTypeId(bg->GetTypeID(), bg->GetArenaType());
         // loop through the players
         for (std::map<uint64, PlayerQueueInfo*>::iterator itr = ginfo->Players.begin(); itr != ginfo->Players.end(); ++itr)
@@ -442,7 +500,7 @@ bool BattlegroundQueue::BuildSelectionPool(uint32 bgTypeId, uint32 queue_id, uin
     }
 
     // initiate the groups eligible to create the bg
-    m_EligibleGroups.Init(&(m_QueuedGroups[queue_id]), bgTypeId, side, MaxPlayers, ArenaType, isRated, MinRating, MaxRating, DisregardTime, excludeTeam);
+    m_EligibleGroups.Init(&(m_QueuedGroups[queue_id]), &(m_RatedGroups[queue_id]), bgTypeId, side, MaxPlayers, ArenaType, isRated, MinRating, MaxRating, DisregardTime, excludeTeam);
     // init the selected groups (clear)
     // and set m_CurrEligGroups pointer
     // we set it this way to only have one EligibleGroups object to save some memory
@@ -952,7 +1010,7 @@ bool BGQueueRemoveEvent::Execute(uint64 /*e_time*/, uint32 /*p_time*/)
         {
             plr->RemoveBattlegroundQueueId(bgQueueTypeId);
             sBattlegroundMgr.m_BattlegroundQueues[bgQueueTypeId].RemovePlayer(m_PlayerGuid, true);
-            sBattlegroundMgr.m_BattlegroundQueues[bgQueueTypeId].Update(bgQueueTypeId, bg->GetQueueType());
+            sBattlegroundMgr.ScheduleQueueUpdate(bgQueueTypeId, sBattlegroundMgr.BGTemplateId(bgQueueTypeId), bg->GetQueueType(), sBattlegroundMgr.BGArenaType(bgQueueTypeId), bg->isRated());
             WorldPacket data;
             sBattlegroundMgr.BuildBattlegroundStatusPacket(&data, bg, m_PlayersTeam, queueSlot, STATUS_NONE, 0, 0);
             plr->GetSession()->SendPacket(&data);
@@ -983,6 +1041,7 @@ BattlegroundMgr::BattlegroundMgr()
     m_RatingDiscardTimer = sWorld.getConfig(CONFIG_ARENA_RATING_DISCARD_TIMER);
     m_PrematureFinishTimer = sWorld.getConfig(CONFIG_BATTLEGROUND_PREMATURE_FINISH_TIMER);
     m_NextRatingDiscardUpdate = m_RatingDiscardTimer;
+    m_QueueUpdateTimer = 0;
     m_AutoDistributionTimeChecker = 0;
     m_ArenaTesting = false;
     m_Testing = false;
@@ -1036,14 +1095,39 @@ void BattlegroundMgr::Update(uint32 diff)
         if (m_NextRatingDiscardUpdate < diff)
         {
             // forced update for level 70 rated arenas
-            m_BattlegroundQueues[BATTLEGROUND_QUEUE_2v2].Update(BATTLEGROUND_AA, 6, ARENA_TYPE_2v2, true, 0);
-            m_BattlegroundQueues[BATTLEGROUND_QUEUE_3v3].Update(BATTLEGROUND_AA, 6, ARENA_TYPE_3v3, true, 0);
-            m_BattlegroundQueues[BATTLEGROUND_QUEUE_5v5].Update(BATTLEGROUND_AA, 6, ARENA_TYPE_5v5, true, 0);
+            ScheduleQueueUpdate(BATTLEGROUND_QUEUE_2v2, BATTLEGROUND_AA, 6, ARENA_TYPE_2v2, true, 0);
+            ScheduleQueueUpdate(BATTLEGROUND_QUEUE_3v3, BATTLEGROUND_AA, 6, ARENA_TYPE_3v3, true, 0);
+            ScheduleQueueUpdate(BATTLEGROUND_QUEUE_5v5, BATTLEGROUND_AA, 6, ARENA_TYPE_5v5, true, 0);
             m_NextRatingDiscardUpdate = m_RatingDiscardTimer;
         }
         else
             m_NextRatingDiscardUpdate -= diff;
     }
+    // run the queue updates scheduled since the last run
+    m_QueueUpdateTimer += diff;
+    if (m_QueueUpdateTimer >= sWorld.getConfig(CONFIG_BATTLEGROUND_QUEUE_UPDATE_INTERVAL))
+    {
+        // map threads schedule updates too (BGQueueRemoveEvent), take the whole set under the lock
+        std::set<uint64> scheduled;
+        {
+            ACE_GUARD(ACE_Thread_Mutex, guard, m_QueueUpdateLock);
+            scheduled.swap(m_QueueUpdateScheduler);
+        }
+
+        if (!scheduled.empty())
+            m_QueueUpdateTimer = 0;
+
+        for (std::set<uint64>::const_iterator itr = scheduled.begin(); itr != scheduled.end(); ++itr)
+        {
+            uint32 arenaRating = uint32(*itr >> 32);
+            uint32 bgQueueTypeId = uint32(*itr >> 24) & 0xFF;
+            uint32 bgTypeId = uint32(*itr >> 16) & 0xFF;
+            uint32 queue_id = uint32(*itr >> 8) & 0xFF;
+            uint8 arenaType = uint8((*itr >> 1) & 0x7F);
+            bool isRated = (*itr & 1) != 0;
+            m_BattlegroundQueues[bgQueueTypeId].Update(bgTypeId, queue_id, arenaType, isRated, arenaRating);
+        }
+    }
     if (m_AutoDistributePoints)
     {
         if (m_AutoDistributionTimeChecker < diff)
@@ -1061,6 +1145,18 @@ void BattlegroundMgr::Update(uint32 diff)
     }
 }
 
+void BattlegroundMgr::ScheduleQueueUpdate(uint32 bgQueueTypeId, uint32 bgTypeId, uint32 queue_id, uint8 arenaType, bool isRated, uint32 arenaRating)
+{
+    if (bgQueueTypeId >= MAX_BATTLEGROUND_QUEUE_TYPES)
+        return;
+
+    // identical requests (same bracket, type and rating) are only run once
+    uint64 key = (uint64(arenaRating) << 32) | (bgQueueTypeId << 24) | (bgTypeId << 16) | (queue_id << 8) | (uint32(arenaType) << 1) | (isRated ? 1 : 0);
+
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_QueueUpdateLock);
+    m_QueueUpdateScheduler.insert(key);
+}
+
 void BattlegroundMgr::BuildBattlegroundStatusPacket(WorldPacket* data, Battleground* bg, uint32 /*team*/, uint8 QueueSlot, uint8 StatusID, uint32 Time1, uint32 Time2, uint32 arenatype, uint8 israted)
 {
     // we can be in 3 queues in same time...
@@ -21,6 +21,8 @@
 #include "Battleground.h"
 #include "Policies/Singleton.h"
 
+#include <ace/Thread_Mutex.h>
+
 class Battleground;
 
 //TODO it is not possible to have this structure, because we should have BattlegroundSet for each queue
@@ -81,11 +83,15 @@ class BattlegroundQueue
         typedef std::list<GroupQueueInfo*> QueuedGroupsList;
         QueuedGroupsList m_QueuedGroups[MAX_BATTLEGROUND_QUEUES];
 
+        // rated groups of m_QueuedGroups ordered by arena team rating, for rating window lookups
+        typedef std::multimap<uint32, GroupQueueInfo*> RatedGroupsIndex;
+        RatedGroupsIndex m_RatedGroups[MAX_BATTLEGROUND_QUEUES];
+
         // class to hold pointers to the groups eligible for a specific selection pool building mode
         class EligibleGroups : public std::list<GroupQueueInfo*>
         {
             public:
-                void Init(QueuedGroupsList* source, uint32 BgTypeId, uint32 side, uint32 MaxPlayers, uint8 ArenaType = 0, bool IsRated = false, uint32 MinRating = 0, uint32 MaxRating = 0, uint32 DisregardTime = 0, uint32 excludeTeam = 0);
+                void Init(QueuedGroupsList* source, RatedGroupsIndex* ratedSource, uint32 BgTypeId, uint32 side, uint32 MaxPlayers, uint8 ArenaType = 0, bool IsRated = false, uint32 MinRating = 0, uint32 MaxRating = 0, uint32 DisregardTime = 0, uint32 excludeTeam = 0);
         };
 
         EligibleGroups m_EligibleGroups;
@@ -125,9 +131,29 @@ class BattlegroundQueue
 
         bool BuildSelectionPool(uint32 bgTypeId, uint32 queue_id, uint32 MinPlayers, uint32 MaxPlayers, SelectionPoolBuildMode mode, uint8 ArenaType = 0, bool isRated = false, uint32 MinRating = 0, uint32 MaxRating = 0, uint32 DisregardTime = 0, uint32 excludeTeam = 0);
 
+        // average time in milliseconds groups of the level bracket waited for their first invite
+        uint32 GetAverageWaitTime(uint32 queue_id) const
+        {
+            return m_WaitTimeCount[queue_id] ? uint32(m_WaitTimeSum[queue_id] / m_WaitTimeCount[queue_id]) : 0;
+        }
+        uint32 GetMaxWaitTime(uint32 queue_id) const
+        {
+            return m_WaitTimeMax[queue_id];
+        }
+        uint32 GetWaitTimeCount(uint32 queue_id) const
+        {
+            return m_WaitTimeCount[queue_id];
+        }
+
     private:
 
         bool InviteGroupToBG(GroupQueueInfo* ginfo, Battleground* bg, uint32 side);
+        void RemoveRatedGroup(uint32 queue_id, GroupQueueInfo* ginfo);
+
+        // queue time metrics per level bracket
+        uint64 m_WaitTimeSum[MAX_BATTLEGROUND_QUEUES];
+        uint32 m_WaitTimeCount[MAX_BATTLEGROUND_QUEUES];
+        uint32 m_WaitTimeMax[MAX_BATTLEGROUND_QUEUES];
 };
 
 /*
@@ -227,6 +253,9 @@ class BattlegroundMgr
         //these queues are instantiated when creating BattlegroundMrg
         BattlegroundQueue m_BattlegroundQueues[MAX_BATTLEGROUND_QUEUE_TYPES]; // public, because we need to access them in BG handler code
 
+        // queue updates are collected and run together every Battleground.QueueUpdateInterval
+        void ScheduleQueueUpdate(uint32 bgQueueTypeId, uint32 bgTypeId, uint32 queue_id, uint8 arenaType = 0, bool isRated = false, uint32 arenaRating = 0);
+
         BGFreeSlotQueueType BGFreeSlotQueue[MAX_BATTLEGROUND_TYPES];
 
         void SendAreaSpiritHealerQueryOpcode(Player* pl, Battleground* bg, uint64 guid);
@@ -271,6 +300,9 @@ class BattlegroundMgr
         uint32 m_MaxRatingDifference;
         uint32 m_RatingDiscardTimer;
         uint32 m_NextRatingDiscardUpdate;
+        std::set<uint64> m_QueueUpdateScheduler;
+        ACE_Thread_Mutex m_QueueUpdateLock;                 // guards m_QueueUpdateScheduler
+        uint32 m_QueueUpdateTimer;
         bool   m_AutoDistributePoints;
         uint64 m_NextAutoDistributionTime;
         uint32 m_AutoDistributionTimeChecker;
@@ -661,26 +661,28 @@ void Channel::SetOwner(uint64 guid, bool exclaim)
 
 void Channel::SendToAll(WorldPacket* data, uint64 p)
 {
+    WorldPacket_AutoPtr shared;
     for (PlayerList::const_iterator i = players.begin(); i != players.end(); ++i)
     {
         Player* plr = sObjectMgr.GetPlayer(i->first, true);
         if (plr)
         {
             if (!p || !plr->GetSocial()->HasIgnore(GUID_LOPART(p)))
-                plr->GetSession()->SendPacket(data);
+                plr->GetSession()->SendPacket(data, shared);
         }
     }
 }
 
 void Channel::SendToAllButOne(WorldPacket* data, uint64 who)
 {
+    WorldPacket_AutoPtr shared;
     for (PlayerList::const_iterator i = players.begin(); i != players.end(); ++i)
     {
         if (i->first != who)
         {
             Player* plr = sObjectMgr.GetPlayer(i->first);
             if (plr)
-                plr->GetSession()->SendPacket(data);
+                plr->GetSession()->SendPacket(data, shared);
         }
     }
 }
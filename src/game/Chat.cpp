@@ -95,11 +95,14 @@ ChatCommand* ChatHandler::getCommandTable()
 
     static ChatCommand serverCommandTable[] =
     {
+        { "bgqueues",       SEC_GAMEMASTER,     true,  &ChatHandler::HandleServerBgQueuesCommand,      "", NULL },
         { "corpses",        SEC_GAMEMASTER,     true,  &ChatHandler::HandleServerCorpsesCommand,       "", NULL },
         { "exit",           SEC_CONSOLE,        true,  &ChatHandler::HandleServerExitCommand,          "", NULL },
+        { "guids",          SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleServerGuidsCommand,         "", NULL },
         { "idlerestart",    SEC_ADMINISTRATOR,  true,  NULL,                                           "", serverIdleRestartCommandTable },
         { "idleshutdown",   SEC_ADMINISTRATOR,  true,  NULL,                                           "", serverIdleShutdownCommandTable },
         { "info",           SEC_PLAYER,         true,  &ChatHandler::HandleServerInfoCommand,          "", NULL },
+        { "maps",           SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleServerMapsCommand,          "", NULL },
         { "motd",           SEC_PLAYER,         true,  &ChatHandler::HandleServerMotdCommand,          "", NULL },
         { "plimit",         SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleServerPLimitCommand,        "", NULL },
         { "restart",        SEC_ADMINISTRATOR,  true,  NULL,                                           "", serverRestartCommandTable },
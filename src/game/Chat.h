@@ -318,6 +318,7 @@ class ChatHandler
         bool HandleInstanceStatsCommand(const char* args);
         bool HandleInstanceSaveDataCommand(const char* args);
 
+        bool HandleServerBgQueuesCommand(const char* args);
         bool HandleServerCorpsesCommand(const char* args);
         bool HandleServerExitCommand(const char* args);
         bool HandleServerIdleRestartCommand(const char* args);
@@ -325,6 +326,8 @@ class ChatHandler
         bool HandleServerInfoCommand(const char* args);
         bool HandleServerMotdCommand(const char* args);
         bool HandleServerPLimitCommand(const char* args);
+        bool HandleServerMapsCommand(const char* args);
+        bool HandleServerGuidsCommand(const char* args);
         bool HandleServerRestartCommand(const char* args);
         bool HandleServerSetLogMaskCommand(const char* args);
         bool HandleServerSetMotdCommand(const char* args);
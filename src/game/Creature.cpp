@@ -176,6 +176,10 @@ Creature::~Creature()
 
     delete i_AI;
     i_AI = NULL;
+
+    // summons, pets and instance copies of spawns do not keep their guid
+    if (m_uint32Values && GetGUIDLow() && GetGUIDLow() != m_DBTableGuid)
+        sObjectMgr.ReleaseLowGuid(HighGuid(GetGUIDHigh()), GetGUIDLow());
 }
 
 void Creature::AddToWorld()
@@ -1684,7 +1688,7 @@ void Creature::Respawn(bool force)
         }
 
         uint32 poolid = sPoolMgr.IsPartOfAPool<Creature>(GetDBTableGUIDLow());
-        if (poolid)
+        if (poolid && !GetMap()->DeferPoolUpdate(this, poolid))
             sPoolMgr.UpdatePool<Creature>(poolid, GetDBTableGUIDLow());
 
         //Re-initialize reactstate that could be altered by movementgenerators
@@ -1467,17 +1467,19 @@ void GameEventMgr::RunSmartAIScripts(uint16 event_id, bool activate)
 {
     //! Iterate over every supported source type (creature and gameobject)
     //! Not entirely sure how this will affect units in non-loaded grids.
+    for (uint32 shard = 0; shard < HashMapHolder<Creature>::GetShardCount(); ++shard)
     {
-        ObjectAccessor::Guard guard(*HashMapHolder<Creature>::GetLock());
-        HashMapHolder<Creature>::MapType const& m = ObjectAccessor::Instance().GetCreatures();
+        HashMapHolder<Creature>::ReadGuard guard(*HashMapHolder<Creature>::GetLock(shard));
+        HashMapHolder<Creature>::MapType const& m = ObjectAccessor::GetCreatures(shard);
         for (HashMapHolder<Creature>::MapType::const_iterator iter = m.begin(); iter != m.end(); ++iter)
             if (iter->second && iter->second->IsInWorld())
                 if (iter->second->AI())
                     iter->second->AI()->sOnGameEvent(activate, event_id);
     }
+    for (uint32 shard = 0; shard < HashMapHolder<GameObject>::GetShardCount(); ++shard)
     {
-        ObjectAccessor::Guard guard(*HashMapHolder<GameObject>::GetLock());
-        HashMapHolder<GameObject>::MapType const& m = ObjectAccessor::GetGameObjects();
+        HashMapHolder<GameObject>::ReadGuard guard(*HashMapHolder<GameObject>::GetLock(shard));
+        HashMapHolder<GameObject>::MapType const& m = ObjectAccessor::GetGameObjects(shard);
         for (HashMapHolder<GameObject>::MapType::const_iterator iter = m.begin(); iter != m.end(); ++iter)
             if (iter->second && iter->second->IsInWorld())
                 if (iter->second->AI())
@@ -71,6 +71,10 @@ GameObject::~GameObject()
 {
     delete m_model;
     delete m_AI;
+
+    // temporary and instance gameobjects do not keep their guid
+    if (m_uint32Values && GetGUIDLow() && GetGUIDLow() != m_DBTableGuid)
+        sObjectMgr.ReleaseLowGuid(HighGuid(GetGUIDHigh()), GetGUIDLow());
 }
 
 bool GameObject::AIM_Initialize()
@@ -337,7 +341,10 @@ void GameObject::Update(uint32 diff)
                     // Respawn timer
                     uint32 poolid = GetDBTableGUIDLow() ? sPoolMgr.IsPartOfAPool<GameObject>(GetDBTableGUIDLow()) : 0;
                     if (poolid)
-                        sPoolMgr.UpdatePool<GameObject>(poolid, GetDBTableGUIDLow());
+                    {
+                        if (!GetMap()->DeferPoolUpdate(this, poolid))
+                            sPoolMgr.UpdatePool<GameObject>(poolid, GetDBTableGUIDLow());
+                    }
                     else
                         GetMap()->AddToMap(this);
                 }
@@ -585,7 +592,10 @@ void GameObject::Delete()
 
     uint32 poolid = GetDBTableGUIDLow() ? sPoolMgr.IsPartOfAPool<GameObject>(GetDBTableGUIDLow()) : 0;
     if (poolid)
-        sPoolMgr.UpdatePool<GameObject>(poolid, GetDBTableGUIDLow());
+    {
+        if (!GetMap()->DeferPoolUpdate(this, poolid))
+            sPoolMgr.UpdatePool<GameObject>(poolid, GetDBTableGUIDLow());
+    }
     else
         AddObjectToRemoveList();
 }
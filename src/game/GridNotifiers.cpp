@@ -78,9 +78,12 @@ VisibleNotifier::SendToSelf()
     if (!i_data.HasData())
         return;
 
+    // creatures going out of range must not disappear before their queued moves
+    i_player.SendCompressedMovesFor(i_data.GetOutOfRangeGUIDs());
+
     WorldPacket packet;
     i_data.BuildPacket(&packet);
-    i_player.GetSession()->SendPacket(&packet);
+    i_player.GetSession()->SendPacket(std::move(packet));
 
     for (std::set<Unit*>::const_iterator it = i_visibleNow.begin(); it != i_visibleNow.end(); ++it)
         i_player.SendAuraDurationsForTarget(*it);
@@ -142,9 +142,12 @@ struct MessageDistDeliverer
     uint32 i_phaseMask;
     float i_distSq;
     uint32 team;
-    MessageDistDeliverer(WorldObject* src, WorldPacket* msg, float dist, bool own_team_only = false)
+    bool i_batched;                                         // queue as compressed move instead of sending
+    WorldPacket_AutoPtr i_shared;                           // one copy for all sockets that have to queue it
+    MessageDistDeliverer(WorldObject* src, WorldPacket* msg, float dist, bool own_team_only = false, bool batched = false)
         : i_source(src), i_message(msg), i_phaseMask(src->GetPhaseMask()), i_distSq(dist* dist)
         , team((own_team_only && src->GetTypeId() == TYPEID_PLAYER) ? ((Player*)src)->GetTeam() : 0)
+        , i_batched(batched)
     {
     }
     void Visit(PlayerMapType& m);
@@ -161,8 +164,10 @@ struct MessageDistDeliverer
         if (!plr->HaveAtClient(i_source))
             return;
 
-        if (WorldSession* session = plr->GetSession())
-            session->SendPacket(i_message);
+        if (i_batched)
+            plr->QueueCompressedMove(i_message, i_source->GetGUID());
+        else if (WorldSession* session = plr->GetSession())
+            session->SendPacket(i_message, i_shared);
     }
 };
 
@@ -217,14 +222,16 @@ struct WorldObjectSearcher
     template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
 };
 
-template<class Check>
+// List searchers accept any container with push_back, hot paths pass a
+// SmallVector (see UnitSearchList) to avoid a heap allocation per result
+template<class Check, class Container = std::list<WorldObject*> >
 struct WorldObjectListSearcher
 {
     uint32 i_phaseMask;
-    std::list<WorldObject*>& i_objects;
+    Container& i_objects;
     Check& i_check;
 
-    WorldObjectListSearcher(WorldObject const* searcher, std::list<WorldObject*>& objects, Check& check) : i_phaseMask(searcher->GetPhaseMask()), i_objects(objects), i_check(check) {}
+    WorldObjectListSearcher(WorldObject const* searcher, Container& objects, Check& check) : i_phaseMask(searcher->GetPhaseMask()), i_objects(objects), i_check(check) {}
 
     void Visit(PlayerMapType& m);
     void Visit(CreatureMapType& m);
@@ -311,14 +318,14 @@ struct GameObjectLastSearcher
     template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
 };
 
-template<class Check>
+template<class Check, class Container = std::list<GameObject*> >
 struct GameObjectListSearcher
 {
     uint32 i_phaseMask;
-    std::list<GameObject*>& i_objects;
+    Container& i_objects;
     Check& i_check;
 
-    GameObjectListSearcher(WorldObject const* searcher, std::list<GameObject*>& objects, Check& check) : i_phaseMask(searcher->GetPhaseMask()), i_objects(objects), i_check(check) {}
+    GameObjectListSearcher(WorldObject const* searcher, Container& objects, Check& check) : i_phaseMask(searcher->GetPhaseMask()), i_objects(objects), i_check(check) {}
 
     void Visit(GameObjectMapType& m);
 
@@ -360,14 +367,14 @@ struct UnitLastSearcher
 };
 
 // All accepted by Check units if any
-template<class Check>
+template<class Check, class Container = std::list<Unit*> >
 struct UnitListSearcher
 {
     uint32 i_phaseMask;
-    std::list<Unit*>& i_objects;
+    Container& i_objects;
     Check& i_check;
 
-    UnitListSearcher(WorldObject const* searcher, std::list<Unit*>& objects, Check& check) : i_phaseMask(searcher->GetPhaseMask()), i_objects(objects), i_check(check) {}
+    UnitListSearcher(WorldObject const* searcher, Container& objects, Check& check) : i_phaseMask(searcher->GetPhaseMask()), i_objects(objects), i_check(check) {}
 
     void Visit(PlayerMapType& m);
     void Visit(CreatureMapType& m);
@@ -406,14 +413,14 @@ struct CreatureLastSearcher
     template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
 };
 
-template<class Check>
+template<class Check, class Container = std::list<Creature*> >
 struct CreatureListSearcher
 {
     uint32 i_phaseMask;
-    std::list<Creature*>& i_objects;
+    Container& i_objects;
     Check& i_check;
 
-    CreatureListSearcher(WorldObject const* searcher, std::list<Creature*>& objects, Check& check) : i_phaseMask(searcher->GetPhaseMask()), i_objects(objects), i_check(check) {}
+    CreatureListSearcher(WorldObject const* searcher, Container& objects, Check& check) : i_phaseMask(searcher->GetPhaseMask()), i_objects(objects), i_check(check) {}
 
     void Visit(CreatureMapType& m);
 
@@ -454,14 +461,14 @@ struct PlayerSearcher
     template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
 };
 
-template<class Check>
+template<class Check, class Container = std::list<Player*> >
 struct PlayerListSearcher
 {
     uint32 i_phaseMask;
-    std::list<Player*>& i_objects;
+    Container& i_objects;
     Check& i_check;
 
-    PlayerListSearcher(WorldObject const* searcher, std::list<Player*>& objects, Check& check)
+    PlayerListSearcher(WorldObject const* searcher, Container& objects, Check& check)
         : i_phaseMask(searcher->GetPhaseMask()), i_objects(objects), i_check(check) {}
 
     void Visit(PlayerMapType& m);
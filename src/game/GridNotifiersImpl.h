@@ -149,8 +149,8 @@ void Oregon::WorldObjectSearcher<Check>::Visit(DynamicObjectMapType& m)
     }
 }
 
-template<class Check>
-void Oregon::WorldObjectListSearcher<Check>::Visit(PlayerMapType& m)
+template<class Check, class Container>
+void Oregon::WorldObjectListSearcher<Check, Container>::Visit(PlayerMapType& m)
 {
     for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
         if (itr->GetSource()->InSamePhase(i_phaseMask))
@@ -158,8 +158,8 @@ void Oregon::WorldObjectListSearcher<Check>::Visit(PlayerMapType& m)
                 i_objects.push_back(itr->GetSource());
 }
 
-template<class Check>
-void Oregon::WorldObjectListSearcher<Check>::Visit(CreatureMapType& m)
+template<class Check, class Container>
+void Oregon::WorldObjectListSearcher<Check, Container>::Visit(CreatureMapType& m)
 {
     for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
         if (itr->GetSource()->InSamePhase(i_phaseMask))
@@ -167,8 +167,8 @@ void Oregon::WorldObjectListSearcher<Check>::Visit(CreatureMapType& m)
                 i_objects.push_back(itr->GetSource());
 }
 
-template<class Check>
-void Oregon::WorldObjectListSearcher<Check>::Visit(CorpseMapType& m)
+template<class Check, class Container>
+void Oregon::WorldObjectListSearcher<Check, Container>::Visit(CorpseMapType& m)
 {
     for (CorpseMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
         if (itr->GetSource()->InSamePhase(i_phaseMask))
@@ -176,8 +176,8 @@ void Oregon::WorldObjectListSearcher<Check>::Visit(CorpseMapType& m)
                 i_objects.push_back(itr->GetSource());
 }
 
-template<class Check>
-void Oregon::WorldObjectListSearcher<Check>::Visit(GameObjectMapType& m)
+template<class Check, class Container>
+void Oregon::WorldObjectListSearcher<Check, Container>::Visit(GameObjectMapType& m)
 {
     for (GameObjectMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
         if (itr->GetSource()->InSamePhase(i_phaseMask))
@@ -185,8 +185,8 @@ void Oregon::WorldObjectListSearcher<Check>::Visit(GameObjectMapType& m)
                 i_objects.push_back(itr->GetSource());
 }
 
-template<class Check>
-void Oregon::WorldObjectListSearcher<Check>::Visit(DynamicObjectMapType& m)
+template<class Check, class Container>
+void Oregon::WorldObjectListSearcher<Check, Container>::Visit(DynamicObjectMapType& m)
 {
     for (DynamicObjectMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
         if (itr->GetSource()->InSamePhase(i_phaseMask))
@@ -229,8 +229,8 @@ void Oregon::GameObjectLastSearcher<Check>::Visit(GameObjectMapType& m)
     }
 }
 
-template<class Check>
-void Oregon::GameObjectListSearcher<Check>::Visit(GameObjectMapType& m)
+template<class Check, class Container>
+void Oregon::GameObjectListSearcher<Check, Container>::Visit(GameObjectMapType& m)
 {
     for (GameObjectMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
         if (itr->GetSource()->InSamePhase(i_phaseMask))
@@ -306,8 +306,8 @@ void Oregon::UnitLastSearcher<Check>::Visit(PlayerMapType& m)
     }
 }
 
-template<class Check>
-void Oregon::UnitListSearcher<Check>::Visit(PlayerMapType& m)
+template<class Check, class Container>
+void Oregon::UnitListSearcher<Check, Container>::Visit(PlayerMapType& m)
 {
     for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
         if (itr->GetSource()->InSamePhase(i_phaseMask))
@@ -315,8 +315,8 @@ void Oregon::UnitListSearcher<Check>::Visit(PlayerMapType& m)
                 i_objects.push_back(itr->GetSource());
 }
 
-template<class Check>
-void Oregon::UnitListSearcher<Check>::Visit(CreatureMapType& m)
+template<class Check, class Container>
+void Oregon::UnitListSearcher<Check, Container>::Visit(CreatureMapType& m)
 {
     for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
         if (itr->GetSource()->InSamePhase(i_phaseMask))
@@ -359,8 +359,8 @@ void Oregon::CreatureLastSearcher<Check>::Visit(CreatureMapType& m)
     }
 }
 
-template<class Check>
-void Oregon::CreatureListSearcher<Check>::Visit(CreatureMapType& m)
+template<class Check, class Container>
+void Oregon::CreatureListSearcher<Check, Container>::Visit(CreatureMapType& m)
 {
     for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
         if (itr->GetSource()->InSamePhase(i_phaseMask))
@@ -368,8 +368,8 @@ void Oregon::CreatureListSearcher<Check>::Visit(CreatureMapType& m)
                 i_objects.push_back(itr->GetSource());
 }
 
-template<class Check>
-void Oregon::PlayerListSearcher<Check>::Visit(PlayerMapType& m)
+template<class Check, class Container>
+void Oregon::PlayerListSearcher<Check, Container>::Visit(PlayerMapType& m)
 {
     for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
         if (itr->GetSource()->InSamePhase(i_phaseMask))
@@ -0,0 +1,110 @@
+/*
+ * This file is part of the OregonCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "GuidAllocator.h"
+#include "World.h"
+
+#include <ace/Guard_T.h>
+
+namespace
+{
+    struct GuidBlock
+    {
+        GuidBlock() : count(0) { }
+
+        uint32 guids[GUID_BLOCK_SIZE];                      // handed out from the back
+        uint32 count;
+    };
+
+    thread_local GuidBlock tBlocks[MAX_GUID_ALLOCATORS];
+}
+
+GuidAllocator::GuidAllocator(GuidAllocatorSlot slot, char const* name, uint32 maxGuid, bool recycle) :
+    m_slot(slot), m_name(name), m_max(maxGuid), m_recycle(recycle), m_next(1), m_reused(0)
+{
+}
+
+uint32 GuidAllocator::Generate()
+{
+    GuidBlock& block = tBlocks[m_slot];
+
+    if (!block.count)
+        block.count = Reserve(block.guids);
+
+    if (!block.count)
+        return 0;
+
+    return block.guids[--block.count];
+}
+
+uint32 GuidAllocator::Reserve(uint32* guids)
+{
+    uint32 count = 0;
+
+    if (m_recycle)
+    {
+        time_t now = sWorld.GetGameTime();
+
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_lock, 0);
+
+        while (count < GUID_BLOCK_SIZE && !m_recycled.empty() && m_recycled.front().first <= now)
+        {
+            guids[count++] = m_recycled.front().second;
+            m_recycled.pop_front();
+        }
+    }
+
+    if (count)
+    {
+        m_reused += count;
+        return count;
+    }
+
+    // a range of fresh guids, stored in reverse so they are handed out ascending
+    uint32 first = m_next;
+    do
+    {
+        if (first > m_max)
+            return 0;
+
+        count = std::min<uint32>(GUID_BLOCK_SIZE, m_max - first + 1);
+    }
+    while (!m_next.compare_exchange_weak(first, first + count));
+
+    for (uint32 i = 0; i < count; ++i)
+        guids[i] = first + count - 1 - i;
+
+    return count;
+}
+
+void GuidAllocator::Release(uint32 guid)
+{
+    uint32 delay = sWorld.getConfig(CONFIG_GUID_RECYCLE_DELAY);
+    if (!m_recycle || !guid || !delay)
+        return;
+
+    time_t reuseTime = sWorld.GetGameTime() + delay;
+
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+    m_recycled.push_back(RecycledGuids::value_type(reuseTime, guid));
+}
+
+uint32 GuidAllocator::GetRecycledCount()
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_lock, 0);
+    return uint32(m_recycled.size());
+}
@@ -0,0 +1,86 @@
+/*
+ * This file is part of the OregonCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef OREGON_GUID_ALLOCATOR_H
+#define OREGON_GUID_ALLOCATOR_H
+
+#include "Platform/Define.h"
+
+#include <ace/Thread_Mutex.h>
+
+#include <atomic>
+#include <deque>
+#include <utility>
+
+#define GUID_BLOCK_SIZE         64                          // guids a thread takes at once
+
+enum GuidAllocatorSlot
+{
+    GUID_ALLOCATOR_CREATURE,
+    GUID_ALLOCATOR_PET,
+    GUID_ALLOCATOR_GAMEOBJECT,
+    GUID_ALLOCATOR_DYNAMICOBJECT,
+    MAX_GUID_ALLOCATORS
+};
+
+/**
+ * Low guids of one world object type.
+ *
+ * Every thread takes a block of guids at once and hands them out without
+ * locking, so map threads do not contend on a shared counter. Guids of
+ * temporary objects (summons, instance copies of spawns, spell objects) can
+ * be given back when the object is deleted. They are reused after
+ * Guid.RecycleDelay seconds, when neither clients nor stale references
+ * held by guid can mistake the new object for the old one.
+ */
+class GuidAllocator
+{
+    public:
+        GuidAllocator(GuidAllocatorSlot slot, char const* name, uint32 maxGuid, bool recycle);
+
+        // first guid of the counter, set at startup before any allocation
+        void SetNext(uint32 next) { m_next = next; }
+
+        // 0 if the guid space is used up
+        uint32 Generate();
+        void Release(uint32 guid);
+
+        char const* GetName() const { return m_name; }
+        uint32 GetNext() const { return m_next; }
+        uint32 GetMax() const { return m_max; }
+        uint32 GetRecycledCount();                          // released, waiting or ready for reuse
+        uint64 GetReusedCount() const { return m_reused; }
+
+    private:
+        typedef std::deque<std::pair<time_t, uint32> > RecycledGuids;
+
+        // takes ready recycled guids or a range of the counter, returns the count
+        uint32 Reserve(uint32* guids);
+
+        GuidAllocatorSlot m_slot;
+        char const* m_name;
+        uint32 m_max;
+        bool m_recycle;
+
+        std::atomic<uint32> m_next;
+        std::atomic<uint64> m_reused;
+
+        ACE_Thread_Mutex m_lock;
+        RecycledGuids m_recycled;                           // in release order
+};
+
+#endif
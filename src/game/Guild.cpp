@@ -610,23 +610,25 @@ void Guild::BroadcastToOfficers(WorldSession* session, const std::string& msg, u
 
 void Guild::BroadcastPacket(WorldPacket* packet)
 {
+    WorldPacket_AutoPtr shared;
     for (MemberList::iterator itr = members.begin(); itr != members.end(); ++itr)
     {
         Player* player = ObjectAccessor::FindPlayer(MAKE_NEW_GUID(itr->first, 0, HIGHGUID_PLAYER), true);
         if (player)
-            player->GetSession()->SendPacket(packet);
+            player->GetSession()->SendPacket(packet, shared);
     }
 }
 
 void Guild::BroadcastPacketToRank(WorldPacket* packet, uint32 rankId)
 {
+    WorldPacket_AutoPtr shared;
     for (MemberList::iterator itr = members.begin(); itr != members.end(); ++itr)
     {
         if (itr->second.RankId == rankId)
         {
             Player* player = ObjectAccessor::FindPlayer(MAKE_NEW_GUID(itr->first, 0, HIGHGUID_PLAYER), true);
             if (player)
-                player->GetSession()->SendPacket(packet);
+                player->GetSession()->SendPacket(packet, shared);
         }
     }
 }
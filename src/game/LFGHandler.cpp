@@ -29,53 +29,56 @@ static void AttemptJoin(Player* _player)
     if (!_player->m_lookingForGroup.canAutoJoin() || _player->GetGroup())
         return;
 
-    ObjectAccessor::Guard guard(*HashMapHolder<Player>::GetLock());
-    HashMapHolder<Player>::MapType const& players = ObjectAccessor::Instance().GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator iter = players.begin(); iter != players.end(); ++iter)
+    for (uint32 shard = 0; shard < HashMapHolder<Player>::GetShardCount(); ++shard)
     {
-        Player* plr = iter->second;
+        HashMapHolder<Player>::ReadGuard guard(*HashMapHolder<Player>::GetLock(shard));
+        HashMapHolder<Player>::MapType const& players = ObjectAccessor::Instance().GetPlayers(shard);
+        for (HashMapHolder<Player>::MapType::const_iterator iter = players.begin(); iter != players.end(); ++iter)
+        {
+            Player* plr = iter->second;
 
-        // skip enemies and self
-        if (!plr || plr == _player || plr->GetTeam() != _player->GetTeam())
-            continue;
+            // skip enemies and self
+            if (!plr || plr == _player || plr->GetTeam() != _player->GetTeam())
+                continue;
 
-        //skip players not in world
-        if (!plr->IsInWorld())
-            continue;
+            //skip players not in world
+            if (!plr->IsInWorld())
+                continue;
 
-        // skip not auto add, not group leader cases
-        if (!plr->GetSession()->LookingForGroup_auto_add || (plr->GetGroup() && plr->GetGroup()->GetLeaderGUID() != plr->GetGUID()))
-            continue;
+            // skip not auto add, not group leader cases
+            if (!plr->GetSession()->LookingForGroup_auto_add || (plr->GetGroup() && plr->GetGroup()->GetLeaderGUID() != plr->GetGUID()))
+                continue;
 
-        // skip non auto-join or empty slots, or non compatible slots
-        if (!plr->m_lookingForGroup.more.canAutoJoin() || !_player->m_lookingForGroup.HaveInSlot(plr->m_lookingForGroup.more))
-            continue;
+            // skip non auto-join or empty slots, or non compatible slots
+            if (!plr->m_lookingForGroup.more.canAutoJoin() || !_player->m_lookingForGroup.HaveInSlot(plr->m_lookingForGroup.more))
+                continue;
 
-        // attempt create group, or skip
-        if (!plr->GetGroup())
-        {
-            Group* group = new Group;
-            if (!group->Create(plr->GetGUID(), plr->GetName()))
+            // attempt create group, or skip
+            if (!plr->GetGroup())
             {
-                delete group;
-                continue;
-            }
+                Group* group = new Group;
+                if (!group->Create(plr->GetGUID(), plr->GetName()))
+                {
+                    delete group;
+                    continue;
+                }
 
-            sObjectMgr.AddGroup(group);
-        }
+                sObjectMgr.AddGroup(group);
+            }
 
-        // stop at success join
-        if (plr->GetGroup()->AddMember(_player->GetGUID(), _player->GetName()))
-        {
-            if (sWorld.getConfig(CONFIG_RESTRICTED_LFG_CHANNEL) && _player->GetSession()->GetSecurity() == SEC_PLAYER)
-                _player->LeaveLFGChannel();
-            break;
-        }
-        // full
-        else
-        {
-            if (sWorld.getConfig(CONFIG_RESTRICTED_LFG_CHANNEL) && plr->GetSession()->GetSecurity() == SEC_PLAYER)
-                plr->LeaveLFGChannel();
+            // stop at success join
+            if (plr->GetGroup()->AddMember(_player->GetGUID(), _player->GetName()))
+            {
+                if (sWorld.getConfig(CONFIG_RESTRICTED_LFG_CHANNEL) && _player->GetSession()->GetSecurity() == SEC_PLAYER)
+                    _player->LeaveLFGChannel();
+                return;
+            }
+            // full
+            else
+            {
+                if (sWorld.getConfig(CONFIG_RESTRICTED_LFG_CHANNEL) && plr->GetSession()->GetSecurity() == SEC_PLAYER)
+                    plr->LeaveLFGChannel();
+            }
         }
     }
 }
@@ -89,59 +92,62 @@ static void AttemptAddMore(Player* _player)
     if (!_player->m_lookingForGroup.more.canAutoJoin())
         return;
 
-    ObjectAccessor::Guard guard(*HashMapHolder<Player>::GetLock());
-    HashMapHolder<Player>::MapType const& players = ObjectAccessor::Instance().GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator iter = players.begin(); iter != players.end(); ++iter)
+    for (uint32 shard = 0; shard < HashMapHolder<Player>::GetShardCount(); ++shard)
     {
-        Player* plr = iter->second;
+        HashMapHolder<Player>::ReadGuard guard(*HashMapHolder<Player>::GetLock(shard));
+        HashMapHolder<Player>::MapType const& players = ObjectAccessor::Instance().GetPlayers(shard);
+        for (HashMapHolder<Player>::MapType::const_iterator iter = players.begin(); iter != players.end(); ++iter)
+        {
+            Player* plr = iter->second;
 
-        // skip enemies and self
-        if (!plr || plr == _player || plr->GetTeam() != _player->GetTeam())
-            continue;
+            // skip enemies and self
+            if (!plr || plr == _player || plr->GetTeam() != _player->GetTeam())
+                continue;
 
-        if (!plr->IsInWorld())
-            continue;
+            if (!plr->IsInWorld())
+                continue;
 
-        // skip not auto join or in group
-        if (!plr->GetSession()->LookingForGroup_auto_join || plr->GetGroup())
-            continue;
+            // skip not auto join or in group
+            if (!plr->GetSession()->LookingForGroup_auto_join || plr->GetGroup())
+                continue;
 
-        if (!plr->m_lookingForGroup.HaveInSlot(_player->m_lookingForGroup.more))
-            continue;
+            if (!plr->m_lookingForGroup.HaveInSlot(_player->m_lookingForGroup.more))
+                continue;
 
-        // attempt create group if need, or stop attempts
-        if (!_player->GetGroup())
-        {
-            Group* group = new Group;
-            if (!group->Create(_player->GetGUID(), _player->GetName()))
+            // attempt create group if need, or stop attempts
+            if (!_player->GetGroup())
             {
-                delete group;
-                return;                                     // can't create group (??)
-            }
+                Group* group = new Group;
+                if (!group->Create(_player->GetGUID(), _player->GetName()))
+                {
+                    delete group;
+                    return;                                     // can't create group (??)
+                }
 
-            sObjectMgr.AddGroup(group);
-        }
+                sObjectMgr.AddGroup(group);
+            }
 
-        // stop at join fail (full)
-        if (!_player->GetGroup()->AddMember(plr->GetGUID(), plr->GetName()))
-        {
-            if (sWorld.getConfig(CONFIG_RESTRICTED_LFG_CHANNEL) && _player->GetSession()->GetSecurity() == SEC_PLAYER)
-                _player->LeaveLFGChannel();
+            // stop at join fail (full)
+            if (!_player->GetGroup()->AddMember(plr->GetGUID(), plr->GetName()))
+            {
+                if (sWorld.getConfig(CONFIG_RESTRICTED_LFG_CHANNEL) && _player->GetSession()->GetSecurity() == SEC_PLAYER)
+                    _player->LeaveLFGChannel();
 
-            break;
-        }
+                return;
+            }
 
-        // joined
-        if (sWorld.getConfig(CONFIG_RESTRICTED_LFG_CHANNEL) && plr->GetSession()->GetSecurity() == SEC_PLAYER)
-            plr->LeaveLFGChannel();
+            // joined
+            if (sWorld.getConfig(CONFIG_RESTRICTED_LFG_CHANNEL) && plr->GetSession()->GetSecurity() == SEC_PLAYER)
+                plr->LeaveLFGChannel();
 
-        // and group full
-        if (_player->GetGroup()->IsFull())
-        {
-            if (sWorld.getConfig(CONFIG_RESTRICTED_LFG_CHANNEL) && _player->GetSession()->GetSecurity() == SEC_PLAYER)
-                _player->LeaveLFGChannel();
+            // and group full
+            if (_player->GetGroup()->IsFull())
+            {
+                if (sWorld.getConfig(CONFIG_RESTRICTED_LFG_CHANNEL) && _player->GetSession()->GetSecurity() == SEC_PLAYER)
+                    _player->LeaveLFGChannel();
 
-            break;
+                return;
+            }
         }
     }
 }
@@ -258,48 +264,51 @@ void WorldSession::SendLfgResult(uint32 type, uint32 entry, uint8 lfg_type)
     data << uint32(0);                                      // count, placeholder
     data << uint32(0);                                      // count again, strange, placeholder
 
-    //@todo Guard Player map
-    HashMapHolder<Player>::MapType const& players = ObjectAccessor::Instance().GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator iter = players.begin(); iter != players.end(); ++iter)
+    for (uint32 shard = 0; shard < HashMapHolder<Player>::GetShardCount(); ++shard)
     {
-        Player* plr = iter->second;
+        HashMapHolder<Player>::ReadGuard guard(*HashMapHolder<Player>::GetLock(shard));
+        HashMapHolder<Player>::MapType const& players = ObjectAccessor::Instance().GetPlayers(shard);
+        for (HashMapHolder<Player>::MapType::const_iterator iter = players.begin(); iter != players.end(); ++iter)
+        {
+            Player* plr = iter->second;
 
-        if (!plr || plr->GetTeam() != _player->GetTeam())
-            continue;
+            if (!plr || plr->GetTeam() != _player->GetTeam())
+                continue;
 
-        if (!plr->IsInWorld())
-            continue;
+            if (!plr->IsInWorld())
+                continue;
 
-        if (!plr->m_lookingForGroup.HaveInSlot(entry, type))
-            continue;
+            if (!plr->m_lookingForGroup.HaveInSlot(entry, type))
+                continue;
 
-        ++number;
+            ++number;
 
-        data << plr->GetPackGUID();                         // packed guid
-        data << plr->getLevel();                            // level
-        data << plr->GetZoneId();                           // current zone
-        data << lfg_type;                                   // 0x00 - LFG, 0x01 - LFM
+            data << plr->GetPackGUID();                         // packed guid
+            data << plr->getLevel();                            // level
+            data << plr->GetZoneId();                           // current zone
+            data << lfg_type;                                   // 0x00 - LFG, 0x01 - LFM
 
-        for (uint8 j = 0; j < MAX_LOOKING_FOR_GROUP_SLOT; ++j)
-            data << uint32(plr->m_lookingForGroup.slots[j].entry | (plr->m_lookingForGroup.slots[j].type << 24));
-        data << plr->m_lookingForGroup.comment;
+            for (uint8 j = 0; j < MAX_LOOKING_FOR_GROUP_SLOT; ++j)
+                data << uint32(plr->m_lookingForGroup.slots[j].entry | (plr->m_lookingForGroup.slots[j].type << 24));
+            data << plr->m_lookingForGroup.comment;
 
-        Group* group = plr->GetGroup();
-        if (group)
-        {
-            data << group->GetMembersCount() - 1;           // count of group members without group leader
-            for (GroupReference* itr = group->GetFirstMember(); itr != NULL; itr = itr->next())
+            Group* group = plr->GetGroup();
+            if (group)
             {
-                Player* member = itr->GetSource();
-                if (member && member->GetGUID() != plr->GetGUID())
+                data << group->GetMembersCount() - 1;           // count of group members without group leader
+                for (GroupReference* itr = group->GetFirstMember(); itr != NULL; itr = itr->next())
                 {
-                    data << member->GetPackGUID();          // packed guid
-                    data << member->getLevel();             // player level
+                    Player* member = itr->GetSource();
+                    if (member && member->GetGUID() != plr->GetGUID())
+                    {
+                        data << member->GetPackGUID();          // packed guid
+                        data << member->getLevel();             // player level
+                    }
                 }
             }
+            else
+                data << uint32(0x00);
         }
-        else
-            data << uint32(0x00);
     }
 
     // fill count placeholders
@@ -162,21 +162,24 @@ bool ChatHandler::HandleGMListIngameCommand(const char* /*args*/)
 {
     bool first = true;
 
-    ObjectAccessor::Guard guard(*HashMapHolder<Player>::GetLock());
-    HashMapHolder<Player>::MapType& m = ObjectAccessor::Instance().GetPlayers();
-    for (HashMapHolder<Player>::MapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    for (uint32 shard = 0; shard < HashMapHolder<Player>::GetShardCount(); ++shard)
     {
-        if (itr->second->GetSession()->GetSecurity() &&
-            (itr->second->IsGameMaster() || sWorld.getConfig(CONFIG_GM_IN_GM_LIST)) &&
-            (!m_session || itr->second->IsVisibleGloballyFor(m_session->GetPlayer())))
+        HashMapHolder<Player>::ReadGuard guard(*HashMapHolder<Player>::GetLock(shard));
+        HashMapHolder<Player>::MapType& m = ObjectAccessor::Instance().GetPlayers(shard);
+        for (HashMapHolder<Player>::MapType::iterator itr = m.begin(); itr != m.end(); ++itr)
         {
-            if (first)
+            if (itr->second->GetSession()->GetSecurity() &&
+                (itr->second->IsGameMaster() || sWorld.getConfig(CONFIG_GM_IN_GM_LIST)) &&
+                (!m_session || itr->second->IsVisibleGloballyFor(m_session->GetPlayer())))
             {
-                SendSysMessage(LANG_GMS_ON_SRV);
-                first = false;
-            }
+                if (first)
+                {
+                    SendSysMessage(LANG_GMS_ON_SRV);
+                    first = false;
+                }
 
-            SendSysMessage(itr->second->GetName());
+                SendSysMessage(itr->second->GetName());
+            }
         }
     }
 
@@ -5465,10 +5465,13 @@ bool ChatHandler::HandleResetAllCommand(const char* args)
 
     CharacterDatabase.PExecute("UPDATE characters SET at_login = at_login | '%u' WHERE (at_login & '%u') = '0'", atLogin, atLogin);
 
-    ObjectAccessor::Guard guard(*HashMapHolder<Player>::GetLock());
-    HashMapHolder<Player>::MapType const& plist = ObjectAccessor::Instance().GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator itr = plist.begin(); itr != plist.end(); ++itr)
-        itr->second->SetAtLoginFlag(atLogin);
+    for (uint32 shard = 0; shard < HashMapHolder<Player>::GetShardCount(); ++shard)
+    {
+        HashMapHolder<Player>::ReadGuard guard(*HashMapHolder<Player>::GetLock(shard));
+        HashMapHolder<Player>::MapType const& plist = ObjectAccessor::Instance().GetPlayers(shard);
+        for (HashMapHolder<Player>::MapType::const_iterator itr = plist.begin(); itr != plist.end(); ++itr)
+            itr->second->SetAtLoginFlag(atLogin);
+    }
 
     return true;
 }
@@ -7051,6 +7054,75 @@ bool ChatHandler::HandleInstanceStatsCommand(const char* /*args*/)
     return true;
 }
 
+struct MapUpdateCostGreater
+{
+    bool operator()(Map const* left, Map const* right) const
+    {
+        return left->GetUpdateCost() > right->GetUpdateCost();
+    }
+};
+
+// List the maps with the most expensive updates
+bool ChatHandler::HandleServerMapsCommand(const char* args)
+{
+    uint32 count = *args ? atoi(args) : 10;
+
+    std::vector<Map*> maps;
+    MapManager::Instance().GetAllMaps(maps);
+    std::sort(maps.begin(), maps.end(), MapUpdateCostGreater());
+
+    PSendSysMessage("maps loaded: %u", uint32(maps.size()));
+    for (uint32 i = 0; i < count && i < maps.size(); ++i)
+    {
+        Map const* map = maps[i];
+        PSendSysMessage("map %u instance %u (%s): %u players, update %.2f ms, queued %.2f ms",
+                        map->GetId(), map->GetInstanceId(), map->GetMapName(), map->GetPlayers().getSize(),
+                        map->GetUpdateCost() / 1000.0f, map->GetUpdateWait() / 1000.0f);
+    }
+
+    return true;
+}
+
+// Show the use of the world object guid ranges
+bool ChatHandler::HandleServerGuidsCommand(const char* /*args*/)
+{
+    for (uint32 i = 0; i < MAX_GUID_ALLOCATORS; ++i)
+    {
+        GuidAllocator* allocator = sObjectMgr.GetGuidAllocator(GuidAllocatorSlot(i));
+        uint32 used = allocator->GetNext() - 1;
+        PSendSysMessage("%s: %u of %u guids used (%.2f%%), %u recycled, " UI64FMTD " reused",
+                        allocator->GetName(), used, allocator->GetMax(), used * 100.0f / allocator->GetMax(),
+                        allocator->GetRecycledCount(), allocator->GetReusedCount());
+    }
+
+    return true;
+}
+
+// Show how long groups waited in the battleground and arena queues for their first invite
+bool ChatHandler::HandleServerBgQueuesCommand(const char* /*args*/)
+{
+    bool found = false;
+    for (uint32 bgQueueTypeId = 0; bgQueueTypeId < MAX_BATTLEGROUND_QUEUE_TYPES; ++bgQueueTypeId)
+    {
+        BattlegroundQueue const& queue = sBattlegroundMgr.m_BattlegroundQueues[bgQueueTypeId];
+        for (uint32 queue_id = 0; queue_id < MAX_BATTLEGROUND_QUEUES; ++queue_id)
+        {
+            if (!queue.GetWaitTimeCount(queue_id))
+                continue;
+
+            PSendSysMessage("queue type %u, level %u+: %u invites, average wait %u s, max wait %u s",
+                            bgQueueTypeId, (queue_id + 1) * 10, queue.GetWaitTimeCount(queue_id),
+                            queue.GetAverageWaitTime(queue_id) / IN_MILLISECONDS, queue.GetMaxWaitTime(queue_id) / IN_MILLISECONDS);
+            found = true;
+        }
+    }
+
+    if (!found)
+        SendSysMessage("No group has been invited from a battleground queue yet.");
+
+    return true;
+}
+
 bool ChatHandler::HandleInstanceSaveDataCommand(const char* /*args*/)
 {
     Player* pl = m_session->GetPlayer();
@@ -30,6 +30,8 @@
 #include "ObjectMgr.h"
 #include "DynamicTree.h"
 #include "MoveMap.h"
+#include "PoolMgr.h"
+#include "TemporarySummon.h"
 
 #define DEFAULT_GRID_EXPIRY     300
 #define MAX_GRID_LOAD_TIME      50
@@ -52,6 +54,9 @@ Map::~Map()
 
     if (!m_scriptSchedule.empty())
         sWorld.DecreaseScheduledScriptCount(m_scriptSchedule.size());
+
+    for (std::vector<MapRegion*>::iterator itr = m_regions.begin(); itr != m_regions.end(); ++itr)
+        delete *itr;
 }
 
 bool Map::ExistMap(uint32 mapid, int gx, int gy)
@@ -203,8 +208,8 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode, Map* _par
     i_mapEntry (sMapStore.LookupEntry(id)), i_spawnMode(SpawnMode), i_InstanceId(InstanceId),
     m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
     m_VisibilityNotifyPeriod(DEFAULT_VISIBILITY_NOTIFY_PERIOD),
-    m_activeNonPlayersIter(m_activeNonPlayers.end()), i_gridExpiry(expiry),
-    i_scriptLock(false)
+    m_activeNonPlayersIter(m_activeNonPlayers.end()), m_updateCost(0), m_updateWait(0), i_gridExpiry(expiry),
+    m_regionUpdate(false), i_scriptLock(false)
 {
     m_parentMap = (_parent ? _parent : this);
 
@@ -423,6 +428,17 @@ bool Map::AddPlayerToMap(Player* player)
 template<class T>
 bool Map::AddToMap(T *obj)
 {
+    // may load grids and touches cells next to the object
+    RegionGuard guard(*this);
+
+    // the cells of another region may be updated by another thread right now
+    if (m_regionUpdate && !obj->IsInWorld() && !IsInUpdatingRegion(obj))
+    {
+        if (std::find(m_regionDeferredAdds.begin(), m_regionDeferredAdds.end(), obj) == m_regionDeferredAdds.end())
+            m_regionDeferredAdds.push_back(obj);
+        return true;
+    }
+
     if (obj->IsInWorld()) // need some clean up later
     {
         obj->UpdateObjectVisibility(true);
@@ -494,6 +510,9 @@ void Map::Update(const uint32& t_diff)
 {
     m_dyn_tree.update(t_diff);
 
+    // unit events must run before the units update their spells
+    m_eventWheel.Update(t_diff);
+
     // update active cells around players and active objects
     resetMarkedCells();
 
@@ -503,73 +522,441 @@ void Map::Update(const uint32& t_diff)
     // for pets
     TypeContainerVisitor<Oregon::ObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
 
-    // the player iterator is stored in the map object
-    // to make sure calls to Map::RemoveFromMap don't invalidate it
+    if (CanUpdateRegions())
+        UpdateRegions(t_diff, grid_object_update, world_object_update);
+    else
+    {
+        // the player iterator is stored in the map object
+        // to make sure calls to Map::RemoveFromMap don't invalidate it
+        for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+        {
+            Player* player = m_mapRefIter->GetSource();
+
+            if (!player || !player->IsInWorld())
+                continue;
+
+            UpdatePlayer(player, t_diff, grid_object_update, world_object_update);
+        }
+
+        // non-player active objects, increasing iterator in the loop in case of object removal
+        for (m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end();)
+        {
+            WorldObject* obj = *m_activeNonPlayersIter;
+            ++m_activeNonPlayersIter;
+
+            if (!obj || !obj->IsInWorld())
+                continue;
+
+            VisitNearbyCellsOf(obj, grid_object_update, world_object_update);
+        }
+    }
+
+    // Process necessary scripts
+    if (!m_scriptSchedule.empty())
+    {
+        i_scriptLock = true;
+        ScriptsProcess();
+        i_scriptLock = false;
+    }
+
+    MoveAllCreaturesInMoveList();
+
+    if (!m_mapRefManager.isEmpty() || !m_activeNonPlayers.empty())
+        ProcessRelocationNotifies(t_diff);
+
+    // creature moves queued during this update, after any visibility changes
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+        if (Player* player = m_mapRefIter->GetSource())
+            player->SendCompressedMoves();
+}
+
+void Map::UpdatePlayer(Player* player, uint32 diff, TypeContainerVisitor<Oregon::ObjectUpdater, GridTypeMapContainer> &gridVisitor, TypeContainerVisitor<Oregon::ObjectUpdater, WorldTypeMapContainer> &worldVisitor)
+{
+    player->Update(diff);
+
+    VisitNearbyCellsOf(player, gridVisitor, worldVisitor);
+
+    // If player is using far sight, visit that object too
+    if (WorldObject* viewPoint = player->GetViewpoint())
     {
-        Player* player = m_mapRefIter->GetSource();
+        if (Creature* viewCreature = viewPoint->ToCreature())
+            VisitNearbyCellsOf(viewCreature, gridVisitor, worldVisitor);
+        else if (DynamicObject* viewObject = viewPoint->ToDynObject())
+            VisitNearbyCellsOf(viewObject, gridVisitor, worldVisitor);
+    }
 
+    // Handle updates for creatures in combat with player and are more than 60 yards away
+    if (player->IsInCombat())
+    {
+        std::vector<Creature*> updateList;
+        HostileReference* ref = player->getHostileRefManager().getFirst();
+
+        while (ref)
+        {
+            if (Unit* unit = ref->GetSource()->getOwner())
+                if (unit->ToCreature() && unit->GetMapId() == player->GetMapId() && !unit->IsWithinDistInMap(player, GetVisibilityRange(), false))
+                    updateList.push_back(unit->ToCreature());
+
+            ref = ref->next();
+        }
+
+        // Process deferred update list for player
+        for (Creature* c : updateList)
+            VisitNearbyCellsOf(c, gridVisitor, worldVisitor);
+    }
+}
+
+bool Map::CanUpdateRegions() const
+{
+    if (!sWorld.getConfig(CONFIG_MAPUPDATE_REGION_SIZE) || Instanceable())
+        return false;
+
+    if (m_mapRefManager.getSize() < sWorld.getConfig(CONFIG_MAPUPDATE_REGION_MIN_PLAYERS))
+        return false;
+
+    return MapManager::Instance().GetMapRegionUpdater()->activated();
+}
+
+uint32 Map::GetRegionSize() const
+{
+    // regions of a phase are one region apart. The gap must be wider than what
+    // both sides reach: the cells updated around their objects and the players
+    // seeing those cells, each rounded up to whole cells
+    float activation = std::max(GetVisibilityRange(), float(sWorld.getConfig(CONFIG_SIGHT_MONSTER)));
+    float reach = activation + GetVisibilityRange() + 2 * SIZE_OF_GRID_CELL;
+    uint32 minSize = uint32(ceil(2 * reach / SIZE_OF_GRIDS));
+
+    return std::max(sWorld.getConfig(CONFIG_MAPUPDATE_REGION_SIZE), minSize);
+}
+
+MapRegion* Map::GetUpdateRegion(std::map<uint32, MapRegion*>& regions, WorldObject* obj, uint32 size)
+{
+    GridCoord p = Oregon::ComputeGridCoord(obj->GetPositionX(), obj->GetPositionY());
+    uint32 x = p.x_coord / size, y = p.y_coord / size;
+    uint32 id = x * MAX_NUMBER_OF_GRIDS + y;
+
+    std::map<uint32, MapRegion*>::iterator itr = regions.find(id);
+    if (itr != regions.end())
+        return itr->second;
+
+    if (regions.size() == m_regions.size())
+        m_regions.push_back(new MapRegion());
+
+    MapRegion* region = m_regions[regions.size()];
+    region->map = this;
+    region->id = id;
+    region->phase = (x & 1) | ((y & 1) << 1);
+    regions[id] = region;
+    return region;
+}
+
+// region updated by the current thread, NULL outside of UpdateRegion
+static thread_local MapRegion* tUpdatingRegion = NULL;
+
+bool Map::IsInUpdatingRegion(WorldObject* obj) const
+{
+    return tUpdatingRegion && tUpdatingRegion->map == this && IsInRegion(obj, *tUpdatingRegion);
+}
+
+bool Map::DeferZoneUpdate(Player* player)
+{
+    RegionGuard guard(*this);
+
+    if (!m_regionUpdate)
+        return false;
+
+    if (std::find(m_regionDeferredZones.begin(), m_regionDeferredZones.end(), player) == m_regionDeferredZones.end())
+        m_regionDeferredZones.push_back(player);
+    return true;
+}
+
+bool Map::DeferTeleport(Player* player)
+{
+    RegionGuard guard(*this);
+
+    if (!m_regionUpdate)
+        return false;
+
+    if (std::find(m_regionDeferredTeleports.begin(), m_regionDeferredTeleports.end(), player) == m_regionDeferredTeleports.end())
+        m_regionDeferredTeleports.push_back(player);
+    return true;
+}
+
+bool Map::DeferGroupUpdate(Player* player)
+{
+    RegionGuard guard(*this);
+
+    if (!m_regionUpdate)
+        return false;
+
+    if (std::find(m_regionDeferredGroupUpdates.begin(), m_regionDeferredGroupUpdates.end(), player) == m_regionDeferredGroupUpdates.end())
+        m_regionDeferredGroupUpdates.push_back(player);
+    return true;
+}
+
+bool Map::DeferPoolUpdate(Creature* creature, uint32 poolId)
+{
+    RegionGuard guard(*this);
+
+    if (!m_regionUpdate)
+        return false;
+
+    m_regionDeferredCreaturePools.push_back(std::make_pair(poolId, creature->GetDBTableGUIDLow()));
+    return true;
+}
+
+bool Map::DeferPoolUpdate(GameObject* go, uint32 poolId)
+{
+    RegionGuard guard(*this);
+
+    if (!m_regionUpdate)
+        return false;
+
+    m_regionDeferredGameObjectPools.push_back(std::make_pair(poolId, go->GetDBTableGUIDLow()));
+    return true;
+}
+
+bool Map::DeferSummon(TempSummon* summon)
+{
+    RegionGuard guard(*this);
+
+    if (std::find(m_regionDeferredAdds.begin(), m_regionDeferredAdds.end(), summon) == m_regionDeferredAdds.end())
+        return false;
+
+    m_regionDeferredSummons.push_back(summon);
+    return true;
+}
+
+void Map::ProcessRegionDeferred()
+{
+    for (std::vector<WorldObject*>::iterator itr = m_regionDeferredAdds.begin(); itr != m_regionDeferredAdds.end(); ++itr)
+    {
+        WorldObject* obj = *itr;
+        switch (obj->GetTypeId())
+        {
+            case TYPEID_UNIT:
+                AddToMap(obj->ToCreature());
+                break;
+            case TYPEID_GAMEOBJECT:
+                AddToMap((GameObject*)obj);
+                break;
+            case TYPEID_DYNAMICOBJECT:
+                AddToMap((DynamicObject*)obj);
+                break;
+            case TYPEID_CORPSE:
+                AddToMap((Corpse*)obj);
+                break;
+            default:
+                break;
+        }
+    }
+    m_regionDeferredAdds.clear();
+
+    // only now in the world, their summoner and AI are told about them
+    for (std::vector<TempSummon*>::iterator itr = m_regionDeferredSummons.begin(); itr != m_regionDeferredSummons.end(); ++itr)
+        if ((*itr)->IsInWorld())
+            (*itr)->InitSummon();
+    m_regionDeferredSummons.clear();
+
+    for (DeferredPoolUpdates::iterator itr = m_regionDeferredCreaturePools.begin(); itr != m_regionDeferredCreaturePools.end(); ++itr)
+        sPoolMgr.UpdatePool<Creature>(itr->first, itr->second);
+    m_regionDeferredCreaturePools.clear();
+
+    for (DeferredPoolUpdates::iterator itr = m_regionDeferredGameObjectPools.begin(); itr != m_regionDeferredGameObjectPools.end(); ++itr)
+        sPoolMgr.UpdatePool<GameObject>(itr->first, itr->second);
+    m_regionDeferredGameObjectPools.clear();
+
+    for (std::vector<Player*>::iterator itr = m_regionDeferredZones.begin(); itr != m_regionDeferredZones.end(); ++itr)
+        if ((*itr)->IsInWorld() && (*itr)->GetMap() == this)
+            (*itr)->UpdateZone((*itr)->GetZoneId());
+    m_regionDeferredZones.clear();
+
+    for (std::vector<Player*>::iterator itr = m_regionDeferredGroupUpdates.begin(); itr != m_regionDeferredGroupUpdates.end(); ++itr)
+        if ((*itr)->IsInWorld() && (*itr)->GetMap() == this)
+            (*itr)->SendUpdateToOutOfRangeGroupMembers();
+    m_regionDeferredGroupUpdates.clear();
+
+    // last, a far teleport takes the player off this map
+    std::vector<Player*> teleports;
+    teleports.swap(m_regionDeferredTeleports);
+    for (std::vector<Player*>::iterator itr = teleports.begin(); itr != teleports.end(); ++itr)
+    {
+        Player* player = *itr;
+        if (!player->IsInWorld() || player->GetMap() != this)
+            continue;
+
+        // TeleportTo sets them again, a refused teleport must not leave them set
+        player->SetSemaphoreTeleportNear(false);
+        player->SetSemaphoreTeleportFar(false);
+        player->TeleportTo(player->GetTeleportDest(), player->GetTeleportOptions());
+    }
+}
+
+bool Map::IsInRegion(WorldObject* obj, MapRegion const& region) const
+{
+    if (!obj->IsPositionValid())
+        return false;
+
+    uint32 size = GetRegionSize();
+    GridCoord p = Oregon::ComputeGridCoord(obj->GetPositionX(), obj->GetPositionY());
+    return (p.x_coord / size) * MAX_NUMBER_OF_GRIDS + p.y_coord / size == region.id;
+}
+
+void Map::UpdateRegions(uint32 diff, TypeContainerVisitor<Oregon::ObjectUpdater, GridTypeMapContainer> &gridVisitor, TypeContainerVisitor<Oregon::ObjectUpdater, WorldTypeMapContainer> &worldVisitor)
+{
+    uint32 size = GetRegionSize();
+    std::map<uint32, MapRegion*> regions;
+    std::vector<Player*> unplaced;
+
+    for (MapRefManager::iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
+    {
+        Player* player = itr->GetSource();
         if (!player || !player->IsInWorld())
             continue;
 
-        player->Update(t_diff);
+        if (player->IsPositionValid())
+            GetUpdateRegion(regions, player, size)->players.push_back(player);
+        else
+            unplaced.push_back(player);
+    }
+
+    for (ActiveNonPlayers::iterator itr = m_activeNonPlayers.begin(); itr != m_activeNonPlayers.end(); ++itr)
+        if ((*itr)->IsInWorld() && (*itr)->IsPositionValid())
+            GetUpdateRegion(regions, *itr, size)->activeObjects.push_back(*itr);
+
+    std::vector<MapRegion*> phases[MAX_MAP_REGION_PHASES];
+    for (std::map<uint32, MapRegion*>::iterator itr = regions.begin(); itr != regions.end(); ++itr)
+        phases[itr->second->phase].push_back(itr->second);
+
+    // objects may now only change map wide state under m_regionLock, scripts
+    // started meanwhile wait for ScriptsProcess
+    m_regionUpdate = true;
+    i_scriptLock = true;
+    m_eventWheel.SetLock(&m_regionLock);
+
+    for (uint32 phase = 0; phase < MAX_MAP_REGION_PHASES; ++phase)
+    {
+        if (phases[phase].empty())
+            continue;
+
+        MapManager::Instance().GetMapRegionUpdater()->update(*this, phases[phase], diff);
+
+        // later phases skip the cells updated so far, marked_cells is only read during a phase
+        for (std::vector<MapRegion*>::iterator itr = phases[phase].begin(); itr != phases[phase].end(); ++itr)
+            for (std::vector<uint32>::iterator cell = (*itr)->cells.begin(); cell != (*itr)->cells.end(); ++cell)
+                markCell(*cell);
+    }
+
+    m_eventWheel.SetLock(NULL);
+    i_scriptLock = false;
+    m_regionUpdate = false;
+
+    ProcessRegionDeferred();
+
+    // merge phase, whatever reaches out of its region is updated here on the map's own thread
+    for (std::vector<Player*>::iterator itr = unplaced.begin(); itr != unplaced.end(); ++itr)
+        if ((*itr)->IsInWorld())
+            UpdatePlayer(*itr, diff, gridVisitor, worldVisitor);
+
+    for (std::map<uint32, MapRegion*>::iterator itr = regions.begin(); itr != regions.end(); ++itr)
+    {
+        MapRegion* region = itr->second;
+
+        for (std::vector<WorldObject*>::iterator obj = region->deferred.begin(); obj != region->deferred.end(); ++obj)
+            if ((*obj)->IsInWorld())
+                VisitNearbyCellsOf(*obj, gridVisitor, worldVisitor);
+
+        for (std::vector<uint32>::iterator cell = region->cells.begin(); cell != region->cells.end(); ++cell)
+            region->marks.reset(*cell);
+
+        region->players.clear();
+        region->activeObjects.clear();
+        region->deferred.clear();
+        region->cells.clear();
+    }
+}
+
+void Map::UpdateRegion(MapRegion& region, uint32 diff)
+{
+    tUpdatingRegion = &region;
+
+    Oregon::ObjectUpdater updater(diff);
+    TypeContainerVisitor<Oregon::ObjectUpdater, GridTypeMapContainer  > grid_object_update(updater);
+    TypeContainerVisitor<Oregon::ObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
+
+    for (std::vector<Player*>::iterator itr = region.players.begin(); itr != region.players.end(); ++itr)
+    {
+        Player* player = *itr;
+        if (!player->IsInWorld())
+            continue;
+
+        player->Update(diff);
 
-        VisitNearbyCellsOf(player, grid_object_update, world_object_update);
+        VisitNearbyCellsOf(player, grid_object_update, world_object_update, region);
 
-        // If player is using far sight, visit that object too
+        // far sight may look into another region
         if (WorldObject* viewPoint = player->GetViewpoint())
         {
-            if (Creature* viewCreature = viewPoint->ToCreature())
-                VisitNearbyCellsOf(viewCreature, grid_object_update, world_object_update);
-            else if (DynamicObject* viewObject = viewPoint->ToDynObject())
-                VisitNearbyCellsOf(viewObject, grid_object_update, world_object_update);
+            if (viewPoint->ToCreature() || viewPoint->ToDynObject())
+            {
+                if (IsInRegion(viewPoint, region))
+                    VisitNearbyCellsOf(viewPoint, grid_object_update, world_object_update, region);
+                else
+                    region.deferred.push_back(viewPoint);
+            }
         }
 
-        // Handle updates for creatures in combat with player and are more than 60 yards away
+        // creatures in combat with the player out of visibility range are left to the merge phase
         if (player->IsInCombat())
         {
-            std::vector<Creature*> updateList;
-            HostileReference* ref = player->getHostileRefManager().getFirst();
-
-            while (ref)
-            {
+            for (HostileReference* ref = player->getHostileRefManager().getFirst(); ref; ref = ref->next())
                 if (Unit* unit = ref->GetSource()->getOwner())
                     if (unit->ToCreature() && unit->GetMapId() == player->GetMapId() && !unit->IsWithinDistInMap(player, GetVisibilityRange(), false))
-                        updateList.push_back(unit->ToCreature());
-
-                ref = ref->next();
-            }
-
-            // Process deferred update list for player
-            for (Creature* c : updateList)
-                VisitNearbyCellsOf(c, grid_object_update, world_object_update);
+                        region.deferred.push_back(unit);
         }
     }
 
-    // non-player active objects, increasing iterator in the loop in case of object removal
-    for (m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end();)
+    for (std::vector<WorldObject*>::iterator itr = region.activeObjects.begin(); itr != region.activeObjects.end(); ++itr)
     {
-        WorldObject* obj = *m_activeNonPlayersIter;
-        ++m_activeNonPlayersIter;
-
-        if (!obj || !obj->IsInWorld())
-            continue;
+        // an earlier update of the region may have removed it
+        {
+            RegionGuard guard(*this);
+            if (m_activeNonPlayers.find(*itr) == m_activeNonPlayers.end())
+                continue;
+        }
 
-        VisitNearbyCellsOf(obj, grid_object_update, world_object_update);
+        if ((*itr)->IsInWorld())
+            VisitNearbyCellsOf(*itr, grid_object_update, world_object_update, region);
     }
 
-    // Process necessary scripts
-    if (!m_scriptSchedule.empty())
-    {
-        i_scriptLock = true;
-        ScriptsProcess();
-        i_scriptLock = false;
-    }
+    tUpdatingRegion = NULL;
+}
 
-    MoveAllCreaturesInMoveList();
+void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Oregon::ObjectUpdater, GridTypeMapContainer> &gridVisitor, TypeContainerVisitor<Oregon::ObjectUpdater, WorldTypeMapContainer> &worldVisitor, MapRegion& region)
+{
+    if (!obj->IsPositionValid())
+        return;
 
-    if (!m_mapRefManager.isEmpty() || !m_activeNonPlayers.empty())
-        ProcessRelocationNotifies(t_diff);
+    CellArea area = Cell::CalculateCellArea(obj->GetPositionX(), obj->GetPositionY(), obj->GetGridActivationRange());
+
+    for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
+    {
+        for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
+        {
+            // cells of earlier phases are marked in the map, this phase's in the region
+            uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
+            if (isCellMarked(cell_id) || region.marks.test(cell_id))
+                continue;
+
+            region.marks.set(cell_id);
+            region.cells.push_back(cell_id);
+            CellCoord pair(x, y);
+            Cell cell(pair);
+            cell.SetNoCreate();
+            Visit(cell, gridVisitor);
+            Visit(cell, worldVisitor);
+        }
+    }
 }
 
 struct ResetNotifier
@@ -671,6 +1058,7 @@ void Map::ProcessRelocationNotifies(const uint32& diff)
 
 void Map::RemovePlayerFromMap(Player* player, bool remove)
 {
+    player->ClearCompressedMoves();
     player->RemoveFromWorld();
     SendRemoveTransports(player);
 
@@ -687,6 +1075,8 @@ void Map::RemovePlayerFromMap(Player* player, bool remove)
 template<class T>
 void Map::RemoveFromMap(T *obj, bool remove)
 {
+    RegionGuard guard(*this);
+
     obj->RemoveFromWorld();
     if (obj->isActiveObject())
         RemoveFromActive(obj);
@@ -764,6 +1154,7 @@ void Map::AddCreatureToMoveList(Creature* c, float x, float y, float z, float an
     if (!c)
         return;
 
+    RegionGuard guard(*this);
     i_creaturesToMove[c] = CreatureMover(x, y, z, ang);
 }
 
@@ -1211,26 +1602,8 @@ uint16 GridMap::getArea(float x, float y)
     return m_area_map[lx * 16 + ly];
 }
 
-float  GridMap::getHeightFromFlat(float /*x*/, float /*y*/) const
-{
-    return m_gridHeight;
-}
-
-float  GridMap::getHeightFromFloat(float x, float y) const
+namespace
 {
-    if (!m_V8 || !m_V9)
-        return m_gridHeight;
-
-    x = MAP_RESOLUTION * (CENTER_GRID_ID - x/SIZE_OF_GRIDS);
-    y = MAP_RESOLUTION * (CENTER_GRID_ID - y/SIZE_OF_GRIDS);
-
-    int x_int = (int)x;
-    int y_int = (int)y;
-    x -= x_int;
-    y -= y_int;
-    x_int &= (MAP_RESOLUTION - 1);
-    y_int &= (MAP_RESOLUTION - 1);
-
     // Height stored as: h5 - its v8 grid, h1-h4 - its v9 grid
     // +--------------> X
     // | h1-------h2     Coordinates is:
@@ -1245,124 +1618,61 @@ float  GridMap::getHeightFromFloat(float x, float y) const
     // 1 - detect triangle
     // 2 - solve linear equation from triangle points
     // Calculate coefficients for solve h = a*x + b*y + c
-
-    float a, b, c;
-    // Select triangle:
-    if (x + y < 1)
-    {
-        if (x > y)
-        {
-            // 1 triangle (h1, h2, h5 points)
-            float h1 = m_V9[(x_int) * 129 + y_int];
-            float h2 = m_V9[(x_int + 1) * 129 + y_int];
-            float h5 = 2 * m_V8[x_int * 128 + y_int];
-            a = h2 - h1;
-            b = h5 - h1 - h2;
-            c = h1;
-        }
-        else
-        {
-            // 2 triangle (h1, h3, h5 points)
-            float h1 = m_V9[x_int * 129 + y_int  ];
-            float h3 = m_V9[x_int * 129 + y_int + 1];
-            float h5 = 2 * m_V8[x_int * 128 + y_int];
-            a = h5 - h1 - h3;
-            b = h3 - h1;
-            c = h1;
-        }
-    }
-    else
+    //
+    // All corners are loaded and the triangle is selected without branches,
+    // the x/y of a batch fall in random triangles. T is the stored height
+    // type, H the type heights are combined in (int32 for packed heights).
+    template<class T, class H>
+    inline float GetTriangleHeight(T const* V9, T const* V8, float x, float y)
     {
-        if (x > y)
-        {
-            // 3 triangle (h2, h4, h5 points)
-            float h2 = m_V9[(x_int + 1) * 129 + y_int  ];
-            float h4 = m_V9[(x_int + 1) * 129 + y_int + 1];
-            float h5 = 2 * m_V8[x_int * 128 + y_int];
-            a = h2 + h4 - h5;
-            b = h4 - h2;
-            c = h5 - h4;
-        }
-        else
-        {
-            // 4 triangle (h3, h4, h5 points)
-            float h3 = m_V9[(x_int) * 129 + y_int + 1];
-            float h4 = m_V9[(x_int + 1) * 129 + y_int + 1];
-            float h5 = 2 * m_V8[x_int * 128 + y_int];
-            a = h4 - h3;
-            b = h3 + h4 - h5;
-            c = h5 - h4;
-        }
+        x = MAP_RESOLUTION * (CENTER_GRID_ID - x/SIZE_OF_GRIDS);
+        y = MAP_RESOLUTION * (CENTER_GRID_ID - y/SIZE_OF_GRIDS);
+
+        int x_int = (int)x;
+        int y_int = (int)y;
+        x -= x_int;
+        y -= y_int;
+        x_int &= (MAP_RESOLUTION - 1);
+        y_int &= (MAP_RESOLUTION - 1);
+
+        T const* V9_h1_ptr = &V9[x_int * 128 + x_int + y_int];
+        H h1 = V9_h1_ptr[  0];
+        H h2 = V9_h1_ptr[129];
+        H h3 = V9_h1_ptr[  1];
+        H h4 = V9_h1_ptr[130];
+        H h5 = 2 * V8[x_int * 128 + y_int];
+
+        bool lower = x + y < 1;                             // triangle 1 or 2
+        bool right = x > y;                                 // triangle 1 or 3
+
+        H a = lower ? (right ? h2 - h1 : h5 - h1 - h3) : (right ? h2 + h4 - h5 : h4 - h3);
+        H b = lower ? (right ? h5 - h1 - h2 : h3 - h1) : (right ? h4 - h2 : h3 + h4 - h5);
+        H c = lower ? h1 : h5 - h4;
+
+        // Calculate height
+        return (a * x) + (b * y) + c;
     }
-    // Calculate height
-    return a * x + b * y + c;
 }
 
-float  GridMap::getHeightFromUint8(float x, float y) const
+float  GridMap::getHeightFromFlat(float /*x*/, float /*y*/) const
 {
-    if (!m_uint8_V8 || !m_uint8_V9)
+    return m_gridHeight;
+}
+
+float  GridMap::getHeightFromFloat(float x, float y) const
+{
+    if (!m_V8 || !m_V9)
         return m_gridHeight;
 
-    x = MAP_RESOLUTION * (CENTER_GRID_ID - x/SIZE_OF_GRIDS);
-    y = MAP_RESOLUTION * (CENTER_GRID_ID - y/SIZE_OF_GRIDS);
+    return GetTriangleHeight<float, float>(m_V9, m_V8, x, y);
+}
 
-    int x_int = (int)x;
-    int y_int = (int)y;
-    x -= x_int;
-    y -= y_int;
-    x_int &= (MAP_RESOLUTION - 1);
-    y_int &= (MAP_RESOLUTION - 1);
+float  GridMap::getHeightFromUint8(float x, float y) const
+{
+    if (!m_uint8_V8 || !m_uint8_V9)
+        return m_gridHeight;
 
-    int32 a, b, c;
-    uint8* V9_h1_ptr = &m_uint8_V9[x_int * 128 + x_int + y_int];
-    if (x + y < 1)
-    {
-        if (x > y)
-        {
-            // 1 triangle (h1, h2, h5 points)
-            int32 h1 = V9_h1_ptr[  0];
-            int32 h2 = V9_h1_ptr[129];
-            int32 h5 = 2 * m_uint8_V8[x_int * 128 + y_int];
-            a = h2 - h1;
-            b = h5 - h1 - h2;
-            c = h1;
-        }
-        else
-        {
-            // 2 triangle (h1, h3, h5 points)
-            int32 h1 = V9_h1_ptr[0];
-            int32 h3 = V9_h1_ptr[1];
-            int32 h5 = 2 * m_uint8_V8[x_int * 128 + y_int];
-            a = h5 - h1 - h3;
-            b = h3 - h1;
-            c = h1;
-        }
-    }
-    else
-    {
-        if (x > y)
-        {
-            // 3 triangle (h2, h4, h5 points)
-            int32 h2 = V9_h1_ptr[129];
-            int32 h4 = V9_h1_ptr[130];
-            int32 h5 = 2 * m_uint8_V8[x_int * 128 + y_int];
-            a = h2 + h4 - h5;
-            b = h4 - h2;
-            c = h5 - h4;
-        }
-        else
-        {
-            // 4 triangle (h3, h4, h5 points)
-            int32 h3 = V9_h1_ptr[  1];
-            int32 h4 = V9_h1_ptr[130];
-            int32 h5 = 2 * m_uint8_V8[x_int * 128 + y_int];
-            a = h4 - h3;
-            b = h3 + h4 - h5;
-            c = h5 - h4;
-        }
-    }
-    // Calculate height
-    return (float)((a * x) + (b * y) + c) * m_gridIntHeightMultiplier + m_gridHeight;
+    return GetTriangleHeight<uint8, int32>(m_uint8_V9, m_uint8_V8, x, y) * m_gridIntHeightMultiplier + m_gridHeight;
 }
 
 float  GridMap::getHeightFromUint16(float x, float y) const
@@ -1370,66 +1680,52 @@ float  GridMap::getHeightFromUint16(float x, float y) const
     if (!m_uint16_V8 || !m_uint16_V9)
         return m_gridHeight;
 
-    x = MAP_RESOLUTION * (CENTER_GRID_ID - x/SIZE_OF_GRIDS);
-    y = MAP_RESOLUTION * (CENTER_GRID_ID - y/SIZE_OF_GRIDS);
-
-    int x_int = (int)x;
-    int y_int = (int)y;
-    x -= x_int;
-    y -= y_int;
-    x_int &= (MAP_RESOLUTION - 1);
-    y_int &= (MAP_RESOLUTION - 1);
+    return GetTriangleHeight<uint16, int32>(m_uint16_V9, m_uint16_V8, x, y) * m_gridIntHeightMultiplier + m_gridHeight;
+}
 
-    int32 a, b, c;
-    uint16* V9_h1_ptr = &m_uint16_V9[x_int * 128 + x_int + y_int];
-    if (x + y < 1)
+void GridMap::getHeights(float const* xs, float const* ys, float* out, uint32 count) const
+{
+    // the storage format is resolved once for the whole batch
+    if (m_gridGetHeight == &GridMap::getHeightFromFloat && m_V8 && m_V9)
     {
-        if (x > y)
-        {
-            // 1 triangle (h1, h2, h5 points)
-            int32 h1 = V9_h1_ptr[  0];
-            int32 h2 = V9_h1_ptr[129];
-            int32 h5 = 2 * m_uint16_V8[x_int * 128 + y_int];
-            a = h2 - h1;
-            b = h5 - h1 - h2;
-            c = h1;
-        }
-        else
-        {
-            // 2 triangle (h1, h3, h5 points)
-            int32 h1 = V9_h1_ptr[0];
-            int32 h3 = V9_h1_ptr[1];
-            int32 h5 = 2 * m_uint16_V8[x_int * 128 + y_int];
-            a = h5 - h1 - h3;
-            b = h3 - h1;
-            c = h1;
-        }
+        for (uint32 i = 0; i < count; ++i)
+            out[i] = GetTriangleHeight<float, float>(m_V9, m_V8, xs[i], ys[i]);
+    }
+    else if (m_gridGetHeight == &GridMap::getHeightFromUint16 && m_uint16_V8 && m_uint16_V9)
+    {
+        for (uint32 i = 0; i < count; ++i)
+            out[i] = GetTriangleHeight<uint16, int32>(m_uint16_V9, m_uint16_V8, xs[i], ys[i]) * m_gridIntHeightMultiplier + m_gridHeight;
+    }
+    else if (m_gridGetHeight == &GridMap::getHeightFromUint8 && m_uint8_V8 && m_uint8_V9)
+    {
+        for (uint32 i = 0; i < count; ++i)
+            out[i] = GetTriangleHeight<uint8, int32>(m_uint8_V9, m_uint8_V8, xs[i], ys[i]) * m_gridIntHeightMultiplier + m_gridHeight;
     }
     else
+        std::fill(out, out + count, m_gridHeight);
+}
+
+void GridMap::getLiquidLevels(float const* xs, float const* ys, float* out, uint32 count) const
+{
+    if (!_liquidMap)
     {
-        if (x > y)
-        {
-            // 3 triangle (h2, h4, h5 points)
-            int32 h2 = V9_h1_ptr[129];
-            int32 h4 = V9_h1_ptr[130];
-            int32 h5 = 2 * m_uint16_V8[x_int * 128 + y_int];
-            a = h2 + h4 - h5;
-            b = h4 - h2;
-            c = h5 - h4;
-        }
+        std::fill(out, out + count, m_liquidLevel);
+        return;
+    }
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        float x = MAP_RESOLUTION * (CENTER_GRID_ID - xs[i]/SIZE_OF_GRIDS);
+        float y = MAP_RESOLUTION * (CENTER_GRID_ID - ys[i]/SIZE_OF_GRIDS);
+
+        int cx_int = ((int)x & (MAP_RESOLUTION - 1)) - m_liquid_offY;
+        int cy_int = ((int)y & (MAP_RESOLUTION - 1)) - m_liquid_offX;
+
+        if (cx_int < 0 || cx_int >= m_liquid_height || cy_int < 0 || cy_int >= m_liquid_width)
+            out[i] = INVALID_HEIGHT;
         else
-        {
-            // 4 triangle (h3, h4, h5 points)
-            int32 h3 = V9_h1_ptr[  1];
-            int32 h4 = V9_h1_ptr[130];
-            int32 h5 = 2 * m_uint16_V8[x_int * 128 + y_int];
-            a = h4 - h3;
-            b = h3 + h4 - h5;
-            c = h5 - h4;
-        }
+            out[i] = _liquidMap[cx_int * m_liquid_width + cy_int];
     }
-    // Calculate height
-    return (float)((a * x) + (b * y) + c) * m_gridIntHeightMultiplier + m_gridHeight;
 }
 
 float  GridMap::getLiquidLevel(float x, float y)
@@ -1799,6 +2095,47 @@ float Map::GetWaterLevel(float x, float y) const
         return 0;
 }
 
+// Points are handed to the GridMap in runs lying in the same grid
+void Map::GetGridHeights(float const* xs, float const* ys, float* out, uint32 count) const
+{
+    for (uint32 first = 0; first < count;)
+    {
+        int gx = (int)(CENTER_GRID_ID - xs[first] / SIZE_OF_GRIDS);
+        int gy = (int)(CENTER_GRID_ID - ys[first] / SIZE_OF_GRIDS);
+
+        uint32 last = first + 1;
+        while (last < count && (int)(CENTER_GRID_ID - xs[last] / SIZE_OF_GRIDS) == gx && (int)(CENTER_GRID_ID - ys[last] / SIZE_OF_GRIDS) == gy)
+            ++last;
+
+        if (GridMap* gmap = const_cast<Map*>(this)->GetGrid(xs[first], ys[first]))
+            gmap->getHeights(xs + first, ys + first, out + first, last - first);
+        else
+            std::fill(out + first, out + last, VMAP_INVALID_HEIGHT_VALUE);
+
+        first = last;
+    }
+}
+
+void Map::GetWaterLevels(float const* xs, float const* ys, float* out, uint32 count) const
+{
+    for (uint32 first = 0; first < count;)
+    {
+        int gx = (int)(CENTER_GRID_ID - xs[first] / SIZE_OF_GRIDS);
+        int gy = (int)(CENTER_GRID_ID - ys[first] / SIZE_OF_GRIDS);
+
+        uint32 last = first + 1;
+        while (last < count && (int)(CENTER_GRID_ID - xs[last] / SIZE_OF_GRIDS) == gx && (int)(CENTER_GRID_ID - ys[last] / SIZE_OF_GRIDS) == gy)
+            ++last;
+
+        if (GridMap* gmap = const_cast<Map*>(this)->GetGrid(xs[first], ys[first]))
+            gmap->getLiquidLevels(xs + first, ys + first, out + first, last - first);
+        else
+            std::fill(out + first, out + last, 0.0f);
+
+        first = last;
+    }
+}
+
 bool Map::isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2) const
 {
     return VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), x1, y1, z1, x2, y2, z2)
@@ -1947,7 +2284,7 @@ void Map::SendInitSelf(Player* player)
 
     WorldPacket packet;
     data.BuildPacket(&packet, hasTransport);
-    player->GetSession()->SendPacket(&packet);
+    player->GetSession()->SendPacket(std::move(packet));
 }
 
 void Map::SendInitTransports(Player* player)
@@ -1977,7 +2314,7 @@ void Map::SendInitTransports(Player* player)
 
     WorldPacket packet;
     transData.BuildPacket(&packet, hasTransport);
-    player->GetSession()->SendPacket(&packet);
+    player->GetSession()->SendPacket(std::move(packet));
 }
 
 void Map::SendRemoveTransports(Player* player)
@@ -2000,7 +2337,7 @@ void Map::SendRemoveTransports(Player* player)
 
     WorldPacket packet;
     transData.BuildPacket(&packet);
-    player->GetSession()->SendPacket(&packet);
+    player->GetSession()->SendPacket(std::move(packet));
 }
 
 inline void Map::setNGrid(NGridType* grid, uint32 x, uint32 y)
@@ -2038,6 +2375,7 @@ void Map::AddObjectToRemoveList(WorldObject* obj)
 
     obj->CleanupsBeforeDelete();                            // remove or simplify at least cross referenced links
 
+    RegionGuard guard(*this);
     i_objectsToRemove.insert(obj);
     //sLog.outMap("Object (GUID: %u TypeId: %u) added to removing list.",obj->GetGUIDLow(),obj->GetTypeId());
 }
@@ -2050,6 +2388,7 @@ void Map::AddObjectToSwitchList(WorldObject* obj, bool on)
     if (obj->GetTypeId() != TYPEID_UNIT)
         return;
 
+    RegionGuard guard(*this);
     std::map<WorldObject*, bool>::iterator itr = i_objectsToSwitch.find(obj);
     if (itr == i_objectsToSwitch.end())
         i_objectsToSwitch.insert(itr, std::make_pair(obj, on));
@@ -2123,8 +2462,9 @@ uint32 Map::GetPlayersCountExceptGMs() const
 
 void Map::SendToPlayers(WorldPacket const* data) const
 {
+    WorldPacket_AutoPtr shared;
     for (MapRefManager::const_iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
-        itr->GetSource()->GetSession()->SendPacket(data);
+        itr->GetSource()->GetSession()->SendPacket(data, shared);
 }
 
 bool Map::ActiveObjectsNearGrid(NGridType const& ngrid) const
@@ -2166,6 +2506,7 @@ bool Map::ActiveObjectsNearGrid(NGridType const& ngrid) const
 
 void Map::AddToActive(Creature* c)
 {
+    RegionGuard guard(*this);
     AddToActiveHelper(c);
 
     // also not allow unloading spawn grid to prevent creating creature clone at load
@@ -2187,6 +2528,7 @@ void Map::AddToActive(Creature* c)
 
 void Map::RemoveFromActive(Creature* c)
 {
+    RegionGuard guard(*this);
     RemoveFromActiveHelper(c);
 
     // also allow unloading spawn grid
@@ -22,11 +22,13 @@
 #include "Policies/ThreadingModel.h"
 #include "ace/RW_Thread_Mutex.h"
 #include "ace/Thread_Mutex.h"
+#include "ace/Recursive_Thread_Mutex.h"
 
 #include "DBCStructure.h"
 #include "GridDefines.h"
 #include "Cell.h"
 #include "Timer.h"
+#include "Utilities/TimerWheel.h"
 #include "SharedDefines.h"
 #include "GameSystem/GridRefManager.h"
 #include "MapRefManager.h"
@@ -36,7 +38,9 @@
 
 #include <bitset>
 #include <list>
+#include <map>
 #include <set>
+#include <vector>
 
 class Unit;
 class WorldPacket;
@@ -47,12 +51,15 @@ class Object;
 class WorldObject;
 class TempSummon;
 class Player;
+class Creature;
+class GameObject;
 class CreatureGroup;
 struct ScriptInfo;
 struct ScriptAction;
 struct Position;
 class Battleground;
 class InstanceMap;
+class Map;
 namespace Oregon { struct ObjectUpdater; }
 
 struct ScriptAction
@@ -208,6 +215,9 @@ class GridMap
             return (this->*m_gridGetHeight)(x, y);
         }
         float  getLiquidLevel(float x, float y);
+        // same as getHeight and getLiquidLevel for count points
+        void   getHeights(float const* xs, float const* ys, float* out, uint32 count) const;
+        void   getLiquidLevels(float const* xs, float const* ys, float* out, uint32 count) const;
         uint8  getTerrainType(float x, float y);
         ZLiquidStatus getLiquidStatus(float x, float y, float z, uint8 ReqLiquidType, LiquidData* data = 0);
 };
@@ -255,6 +265,27 @@ enum LevelRequirementVsMode
 
 typedef UNORDERED_MAP<Creature*, CreatureMover> CreatureMoveList;
 
+typedef std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP* TOTAL_NUMBER_OF_CELLS_PER_MAP> CellMarks;
+
+#define MAX_MAP_REGION_PHASES   4                           // 2x2 checkerboard
+
+// Players and active objects of one square of grids, updated on a region
+// update thread together with the cells around them. Regions of the same
+// phase are never adjacent, so their cells and objects are apart.
+struct MapRegion
+{
+    MapRegion() : map(NULL), id(0), phase(0) { }
+
+    Map* map;
+    uint32 id;                                              // region x * MAX_NUMBER_OF_GRIDS + region y
+    uint32 phase;
+    std::vector<Player*> players;
+    std::vector<WorldObject*> activeObjects;
+    std::vector<WorldObject*> deferred;                     // reach out of the region, updated in the merge phase
+    std::vector<uint32> cells;                              // visited cells, marked in marks
+    CellMarks marks;
+};
+
 #define MAX_HEIGHT            100000.0f                     // can be use for find ground height at surface
 #define INVALID_HEIGHT       -100000.0f                     // for check, must be equal to VMAP_INVALID_HEIGHT, real value for unknown height is VMAP_INVALID_HEIGHT_VALUE
 #define MAX_FALL_DISTANCE     250000.0f                     // "unlimited fall" to find VMap ground if it is available, just larger than MAX_HEIGHT - INVALID_HEIGHT
@@ -288,8 +319,24 @@ class Map : public GridRefManager<NGridType>, public Oregon::ObjectLevelLockable
         void VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Oregon::ObjectUpdater, GridTypeMapContainer> &gridVisitor, TypeContainerVisitor<Oregon::ObjectUpdater, WorldTypeMapContainer> &worldVisitor);
         virtual void Update(const uint32&);
 
+        // one region of a continent updated in parallel, called by MapRegionUpdater
+        void UpdateRegion(MapRegion& region, uint32 diff);
+
+        // while regions update, work that reaches world wide state or other regions
+        // is queued for the merge phase. These return false if it can be done now
+        bool DeferZoneUpdate(Player* player);
+        bool DeferTeleport(Player* player);
+        bool DeferGroupUpdate(Player* player);
+        bool DeferPoolUpdate(Creature* creature, uint32 poolId);
+        bool DeferPoolUpdate(GameObject* go, uint32 poolId);
+        // true if AddToMap queued the summon, it is added and InitSummon'd in the merge phase
+        bool DeferSummon(TempSummon* summon);
+
         float GetVisibilityRange() const { return m_VisibleDistance; }
 
+        // delayed unit events (EventProcessor) of all units in this map
+        TimerWheel& GetEventWheel() { return m_eventWheel; }
+
         //function for setting up visibility distance for maps on per-type/per-Id basis
         virtual void InitVisibilityDistance();
 
@@ -361,6 +408,9 @@ class Map : public GridRefManager<NGridType>, public Oregon::ObjectLevelLockable
 
         uint8 GetTerrainType(float x, float y) const;
         float GetWaterLevel(float x, float y) const;
+        // raw .map ground heights (no vmaps or gameobjects) and water levels of count points
+        void GetGridHeights(float const* xs, float const* ys, float* out, uint32 count) const;
+        void GetWaterLevels(float const* xs, float const* ys, float* out, uint32 count) const;
         bool IsInWater(float x, float y, float z, LiquidData* data = nullptr) const;
         bool IsUnderWater(float x, float y, float z) const;
         bool IsSwimmable(float x, float y, float z, LiquidData* data = nullptr) const;
@@ -473,15 +523,37 @@ class Map : public GridRefManager<NGridType>, public Oregon::ObjectLevelLockable
         {
             return !m_mapRefManager.isEmpty();
         }
+        // only timers to update, nothing near a player or active object
+        bool IsIdle() const
+        {
+            return m_mapRefManager.isEmpty() && m_activeNonPlayers.empty();
+        }
+
+        // moving averages of the update time and of the time spent queued in MapUpdater, in microseconds
+        uint32 GetUpdateCost() const
+        {
+            return m_updateCost;
+        }
+        uint32 GetUpdateWait() const
+        {
+            return m_updateWait;
+        }
+        void AddUpdateSample(uint32 cost, uint32 wait)
+        {
+            m_updateCost = (m_updateCost * 7 + cost) / 8;
+            m_updateWait = (m_updateWait * 7 + wait) / 8;
+        }
         uint32 GetPlayersCountExceptGMs() const;
         bool ActiveObjectsNearGrid(NGridType const& ngrid) const;
 
         void AddWorldObject(WorldObject* obj)
         {
+            RegionGuard guard(*this);
             i_worldObjects.insert(obj);
         }
         void RemoveWorldObject(WorldObject* obj)
         {
+            RegionGuard guard(*this);
             i_worldObjects.erase(obj);
         }
 
@@ -588,6 +660,18 @@ class Map : public GridRefManager<NGridType>, public Oregon::ObjectLevelLockable
         void setNGrid(NGridType* grid, uint32 x, uint32 y);
         void ScriptsProcess();
 
+        void UpdatePlayer(Player* player, uint32 diff, TypeContainerVisitor<Oregon::ObjectUpdater, GridTypeMapContainer> &gridVisitor, TypeContainerVisitor<Oregon::ObjectUpdater, WorldTypeMapContainer> &worldVisitor);
+
+        // parallel update of large continents, see MapUpdate.Regions in the config
+        bool CanUpdateRegions() const;
+        uint32 GetRegionSize() const;
+        MapRegion* GetUpdateRegion(std::map<uint32, MapRegion*>& regions, WorldObject* obj, uint32 size);
+        void UpdateRegions(uint32 diff, TypeContainerVisitor<Oregon::ObjectUpdater, GridTypeMapContainer> &gridVisitor, TypeContainerVisitor<Oregon::ObjectUpdater, WorldTypeMapContainer> &worldVisitor);
+        void VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Oregon::ObjectUpdater, GridTypeMapContainer> &gridVisitor, TypeContainerVisitor<Oregon::ObjectUpdater, WorldTypeMapContainer> &worldVisitor, MapRegion& region);
+        bool IsInRegion(WorldObject* obj, MapRegion const& region) const;
+        bool IsInUpdatingRegion(WorldObject* obj) const;
+        void ProcessRegionDeferred();
+
     protected:
         void SetUnloadReferenceLock(const GridCoord& p, bool on)
         {
@@ -596,6 +680,26 @@ class Map : public GridRefManager<NGridType>, public Oregon::ObjectLevelLockable
 
         typedef Oregon::ObjectLevelLockable<Map, ACE_Thread_Mutex>::Lock Guard;
 
+        // map wide containers that objects change during their update are
+        // serialized with it while regions of the map update concurrently
+        class RegionGuard
+        {
+            public:
+                explicit RegionGuard(Map& map) : m_lock(map.m_regionUpdate ? &map.m_regionLock : NULL)
+                {
+                    if (m_lock)
+                        m_lock->acquire();
+                }
+                ~RegionGuard()
+                {
+                    if (m_lock)
+                        m_lock->release();
+                }
+
+            private:
+                ACE_Recursive_Thread_Mutex* m_lock;
+        };
+
         MapEntry const* i_mapEntry;
         uint8 i_spawnMode;
         uint32 i_InstanceId;
@@ -611,6 +715,9 @@ class Map : public GridRefManager<NGridType>, public Oregon::ObjectLevelLockable
         ActiveNonPlayers m_activeNonPlayers;
         ActiveNonPlayers::iterator m_activeNonPlayersIter;
 
+        uint32 m_updateCost;
+        uint32 m_updateWait;
+
     private:
         Player* _GetScriptPlayerSourceOrTarget(Object* source, Object* target, const ScriptInfo* scriptInfo) const;
         Creature* _GetScriptCreatureSourceOrTarget(Object* source, Object* target, const ScriptInfo* scriptInfo, bool bReverse = false) const;
@@ -622,6 +729,7 @@ class Map : public GridRefManager<NGridType>, public Oregon::ObjectLevelLockable
         GameObject* _FindGameObject(WorldObject* pWorldObject, uint32 guid) const;
 
         DynamicMapTree m_dyn_tree;
+        TimerWheel m_eventWheel;
         time_t i_gridExpiry;
 
         //used for fast base_map (e.g. MapInstanced class object) search for
@@ -630,7 +738,22 @@ class Map : public GridRefManager<NGridType>, public Oregon::ObjectLevelLockable
 
         NGridType* i_grids[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
         GridMap* GridMaps[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
-        std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP* TOTAL_NUMBER_OF_CELLS_PER_MAP> marked_cells;
+        CellMarks marked_cells;
+
+        std::vector<MapRegion*> m_regions;                  // reused between updates
+        ACE_Recursive_Thread_Mutex m_regionLock;
+        bool m_regionUpdate;                                // regions are updating, RegionGuard locks
+
+        // queued during the region phases under m_regionLock, done in the merge phase
+        std::vector<WorldObject*> m_regionDeferredAdds;     // added outside the region of the updating thread
+        std::vector<Player*> m_regionDeferredZones;         // zone changes, outdoor pvp, weather and channels are world wide
+        std::vector<Player*> m_regionDeferredTeleports;     // destination may be in another region
+        std::vector<Player*> m_regionDeferredGroupUpdates;  // reads the visibility of group members in other regions
+        std::vector<TempSummon*> m_regionDeferredSummons;   // deferred adds still waiting for InitSummon
+        // pool id, db guid; a pool may spawn its next member anywhere on the map
+        typedef std::vector<std::pair<uint32, uint32> > DeferredPoolUpdates;
+        DeferredPoolUpdates m_regionDeferredCreaturePools;
+        DeferredPoolUpdates m_regionDeferredGameObjectPools;
 
         //these functions used to process player/mob aggro reactions and
         //visibility calculations. Highly optimized for massive calculations
@@ -652,12 +775,15 @@ class Map : public GridRefManager<NGridType>, public Oregon::ObjectLevelLockable
         template<class T>
         void AddToActiveHelper(T* obj)
         {
+            RegionGuard guard(*this);
             m_activeNonPlayers.insert(obj);
         }
 
         template<class T>
         void RemoveFromActiveHelper(T* obj)
         {
+            RegionGuard guard(*this);
+
             // Map::Update for active object in proccess
             if (m_activeNonPlayersIter != m_activeNonPlayers.end())
             {
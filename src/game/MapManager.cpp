@@ -66,6 +66,12 @@ void MapManager::Initialize()
     if (num_threads > 0 && m_updater.activate(num_threads) == -1)
         abort();
 
+    // crowded continents update their regions on a pool of their own
+    int region_threads(sWorld.getConfig(CONFIG_MAPUPDATE_REGION_THREADS));
+    if (region_threads > 0 && sWorld.getConfig(CONFIG_MAPUPDATE_REGION_SIZE) &&
+        m_regionUpdater.activate(region_threads) == -1)
+        abort();
+
     InitMaxInstanceId();
 }
 
@@ -232,7 +238,8 @@ void MapManager::Update(time_t diff)
     MapMapType::iterator iter = i_maps.begin();
     for (; iter != i_maps.end(); ++iter)
     {
-        if (m_updater.activated())
+        // instanced maps schedule their instances, so they are ordered by cost together with the continents
+        if (m_updater.activated() && !iter->second->Instanceable())
             m_updater.schedule_update(*iter->second, i_timer.GetCurrent());
         else
             iter->second->Update(i_timer.GetCurrent());
@@ -283,6 +290,9 @@ void MapManager::UnloadAll()
 
     if (m_updater.activated())
         m_updater.deactivate();
+
+    if (m_regionUpdater.activated())
+        m_regionUpdater.deactivate();
 }
 
 void MapManager::InitMaxInstanceId()
@@ -311,6 +321,24 @@ uint32 MapManager::GetNumInstances()
     return ret;
 }
 
+void MapManager::GetAllMaps(std::vector<Map*>& maps)
+{
+    Guard guard(*this);
+
+    for (MapMapType::iterator itr = i_maps.begin(); itr != i_maps.end(); ++itr)
+    {
+        Map* map = itr->second;
+        maps.push_back(map);
+
+        if (!map->Instanceable())
+            continue;
+
+        MapInstanced::InstancedMaps& instances = ((MapInstanced*)map)->GetInstancedMaps();
+        for (MapInstanced::InstancedMaps::iterator mitr = instances.begin(); mitr != instances.end(); ++mitr)
+            maps.push_back(mitr->second);
+    }
+}
+
 uint32 MapManager::GetNumPlayersInInstances()
 {
     Guard guard(*this);
@@ -140,8 +140,10 @@ class MapManager : public Oregon::Singleton<MapManager, Oregon::ClassLevelLockab
         /* statistics */
         uint32 GetNumInstances();
         uint32 GetNumPlayersInInstances();
+        void GetAllMaps(std::vector<Map*>& maps);         // continents and instances
 
         MapUpdater * GetMapUpdater() { return &m_updater; }
+        MapRegionUpdater * GetMapRegionUpdater() { return &m_regionUpdater; }
 
     private:
         // debugging code, should be deleted some day
@@ -169,6 +171,7 @@ class MapManager : public Oregon::Singleton<MapManager, Oregon::ClassLevelLockab
 
         uint32 i_MaxInstanceId;
         MapUpdater m_updater;
+        MapRegionUpdater m_regionUpdater;
 };
 #endif
 
@@ -23,6 +23,9 @@
 #include <ace/Guard_T.h>
 #include <ace/Method_Request.h>
 
+#include <algorithm>
+#include <chrono>
+
 class WDBThreadStartReq1 : public ACE_Method_Request
 {
     public:
@@ -53,6 +56,21 @@ class WDBThreadEndReq1 : public ACE_Method_Request
         }
 };
 
+typedef std::chrono::steady_clock MapUpdateClock;
+
+static uint32 MicrosecondsSince(MapUpdateClock::time_point start, MapUpdateClock::time_point end)
+{
+    return uint32(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+}
+
+// updates the map and feeds the time it took into the map's moving average
+static void TimedUpdate(Map& map, ACE_UINT32 diff, MapUpdateClock::time_point queued)
+{
+    MapUpdateClock::time_point start = MapUpdateClock::now();
+    map.Update(diff);
+    map.AddUpdateSample(MicrosecondsSince(start, MapUpdateClock::now()), MicrosecondsSince(queued, start));
+}
+
 class MapUpdateRequest : public ACE_Method_Request
 {
     private:
@@ -60,22 +78,32 @@ class MapUpdateRequest : public ACE_Method_Request
         Map& m_map;
         MapUpdater& m_updater;
         ACE_UINT32 m_diff;
+        MapUpdateClock::time_point m_queued;
 
     public:
 
         MapUpdateRequest(Map& m, MapUpdater& u, ACE_UINT32 d)
-            : m_map(m), m_updater(u), m_diff(d)
+            : m_map(m), m_updater(u), m_diff(d), m_queued(MapUpdateClock::now())
         {
         }
 
         virtual int call()
         {
-            m_map.Update (m_diff);
+            TimedUpdate(m_map, m_diff, m_queued);
             m_updater.update_finished();
             return 0;
         }
 };
 
+struct ScheduledUpdateCostGreater
+{
+    template<class T>
+    bool operator()(T const& left, T const& right) const
+    {
+        return left.map->GetUpdateCost() > right.map->GetUpdateCost();
+    }
+};
+
 int MapUpdater::activate(size_t num_threads)
 {
     return m_executor.activate((int)num_threads, new WDBThreadStartReq1, new WDBThreadEndReq1);
@@ -90,6 +118,8 @@ int MapUpdater::deactivate()
 
 int MapUpdater::wait()
 {
+    dispatch();
+
     ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, -1);
 
     while (pending_requests > 0)
@@ -99,6 +129,34 @@ int MapUpdater::wait()
 }
 
 int MapUpdater::schedule_update(Map& map, ACE_UINT32 diff)
+{
+    if (map.IsIdle())
+        m_idle.push_back(ScheduledUpdate(&map, diff));
+    else
+        m_scheduled.push_back(ScheduledUpdate(&map, diff));
+
+    return 0;
+}
+
+void MapUpdater::dispatch()
+{
+    // the executor queue is FIFO, so the most expensive maps are picked up first
+    std::stable_sort(m_scheduled.begin(), m_scheduled.end(), ScheduledUpdateCostGreater());
+
+    for (ScheduledUpdates::iterator itr = m_scheduled.begin(); itr != m_scheduled.end(); ++itr)
+        if (execute(*itr->map, itr->diff) == -1)
+            TimedUpdate(*itr->map, itr->diff, MapUpdateClock::now());
+
+    m_scheduled.clear();
+
+    // cheap, done here instead of paying a request and a context switch each
+    for (ScheduledUpdates::iterator itr = m_idle.begin(); itr != m_idle.end(); ++itr)
+        TimedUpdate(*itr->map, itr->diff, MapUpdateClock::now());
+
+    m_idle.clear();
+}
+
+int MapUpdater::execute(Map& map, ACE_UINT32 diff)
 {
     ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, -1);
 
@@ -134,3 +192,88 @@ void MapUpdater::update_finished()
 
     m_condition.broadcast();
 }
+
+class MapRegionUpdateRequest : public ACE_Method_Request
+{
+    private:
+
+        Map& m_map;
+        MapRegion& m_region;
+        MapRegionUpdater& m_updater;
+        ACE_UINT32 m_diff;
+        size_t& m_pending;
+
+    public:
+
+        MapRegionUpdateRequest(Map& m, MapRegion& r, MapRegionUpdater& u, ACE_UINT32 d, size_t& p)
+            : m_map(m), m_region(r), m_updater(u), m_diff(d), m_pending(p)
+        {
+        }
+
+        virtual int call()
+        {
+            m_map.UpdateRegion(m_region, m_diff);
+            m_updater.update_finished(m_pending);
+            return 0;
+        }
+};
+
+int MapRegionUpdater::activate(size_t num_threads)
+{
+    return m_executor.activate((int)num_threads, new WDBThreadStartReq1, new WDBThreadEndReq1);
+}
+
+int MapRegionUpdater::deactivate()
+{
+    return m_executor.deactivate();
+}
+
+bool MapRegionUpdater::activated()
+{
+    return m_executor.activated();
+}
+
+void MapRegionUpdater::update(Map& map, std::vector<MapRegion*> const& regions, ACE_UINT32 diff)
+{
+    if (regions.empty())
+        return;
+
+    size_t pending = 0;
+
+    for (size_t i = 0; i + 1 < regions.size(); ++i)
+    {
+        {
+            ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+            ++pending;
+        }
+
+        if (m_executor.execute(new MapRegionUpdateRequest(map, *regions[i], *this, diff, pending)) == -1)
+        {
+            ACE_DEBUG((LM_ERROR, ACE_TEXT("(%t) \n"), ACE_TEXT("Failed to schedule Map Region Update")));
+
+            {
+                ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+                --pending;
+            }
+
+            map.UpdateRegion(*regions[i], diff);
+        }
+    }
+
+    map.UpdateRegion(*regions.back(), diff);
+
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+
+    while (pending > 0)
+        m_condition.wait();
+}
+
+void MapRegionUpdater::update_finished(size_t& pending)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+
+    --pending;
+
+    // the pool is shared by all continents, wake every waiting map thread
+    m_condition.broadcast();
+}
@@ -23,8 +23,20 @@
 
 #include "DelayExecutor.h"
 
+#include <vector>
+
 class Map;
+struct MapRegion;
 
+/**
+ * Runs the map updates of a tick on the map update threads.
+ *
+ * Updates are collected by schedule_update and started by wait, the maps
+ * that took longest in the past ticks first: the tick ends when the last
+ * map is done, so the slow continents and raids must not queue behind
+ * small instances. Maps without players or active objects only update
+ * timers, they run on the calling thread while the pool is busy.
+ */
 class MapUpdater
 {
     public:
@@ -36,6 +48,7 @@ class MapUpdater
 
         int schedule_update(Map& map, ACE_UINT32 diff);
 
+        // starts the scheduled updates and blocks until all are done
         int wait();
 
         int activate(size_t num_threads);
@@ -46,12 +59,61 @@ class MapUpdater
 
     private:
 
+        struct ScheduledUpdate
+        {
+            ScheduledUpdate(Map* m, ACE_UINT32 d) : map(m), diff(d) { }
+
+            Map* map;
+            ACE_UINT32 diff;
+        };
+
+        typedef std::vector<ScheduledUpdate> ScheduledUpdates;
+
         DelayExecutor m_executor;
-        ACE_Condition_Thread_Mutex m_condition;
         ACE_Thread_Mutex m_mutex;
+        ACE_Condition_Thread_Mutex m_condition;
         size_t pending_requests;
 
+        ScheduledUpdates m_scheduled;                       // run on the pool, longest first
+        ScheduledUpdates m_idle;                            // run by the thread calling wait
+
+        void dispatch();
+        int execute(Map& map, ACE_UINT32 diff);
         void update_finished();
 };
 
+/**
+ * Runs the regions of one phase of a continent update concurrently.
+ *
+ * Several continents may share the pool, every update call waits for its
+ * own regions only. The calling map thread updates the last region itself
+ * instead of waiting idle.
+ */
+class MapRegionUpdater
+{
+    public:
+
+        MapRegionUpdater() : m_executor(), m_mutex(), m_condition(m_mutex) {}
+        ~MapRegionUpdater() { };
+
+        friend class MapRegionUpdateRequest;
+
+        // updates the regions and blocks until all are done
+        void update(Map& map, std::vector<MapRegion*> const& regions, ACE_UINT32 diff);
+
+        int activate(size_t num_threads);
+
+        int deactivate();
+
+        bool activated();
+
+    private:
+
+        DelayExecutor m_executor;
+        ACE_Thread_Mutex m_mutex;
+        ACE_Condition_Thread_Mutex m_condition;
+
+        void update_finished(size_t& pending);
+};
+
 #endif //_MAP_UPDATER_H_INCLUDED
@@ -22,7 +22,7 @@
 #include "DetourNavMesh.h"
 
 #define MMAP_MAGIC 0x4d4d4150   // 'MMAP'
-#define MMAP_VERSION 4
+#define MMAP_VERSION 5
 
 struct MmapTileHeader
 {
@@ -31,9 +31,10 @@ struct MmapTileHeader
     uint32 mmapVersion;
     uint32 size;
     bool usesLiquids : 1;
+    uint64 inputHash;           // generator input the tile was built from
 
     MmapTileHeader() : mmapMagic(MMAP_MAGIC), dtVersion(DT_NAVMESH_VERSION),
-        mmapVersion(MMAP_VERSION), size(0), usesLiquids(true) {}
+        mmapVersion(MMAP_VERSION), size(0), usesLiquids(true), inputHash(0) {}
 };
 
 enum NavTerrain
@@ -90,7 +90,7 @@ namespace Movement
         data << unit.GetPackGUID();
 
         PacketBuilder::WriteMonsterMove(move_spline, data);
-        unit.SendMessageToSet(&data, true);
+        unit.SendMonsterMoveToSet(&data);
 
         return move_spline.Duration();
     }
@@ -130,7 +130,7 @@ namespace Movement
         data << real_position.x << real_position.y << real_position.z;
         data << move_spline.GetId();
         data << uint8(MonsterMoveStop);
-        unit.SendMessageToSet(&data, true);
+        unit.SendMonsterMoveToSet(&data);
     }
 
     MoveSplineInit::MoveSplineInit(Unit& m) : unit(m)
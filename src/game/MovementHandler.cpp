@@ -188,13 +188,10 @@ void WorldSession::HandleMoveWorldportAckOpcode()
         GetPlayer()->SetWaterWalking(true);
 
     // resummon pet
-    if (GetPlayer()->m_temporaryUnsummonedPetNumber)
+    if (uint32 petnumber = GetPlayer()->m_temporaryUnsummonedPetNumber)
     {
-        Pet* NewPet = new Pet(GetPlayer());
-        if (!NewPet->LoadPetFromDB(GetPlayer(), 0, GetPlayer()->m_temporaryUnsummonedPetNumber, true))
-            delete NewPet;
-
         GetPlayer()->m_temporaryUnsummonedPetNumber = 0;
+        Pet::LoadPetFromDBAsync(GetPlayer(), PET_LOAD_ORIGIN_RESUMMON, 0, petnumber, true);
     }
 
     //lets process all delayed operations on successful teleport
@@ -241,13 +238,10 @@ void WorldSession::HandleMoveTeleportAck(WorldPacket& recv_data)
     }
 
     // resummon pet
-    if (plMover->m_temporaryUnsummonedPetNumber)
+    if (uint32 petnumber = plMover->m_temporaryUnsummonedPetNumber)
     {
-        Pet* NewPet = new Pet(plMover);
-        if (!NewPet->LoadPetFromDB(plMover, 0, plMover->m_temporaryUnsummonedPetNumber, true))
-            delete NewPet;
-
         plMover->m_temporaryUnsummonedPetNumber = 0;
+        Pet::LoadPetFromDBAsync(plMover, PET_LOAD_ORIGIN_RESUMMON, 0, petnumber, true);
     }
 
     //lets process all delayed operations on successful teleport
@@ -481,25 +481,17 @@ void WorldSession::SendStablePet(uint64 guid)
         ++num;
     }
 
-    //                                                            0      1     2   3      4      5        6
-    QueryResult_AutoPtr result = CharacterDatabase.PQuery("SELECT owner, slot, id, entry, level, loyalty, name FROM character_pet WHERE owner = '%u' AND slot > 0 AND slot < 3", _player->GetGUIDLow());
-
-    if (result)
+    StabledPetMap const& stabled = _player->GetStabledPets();
+    for (StabledPetMap::const_iterator itr = stabled.begin(); itr != stabled.end(); ++itr)
     {
-        do
-        {
-            Field* fields = result->Fetch();
-
-            data << uint32(fields[2].GetUInt32());          // petnumber
-            data << uint32(fields[3].GetUInt32());          // creature entry
-            data << uint32(fields[4].GetUInt32());          // level
-            data << fields[6].GetString();                  // name
-            data << uint32(fields[5].GetUInt32());          // loyalty
-            data << uint8(fields[1].GetUInt32() + 1);       // slot
+        data << uint32(itr->second.petnumber);
+        data << uint32(itr->second.entry);
+        data << uint32(itr->second.level);
+        data << itr->second.name;
+        data << uint32(itr->second.loyalty);
+        data << uint8(itr->first + 1);                      // slot
 
-            ++num;
-        }
-        while (result->NextRow());
+        ++num;
     }
 
     data.put<uint8>(8, num);                                // set real data to placeholder
@@ -541,20 +533,10 @@ void WorldSession::HandleStablePet(WorldPacket& recv_data)
 
     uint32 free_slot = 1;
 
-    QueryResult_AutoPtr result = CharacterDatabase.PQuery("SELECT owner,slot,id FROM character_pet WHERE owner = '%u'  AND slot > 0 AND slot < 3 ORDER BY slot ", _player->GetGUIDLow());
-    if (result)
-    {
-        do
-        {
-            Field* fields = result->Fetch();
-
-            uint32 slot = fields[1].GetUInt32();
-
-            if (slot == free_slot)                             // this slot not free
-                ++free_slot;
-        }
-        while (result->NextRow());
-    }
+    StabledPetMap const& stabled = _player->GetStabledPets();
+    for (StabledPetMap::const_iterator itr = stabled.begin(); itr != stabled.end(); ++itr)
+        if (itr->first == free_slot)                        // this slot not free
+            ++free_slot;
 
     if (free_slot > 0 && free_slot <= GetPlayer()->m_stableSlots)
     {
@@ -597,31 +579,22 @@ void WorldSession::HandleUnstablePet(WorldPacket& recv_data)
         return;
     }
 
+    StabledPetMap::const_iterator stabled = _player->FindStabledPet(petnumber);
+    if (stabled == _player->GetStabledPets().end())
+    {
+        data << uint8(0x06);
+        SendPacket(&data);
+        return;
+    }
+
+    uint32 petentry = stabled->second.entry;
+
     // delete dead pet
     if (pet)
         _player->RemovePet(pet, PET_SAVE_AS_DELETED);
 
-    Pet* newpet = NULL;
-
-    QueryResult_AutoPtr result = CharacterDatabase.PQuery("SELECT entry FROM character_pet WHERE owner = '%u' AND id = '%u' AND slot > 0 AND slot < 3", _player->GetGUIDLow(), petnumber);
-    if (result)
-    {
-        Field* fields = result->Fetch();
-        uint32 petentry = fields[0].GetUInt32();
-
-        newpet = new Pet(_player, HUNTER_PET);
-        if (!newpet->LoadPetFromDB(_player, petentry, petnumber))
-        {
-            delete newpet;
-            newpet = NULL;
-        }
-    }
-
-    if (newpet)
-        data << uint8(0x09);
-    else
-        data << uint8(0x06);
-    SendPacket(&data);
+    // stable result is sent when the pet is loaded
+    Pet::LoadPetFromDBAsync(_player, PET_LOAD_ORIGIN_STABLE, petentry, petnumber, false, HUNTER_PET);
 }
 
 void WorldSession::HandleBuyStableSlot(WorldPacket& recv_data)
@@ -686,37 +659,24 @@ void WorldSession::HandleStableSwapPet(WorldPacket& recv_data)
     if (GetPlayer()->HasUnitState(UNIT_STATE_DIED))
         GetPlayer()->RemoveSpellsCausingAura(SPELL_AURA_FEIGN_DEATH);
 
-    WorldPacket data(SMSG_STABLE_RESULT, 200);              // guess size
-
     Pet* pet = _player->GetPet();
 
     if (!pet || pet->getPetType() != HUNTER_PET)
         return;
 
     // find swapped pet slot in stable
-    QueryResult_AutoPtr result = CharacterDatabase.PQuery("SELECT slot,entry FROM character_pet WHERE owner = '%u' AND id = '%u'", _player->GetGUIDLow(), pet_number);
-    if (!result)
+    StabledPetMap::const_iterator stabled = _player->FindStabledPet(pet_number);
+    if (stabled == _player->GetStabledPets().end())
         return;
 
-    Field* fields = result->Fetch();
-
-    uint32 slot     = fields[0].GetUInt32();
-    uint32 petentry = fields[1].GetUInt32();
+    uint32 slot     = stabled->first;
+    uint32 petentry = stabled->second.entry;
 
     // move alive pet to slot or delele dead pet
     _player->RemovePet(pet, pet->IsAlive() ? PetSaveMode(slot) : PET_SAVE_AS_DELETED);
 
-    // summon unstabled pet
-    Pet* newpet = new Pet(_player);
-    if (!newpet->LoadPetFromDB(_player, petentry, pet_number))
-    {
-        delete newpet;
-        data << uint8(0x06);
-    }
-    else
-        data << uint8(0x09);
-
-    SendPacket(&data);
+    // summon unstabled pet, stable result is sent when it is loaded
+    Pet::LoadPetFromDBAsync(_player, PET_LOAD_ORIGIN_STABLE, petentry, pet_number, false);
 }
 
 void WorldSession::HandleRepairItemOpcode(WorldPacket& recv_data)
@@ -212,7 +212,7 @@ void Object::SendUpdateToPlayer(Player* player)
 
     BuildCreateUpdateBlockForPlayer(&upd, player);
     upd.BuildPacket(&packet);
-    player->GetSession()->SendPacket(&packet);
+    player->GetSession()->SendPacket(std::move(packet));
 }
 
 void Object::BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target) const
@@ -487,189 +487,267 @@ void Object::_BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask*
     if (isType(TYPEMASK_UNIT))                               // unit (creature/player) case
     {
         for (uint16 index = 0; index < m_valuesCount; index ++)
+            if (updateMask->GetBit(index))
+                _BuildUnitUpdateField(data, index, target);
+    }
+    else if (isType(TYPEMASK_GAMEOBJECT))                    // gameobject case
+    {
+        for (uint16 index = 0; index < m_valuesCount; ++index)
+            if (updateMask->GetBit(index))
+                _BuildGameObjectUpdateField(data, index, IsActivateToQuest);
+    }
+    else                                                    // other objects case (no special index checks)
+    {
+        for (uint16 index = 0; index < m_valuesCount; ++index)
         {
             if (updateMask->GetBit(index))
             {
-                // remove custom flag before send
-                if (index == UNIT_NPC_FLAGS)
-                    *data << uint32(m_uint32Values[index]);
-                // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
-                else if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
-                {
-                    // convert from float to uint32 and send
-                    *data << uint32(m_floatValues[ index ] < 0 ? 0 : m_floatValues[ index ]);
-                }
-                // there are some float values which may be negative or can't get negative due to other checks
-                else if ((index >= UNIT_FIELD_NEGSTAT0   && index <= UNIT_FIELD_NEGSTAT4) ||
-                         (index >= UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
-                         (index >= UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
-                         (index >= UNIT_FIELD_POSSTAT0   && index <= UNIT_FIELD_POSSTAT4))
-                    *data << uint32(m_floatValues[ index ]);
-                // Gamemasters should be always able to select units - remove not selectable flag
-                else if (index == UNIT_FIELD_FLAGS && target->IsGameMaster())
-                    *data << (m_uint32Values[ index ] & ~UNIT_FLAG_NOT_SELECTABLE);
-                // use modelid_a if not gm, _h if gm for CREATURE_FLAG_EXTRA_TRIGGER creatures
-                else if (index == UNIT_FIELD_DISPLAYID && GetTypeId() == TYPEID_UNIT)
+                // send in current format (float as float, uint32 as uint32)
+                *data << m_uint32Values[ index ];
+            }
+        }
+    }
+}
+
+void Object::_BuildUnitUpdateField(ByteBuffer* data, uint16 index, Player* target) const
+{
+    // remove custom flag before send
+    if (index == UNIT_NPC_FLAGS)
+        *data << uint32(m_uint32Values[index]);
+    // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
+    else if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
+    {
+        // convert from float to uint32 and send
+        *data << uint32(m_floatValues[ index ] < 0 ? 0 : m_floatValues[ index ]);
+    }
+    // there are some float values which may be negative or can't get negative due to other checks
+    else if ((index >= UNIT_FIELD_NEGSTAT0   && index <= UNIT_FIELD_NEGSTAT4) ||
+             (index >= UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
+             (index >= UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
+             (index >= UNIT_FIELD_POSSTAT0   && index <= UNIT_FIELD_POSSTAT4))
+        *data << uint32(m_floatValues[ index ]);
+    // Gamemasters should be always able to select units - remove not selectable flag
+    else if (index == UNIT_FIELD_FLAGS && target->IsGameMaster())
+        *data << (m_uint32Values[ index ] & ~UNIT_FLAG_NOT_SELECTABLE);
+    // use modelid_a if not gm, _h if gm for CREATURE_FLAG_EXTRA_TRIGGER creatures
+    else if (index == UNIT_FIELD_DISPLAYID && GetTypeId() == TYPEID_UNIT)
+    {
+        const CreatureInfo* cinfo = ToCreature()->GetCreatureTemplate();
+        if (cinfo->flags_extra & CREATURE_FLAG_EXTRA_TRIGGER)
+        {
+            if (target->IsGameMaster())
+            {
+                if (cinfo->modelid1)
+                    *data << cinfo->modelid1;
+                else
+                    *data << 17519; // world invisible trigger's model
+            }
+            else
+            {
+                *data << 11686; // world invisible trigger's model
+            }
+        }
+        else
+            *data << m_uint32Values[ index ];
+    }
+    // hide lootable animation for unallowed players
+    else if (index == UNIT_DYNAMIC_FLAGS && GetTypeId() == TYPEID_UNIT)
+    {
+        uint32 value = m_uint32Values[index];
+
+        if (Creature* creature = (Creature*)this)
+            if (!creature->loot.isLooted())
+                if (!(value & UNIT_DYNFLAG_LOOTABLE))
                 {
-                    const CreatureInfo* cinfo = ToCreature()->GetCreatureTemplate();
-                    if (cinfo->flags_extra & CREATURE_FLAG_EXTRA_TRIGGER)
-                    {
-                        if (target->IsGameMaster())
-                        {
-                            if (cinfo->modelid1)
-                                *data << cinfo->modelid1;
-                            else
-                                *data << 17519; // world invisible trigger's model
-                        }
-                        else
-                        {
-                            *data << 11686; // world invisible trigger's model
-                        }
-                    }
-                    else
-                        *data << m_uint32Values[ index ];
+                    creature->SetFlag(UNIT_DYNAMIC_FLAGS, UNIT_DYNFLAG_LOOTABLE);
+                    value = value | UNIT_DYNFLAG_LOOTABLE;
                 }
-                // hide lootable animation for unallowed players
-                else if (index == UNIT_DYNAMIC_FLAGS && GetTypeId() == TYPEID_UNIT)
-                {
-                    uint32 value = m_uint32Values[index];
-
-                    if (Creature* creature = (Creature*)this)
-                        if (!creature->loot.isLooted())
-                            if (!(value & UNIT_DYNFLAG_LOOTABLE))
-                            {
-                                creature->SetFlag(UNIT_DYNAMIC_FLAGS, UNIT_DYNFLAG_LOOTABLE);
-                                value = value | UNIT_DYNFLAG_LOOTABLE;
-                            }
 
-                    if (!target->isAllowedToLoot((Creature*)this))
-                        if (value & UNIT_DYNFLAG_LOOTABLE)
-                            value = value & ~UNIT_DYNFLAG_LOOTABLE;
+        if (!target->isAllowedToLoot((Creature*)this))
+            if (value & UNIT_DYNFLAG_LOOTABLE)
+                value = value & ~UNIT_DYNFLAG_LOOTABLE;
 
-                    bool tapped = ToCreature()->isTappedBy(target->ToPlayer());
+        bool tapped = ToCreature()->isTappedBy(target->ToPlayer());
 
-                    if (value & UNIT_DYNFLAG_OTHER_TAGGER && tapped)
-                        value = value & ~UNIT_DYNFLAG_OTHER_TAGGER;
+        if (value & UNIT_DYNFLAG_OTHER_TAGGER && tapped)
+            value = value & ~UNIT_DYNFLAG_OTHER_TAGGER;
 
-                    *data << value;
-                }
+        *data << value;
+    }
 
-                // hide RAF menu to non-RAF linked friends
-                else if (index == UNIT_DYNAMIC_FLAGS && GetTypeId() == TYPEID_PLAYER)
-                {
-                    if (sObjectMgr.GetRAFLinkStatus(target->ToPlayer(), this->ToPlayer()) != RAF_LINK_NONE)
-                        *data << (m_uint32Values[ index ]);
-                    else
-                        *data << (m_uint32Values[ index ] & ~UNIT_DYNFLAG_REFER_A_FRIEND);
-                }
-                // FG: pretend that OTHER players in own group are friendly ("blue")
-                else if (index == UNIT_FIELD_BYTES_2 || index == UNIT_FIELD_FACTIONTEMPLATE)
-                {
-                    bool ch = false;
-                    if (target->GetTypeId() == TYPEID_PLAYER && GetTypeId() == TYPEID_PLAYER && target != this)
-                    {
-                        if (target->IsInSameGroupWith(ToPlayer()) || target->IsInSameRaidWith(ToPlayer()))
-                        {
-                            if (index == UNIT_FIELD_BYTES_2)
-                            {
-                                DEBUG_LOG("-- VALUES_UPDATE: Sending '%s' the blue-group-fix from '%s' (flag)", target->GetName(), ToPlayer()->GetName());
-                                *data << (m_uint32Values[ index ] & ((UNIT_BYTE2_FLAG_SANCTUARY | UNIT_BYTE2_FLAG_AURAS | UNIT_BYTE2_FLAG_UNK5) << 8)); // this flag is at uint8 offset 1 !!
-
-                                ch = true;
-                            }
-                            else if (index == UNIT_FIELD_FACTIONTEMPLATE)
-                            {
-                                FactionTemplateEntry const* ft1, *ft2;
-                                ft1 = ToPlayer()->GetFactionTemplateEntry();
-                                ft2 = target->ToPlayer()->GetFactionTemplateEntry();
-                                if (ft1 && ft2 && !ft1->IsFriendlyTo(*ft2))
-                                {
-                                    uint32 faction = target->ToPlayer()->GetFaction(); // pretend that all other HOSTILE players have own faction, to allow follow, heal, rezz (trade wont work)
-                                    DEBUG_LOG("-- VALUES_UPDATE: Sending '%s' the blue-group-fix from '%s' (faction %u)", target->GetName(), ToPlayer()->GetName(), faction);
-                                    *data << uint32(faction);
-                                    ch = true;
-                                }
-                            }
-                        }
-                    }
-                    if (!ch)
-                        *data << m_uint32Values[ index ];
-                }
-                else if (index == UNIT_FIELD_HEALTH)
+    // hide RAF menu to non-RAF linked friends
+    else if (index == UNIT_DYNAMIC_FLAGS && GetTypeId() == TYPEID_PLAYER)
+    {
+        if (sObjectMgr.GetRAFLinkStatus(target->ToPlayer(), this->ToPlayer()) != RAF_LINK_NONE)
+            *data << (m_uint32Values[ index ]);
+        else
+            *data << (m_uint32Values[ index ] & ~UNIT_DYNFLAG_REFER_A_FRIEND);
+    }
+    // FG: pretend that OTHER players in own group are friendly ("blue")
+    else if (index == UNIT_FIELD_BYTES_2 || index == UNIT_FIELD_FACTIONTEMPLATE)
+    {
+        bool ch = false;
+        if (target->GetTypeId() == TYPEID_PLAYER && GetTypeId() == TYPEID_PLAYER && target != this)
+        {
+            if (target->IsInSameGroupWith(ToPlayer()) || target->IsInSameRaidWith(ToPlayer()))
+            {
+                if (index == UNIT_FIELD_BYTES_2)
                 {
-                    if (GetTypeId() == TYPEID_UNIT || GetTypeId() == TYPEID_PLAYER)
-                    {
-                        const Unit* me = reinterpret_cast<const Unit*>(this);
-                        if (me->ShouldRevealHealthTo(target))
-                            *data << m_uint32Values[ index ];
-                        else
-                            *data << uint32(std::ceil(me->GetHealthPct()));
-                    }
-                    else
-                        *data << m_uint32Values[ index ];
+                    DEBUG_LOG("-- VALUES_UPDATE: Sending '%s' the blue-group-fix from '%s' (flag)", target->GetName(), ToPlayer()->GetName());
+                    *data << (m_uint32Values[ index ] & ((UNIT_BYTE2_FLAG_SANCTUARY | UNIT_BYTE2_FLAG_AURAS | UNIT_BYTE2_FLAG_UNK5) << 8)); // this flag is at uint8 offset 1 !!
+
+                    ch = true;
                 }
-                else if (index == UNIT_FIELD_MAXHEALTH)
+                else if (index == UNIT_FIELD_FACTIONTEMPLATE)
                 {
-                    if (GetTypeId() == TYPEID_UNIT || GetTypeId() == TYPEID_PLAYER)
+                    FactionTemplateEntry const* ft1, *ft2;
+                    ft1 = ToPlayer()->GetFactionTemplateEntry();
+                    ft2 = target->ToPlayer()->GetFactionTemplateEntry();
+                    if (ft1 && ft2 && !ft1->IsFriendlyTo(*ft2))
                     {
-                        const Unit* me = reinterpret_cast<const Unit*>(this);
-                        if (me->ShouldRevealHealthTo(target))
-                            *data << m_uint32Values[ index ];
-                        else
-                            *data << uint32(100);
+                        uint32 faction = target->ToPlayer()->GetFaction(); // pretend that all other HOSTILE players have own faction, to allow follow, heal, rezz (trade wont work)
+                        DEBUG_LOG("-- VALUES_UPDATE: Sending '%s' the blue-group-fix from '%s' (faction %u)", target->GetName(), ToPlayer()->GetName(), faction);
+                        *data << uint32(faction);
+                        ch = true;
                     }
-                    else
-                        *data << m_uint32Values[ index ];
-                }
-                else
-                {
-                    // send in current format (float as float, uint32 as uint32)
-                    *data << m_uint32Values[ index ];
                 }
             }
         }
+        if (!ch)
+            *data << m_uint32Values[ index ];
     }
-    else if (isType(TYPEMASK_GAMEOBJECT))                    // gameobject case
+    else if (index == UNIT_FIELD_HEALTH)
     {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
+        if (GetTypeId() == TYPEID_UNIT || GetTypeId() == TYPEID_PLAYER)
         {
-            if (updateMask->GetBit(index))
-            {
-                // send in current format (float as float, uint32 as uint32)
-                if (index == GAMEOBJECT_DYN_FLAGS)
-                {
-                    if (IsActivateToQuest)
-                    {
-                        switch (((GameObject*)this)->GetGoType())
-                        {
-                        case GAMEOBJECT_TYPE_CHEST:
-                        case GAMEOBJECT_TYPE_GOOBER:
-                            *data << uint16(GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE);
-                            *data << uint16(-1);
-                            break;
-                        default:
-                            *data << uint32(0);         // unknown, not happen.
-                            break;
-                        }
-                    }
-                    else
-                        *data << uint32(0);                 // disable quest object
-                }
-                else
-                    *data << m_uint32Values[ index ];       // other cases
-            }
+            const Unit* me = reinterpret_cast<const Unit*>(this);
+            if (me->ShouldRevealHealthTo(target))
+                *data << m_uint32Values[ index ];
+            else
+                *data << uint32(std::ceil(me->GetHealthPct()));
         }
+        else
+            *data << m_uint32Values[ index ];
     }
-    else                                                    // other objects case (no special index checks)
+    else if (index == UNIT_FIELD_MAXHEALTH)
     {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
+        if (GetTypeId() == TYPEID_UNIT || GetTypeId() == TYPEID_PLAYER)
         {
-            if (updateMask->GetBit(index))
-            {
-                // send in current format (float as float, uint32 as uint32)
+            const Unit* me = reinterpret_cast<const Unit*>(this);
+            if (me->ShouldRevealHealthTo(target))
                 *data << m_uint32Values[ index ];
+            else
+                *data << uint32(100);
+        }
+        else
+            *data << m_uint32Values[ index ];
+    }
+    else
+    {
+        // send in current format (float as float, uint32 as uint32)
+        *data << m_uint32Values[ index ];
+    }
+}
+
+void Object::_BuildGameObjectUpdateField(ByteBuffer* data, uint16 index, bool activateToQuest) const
+{
+    // send in current format (float as float, uint32 as uint32)
+    if (index == GAMEOBJECT_DYN_FLAGS)
+    {
+        if (activateToQuest)
+        {
+            switch (((GameObject*)this)->GetGoType())
+            {
+            case GAMEOBJECT_TYPE_CHEST:
+            case GAMEOBJECT_TYPE_GOOBER:
+                *data << uint16(GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE);
+                *data << uint16(-1);
+                break;
+            default:
+                *data << uint32(0);         // unknown, not happen.
+                break;
             }
         }
+        else
+            *data << uint32(0);                 // disable quest object
+    }
+    else
+        *data << m_uint32Values[ index ];       // other cases
+}
+
+bool Object::IsViewerDependentField(uint16 index) const
+{
+    if (isType(TYPEMASK_UNIT))
+    {
+        switch (index)
+        {
+            case UNIT_FIELD_FLAGS:                          // gm
+            case UNIT_FIELD_DISPLAYID:                      // gm, for trigger creatures
+            case UNIT_DYNAMIC_FLAGS:                        // loot and tap, raf
+            case UNIT_FIELD_BYTES_2:                        // group
+            case UNIT_FIELD_FACTIONTEMPLATE:                // group
+            case UNIT_FIELD_HEALTH:
+            case UNIT_FIELD_MAXHEALTH:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    if (isType(TYPEMASK_GAMEOBJECT))
+        return index == GAMEOBJECT_DYN_FLAGS;               // quest activation
+
+    return false;
+}
+
+void Object::BuildSharedValuesUpdateBlock(ByteBuffer& block, UpdateFieldOffsets& viewerFields, Player* target) const
+{
+    ASSERT(target != this);
+
+    block << (uint8) UPDATETYPE_VALUES;
+    block << (uint8)0xFF;
+    block << GetGUID();
+
+    UpdateMask updateMask;
+    updateMask.SetCount(m_valuesCount);
+
+    _SetUpdateBits(&updateMask, target);
+    _BuildValuesUpdate(UPDATETYPE_VALUES, &block, &updateMask, target);
+
+    // every field is sent as 4 bytes after the header and the mask
+    size_t pos = 1 + 1 + 8 + 1 + updateMask.GetLength();
+    for (uint16 index = 0; index < m_valuesCount; ++index)
+    {
+        if (!updateMask.GetBit(index))
+            continue;
+
+        if (IsViewerDependentField(index))
+            viewerFields.push_back(UpdateFieldOffsets::value_type(index, pos));
+
+        pos += 4;
+    }
+
+    ASSERT(pos == block.wpos());
+}
+
+void Object::PatchValuesUpdateBlock(ByteBuffer& block, UpdateFieldOffsets const& viewerFields, Player* target) const
+{
+    ByteBuffer field(4);
+
+    for (UpdateFieldOffsets::const_iterator itr = viewerFields.begin(); itr != viewerFields.end(); ++itr)
+    {
+        field.clear();
+
+        if (isType(TYPEMASK_UNIT))
+            _BuildUnitUpdateField(&field, itr->first, target);
+        else
+        {
+            GameObject const* go = (GameObject const*)this;
+            _BuildGameObjectUpdateField(&field, itr->first, !go->IsTransport() && (go->ActivateToQuest(target) || target->IsGameMaster()));
+        }
+
+        ASSERT(field.wpos() == 4);
+        block.put(itr->second, field.contents(), 4);
     }
 }
 
@@ -862,6 +940,10 @@ void Object::SetFloatValue(uint16 index, float value)
     {
         m_floatValues[ index ] = value;
 
+        // object size is part of the grid cell index
+        if (index == UNIT_FIELD_COMBATREACH && isType(TYPEMASK_UNIT))
+            ToUnit()->UpdateGridSpatialIndex();
+
         if (m_inWorld)
         {
             if (!m_objectUpdated)
@@ -2110,6 +2192,11 @@ TempSummon* Map::SummonCreature(uint32 entry, const Position& pos, SummonPropert
         summon->SetTempSummonType(spwType);
     summon->InitStats(duration);
     AddToMap(summon->ToCreature());
+
+    // summoned into another region while regions update, not in the world yet
+    if (!summon->IsInWorld() && DeferSummon(summon))
+        return summon;
+
     summon->InitSummon();
 
     return summon;
@@ -2139,36 +2226,17 @@ void WorldObject::SetZoneScript()
 
 Pet* Player::SummonPet(uint32 entry, float x, float y, float z, float ang, PetType petType, uint32 duration)
 {
-    Pet* pet = new Pet(this, petType);
     SetPetStatus(PET_STATUS_CURRENT);
 
-    if (petType == SUMMON_PET && pet->LoadPetFromDB(this, entry))
-    {
-        // Remove Demonic Sacrifice auras (known pet)
-        Unit::AuraList const& auraClassScripts = GetAurasByType(SPELL_AURA_OVERRIDE_CLASS_SCRIPTS);
-        for (Unit::AuraList::const_iterator itr = auraClassScripts.begin(); itr != auraClassScripts.end();)
-        {
-            if ((*itr)->GetModifier()->m_miscvalue == 2228)
-            {
-                RemoveAurasDueToSpell((*itr)->GetId());
-                itr = auraClassScripts.begin();
-            }
-            else
-                ++itr;
-        }
-
-        if (duration > 0)
-            pet->SetDuration(duration);
-
+    // a known pet is loaded by the world thread, which also removes Demonic Sacrifice then
+    if (petType == SUMMON_PET && Pet::LoadSummonPetFromDBAsync(this, entry, duration))
         return NULL;
-    }
 
     // petentry == 0 for hunter "call pet" (current pet summoned if any)
     if (!entry)
-    {
-        delete pet;
         return NULL;
-    }
+
+    Pet* pet = new Pet(this, petType);
 
     Map* map = GetMap();
     uint32 pet_number = sObjectMgr.GeneratePetNumber();
@@ -2228,20 +2296,7 @@ Pet* Player::SummonPet(uint32 entry, float x, float y, float z, float ang, PetTy
     }
 
     if (petType == SUMMON_PET)
-    {
-        // Remove Demonic Sacrifice auras (known pet)
-        Unit::AuraList const& auraClassScripts = GetAurasByType(SPELL_AURA_OVERRIDE_CLASS_SCRIPTS);
-        for (Unit::AuraList::const_iterator itr = auraClassScripts.begin(); itr != auraClassScripts.end();)
-        {
-            if ((*itr)->GetModifier()->m_miscvalue == 2228)
-            {
-                RemoveAurasDueToSpell((*itr)->GetId());
-                itr = auraClassScripts.begin();
-            }
-            else
-                ++itr;
-        }
-    }
+        RemoveDemonicSacrifice();
 
     if (duration > 0)
         pet->SetDuration(duration);
@@ -2249,6 +2304,21 @@ Pet* Player::SummonPet(uint32 entry, float x, float y, float z, float ang, PetTy
     return pet;
 }
 
+void Player::RemoveDemonicSacrifice()
+{
+    Unit::AuraList const& auraClassScripts = GetAurasByType(SPELL_AURA_OVERRIDE_CLASS_SCRIPTS);
+    for (Unit::AuraList::const_iterator itr = auraClassScripts.begin(); itr != auraClassScripts.end();)
+    {
+        if ((*itr)->GetModifier()->m_miscvalue == 2228)
+        {
+            RemoveAurasDueToSpell((*itr)->GetId());
+            itr = auraClassScripts.begin();
+        }
+        else
+            ++itr;
+    }
+}
+
 GameObject* WorldObject::SummonGameObject(uint32 entry, float x, float y, float z, float ang, float rotation0, float rotation1, float rotation2, float rotation3, uint32 respawnTime)
 {
     if (!IsInWorld())
@@ -2588,6 +2658,9 @@ void WorldObject::SetPhaseMask(uint32 newPhaseMask, bool update)
 {
     m_phaseMask = newPhaseMask;
 
+    if (m_gridSpatialSlot.index)
+        m_gridSpatialSlot.index->SetPhaseMask(m_gridSpatialSlot.slot, newPhaseMask);
+
     if (update && IsInWorld())
         UpdateObjectVisibility();
 }
@@ -2659,7 +2732,9 @@ struct WorldObjectChangeAccumulator
     UpdateDataMapType& i_updateDatas;
     WorldObject& i_object;
     std::set<uint64> plr_list;
-    WorldObjectChangeAccumulator(WorldObject& obj, UpdateDataMapType& d) : i_updateDatas(d), i_object(obj) {}
+    ByteBuffer i_block;                                     // built for the first player, patched for the others
+    Object::UpdateFieldOffsets i_viewerFields;
+    WorldObjectChangeAccumulator(WorldObject& obj, UpdateDataMapType& d) : i_updateDatas(d), i_object(obj), i_block(500) {}
     void Visit(PlayerMapType& m)
     {
         for (PlayerMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
@@ -2705,11 +2780,32 @@ struct WorldObjectChangeAccumulator
         // Only send update once to a player
         if (plr_list.find(plr->GetGUID()) == plr_list.end() && plr->HaveAtClient(&i_object))
         {
-            i_object.BuildFieldsUpdate(plr, i_updateDatas);
+            // a player sees fields of its own nobody else does
+            if (plr == &i_object)
+                i_object.BuildFieldsUpdate(plr, i_updateDatas);
+            else
+                BuildSharedUpdate(plr);
             plr_list.insert(plr->GetGUID());
         }
     }
 
+    void BuildSharedUpdate(Player* plr)
+    {
+        UpdateData& data = i_updateDatas[plr];
+
+        if (i_block.empty())
+            i_object.BuildSharedValuesUpdateBlock(i_block, i_viewerFields, plr);
+        else if (!i_viewerFields.empty())
+        {
+            ByteBuffer block(i_block);
+            i_object.PatchValuesUpdateBlock(block, i_viewerFields, plr);
+            data.AddUpdateBlock(block);
+            return;
+        }
+
+        data.AddUpdateBlock(i_block);
+    }
+
     template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
 };
 
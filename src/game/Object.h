@@ -24,6 +24,7 @@
 #include "UpdateFields.h"
 #include "UpdateData.h"
 #include "GameSystem/GridReference.h"
+#include "GameSystem/GridRefManager.h"
 #include "ObjectGuid.h"
 #include "GridDefines.h"
 #include "Map.h"
@@ -196,6 +197,12 @@ class Object
         void SendUpdateToPlayer(Player* player);
 
         void BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target) const;
+
+        // values update serialized once for all players seeing the object but itself,
+        // the fields that differ per player are written again into a copy for each
+        typedef std::vector<std::pair<uint16, size_t> > UpdateFieldOffsets;
+        void BuildSharedValuesUpdateBlock(ByteBuffer& block, UpdateFieldOffsets& viewerFields, Player* target) const;
+        void PatchValuesUpdateBlock(ByteBuffer& block, UpdateFieldOffsets const& viewerFields, Player* target) const;
         void BuildOutOfRangeUpdateBlock(UpdateData* data) const;
         void BuildMovementUpdateBlock(UpdateData* data, uint32 flags = 0) const;
 
@@ -396,6 +403,9 @@ class Object
         virtual void _SetCreateBits(UpdateMask* updateMask, Player* target) const;
         void _BuildMovementUpdate(ByteBuffer* data, uint8 updateFlags) const;
         void _BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target) const;
+        void _BuildUnitUpdateField(ByteBuffer* data, uint16 index, Player* target) const;
+        void _BuildGameObjectUpdateField(ByteBuffer* data, uint16 index, bool activateToQuest) const;
+        bool IsViewerDependentField(uint16 index) const;
 
         uint16 m_objectType;
 
@@ -572,6 +582,37 @@ class WorldLocation : public Position
         uint32 m_mapId;
 };
 
+// Grid link of a world object, also registers the object in the spatial index of the cell
+template<class T>
+class GridObjectReference : public GridReference<T>
+{
+    protected:
+        void targetObjectBuildLink() override
+        {
+            GridReference<T>::targetObjectBuildLink();
+            T* obj = this->GetSource();
+            this->getTarget()->GetSpatialIndex().Insert(&obj->GetGridSpatialSlot(), obj,
+                obj->GetPositionX(), obj->GetPositionY(), obj->GetPositionZ(), obj->GetObjectSize(), obj->GetPhaseMask());
+        }
+        void targetObjectDestroyLink() override
+        {
+            if (this->isValid())
+                this->getTarget()->GetSpatialIndex().Remove(&this->GetSource()->GetGridSpatialSlot());
+            GridReference<T>::targetObjectDestroyLink();
+        }
+        void sourceObjectDestroyLink() override
+        {
+            this->getTarget()->GetSpatialIndex().Remove(&this->GetSource()->GetGridSpatialSlot());
+            GridReference<T>::sourceObjectDestroyLink();
+        }
+    public:
+        ~GridObjectReference() override
+        {
+            // unlink while our overrides are still in place
+            this->unlink();
+        }
+};
+
 template<class T>
 class GridObject
 {
@@ -580,7 +621,7 @@ class GridObject
         void AddToGrid(GridRefManager<T>& m) { ASSERT(!IsInGrid()); _gridRef.link(&m, (T*)this); }
         void RemoveFromGrid() { ASSERT(IsInGrid()); _gridRef.unlink(); }
     private:
-        GridReference<T> _gridRef;
+        GridObjectReference<T> _gridRef;
 };
 
 template <class T_VALUES, class T_FLAGS, class FLAG_TYPE, uint8 ARRAY_SIZE>
@@ -646,6 +687,20 @@ class WorldObject : public Object, public WorldLocation
         {
             return (m_valuesCount > UNIT_FIELD_COMBATREACH) ? m_floatValues[UNIT_FIELD_COMBATREACH] : DEFAULT_WORLD_OBJECT_SIZE;
         }
+
+        // hide Position::Relocate so every move of a world object reaches the grid cell index
+        void Relocate(float x, float y) { Position::Relocate(x, y); UpdateGridSpatialIndex(); }
+        void Relocate(float x, float y, float z) { Position::Relocate(x, y, z); UpdateGridSpatialIndex(); }
+        void Relocate(float x, float y, float z, float orientation) { Position::Relocate(x, y, z, orientation); UpdateGridSpatialIndex(); }
+        void Relocate(Position const& pos) { Position::Relocate(pos); UpdateGridSpatialIndex(); }
+        void Relocate(Position const* pos) { Position::Relocate(pos); UpdateGridSpatialIndex(); }
+
+        GridSpatialSlot& GetGridSpatialSlot() { return m_gridSpatialSlot; }
+        void UpdateGridSpatialIndex()
+        {
+            if (m_gridSpatialSlot.index)
+                m_gridSpatialSlot.index->Relocate(m_gridSpatialSlot.slot, GetPositionX(), GetPositionY(), GetPositionZ(), GetObjectSize());
+        }
         void UpdateGroundPositionZ(float x, float y, float& z) const;
         void UpdateAllowedPositionZ(float x, float y, float& z) const;
 
@@ -915,6 +970,7 @@ class WorldObject : public Object, public WorldLocation
         //uint32 m_mapId;                                     // object at map with map_id
         uint32 m_InstanceId;                                // in map copy with instance id
         uint32 m_phaseMask;                                 // in area phase state
+        GridSpatialSlot m_gridSpatialSlot;                  // entry in the spatial index of the grid cell, if in grid
 
         uint16 m_notifyflags;
         uint16 m_executed_notifies;
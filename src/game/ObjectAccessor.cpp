@@ -156,14 +156,7 @@ Player* ObjectAccessor::FindPlayer(uint64 guid, bool force)
     if (!force)
         return GetObjectInWorld(guid, (Player*)NULL);
 
-    Guard guard(*HashMapHolder<Player>::GetLock());
-
-    HashMapHolder<Player>::MapType& m = HashMapHolder<Player>::GetContainer();
-    for (HashMapHolder<Player>::MapType::iterator iter = m.begin(); iter != m.end(); ++iter)
-        if (iter->second->GetGUID() == guid)
-            return iter->second;
-
-    return NULL;
+    return HashMapHolder<Player>::Find(guid);
 }
 
 Unit* ObjectAccessor::FindUnit(uint64 guid)
@@ -173,33 +166,41 @@ Unit* ObjectAccessor::FindUnit(uint64 guid)
 
 Player* ObjectAccessor::FindPlayerByName(const char* name, bool force)
 {
-    Guard guard(*HashMapHolder<Player>::GetLock());
-
-    HashMapHolder<Player>::MapType& m = HashMapHolder<Player>::GetContainer();
-    for (HashMapHolder<Player>::MapType::iterator iter = m.begin(); iter != m.end(); ++iter)
-        if (!strcmp(name, iter->second->GetName()) && (iter->second->IsInWorld() || force))
-            return iter->second;
+    for (uint32 i = 0; i < HashMapHolder<Player>::GetShardCount(); ++i)
+    {
+        HashMapHolder<Player>::ReadGuard guard(*HashMapHolder<Player>::GetLock(i));
+        HashMapHolder<Player>::MapType& m = HashMapHolder<Player>::GetContainer(i);
+        for (HashMapHolder<Player>::MapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+            if (!strcmp(name, iter->second->GetName()) && (iter->second->IsInWorld() || force))
+                return iter->second;
+    }
 
     return NULL;
 }
 
 Player* ObjectAccessor::FindPlayerByAccountId(uint64 Id, bool force)
 {
-    Guard guard(*HashMapHolder<Player>::GetLock());
-    HashMapHolder<Player>::MapType& m = HashMapHolder<Player>::GetContainer();
-    for (HashMapHolder<Player>::MapType::iterator iter = m.begin(); iter != m.end(); ++iter)
-        if (iter->second->GetSession()->GetAccountId() == Id && (iter->second->IsInWorld() || force))
-            return iter->second;
+    for (uint32 i = 0; i < HashMapHolder<Player>::GetShardCount(); ++i)
+    {
+        HashMapHolder<Player>::ReadGuard guard(*HashMapHolder<Player>::GetLock(i));
+        HashMapHolder<Player>::MapType& m = HashMapHolder<Player>::GetContainer(i);
+        for (HashMapHolder<Player>::MapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+            if (iter->second->GetSession()->GetAccountId() == Id && (iter->second->IsInWorld() || force))
+                return iter->second;
+    }
 
     return NULL;
 }
 
 void ObjectAccessor::SaveAllPlayers()
 {
-    Guard guard(*HashMapHolder<Player>::GetLock());
-    HashMapHolder<Player>::MapType& m = HashMapHolder<Player>::GetContainer();
-    for (HashMapHolder<Player>::MapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        itr->second->SaveToDB();
+    for (uint32 i = 0; i < HashMapHolder<Player>::GetShardCount(); ++i)
+    {
+        HashMapHolder<Player>::ReadGuard guard(*HashMapHolder<Player>::GetLock(i));
+        HashMapHolder<Player>::MapType& m = HashMapHolder<Player>::GetContainer(i);
+        for (HashMapHolder<Player>::MapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+            itr->second->SaveToDB();
+    }
 }
 
 Corpse* ObjectAccessor::GetCorpseForPlayerGUID(uint64 guid)
@@ -394,15 +395,14 @@ void ObjectAccessor::Update(uint32 /*diff*/)
     for (UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
     {
         iter->second.BuildPacket(&packet);
-        iter->first->GetSession()->SendPacket(&packet);
+        iter->first->GetSession()->SendPacket(std::move(packet));
         packet.clear();                                     // clean the string
     }
 }
 
 // Define the static members of HashMapHolder
 
-template <class T> UNORDERED_MAP< uint64, T* > HashMapHolder<T>::m_objectMap;
-template <class T> ACE_Thread_Mutex HashMapHolder<T>::i_lock;
+template <class T> typename HashMapHolder<T>::Shard HashMapHolder<T>::m_shards[HASHMAPHOLDER_SHARDS];
 
 // Global definitions for the hashmap storage
 
@@ -21,6 +21,8 @@
 #include "Platform/Define.h"
 #include "Policies/Singleton.h"
 #include <ace/Thread_Mutex.h>
+#include <ace/RW_Thread_Mutex.h>
+#include <ace/Guard_T.h>
 #include "Utilities/UnorderedMap.h"
 #include "Policies/ThreadingModel.h"
 
@@ -41,50 +43,81 @@ class DynamicObject;
 class WorldObject;
 class Map;
 
+// number of independently locked parts of every HashMapHolder
+#define HASHMAPHOLDER_SHARDS 16
+
+// Objects are spread over HASHMAPHOLDER_SHARDS maps by guid, each with its own
+// reader/writer lock, so lookups from different map threads don't serialize.
+// To walk all objects, iterate the shards and hold each shard's read lock:
+//   for (uint32 i = 0; i < HashMapHolder<Player>::GetShardCount(); ++i)
+//   {
+//       HashMapHolder<Player>::ReadGuard guard(*HashMapHolder<Player>::GetLock(i));
+//       HashMapHolder<Player>::MapType& m = HashMapHolder<Player>::GetContainer(i);
+//       ...
+//   }
 template <class T>
 class HashMapHolder
 {
     public:
 
         typedef UNORDERED_MAP<uint64, T*> MapType;
-        typedef ACE_Thread_Mutex LockType;
-        typedef Oregon::GeneralLock<LockType > Guard;
+        typedef ACE_RW_Thread_Mutex LockType;
+        typedef ACE_Read_Guard<LockType> ReadGuard;
+        typedef ACE_Write_Guard<LockType> WriteGuard;
 
         static void Insert(T* o)
         {
-            Guard guard(i_lock);
-            m_objectMap[o->GetGUID()] = o;
+            Shard& shard = GetShard(o->GetGUID());
+            WriteGuard guard(shard.lock);
+            shard.objects[o->GetGUID()] = o;
         }
 
         static void Remove(T* o)
         {
-            Guard guard(i_lock);
-            m_objectMap.erase(o->GetGUID());
+            Shard& shard = GetShard(o->GetGUID());
+            WriteGuard guard(shard.lock);
+            shard.objects.erase(o->GetGUID());
         }
 
         static T* Find(uint64 guid)
         {
-            Guard guard(i_lock);
-            typename MapType::iterator itr = m_objectMap.find(guid);
-            return (itr != m_objectMap.end()) ? itr->second : NULL;
+            Shard& shard = GetShard(guid);
+            ReadGuard guard(shard.lock);
+            typename MapType::iterator itr = shard.objects.find(guid);
+            return (itr != shard.objects.end()) ? itr->second : NULL;
         }
 
-        static MapType& GetContainer()
+        static uint32 GetShardCount()
         {
-            return m_objectMap;
+            return HASHMAPHOLDER_SHARDS;
         }
 
-        static LockType* GetLock()
+        static MapType& GetContainer(uint32 shard)
         {
-            return &i_lock;
+            return m_shards[shard].objects;
+        }
+
+        static LockType* GetLock(uint32 shard)
+        {
+            return &m_shards[shard].lock;
         }
     private:
 
         //Non instanceable only static
         HashMapHolder() {}
 
-        static LockType i_lock;
-        static MapType  m_objectMap;
+        struct Shard
+        {
+            LockType lock;
+            MapType  objects;
+        };
+
+        static Shard& GetShard(uint64 guid)
+        {
+            return m_shards[GUID_LOPART(guid) % HASHMAPHOLDER_SHARDS];
+        }
+
+        static Shard m_shards[HASHMAPHOLDER_SHARDS];
 };
 
 class ObjectAccessor : public Oregon::Singleton<ObjectAccessor, Oregon::ClassLevelLockable<ObjectAccessor, ACE_Thread_Mutex> >
@@ -185,22 +218,22 @@ class ObjectAccessor : public Oregon::Singleton<ObjectAccessor, Oregon::ClassLev
         Player* FindPlayerByName(const char* name, bool force = false);
         Player* FindPlayerByAccountId(uint64 Id, bool force = false);
 
-        // when using this, you must use the hashmapholder's lock
-        HashMapHolder<Player>::MapType& GetPlayers()
+        // when using this, you must hold the read lock of the shard
+        HashMapHolder<Player>::MapType& GetPlayers(uint32 shard)
         {
-            return HashMapHolder<Player>::GetContainer();
+            return HashMapHolder<Player>::GetContainer(shard);
         }
 
-        // when using this, you must use the hashmapholder's lock
-        static HashMapHolder<Creature>::MapType const& GetCreatures()
+        // when using this, you must hold the read lock of the shard
+        static HashMapHolder<Creature>::MapType const& GetCreatures(uint32 shard)
         {
-            return HashMapHolder<Creature>::GetContainer();
+            return HashMapHolder<Creature>::GetContainer(shard);
         }
 
-        // when using this, you must use the hashmapholder's lock
-        static HashMapHolder<GameObject>::MapType const& GetGameObjects()
+        // when using this, you must hold the read lock of the shard
+        static HashMapHolder<GameObject>::MapType const& GetGameObjects(uint32 shard)
         {
-            return HashMapHolder<GameObject>::GetContainer();
+            return HashMapHolder<GameObject>::GetContainer(shard);
         }
 
         template<class T> void AddObject(T* object)
@@ -277,15 +277,19 @@ LanguageDesc const* GetLanguageDescByID(uint32 lang)
     return NULL;
 }
 
-ObjectMgr::ObjectMgr()
+ObjectMgr::ObjectMgr() :
+    m_creatureGuids(GUID_ALLOCATOR_CREATURE, "Creature", 0x00FFFFFD, true),
+    m_petGuids(GUID_ALLOCATOR_PET, "Pet", 0x00FFFFFD, true),
+    m_goGuids(GUID_ALLOCATOR_GAMEOBJECT, "Gameobject", 0x00FFFFFD, true),
+    m_doGuids(GUID_ALLOCATOR_DYNAMICOBJECT, "DynamicObject", 0xFFFFFFFD, false)
 {
     m_hiCharGuid        = 1;
-    m_hiCreatureGuid    = 1;
-    m_hiPetGuid         = 1;
     m_hiItemGuid        = 1;
-    m_hiGoGuid          = 1;
-    m_hiDoGuid          = 1;
     m_hiCorpseGuid      = 1;
+    m_guidAllocators[GUID_ALLOCATOR_CREATURE]       = &m_creatureGuids;
+    m_guidAllocators[GUID_ALLOCATOR_PET]            = &m_petGuids;
+    m_guidAllocators[GUID_ALLOCATOR_GAMEOBJECT]     = &m_goGuids;
+    m_guidAllocators[GUID_ALLOCATOR_DYNAMICOBJECT]  = &m_doGuids;
     m_hiPetNumber       = 1;
     m_ItemTextId        = 1;
     m_mailid            = 1;
@@ -5602,24 +5606,24 @@ void ObjectMgr::SetHighestGuids()
 
     result = WorldDatabase.Query("SELECT MAX(guid) FROM creature");
     if (result)
-        m_hiCreatureGuid = (*result)[0].GetUInt32() + 1;
+        m_creatureGuids.SetNext((*result)[0].GetUInt32() + 1);
 
-    // pet guids are not saved to DB, set to 0 (pet guid != pet id)
-    m_hiPetGuid = 0;
+    // pet guids are not saved to DB (pet guid != pet id)
+    m_petGuids.SetNext(1);
 
     result = CharacterDatabase.Query("SELECT MAX(guid) FROM item_instance");
     if (result)
         m_hiItemGuid = (*result)[0].GetUInt32() + 1;
 
     // Cleanup other tables from not existed guids ( >= m_hiItemGuid)
-    CharacterDatabase.PExecute("DELETE FROM character_inventory WHERE item >= '%u'", m_hiItemGuid);
-    CharacterDatabase.PExecute("DELETE FROM mail_items WHERE item_guid >= '%u'", m_hiItemGuid);
-    CharacterDatabase.PExecute("DELETE FROM auctionhouse WHERE itemguid >= '%u'", m_hiItemGuid);
-    CharacterDatabase.PExecute("DELETE FROM guild_bank_item WHERE item_guid >= '%u'", m_hiItemGuid);
+    CharacterDatabase.PExecute("DELETE FROM character_inventory WHERE item >= '%u'", m_hiItemGuid.load());
+    CharacterDatabase.PExecute("DELETE FROM mail_items WHERE item_guid >= '%u'", m_hiItemGuid.load());
+    CharacterDatabase.PExecute("DELETE FROM auctionhouse WHERE itemguid >= '%u'", m_hiItemGuid.load());
+    CharacterDatabase.PExecute("DELETE FROM guild_bank_item WHERE item_guid >= '%u'", m_hiItemGuid.load());
 
     result = WorldDatabase.Query("SELECT MAX(guid) FROM gameobject");
     if (result)
-        m_hiGoGuid = (*result)[0].GetUInt32() + 1;
+        m_goGuids.SetNext((*result)[0].GetUInt32() + 1);
 
     result = CharacterDatabase.Query("SELECT MAX(id) FROM auctionhouse");
     if (result)
@@ -5712,63 +5716,77 @@ uint32 ObjectMgr::CreateItemText(std::string text)
 
 uint32 ObjectMgr::GenerateLowGuid(HighGuid guidhigh)
 {
+    GuidAllocator* allocator = NULL;
+    uint32 guid = 0;
+
     switch (guidhigh)
     {
     case HIGHGUID_ITEM:
-        if (m_hiItemGuid >= 0xFFFFFFFE)
+        guid = m_hiItemGuid++;
+        if (guid >= 0xFFFFFFFE)
         {
             sLog.outError("Item guid overflow!! Can't continue, shutting down server. ");
             World::StopNow(ERROR_EXIT_CODE);
         }
-        return m_hiItemGuid++;
-    case HIGHGUID_UNIT:
-        if (m_hiCreatureGuid >= 0x00FFFFFE)
-        {
-            sLog.outError("Creature guid overflow!! Can't continue, shutting down server. ");
-            World::StopNow(ERROR_EXIT_CODE);
-        }
-        return m_hiCreatureGuid++;
-    case HIGHGUID_PET:
-        if (m_hiPetGuid >= 0x00FFFFFE)
-        {
-            sLog.outError("Pet guid overflow!! Can't continue, shutting down server. ");
-            World::StopNow(ERROR_EXIT_CODE);
-        }
-        return m_hiPetGuid++;
+        return guid;
     case HIGHGUID_PLAYER:
-        if (m_hiCharGuid >= 0xFFFFFFFE)
+        guid = m_hiCharGuid++;
+        if (guid >= 0xFFFFFFFE)
         {
             sLog.outError("Players guid overflow!! Can't continue, shutting down server. ");
             World::StopNow(ERROR_EXIT_CODE);
         }
-        return m_hiCharGuid++;
-    case HIGHGUID_GAMEOBJECT:
-        if (m_hiGoGuid >= 0x00FFFFFE)
-        {
-            sLog.outError("Gameobject guid overflow!! Can't continue, shutting down server. ");
-            World::StopNow(ERROR_EXIT_CODE);
-        }
-        return m_hiGoGuid++;
+        return guid;
     case HIGHGUID_CORPSE:
-        if (m_hiCorpseGuid >= 0xFFFFFFFE)
+        guid = m_hiCorpseGuid++;
+        if (guid >= 0xFFFFFFFE)
         {
             sLog.outError("Corpse guid overflow!! Can't continue, shutting down server. ");
             World::StopNow(ERROR_EXIT_CODE);
         }
-        return m_hiCorpseGuid++;
+        return guid;
+    case HIGHGUID_UNIT:
+        allocator = &m_creatureGuids;
+        break;
+    case HIGHGUID_PET:
+        allocator = &m_petGuids;
+        break;
+    case HIGHGUID_GAMEOBJECT:
+        allocator = &m_goGuids;
+        break;
     case HIGHGUID_DYNAMICOBJECT:
-        if (m_hiDoGuid >= 0xFFFFFFFE)
-        {
-            sLog.outError("DynamicObject guid overflow!! Can't continue, shutting down server. ");
-            World::StopNow(ERROR_EXIT_CODE);
-        }
-        return m_hiDoGuid++;
+        allocator = &m_doGuids;
+        break;
     default:
         ASSERT(0);
+        return 0;
     }
 
-    ASSERT(0);
-    return 0;
+    guid = allocator->Generate();
+    if (!guid)
+    {
+        sLog.outError("%s guid overflow!! Can't continue, shutting down server. ", allocator->GetName());
+        World::StopNow(ERROR_EXIT_CODE);
+    }
+    return guid;
+}
+
+void ObjectMgr::ReleaseLowGuid(HighGuid guidhigh, uint32 guid)
+{
+    switch (guidhigh)
+    {
+    case HIGHGUID_UNIT:
+        m_creatureGuids.Release(guid);
+        break;
+    case HIGHGUID_PET:
+        m_petGuids.Release(guid);
+        break;
+    case HIGHGUID_GAMEOBJECT:
+        m_goGuids.Release(guid);
+        break;
+    default:
+        break;
+    }
 }
 
 void ObjectMgr::LoadGameObjectLocales()
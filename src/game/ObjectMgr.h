@@ -38,6 +38,7 @@
 #include "Database/SQLStorage.h"
 #include "Path.h"
 #include "ConditionMgr.h"
+#include "GuidAllocator.h"
 
 #include <string>
 #include <map>
@@ -906,6 +907,9 @@ class ObjectMgr
 
         void SetHighestGuids();
         uint32 GenerateLowGuid(HighGuid guidhigh);
+        // guid of a deleted temporary world object, for reuse
+        void ReleaseLowGuid(HighGuid guidhigh, uint32 guid);
+        GuidAllocator* GetGuidAllocator(GuidAllocatorSlot slot) { return m_guidAllocators[slot]; }
         uint32 GenerateAuctionID();
         uint32 GenerateMailID();
         uint32 GenerateItemTextID();
@@ -1195,13 +1199,16 @@ class ObjectMgr
         uint32 m_hiPetNumber;
 
         // first free low guid for seelcted guid type
-        uint32 m_hiCharGuid;
-        uint32 m_hiCreatureGuid;
-        uint32 m_hiPetGuid;
-        uint32 m_hiItemGuid;
-        uint32 m_hiGoGuid;
-        uint32 m_hiDoGuid;
-        uint32 m_hiCorpseGuid;
+        std::atomic<uint32> m_hiCharGuid;
+        std::atomic<uint32> m_hiItemGuid;
+        std::atomic<uint32> m_hiCorpseGuid;
+
+        // world objects, allocated by blocks per thread and partly recycled
+        GuidAllocator m_creatureGuids;
+        GuidAllocator m_petGuids;
+        GuidAllocator m_goGuids;
+        GuidAllocator m_doGuids;
+        GuidAllocator* m_guidAllocators[MAX_GUID_ALLOCATORS];
 
         QuestMap            mQuestTemplates;
 
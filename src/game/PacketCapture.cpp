@@ -0,0 +1,146 @@
+/*
+ * This file is part of the OregonCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "PacketCapture.h"
+#include "WorldPacket.h"
+#include "WorldSession.h"
+#include "Config/Config.h"
+#include "Log.h"
+#include "Timer.h"
+
+#include <ace/Guard_T.h>
+
+INSTANTIATE_SINGLETON_1(PacketCapture);
+
+PacketCapture::PacketCapture() : m_file(NULL), m_startTime(0), m_records(0)
+{
+}
+
+PacketCapture::~PacketCapture()
+{
+    Close();
+}
+
+void PacketCapture::Initialize()
+{
+    std::string filename = sConfig.GetStringDefault("PacketCapture.File", "");
+    if (filename.empty())
+        return;
+
+    m_file = fopen(filename.c_str(), "wb");
+    if (!m_file)
+    {
+        sLog.outError("PacketCapture: cannot open %s for writing, packets are not recorded.", filename.c_str());
+        return;
+    }
+
+    m_startTime = getMSTime64();
+    m_records = 0;
+
+    ByteBuffer header(16);
+    header << uint32(PACKET_CAPTURE_MAGIC);
+    header << uint32(PACKET_CAPTURE_VERSION);
+    header << uint64(time(NULL));
+    if (fwrite(header.contents(), header.size(), 1, m_file) != 1)
+    {
+        sLog.outError("PacketCapture: cannot write to %s, packets are not recorded.", filename.c_str());
+        fclose(m_file);
+        m_file = NULL;
+        return;
+    }
+
+    sLog.outString("Recording the packets of all sessions to %s.", filename.c_str());
+}
+
+void PacketCapture::Close()
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+
+    if (!m_file)
+        return;
+
+    fclose(m_file);
+    m_file = NULL;
+
+    sLog.outString("PacketCapture: %u records written.", m_records);
+}
+
+void PacketCapture::StartRecord(ByteBuffer& record, PacketCaptureRecord type, uint32 accountId)
+{
+    record << uint8(type);
+    record << uint32(0);                                    // time, set by Write
+    record << uint32(accountId);
+}
+
+void PacketCapture::Write(ByteBuffer& record)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+
+    if (!m_file)
+        return;
+
+    // time is taken under the lock, so records are in time order whatever thread writes them
+    record.put<uint32>(1, uint32(getMSTime64() - m_startTime));
+
+    if (fwrite(record.contents(), record.size(), 1, m_file) != 1)
+    {
+        sLog.outError("PacketCapture: write failed, recording stopped.");
+        fclose(m_file);
+        m_file = NULL;
+        return;
+    }
+
+    ++m_records;
+}
+
+void PacketCapture::RecordSessionOpen(uint32 accountId, uint32 security, uint8 expansion, time_t muteTime, LocaleConstant locale)
+{
+    if (!m_file)
+        return;
+
+    ByteBuffer record(20);
+    StartRecord(record, CAPTURE_SESSION_OPEN, accountId);
+    record << uint8(security);
+    record << uint8(expansion);
+    record << uint8(locale);
+    record << uint64(muteTime);
+    Write(record);
+}
+
+void PacketCapture::RecordPacket(WorldSession const* session, WorldPacket const& packet)
+{
+    if (!m_file)
+        return;
+
+    ByteBuffer record(15 + packet.size());
+    StartRecord(record, CAPTURE_PACKET, session->GetAccountId());
+    record << uint16(packet.GetOpcode());
+    record << uint32(packet.size());
+    if (packet.size())
+        record.append(packet.contents(), packet.size());
+    Write(record);
+}
+
+void PacketCapture::RecordSessionClose(WorldSession const* session)
+{
+    if (!m_file)
+        return;
+
+    ByteBuffer record(9);
+    StartRecord(record, CAPTURE_SESSION_CLOSE, session->GetAccountId());
+    Write(record);
+}
@@ -0,0 +1,84 @@
+/*
+ * This file is part of the OregonCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __PACKETCAPTURE_H
+#define __PACKETCAPTURE_H
+
+#include "Common.h"
+#include "Policies/Singleton.h"
+#include "ByteBuffer.h"
+
+#include <ace/Thread_Mutex.h>
+
+class WorldPacket;
+class WorldSession;
+
+/*
+ * Capture file layout, all values little endian:
+ *
+ *   header: uint32 magic, uint32 version, uint64 unix time of the capture start
+ *   record: uint8 type, uint32 ms since the capture start, uint32 account id, then
+ *     CAPTURE_SESSION_OPEN:  uint8 security, uint8 expansion, uint8 locale, uint64 mute time
+ *     CAPTURE_PACKET:        uint16 opcode, uint32 size, size bytes of decrypted packet data
+ *     CAPTURE_SESSION_CLOSE: nothing
+ */
+#define PACKET_CAPTURE_MAGIC    0x5041434F                  // "OCAP"
+#define PACKET_CAPTURE_VERSION  1
+
+enum PacketCaptureRecord
+{
+    CAPTURE_SESSION_OPEN    = 0,
+    CAPTURE_PACKET          = 1,
+    CAPTURE_SESSION_CLOSE   = 2
+};
+
+/**
+ * Records the packets clients send to the world, for PacketReplay.
+ *
+ * Only packets handed to a WorldSession are recorded, the ones the socket
+ * answers itself (ping, keep alive, authentication) are not. Records come
+ * from the network threads and the world thread and are written in the
+ * order they happened.
+ */
+class PacketCapture
+{
+    public:
+        PacketCapture();
+        ~PacketCapture();
+
+        // opens the file set by PacketCapture.File, if any
+        void Initialize();
+        void Close();
+
+        bool IsActive() const { return m_file != NULL; }
+
+        void RecordSessionOpen(uint32 accountId, uint32 security, uint8 expansion, time_t muteTime, LocaleConstant locale);
+        void RecordPacket(WorldSession const* session, WorldPacket const& packet);
+        void RecordSessionClose(WorldSession const* session);
+
+    private:
+        void StartRecord(ByteBuffer& record, PacketCaptureRecord type, uint32 accountId);
+        void Write(ByteBuffer& record);
+
+        FILE* m_file;
+        uint64 m_startTime;                                 // getMSTime64() at the capture start
+        uint32 m_records;
+        ACE_Thread_Mutex m_lock;
+};
+
+#define sPacketCapture Oregon::Singleton<PacketCapture>::Instance()
+#endif
@@ -0,0 +1,282 @@
+/*
+ * This file is part of the OregonCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "PacketReplay.h"
+#include "WorldPacket.h"
+#include "WorldSession.h"
+#include "World.h"
+#include "Log.h"
+#include "Timer.h"
+#include "Utilities/Util.h"
+
+#include <algorithm>
+#include <chrono>
+
+// ticks run after the end of the capture until the last sessions are gone
+#define REPLAY_MAX_DRAIN_TICKS  200
+
+PacketReplay::PacketReplay() : m_file(NULL), m_captureStart(0), m_haveRecord(false), m_type(0), m_time(0),
+    m_accountId(0), m_sessions(0), m_packets(0), m_skipped(0)
+{
+}
+
+PacketReplay::~PacketReplay()
+{
+    if (m_file)
+        fclose(m_file);
+}
+
+bool PacketReplay::Open(char const* filename)
+{
+    m_file = fopen(filename, "rb");
+    if (!m_file)
+    {
+        sLog.outError("PacketReplay: cannot open %s.", filename);
+        return false;
+    }
+
+    uint8 raw[16];
+    if (fread(raw, sizeof(raw), 1, m_file) != 1)
+    {
+        sLog.outError("PacketReplay: %s is not a packet capture.", filename);
+        return false;
+    }
+
+    ByteBuffer header(sizeof(raw));
+    header.append(raw, sizeof(raw));
+
+    uint32 magic, version;
+    uint64 start;
+    header >> magic >> version >> start;
+
+    if (magic != PACKET_CAPTURE_MAGIC || version != PACKET_CAPTURE_VERSION)
+    {
+        sLog.outError("PacketReplay: %s is not a packet capture of version %u.", filename, PACKET_CAPTURE_VERSION);
+        return false;
+    }
+
+    m_captureStart = time_t(start);
+    return ReadRecord();
+}
+
+bool PacketReplay::ReadRecord()
+{
+    m_haveRecord = false;
+
+    uint8 raw[9];
+    size_t read = fread(raw, 1, sizeof(raw), m_file);
+    if (!read)
+        return true;                                        // end of the capture
+
+    if (read != sizeof(raw))
+    {
+        sLog.outError("PacketReplay: the capture ends inside a record.");
+        return false;
+    }
+
+    m_data.clear();
+    m_data.append(raw, sizeof(raw));
+    m_data >> m_type >> m_time >> m_accountId;
+
+    size_t size;
+    switch (m_type)
+    {
+        case CAPTURE_SESSION_OPEN:
+            size = 11;
+            break;
+        case CAPTURE_PACKET:
+        {
+            uint8 packetHeader[6];
+            if (fread(packetHeader, sizeof(packetHeader), 1, m_file) != 1)
+            {
+                sLog.outError("PacketReplay: the capture ends inside a record.");
+                return false;
+            }
+
+            m_data.append(packetHeader, sizeof(packetHeader));
+            size = m_data.read<uint32>(m_data.rpos() + 2);
+            break;
+        }
+        case CAPTURE_SESSION_CLOSE:
+            size = 0;
+            break;
+        default:
+            sLog.outError("PacketReplay: unknown record type %u.", m_type);
+            return false;
+    }
+
+    if (size)
+    {
+        std::vector<uint8> payload(size);
+        if (fread(&payload[0], size, 1, m_file) != 1)
+        {
+            sLog.outError("PacketReplay: the capture ends inside a record.");
+            return false;
+        }
+
+        m_data.append(&payload[0], size);
+    }
+
+    m_haveRecord = true;
+    return true;
+}
+
+WorldSession* PacketReplay::FindSession(uint32 accountId) const
+{
+    SessionMap::const_iterator itr = m_added.find(accountId);
+    if (itr != m_added.end())
+        return itr->second;
+
+    return sWorld.FindSession(accountId);
+}
+
+void PacketReplay::ApplyRecord()
+{
+    switch (m_type)
+    {
+        case CAPTURE_SESSION_OPEN:
+        {
+            uint8 security, expansion, locale;
+            uint64 muteTime;
+            m_data >> security >> expansion >> locale >> muteTime;
+
+            WorldSession* session = new WorldSession(m_accountId, NULL, security, expansion, time_t(muteTime), LocaleConstant(locale));
+            session->SetReplayConnected(true);
+            session->ResetTimeOutTime();
+
+            sWorld.AddSession(session);
+            m_added[m_accountId] = session;
+            ++m_sessions;
+            break;
+        }
+        case CAPTURE_PACKET:
+        {
+            uint16 opcode;
+            uint32 size;
+            m_data >> opcode >> size;
+
+            WorldSession* session = FindSession(m_accountId);
+            if (!session)
+            {
+                ++m_skipped;
+                break;
+            }
+
+            WorldPacket* packet = new WorldPacket(opcode, size);
+            if (size)
+                packet->append(m_data.contents() + m_data.rpos(), size);
+
+            // like WorldSocket::ProcessIncoming
+            session->ResetTimeOutTime();
+            session->QueuePacket(packet);
+            ++m_packets;
+            break;
+        }
+        case CAPTURE_SESSION_CLOSE:
+            if (WorldSession* session = FindSession(m_accountId))
+                session->KickPlayer();
+            break;
+    }
+}
+
+bool PacketReplay::Run(uint32 tickDiff, uint32 seed)
+{
+    if (!tickDiff)
+        tickDiff = 1;
+
+    sLog.outString("PacketReplay: replaying the capture of %s in %u ms steps, random seed %u.",
+                   TimeToTimestampStr(m_captureStart).c_str(), tickDiff, seed);
+
+    rand_seed(seed);
+
+    // the relative times must match the capture, the game time is the one of the capture
+    SimulatedClock::Start(getMSTime64(), m_captureStart);
+
+    uint32 simulated = 0;
+    uint32 drainTicks = 0;
+    bool ok = true;
+
+    while (!World::IsStopped())
+    {
+        simulated += tickDiff;
+        SimulatedClock::Advance(tickDiff);
+
+        while (m_haveRecord && m_time <= simulated)
+        {
+            ApplyRecord();
+            if (!ReadRecord())
+            {
+                ok = false;
+                break;
+            }
+
+            // the capture stopped with players online
+            if (!m_haveRecord)
+            {
+                sWorld.KickAll();
+                for (SessionMap::const_iterator itr = m_added.begin(); itr != m_added.end(); ++itr)
+                    itr->second->KickPlayer();
+            }
+        }
+
+        if (!ok)
+            break;
+
+        if (!m_haveRecord && m_added.empty() && !sWorld.GetActiveAndQueuedSessionCount())
+            break;
+
+        if (!m_haveRecord && ++drainTicks > REPLAY_MAX_DRAIN_TICKS)
+        {
+            sLog.outError("PacketReplay: %u sessions still open after the end of the capture.", sWorld.GetActiveAndQueuedSessionCount());
+            break;
+        }
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        sWorld.Update(tickDiff);
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+        m_tickTimes.push_back(uint32(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()));
+        m_added.clear();
+    }
+
+    PrintResults(simulated);
+
+    // world shutdown runs on the real clock again
+    SimulatedClock::Stop();
+    return ok;
+}
+
+void PacketReplay::PrintResults(uint32 simulated) const
+{
+    sLog.outString("PacketReplay: %u sessions, %u packets replayed, %u packets of closed sessions skipped, %u s simulated.",
+                   m_sessions, m_packets, m_skipped, simulated / IN_MILLISECONDS);
+
+    if (m_tickTimes.empty())
+        return;
+
+    std::vector<uint32> sorted(m_tickTimes);
+    std::sort(sorted.begin(), sorted.end());
+
+    uint64 sum = 0;
+    for (std::vector<uint32>::const_iterator itr = sorted.begin(); itr != sorted.end(); ++itr)
+        sum += *itr;
+
+    size_t count = sorted.size();
+    sLog.outString("PacketReplay: %u world updates, avg %.3f ms, p50 %.3f ms, p95 %.3f ms, p99 %.3f ms, max %.3f ms, total %.3f s",
+                   uint32(count), sum / 1000.0 / count, sorted[count / 2] / 1000.0, sorted[count * 95 / 100] / 1000.0,
+                   sorted[count * 99 / 100] / 1000.0, sorted.back() / 1000.0, sum / 1000000.0);
+}
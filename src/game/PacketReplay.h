@@ -0,0 +1,79 @@
+/*
+ * This file is part of the OregonCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __PACKETREPLAY_H
+#define __PACKETREPLAY_H
+
+#include "Common.h"
+#include "PacketCapture.h"
+
+#include <map>
+#include <vector>
+
+class WorldSession;
+
+/**
+ * Feeds a PacketCapture file back through the world.
+ *
+ * Every recorded session becomes a WorldSession without socket, its packets
+ * are queued at the time they were recorded and the world is updated in
+ * fixed steps on the SimulatedClock with a seeded random generator, so
+ * runs of the same capture against the same database snapshot can be
+ * compared between builds. Reports the wall time of the world updates.
+ *
+ * The replay runs in the world thread. Map updates are only reproducible
+ * without map update threads, and code reading time(NULL) directly
+ * instead of the game time still sees the real clock.
+ */
+class PacketReplay
+{
+    public:
+        PacketReplay();
+        ~PacketReplay();
+
+        bool Open(char const* filename);
+
+        // replays the whole capture, false if the file is broken
+        bool Run(uint32 tickDiff, uint32 seed);
+
+    private:
+        bool ReadRecord();
+        void ApplyRecord();
+        WorldSession* FindSession(uint32 accountId) const;
+        void PrintResults(uint32 simulated) const;
+
+        FILE* m_file;
+        time_t m_captureStart;
+
+        // next record of the capture
+        bool m_haveRecord;
+        uint8 m_type;
+        uint32 m_time;
+        uint32 m_accountId;
+        ByteBuffer m_data;
+
+        // sessions created since the last world update, not yet known to World::FindSession
+        typedef std::map<uint32, WorldSession*> SessionMap;
+        SessionMap m_added;
+
+        std::vector<uint32> m_tickTimes;                    // wall time of every world update in us
+        uint32 m_sessions;
+        uint32 m_packets;
+        uint32 m_skipped;                                   // packets of sessions that were already gone
+};
+
+#endif
@@ -17,12 +17,14 @@
 
 #include "Common.h"
 #include "Database/DatabaseEnv.h"
+#include "Database/DatabaseImpl.h"
 #include "Log.h"
 #include "WorldSession.h"
 #include "WorldPacket.h"
 #include "ObjectMgr.h"
 #include "SpellMgr.h"
 #include "Pet.h"
+#include "ObjectAccessor.h"
 #include "MapManager.h"
 #include "Formulas.h"
 #include "SpellAuras.h"
@@ -128,26 +130,185 @@ void Pet::RemoveFromWorld()
     }
 }
 
-bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool current)
+bool PetLoadQueryHolder::Initialize()
 {
-    uint32 ownerid = owner->GetGUIDLow();
-
-    QueryResult_AutoPtr result;
-
-    if (petnumber)
-        // known petnumber entry                  0   1      2      3        4      5    6           7              8        9           10    11    12       13         14       15            16      17              18        19                 20                 21              22
-        result = CharacterDatabase.PQuery("SELECT id, entry, owner, modelid, level, exp, Reactstate, loyaltypoints, loyalty, trainpoint, slot, name, renamed, curhealth, curmana, curhappiness, abdata, TeachSpelldata, savetime, resettalents_cost, resettalents_time, CreatedBySpell, PetType FROM character_pet WHERE owner = '%u' AND id = '%u'", ownerid, petnumber);
-    else if (current)
-        // current pet (slot 0)                   0   1      2      3        4      5    6           7              8        9           10    11    12       13         14       15            16      17              18        19                 20                 21              22
-        result = CharacterDatabase.PQuery("SELECT id, entry, owner, modelid, level, exp, Reactstate, loyaltypoints, loyalty, trainpoint, slot, name, renamed, curhealth, curmana, curhappiness, abdata, TeachSpelldata, savetime, resettalents_cost, resettalents_time, CreatedBySpell, PetType FROM character_pet WHERE owner = '%u' AND slot = '0'", ownerid);
-    else if (petentry)
+    SetSize(MAX_PET_LOAD_QUERY);
+
+    uint32 ownerid = GUID_LOPART(m_ownerGuid);
+
+    // selection of the pet row, reused by the auxiliary queries when the pet number is unknown
+    char where[128];
+    if (m_petNumber)
+        // known petnumber entry
+        snprintf(where, sizeof(where), "owner = '%u' AND id = '%u'", ownerid, m_petNumber);
+    else if (m_current)
+        // current pet (slot 0)
+        snprintf(where, sizeof(where), "owner = '%u' AND slot = '0'", ownerid);
+    else if (m_petEntry)
         // known petentry entry (unique for summoned pet, but non unique for hunter pet (only from current or not stabled pets)
-        //                                        0   1      2      3        4      5    6           7              8        9           10    11    12       13         14       15            16      17              18        19                 20                 21              22
-        result = CharacterDatabase.PQuery("SELECT id, entry, owner, modelid, level, exp, Reactstate, loyaltypoints, loyalty, trainpoint, slot, name, renamed, curhealth, curmana, curhappiness, abdata, TeachSpelldata, savetime, resettalents_cost, resettalents_time, CreatedBySpell, PetType FROM character_pet WHERE owner = '%u' AND entry = '%u' AND (slot = '0' OR slot = '3') ", ownerid, petentry);
+        snprintf(where, sizeof(where), "owner = '%u' AND entry = '%u' AND (slot = '0' OR slot = '3')", ownerid, m_petEntry);
     else
         // any current or other non-stabled pet (for hunter "call pet")
-        //                                        0   1      2      3        4      5    6           7              8        9           10    11    12       13         14       15            16      17              18        19                 20                 21              22
-        result = CharacterDatabase.PQuery("SELECT id, entry, owner, modelid, level, exp, Reactstate, loyaltypoints, loyalty, trainpoint, slot, name, renamed, curhealth, curmana, curhappiness, abdata, TeachSpelldata, savetime, resettalents_cost, resettalents_time, CreatedBySpell, PetType FROM character_pet WHERE owner = '%u' AND (slot = '0' OR slot = '3') ", ownerid);
+        snprintf(where, sizeof(where), "owner = '%u' AND (slot = '0' OR slot = '3')", ownerid);
+
+    char petid[192];
+    if (m_petNumber)
+        snprintf(petid, sizeof(petid), "'%u'", m_petNumber);
+    else
+        snprintf(petid, sizeof(petid), "(SELECT id FROM character_pet WHERE %s ORDER BY slot LIMIT 1)", where);
+
+    bool res = true;
+
+    //                                                        0   1      2      3        4      5    6           7              8        9           10    11    12       13         14       15            16      17              18        19                 20                 21              22
+    res &= SetPQuery(PET_LOAD_QUERY_LOADFROM,           "SELECT id, entry, owner, modelid, level, exp, Reactstate, loyaltypoints, loyalty, trainpoint, slot, name, renamed, curhealth, curmana, curhappiness, abdata, TeachSpelldata, savetime, resettalents_cost, resettalents_time, CreatedBySpell, PetType FROM character_pet WHERE %s ORDER BY slot LIMIT 1", where);
+    res &= SetPQuery(PET_LOAD_QUERY_LOADAURAS,          "SELECT caster_guid,item_caster_guid,spell,effect_index,stackcount,amount,maxduration,remaintime,remaincharges FROM pet_aura WHERE guid = %s", petid);
+    res &= SetPQuery(PET_LOAD_QUERY_LOADSPELLS,         "SELECT spell,active FROM pet_spell WHERE guid = %s", petid);
+    res &= SetPQuery(PET_LOAD_QUERY_LOADSPELLCOOLDOWNS, "SELECT spell,time FROM pet_spell_cooldown WHERE guid = %s", petid);
+    res &= SetPQuery(PET_LOAD_QUERY_LOADDECLINEDNAME,   "SELECT genitive, dative, accusative, instrumental, prepositional FROM character_pet_declinedname WHERE owner = '%u' AND id = %s", ownerid, petid);
+
+    // at login the status of a pet that is not in the active slot is needed too
+    if (m_origin == PET_LOAD_ORIGIN_LOGIN)
+        res &= SetPQuery(PET_LOAD_QUERY_LOADSTATUS,     "SELECT curhealth FROM character_pet WHERE owner = '%u'", ownerid);
+
+    return res;
+}
+
+// don't keep the owner pointer in the callback
+// the player may log out before the query callbacks get executed
+class PetLoadHandler
+{
+    public:
+        void HandlePetLoadCallback(QueryResult_AutoPtr /*dummy*/, SqlQueryHolder* holder)
+        {
+            if (!holder)
+                return;
+
+            PetLoadQueryHolder* petHolder = (PetLoadQueryHolder*)holder;
+            if (Player* owner = HashMapHolder<Player>::Find(petHolder->GetOwnerGuid()))
+                HandlePetLoad(owner, petHolder);
+
+            delete holder;
+        }
+
+        void HandlePetLoad(Player* owner, PetLoadQueryHolder* holder)
+        {
+            Pet* pet = NULL;
+
+            // owner may have teleported, died or summoned another pet while the queries were pending
+            if (owner->IsInWorld() && !owner->GetPetGUID())
+            {
+                pet = new Pet(owner, holder->GetPetType());
+                if (!pet->LoadPetFromDB(owner, holder))
+                {
+                    delete pet;
+                    pet = NULL;
+                }
+            }
+
+            switch (holder->GetOrigin())
+            {
+            case PET_LOAD_ORIGIN_LOGIN:
+                if (pet)
+                    // Pet has been loaded from the database into the world
+                    owner->SetPetStatus(pet->IsAlive() ? PET_STATUS_CURRENT : PET_STATUS_DEAD);
+                // Even if the pet is not in the active slot and will not be loaded into the world, update it's status
+                // Need to fetch pet's current health value from the DB, to find out if the pet is dead or alive
+                else if (QueryResult_AutoPtr result = holder->GetResult(PET_LOAD_QUERY_LOADSTATUS))
+                    owner->SetPetStatus((result->Fetch()->GetUInt32() != 0) ? PET_STATUS_DISMISSED : PET_STATUS_DEAD_AND_REMOVED);
+                break;
+            case PET_LOAD_ORIGIN_RESUMMON:
+                // still between maps, keep the pet for the next resummon
+                if (!pet && !owner->IsInWorld() && !owner->GetTemporaryUnsummonedPetNumber())
+                    owner->SetTemporaryUnsummonedPetNumber(holder->GetPetNumber());
+                break;
+            case PET_LOAD_ORIGIN_STABLE:
+                {
+                    WorldPacket data(SMSG_STABLE_RESULT, 1);
+                    data << uint8(pet ? 0x09 : 0x06);
+                    owner->GetSession()->SendPacket(&data);
+                    break;
+                }
+            case PET_LOAD_ORIGIN_SUMMON:
+                if (pet)
+                {
+                    owner->RemoveDemonicSacrifice();
+                    if (holder->GetDuration())
+                        pet->SetDuration(holder->GetDuration());
+                }
+                break;
+            default:
+                break;
+            }
+        }
+} petLoadHandler;
+
+// the results are handled by the world thread, also for loads requested from map threads
+static void QueuePetLoad(Player* owner, PetLoadQueryHolder* holder)
+{
+    if (CharacterDatabase.DelayQueryHolder(&petLoadHandler, &PetLoadHandler::HandlePetLoadCallback, (SqlQueryHolder*)holder, sWorld.GetResultQueue()))
+        return;
+
+    // no delay thread
+    holder->DirectExecute(&CharacterDatabase);
+    petLoadHandler.HandlePetLoad(owner, holder);
+    delete holder;
+}
+
+void Pet::LoadPetFromDBAsync(Player* owner, PetLoadOrigin origin, uint32 petentry, uint32 petnumber, bool current, PetType type)
+{
+    PetLoadQueryHolder* holder = new PetLoadQueryHolder(owner->GetGUID(), petentry, petnumber, current, type, origin);
+    if (!holder->Initialize())
+    {
+        delete holder;                                      // delete all unprocessed queries
+        return;
+    }
+
+    QueuePetLoad(owner, holder);
+}
+
+bool Pet::LoadSummonPetFromDBAsync(Player* owner, uint32 petentry, uint32 duration)
+{
+    PetLoadQueryHolder* holder = new PetLoadQueryHolder(owner->GetGUID(), petentry, 0, false, SUMMON_PET, PET_LOAD_ORIGIN_SUMMON);
+    holder->SetDuration(duration);
+    if (!holder->Initialize())
+    {
+        delete holder;
+        return false;
+    }
+
+    // the caller creates a new pet if there is none, only that must be known right away
+    holder->DirectExecute(&CharacterDatabase, PET_LOAD_QUERY_LOADFROM);
+    if (!holder->GetResult(PET_LOAD_QUERY_LOADFROM))
+    {
+        delete holder;
+        return false;
+    }
+
+    QueuePetLoad(owner, holder);
+    return true;
+}
+
+bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool current)
+{
+    PetLoadQueryHolder holder(owner->GetGUID(), petentry, petnumber, current);
+    if (!holder.Initialize())
+        return false;
+
+    // mostly there is no such pet, the other queries are only run on a hit
+    holder.DirectExecute(&CharacterDatabase, PET_LOAD_QUERY_LOADFROM);
+    if (!holder.GetResult(PET_LOAD_QUERY_LOADFROM))
+        return false;
+
+    holder.DirectExecute(&CharacterDatabase);
+    return LoadPetFromDB(owner, &holder);
+}
+
+bool Pet::LoadPetFromDB(Player* owner, PetLoadQueryHolder* holder)
+{
+    uint32 ownerid = owner->GetGUIDLow();
+    bool current = holder->IsCurrent();
+
+    QueryResult_AutoPtr result = holder->GetResult(PET_LOAD_QUERY_LOADFROM);
 
     if (!result)
         return false;
@@ -155,7 +316,7 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool c
     Field* fields = result->Fetch();
 
     // update for case of current pet "slot = 0"
-    petentry = fields[1].GetUInt32();
+    uint32 petentry = fields[1].GetUInt32();
     if (!petentry)
         return false;
 
@@ -271,6 +432,8 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool c
         CharacterDatabase.PExecute("UPDATE character_pet SET slot = '3' WHERE owner = '%u' AND slot = '0' AND id <> '%u'", ownerid, m_charmInfo->GetPetNumber());
         CharacterDatabase.PExecute("UPDATE character_pet SET slot = '0' WHERE owner = '%u' AND id = '%u'", ownerid, m_charmInfo->GetPetNumber());
         CharacterDatabase.CommitTransaction();
+
+        owner->RemoveStabledPet(m_charmInfo->GetPetNumber());
     }
 
     if (!is_temporary_summoned)
@@ -311,12 +474,12 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool c
     map->AddToMap(ToCreature());
 
     uint32 timediff = (time(NULL) - fields[18].GetUInt32());
-    _LoadAuras(timediff);
+    _LoadAuras(holder->GetResult(PET_LOAD_QUERY_LOADAURAS), timediff);
 
     if (!is_temporary_summoned)
     {
-        _LoadSpells();
-        _LoadSpellCooldowns();
+        _LoadSpells(holder->GetResult(PET_LOAD_QUERY_LOADSPELLS));
+        _LoadSpellCooldowns(holder->GetResult(PET_LOAD_QUERY_LOADSPELLCOOLDOWNS));
         LearnPetPassives();
         if (map->IsBattleArena())
             RemoveArenaAuras();
@@ -333,7 +496,7 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool c
 
     if (getPetType() == HUNTER_PET)
     {
-        result = CharacterDatabase.PQuery("SELECT genitive, dative, accusative, instrumental, prepositional FROM character_pet_declinedname WHERE owner = '%u' AND id = '%u'", owner->GetGUIDLow(), GetCharmInfo()->GetPetNumber());
+        result = holder->GetResult(PET_LOAD_QUERY_LOADDECLINEDNAME);
 
         if (result)
         {
@@ -459,12 +622,18 @@ void Pet::SavePetToDB(PetSaveMode mode)
             CharacterDatabase.Execute(ss.str().c_str());
 
             CharacterDatabase.CommitTransaction();
+
+            if (mode == PET_SAVE_IN_STABLE_SLOT_1 || mode == PET_SAVE_IN_STABLE_SLOT_2)
+                m_owner->SetStabledPet(uint32(mode), this);
+            else
+                m_owner->RemoveStabledPet(m_charmInfo->GetPetNumber());
             break;
         }
     case PET_SAVE_AS_DELETED:
         {
             RemoveAllAuras();
             DeleteFromDB(m_charmInfo->GetPetNumber());
+            m_owner->RemoveStabledPet(m_charmInfo->GetPetNumber());
             break;
         }
     default:
@@ -1237,13 +1406,11 @@ uint32 Pet::GetCurrentFoodBenefitLevel(uint32 itemlevel)
         return 0;                                           //food too low level
 }
 
-void Pet::_LoadSpellCooldowns()
+void Pet::_LoadSpellCooldowns(QueryResult_AutoPtr result)
 {
     m_CreatureSpellCooldowns.clear();
     m_CreatureCategoryCooldowns.clear();
 
-    QueryResult_AutoPtr result = CharacterDatabase.PQuery("SELECT spell,time FROM pet_spell_cooldown WHERE guid = '%u'", m_charmInfo->GetPetNumber());
-
     if (result)
     {
         time_t curTime = time(NULL);
@@ -1305,10 +1472,8 @@ void Pet::_SaveSpellCooldowns()
     }
 }
 
-void Pet::_LoadSpells()
+void Pet::_LoadSpells(QueryResult_AutoPtr result)
 {
-    QueryResult_AutoPtr result = CharacterDatabase.PQuery("SELECT spell,active FROM pet_spell WHERE guid = '%u'", m_charmInfo->GetPetNumber());
-
     if (result)
     {
         do
@@ -1352,7 +1517,7 @@ void Pet::_SaveSpells()
     }
 }
 
-void Pet::_LoadAuras(uint32 timediff)
+void Pet::_LoadAuras(QueryResult_AutoPtr result, uint32 timediff)
 {
     m_Auras.clear();
     for (int i = 0; i < TOTAL_AURAS; i++)
@@ -1362,8 +1527,6 @@ void Pet::_LoadAuras(uint32 timediff)
     for (int i = UNIT_FIELD_AURA; i <= UNIT_FIELD_AURASTATE; ++i)
         SetUInt32Value(i, 0);
 
-    QueryResult_AutoPtr result = CharacterDatabase.PQuery("SELECT caster_guid,item_caster_guid,spell,effect_index,stackcount,amount,maxduration,remaintime,remaincharges FROM pet_aura WHERE guid = '%u'", m_charmInfo->GetPetNumber());
-
     if (result)
     {
         do
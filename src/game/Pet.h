@@ -21,6 +21,7 @@
 #include "ObjectGuid.h"
 #include "Unit.h"
 #include "TemporarySummon.h"
+#include "Database/SqlOperations.h"
 
 enum PetType
 {
@@ -130,6 +131,57 @@ enum PetNameInvalidReason
     PET_NAME_DECLENSION_DOESNT_MATCH_BASE_NAME              = 16
 };
 
+enum PetLoadQueryIndex
+{
+    PET_LOAD_QUERY_LOADFROM                 = 0,
+    PET_LOAD_QUERY_LOADAURAS                = 1,
+    PET_LOAD_QUERY_LOADSPELLS               = 2,
+    PET_LOAD_QUERY_LOADSPELLCOOLDOWNS       = 3,
+    PET_LOAD_QUERY_LOADDECLINEDNAME         = 4,
+    PET_LOAD_QUERY_LOADSTATUS               = 5,        // only for PET_LOAD_ORIGIN_LOGIN
+
+    MAX_PET_LOAD_QUERY
+};
+
+// What requested the pet load, decides what is done with the result once it returns
+enum PetLoadOrigin
+{
+    PET_LOAD_ORIGIN_DIRECT                  = 0,        // synchronous load, caller handles the result
+    PET_LOAD_ORIGIN_LOGIN                   = 1,        // current pet at player login
+    PET_LOAD_ORIGIN_RESUMMON                = 2,        // temporary unsummoned pet (teleport, arena leave, ...)
+    PET_LOAD_ORIGIN_STABLE                  = 3,        // unstabled or swapped at a stable master
+    PET_LOAD_ORIGIN_SUMMON                  = 4         // stored summon pet called by a spell
+};
+
+// Groups all character_pet / pet_* queries needed to materialize one pet.
+// Auxiliary tables are keyed by the pet number, which is not known when the pet is
+// selected by slot or entry, so they use the same selection as a subquery.
+class PetLoadQueryHolder : public SqlQueryHolder
+{
+    private:
+        uint64 m_ownerGuid;
+        uint32 m_petEntry;
+        uint32 m_petNumber;
+        bool m_current;
+        PetType m_petType;
+        PetLoadOrigin m_origin;
+        uint32 m_duration;
+    public:
+        PetLoadQueryHolder(uint64 ownerGuid, uint32 petentry, uint32 petnumber, bool current,
+                           PetType type = MAX_PET_TYPE, PetLoadOrigin origin = PET_LOAD_ORIGIN_DIRECT)
+            : m_ownerGuid(ownerGuid), m_petEntry(petentry), m_petNumber(petnumber), m_current(current),
+              m_petType(type), m_origin(origin), m_duration(0) { }
+        uint64 GetOwnerGuid() const { return m_ownerGuid; }
+        uint32 GetPetEntry() const { return m_petEntry; }
+        uint32 GetPetNumber() const { return m_petNumber; }
+        bool IsCurrent() const { return m_current; }
+        PetType GetPetType() const { return m_petType; }
+        PetLoadOrigin GetOrigin() const { return m_origin; }
+        uint32 GetDuration() const { return m_duration; }
+        void SetDuration(uint32 duration) { m_duration = duration; }
+        bool Initialize();
+};
+
 typedef UNORDERED_MAP<uint16, PetSpell> PetSpellMap;
 typedef std::map<uint32, uint32> TeachSpellMap;
 typedef std::vector<uint32> AutoSpellList;
@@ -174,6 +226,10 @@ class Pet : public Guardian
         bool Create (uint32 guidlow, Map* map, uint32 phaseMask, uint32 Entry, uint32 pet_number);
         bool CreateBaseAtCreature(Creature* creature);
         bool LoadPetFromDB(Player* owner, uint32 petentry = 0, uint32 petnumber = 0, bool current = false);
+        bool LoadPetFromDB(Player* owner, PetLoadQueryHolder* holder);
+        static void LoadPetFromDBAsync(Player* owner, PetLoadOrigin origin, uint32 petentry, uint32 petnumber, bool current, PetType type = MAX_PET_TYPE);
+        // looks the pet up in place, the rest is loaded like LoadPetFromDBAsync. False if there is no such pet
+        static bool LoadSummonPetFromDBAsync(Player* owner, uint32 petentry, uint32 duration);
         void SavePetToDB(PetSaveMode mode);
         void Remove(PetSaveMode mode, bool returnreagent = false);
         static void DeleteFromDB(uint32 guidlow);
@@ -233,11 +289,11 @@ class Pet : public Guardian
         void CastPetAuras(bool current);
         void CastPetAura(PetAura const* aura);
 
-        void _LoadSpellCooldowns();
+        void _LoadSpellCooldowns(QueryResult_AutoPtr result);
         void _SaveSpellCooldowns();
-        void _LoadAuras(uint32 timediff);
+        void _LoadAuras(QueryResult_AutoPtr result, uint32 timediff);
         void _SaveAuras();
-        void _LoadSpells();
+        void _LoadSpells(QueryResult_AutoPtr result);
         void _SaveSpells();
 
         bool addSpell(uint16 spell_id, uint16 active = ACT_DECIDE, PetSpellState state = PETSPELL_NEW, PetSpellType type = PETSPELL_NORMAL);
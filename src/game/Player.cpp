@@ -18,6 +18,7 @@
 #include "Common.h"
 #include "Language.h"
 #include "Database/DatabaseEnv.h"
+#include "Database/SqlBatch.h"
 #include "Log.h"
 #include "Opcodes.h"
 #include "ObjectMgr.h"
@@ -31,6 +32,7 @@
 #include "QuestDef.h"
 #include "GossipDef.h"
 #include "UpdateData.h"
+#include "zlib.h"
 #include "Channel.h"
 #include "ChannelMgr.h"
 #include "MapManager.h"
@@ -82,6 +84,32 @@
 #define SKILL_PERM_BONUS(x)    int16(PAIR32_HIPART(x))
 #define MAKE_SKILL_BONUS(t, p) MAKE_PAIR32(t, p)
 
+// FNV-1a, tells whether a saved section changed since the last save
+static uint64 HashSaveData(void const* data, size_t size)
+{
+    uint64 hash = UI64LIT(14695981039346656037);
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= ((uint8 const*)data)[i];
+        hash *= UI64LIT(1099511628211);
+    }
+    return hash;
+}
+
+// columns of the characters row written by Player::SaveToDB, in value order;
+// "data" is only appended when the update fields changed since the last save
+static char const* const CharacterSaveColumns[] =
+{
+    "guid", "account", "name", "race", "class", "gender", "level", "xp", "money", "playerBytes", "playerBytes2", "playerFlags",
+    "map", "instance_id", "dungeon_difficulty", "position_x", "position_y", "position_z", "orientation",
+    "taximask", "online", "cinematic",
+    "totaltime", "leveltime", "rest_bonus", "logout_time", "is_logout_resting", "resettalents_cost", "resettalents_time",
+    "trans_x", "trans_y", "trans_z", "trans_o", "transguid", "extra_flags", "stable_slots", "at_login", "zone",
+    "death_expire_time", "taxi_path", "arenaPoints", "totalHonorPoints", "todayHonorPoints", "yesterdayHonorPoints",
+    "totalKills", "todayKills", "yesterdayKills", "chosenTitle", "watchedFaction", "drunk", "grantableLevels", "health",
+    "powerMana", "powerRage", "powerFocus", "powerEnergy", "powerHappiness", "latency", "data"
+};
+
 enum CharacterFlags
 {
     CHARACTER_FLAG_NONE                 = 0x00000000,
@@ -251,9 +279,10 @@ uint32 PlayerTaxi::GetCurrentTaxiPath() const
 
 UpdateMask Player::updateVisualBits;
 
-Player::Player(WorldSession* session) : Unit(true), m_reputationMgr(this)
+Player::Player(WorldSession* session) : Unit(true), m_compressedMoves(0), m_reputationMgr(this)
 {
     m_transport = 0;
+    m_compressedMoveCount = 0;
 
     m_speakTime = 0;
     m_speakCount = 0;
@@ -289,6 +318,7 @@ Player::Player(WorldSession* session) : Unit(true), m_reputationMgr(this)
     m_team = 0;
 
     m_nextSave = sWorld.getConfig(CONFIG_INTERVAL_SAVE);
+    m_saveDelayed = 0;
 
     clearResurrectRequestData();
 
@@ -335,6 +365,10 @@ Player::Player(WorldSession* session) : Unit(true), m_reputationMgr(this)
     m_DailyQuestChanged = false;
     m_lastDailyQuestTime = 0;
 
+    m_savedDataHash = 0;
+    m_savedAurasHash = 0;
+    m_savedCooldownsHash = 0;
+
     for (uint8 i = 0; i < MAX_TIMERS; i++)
         m_MirrorTimer[i] = DISABLED_MIRROR_TIMER;
 
@@ -1174,7 +1208,12 @@ void Player::Update(uint32 p_time)
 
             uint32 newzone = GetZoneId();
             if (m_zoneUpdateId != newzone)
-                UpdateZone(newzone);                        // also update area
+            {
+                // outdoor pvp, weather and channels are world wide, a continent
+                // updating by regions changes zones in its merge phase
+                if (!GetMap()->DeferZoneUpdate(this))
+                    UpdateZone(newzone);                    // also update area
+            }
             else
             {
                 // use area updates as well
@@ -1208,9 +1247,19 @@ void Player::Update(uint32 p_time)
     {
         if (p_time >= m_nextSave)
         {
-            // m_nextSave reset in SaveToDB call
-            SaveToDB();
-            sLog.outDetail("Player '%s' (GUID: %u) saved", GetName(), GetGUIDLow());
+            // autosaves are rate limited world wide, a save that was held back
+            // for a whole extra interval is done regardless
+            if (sWorld.TakeAutoSaveSlot() || m_saveDelayed >= sWorld.getConfig(CONFIG_INTERVAL_SAVE))
+            {
+                // m_nextSave reset in SaveToDB call
+                SaveToDB();
+                sLog.outDetail("Player '%s' (GUID: %u) saved", GetName(), GetGUIDLow());
+            }
+            else
+            {
+                m_saveDelayed += p_time;
+                m_nextSave = 1;                             // retry next update
+            }
         }
         else
             m_nextSave -= p_time;
@@ -1252,7 +1301,8 @@ void Player::Update(uint32 p_time)
     UpdateHomebindTime(p_time);
 
     // group update
-    SendUpdateToOutOfRangeGroupMembers();
+    if (!GetMap()->DeferGroupUpdate(this))
+        SendUpdateToOutOfRangeGroupMembers();
 
     Pet* pet = GetPet();
     if (pet && !pet->IsWithinDistInMap(this, GetMap()->GetVisibilityRange()) && !pet->isPossessed())
@@ -1532,6 +1582,20 @@ bool Player::TeleportTo(uint32 mapid, float x, float y, float z, float orientati
     else
         sLog.outDebug("Player %s is being teleported to map %u", GetName(), mapid);
 
+    // a continent updating by regions teleports in its merge phase, the destination
+    // may be in a region another thread is updating
+    if (IsInWorld() && GetMap()->DeferTeleport(this))
+    {
+        if (GetMapId() == mapid)
+            SetSemaphoreTeleportNear(true);
+        else
+            SetSemaphoreTeleportFar(true);
+
+        m_teleport_dest = WorldLocation(mapid, x, y, z, orientation);
+        m_teleport_options = options;
+        return true;
+    }
+
     // reset movement flags at teleport, because player will continue move with these flags after teleport
     SetUnitMovementFlags(MOVEMENTFLAG_NONE);
     DisableSpline();
@@ -1908,10 +1972,9 @@ void Player::ResummonTemporaryUnsummonedPetIfAny()
 
     if (GetTemporaryUnsummonedPetNumber())
     {
-        Pet* NewPet = new Pet(this);
-        if (!NewPet->LoadPetFromDB(this, 0, GetTemporaryUnsummonedPetNumber(), true))
-            delete NewPet;
+        uint32 petnumber = GetTemporaryUnsummonedPetNumber();
         SetTemporaryUnsummonedPetNumber(0);
+        Pet::LoadPetFromDBAsync(this, PET_LOAD_ORIGIN_RESUMMON, 0, petnumber, true);
     }
     else
     {
@@ -3401,21 +3464,32 @@ void Player::_LoadSpellCooldowns(QueryResult_AutoPtr result)
 
 void Player::_SaveSpellCooldowns()
 {
-    CharacterDatabase.PExecute("DELETE FROM character_spell_cooldown WHERE guid = '%u'", GetGUIDLow());
-
     time_t curTime = time(NULL);
 
-    // remove outdated and save active
+    // remove outdated and collect active
+    std::string rows;
+    char buf[64];
     for (SpellCooldowns::iterator itr = m_spellCooldowns.begin(); itr != m_spellCooldowns.end();)
     {
         if (itr->second.end <= curTime)
             m_spellCooldowns.erase(itr++);
         else
         {
-            CharacterDatabase.PExecute("INSERT INTO character_spell_cooldown (guid,spell,item,time) VALUES ('%u', '%u', '%u', '" UI64FMTD "')", GetGUIDLow(), itr->first, itr->second.itemid, uint64(itr->second.end));
+            snprintf(buf, sizeof(buf), "%s(%u,%u,%u," UI64FMTD ")", rows.empty() ? "" : ",", GetGUIDLow(), itr->first, itr->second.itemid, uint64(itr->second.end));
+            rows += buf;
             ++itr;
         }
     }
+
+    // cooldowns are stored by end time, the rows only change when one starts or ends
+    uint64 hash = HashSaveData(rows.data(), rows.size());
+    if (hash == m_savedCooldownsHash)
+        return;
+    m_savedCooldownsHash = hash;
+
+    CharacterDatabase.PExecute("DELETE FROM character_spell_cooldown WHERE guid = '%u'", GetGUIDLow());
+    if (!rows.empty())
+        CharacterDatabase.Execute(("INSERT INTO character_spell_cooldown (guid,spell,item,time) VALUES " + rows).c_str());
 }
 
 uint32 Player::ResetTalentsCost() const
@@ -5705,6 +5779,105 @@ void Player::SendMessageToSetInRange(WorldPacket* data, float dist, bool self)
     VisitNearbyWorldObject(dist, notifier);
 }
 
+void Player::QueueCompressedMove(WorldPacket const* data, uint64 mover)
+{
+    // every move carries a one byte size, bigger ones can't be batched
+    if (data->size() + sizeof(uint16) > 0xFF)
+    {
+        SendCompressedMoves();
+        GetSession()->SendPacket(data);
+        return;
+    }
+
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_compressedMovesLock);
+    m_compressedMoves << uint8(data->size() + sizeof(uint16));
+    m_compressedMoves << uint16(data->GetOpcode());
+    m_compressedMoves.append(data->contents(), data->size());
+    if (std::find(m_compressedMovers.begin(), m_compressedMovers.end(), mover) == m_compressedMovers.end())
+        m_compressedMovers.push_back(mover);
+    ++m_compressedMoveCount;
+}
+
+void Player::SendCompressedMoves()
+{
+    if (!m_compressedMoveCount)
+        return;
+
+    // held while sending so moves queued meanwhile can't overtake these
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_compressedMovesLock);
+
+    uint32 count = m_compressedMoveCount;
+    if (!count)
+        return;
+
+    m_compressedMoveCount = 0;
+    m_compressedMovers.clear();
+
+    // nothing to gain from compressing a single move
+    if (count == 1)
+    {
+        WorldPacket data(m_compressedMoves.read<uint16>(1), m_compressedMoves.size() - 3);
+        data.append(m_compressedMoves.contents() + 3, m_compressedMoves.size() - 3);
+        m_compressedMoves.clear();
+        GetSession()->SendPacket(std::move(data));
+        return;
+    }
+
+    uint32 pSize = m_compressedMoves.size();
+    uint32 destsize = compressBound(pSize);
+
+    WorldPacket data(SMSG_COMPRESSED_MOVES, destsize + sizeof(uint32));
+    data.resize(destsize + sizeof(uint32));
+    data.put<uint32>(0, pSize);
+    UpdateData::Compress(const_cast<uint8*>(data.contents()) + sizeof(uint32), &destsize, (void*)m_compressedMoves.contents(), pSize);
+    m_compressedMoves.clear();
+
+    if (destsize)
+    {
+        data.resize(destsize + sizeof(uint32));
+        GetSession()->SendPacket(std::move(data));
+    }
+}
+
+void Player::SendCompressedMovesFor(uint64 mover)
+{
+    if (!m_compressedMoveCount)
+        return;
+
+    bool queued;
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, m_compressedMovesLock);
+        queued = std::find(m_compressedMovers.begin(), m_compressedMovers.end(), mover) != m_compressedMovers.end();
+    }
+
+    if (queued)
+        SendCompressedMoves();
+}
+
+void Player::SendCompressedMovesFor(std::set<uint64> const& movers)
+{
+    if (!m_compressedMoveCount || movers.empty())
+        return;
+
+    bool queued = false;
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, m_compressedMovesLock);
+        for (std::vector<uint64>::const_iterator itr = m_compressedMovers.begin(); itr != m_compressedMovers.end() && !queued; ++itr)
+            queued = movers.find(*itr) != movers.end();
+    }
+
+    if (queued)
+        SendCompressedMoves();
+}
+
+void Player::ClearCompressedMoves()
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_compressedMovesLock);
+    m_compressedMoves.clear();
+    m_compressedMovers.clear();
+    m_compressedMoveCount = 0;
+}
+
 void Player::SendMessageToSetInRange(WorldPacket* data, float dist, bool self, bool own_team_only)
 {
     if (self)
@@ -14845,6 +15018,8 @@ bool Player::LoadFromDB(uint32 guid, SqlQueryHolder* holder)
         m_stableSlots = 2;
     }
 
+    _LoadStabledPets(holder->GetResult(PLAYER_LOGIN_QUERY_LOADSTABLEDPETS));
+
     m_atLoginFlags = fields[34].GetUInt32();
 
     if (HasAtLoginFlag(AT_LOGIN_RENAME))
@@ -15485,20 +15660,63 @@ void Player::LoadPet()
 {
     //fixme: the pet should still be loaded if the player is not in world
     // just not added to the map
+    // pet status is updated when the load completes
     if (IsInWorld())
+        Pet::LoadPetFromDBAsync(this, PET_LOAD_ORIGIN_LOGIN, 0, 0, true);
+}
+
+void Player::_LoadStabledPets(QueryResult_AutoPtr result)
+{
+    m_stabledPets.clear();
+
+    if (!result)
+        return;
+
+    do
     {
-        Pet* pet = new Pet(this);
-        if (!pet->LoadPetFromDB(this, 0, 0, true)) // Pet was not loaded from DB
-        {
-            // Even if the pet is not in the active slot and will not be loaded into the world, update it's status
-            // Need to fetch pet's current health value from the DB, to find out if the pet is dead or alive
-            if (QueryResult_AutoPtr result = CharacterDatabase.PQuery("SELECT curhealth FROM character_pet WHERE owner = '%u'", GetGUIDLow()))
-                SetPetStatus((result->Fetch()->GetUInt32() != 0) ? PET_STATUS_DISMISSED : PET_STATUS_DEAD_AND_REMOVED);
+        Field* fields = result->Fetch();
 
-            delete pet;
+        StabledPetInfo& info = m_stabledPets[fields[0].GetUInt32()];
+        info.petnumber = fields[1].GetUInt32();
+        info.entry     = fields[2].GetUInt32();
+        info.level     = fields[3].GetUInt32();
+        info.loyalty   = fields[4].GetUInt32();
+        info.name      = fields[5].GetCppString();
+    }
+    while (result->NextRow());
+}
+
+StabledPetMap::const_iterator Player::FindStabledPet(uint32 petnumber) const
+{
+    for (StabledPetMap::const_iterator itr = m_stabledPets.begin(); itr != m_stabledPets.end(); ++itr)
+        if (itr->second.petnumber == petnumber)
+            return itr;
+
+    return m_stabledPets.end();
+}
+
+void Player::SetStabledPet(uint32 slot, Pet* pet)
+{
+    RemoveStabledPet(pet->GetCharmInfo()->GetPetNumber());
+
+    // a pet previously in this slot was moved out of the stable by the save
+    StabledPetInfo& info = m_stabledPets[slot];
+    info.petnumber = pet->GetCharmInfo()->GetPetNumber();
+    info.entry     = pet->GetEntry();
+    info.level     = pet->getLevel();
+    info.loyalty   = pet->GetLoyaltyLevel();
+    info.name      = pet->GetName();
+}
+
+void Player::RemoveStabledPet(uint32 petnumber)
+{
+    for (StabledPetMap::iterator itr = m_stabledPets.begin(); itr != m_stabledPets.end(); ++itr)
+    {
+        if (itr->second.petnumber == petnumber)
+        {
+            m_stabledPets.erase(itr);
+            return;
         }
-        // Pet has been loaded from the database into the world
-        else SetPetStatus((pet->IsAlive()) ? PET_STATUS_CURRENT : PET_STATUS_DEAD);
     }
 }
 
@@ -16239,6 +16457,7 @@ void Player::SaveToDB()
 {
     // delay auto save at any saves (manual, in code, or autosave)
     m_nextSave = sWorld.getConfig(CONFIG_INTERVAL_SAVE);
+    m_saveDelayed = 0;
 
     //lets allow only players in world to be saved
     if (IsBeingTeleportedFar())
@@ -16279,15 +16498,16 @@ void Player::SaveToDB()
     std::string sql_name = m_name;
     CharacterDatabase.escape_string(sql_name);
 
+    // the data column is the bulk of the row, skip it when no update field changed
+    uint64 dataHash = HashSaveData(m_uint32Values, m_valuesCount * sizeof(uint32));
+    bool saveData = dataHash != m_savedDataHash;
+    size_t columnCount = sizeof(CharacterSaveColumns) / sizeof(CharacterSaveColumns[0]) - (saveData ? 0 : 1);
+
     std::ostringstream ss;
-    ss << "REPLACE INTO characters (guid,account,name,race,class,gender,level,xp,money,playerBytes,playerBytes2,playerFlags,"
-       "map, instance_id, dungeon_difficulty, position_x, position_y, position_z, orientation, data, "
-       "taximask, online, cinematic, "
-       "totaltime, leveltime, rest_bonus, logout_time, is_logout_resting, resettalents_cost, resettalents_time, "
-       "trans_x, trans_y, trans_z, trans_o, transguid, extra_flags, stable_slots, at_login, zone, "
-       "death_expire_time, taxi_path, arenaPoints, totalHonorPoints, todayHonorPoints, yesterdayHonorPoints, "
-       "totalKills, todayKills, yesterdayKills, chosenTitle, watchedFaction, drunk, grantableLevels, health, "
-       "powerMana, powerRage, powerFocus, powerEnergy, powerHappiness, latency) VALUES ("
+    ss << "INSERT INTO characters (";
+    for (size_t i = 0; i < columnCount; ++i)
+        ss << (i ? "," : "") << CharacterSaveColumns[i];
+    ss << ") VALUES ("
        << GetGUIDLow() << ", "
        << GetSession()->GetAccountId() << ", '"
        << sql_name << "', "
@@ -16322,13 +16542,7 @@ void Player::SaveToDB()
            << finiteAlways(GetTeleportDest().GetOrientation()) << ", '";
     }
 
-    uint16 i;
-    for (i = 0; i < m_valuesCount; ++i)
-        ss << GetUInt32Value(i) << " ";
-
-    ss << "', '";
-
-    for (i = 0; i < 8; i++)
+    for (uint8 i = 0; i < 8; i++)
         ss << m_taxi.GetTaximask(i) << " ";
 
     ss << "', ";
@@ -16397,11 +16611,24 @@ void Player::SaveToDB()
     ss << ", '";
 
     ss << GetSession()->GetLatency();
-    ss << "')";
+    ss << "'";
+
+    if (saveData)
+    {
+        ss << ", '";
+        for (uint16 i = 0; i < m_valuesCount; ++i)
+            ss << GetUInt32Value(i) << " ";
+        ss << "'";
+    }
+
+    ss << ") ON DUPLICATE KEY UPDATE ";
+    for (size_t i = 1; i < columnCount; ++i)
+        ss << (i > 1 ? "," : "") << CharacterSaveColumns[i] << "=VALUES(" << CharacterSaveColumns[i] << ")";
 
     CharacterDatabase.BeginTransaction();
 
     CharacterDatabase.Execute(ss.str().c_str());
+    m_savedDataHash = dataHash;
 
     if (m_mailsUpdated)                                     //save mails only when needed
         _SaveMail();
@@ -16446,24 +16673,24 @@ void Player::SaveGoldToDB()
 
 void Player::_SaveActions()
 {
+    SqlBatch upsert(CharacterDatabase, "INSERT INTO character_action (guid,button,action,type,misc) VALUES ",
+                    " ON DUPLICATE KEY UPDATE action=VALUES(action),type=VALUES(type),misc=VALUES(misc)");
+    std::ostringstream del;
+    del << "DELETE FROM character_action WHERE guid = '" << GetGUIDLow() << "' AND button IN (";
+    SqlBatch remove(CharacterDatabase, del.str(), ")");
+
     for (ActionButtonList::iterator itr = m_actionButtons.begin(); itr != m_actionButtons.end();)
     {
         switch (itr->second.uState)
         {
             case ACTIONBUTTON_NEW:
-                CharacterDatabase.PExecute("INSERT INTO character_action (guid,button,action,type,misc) VALUES ('%u', '%u', '%u', '%u', '%u')",
-                                           GetGUIDLow(), (uint32)itr->first, (uint32)itr->second.action, (uint32)itr->second.type, (uint32)itr->second.misc);
-                itr->second.uState = ACTIONBUTTON_UNCHANGED;
-                ++itr;
-                break;
             case ACTIONBUTTON_CHANGED:
-                CharacterDatabase.PExecute("UPDATE character_action  SET action = '%u', type = '%u', misc= '%u' WHERE guid= '%u' AND button= '%u' ",
-                                           (uint32)itr->second.action, (uint32)itr->second.type, (uint32)itr->second.misc, GetGUIDLow(), (uint32)itr->first);
+                upsert.AddRow("(%u,%u,%u,%u,%u)", GetGUIDLow(), (uint32)itr->first, (uint32)itr->second.action, (uint32)itr->second.type, (uint32)itr->second.misc);
                 itr->second.uState = ACTIONBUTTON_UNCHANGED;
                 ++itr;
                 break;
             case ACTIONBUTTON_DELETED:
-                CharacterDatabase.PExecute("DELETE FROM character_action WHERE guid = '%u' and button = '%u'", GetGUIDLow(), (uint32)itr->first);
+                remove.AddRow("%u", (uint32)itr->first);
                 m_actionButtons.erase(itr++);
                 break;
             default:
@@ -16475,17 +16702,15 @@ void Player::_SaveActions()
 
 void Player::_SaveAuras()
 {
-    CharacterDatabase.PExecute("DELETE FROM character_aura WHERE guid = '%u'", GetGUIDLow());
-
     AuraMap const& auras = GetAuras();
 
-    if (auras.empty())
-        return;
+    std::string rows;
+    char buf[192];
 
-    spellEffectPair lastEffectPair = auras.begin()->first;
+    spellEffectPair lastEffectPair = auras.empty() ? spellEffectPair(0, 0) : auras.begin()->first;
     uint32 stackCounter = 1;
 
-    for (AuraMap::const_iterator itr = auras.begin(); ; ++itr)
+    for (AuraMap::const_iterator itr = auras.begin(); !auras.empty(); ++itr)
     {
         if (itr == auras.end() || lastEffectPair != itr->first)
         {
@@ -16520,9 +16745,9 @@ void Player::_SaveAuras()
 
                     if (i == 3)
                     {
-                        CharacterDatabase.PExecute("INSERT INTO character_aura (guid,caster_guid,item_caster_guid,spell,effect_index,stackcount,amount,maxduration,remaintime,remaincharges) "
-                                                   "VALUES ('%u', '" UI64FMTD "', '" UI64FMTD "', '%u', '%u', '%u', '%d', '%d', '%d', '%d')", GetGUIDLow(), aura->GetCasterGUID(),  aura->GetCastItemGUID(), (uint32)aura->GetId(),
-                                                   (uint32)aura->GetEffIndex(), (uint32)aura->GetStackAmount(), aura->GetModifier()->m_amount, int(aura->GetAuraMaxDuration()), int(aura->GetAuraDuration()), int(aura->m_procCharges));
+                        snprintf(buf, sizeof(buf), "%s(%u," UI64FMTD "," UI64FMTD ",%u,%u,%u,%d,%d,%d,%d)", rows.empty() ? "" : ",", GetGUIDLow(), aura->GetCasterGUID(), aura->GetCastItemGUID(), (uint32)aura->GetId(),
+                                 (uint32)aura->GetEffIndex(), (uint32)aura->GetStackAmount(), aura->GetModifier()->m_amount, int(aura->GetAuraMaxDuration()), int(aura->GetAuraDuration()), int(aura->m_procCharges));
+                        rows += buf;
                     }
                 }
             }
@@ -16540,6 +16765,16 @@ void Player::_SaveAuras()
             stackCounter = 1;
         }
     }
+
+    // auras without duration (or none at all) are the common case, don't rewrite identical rows
+    uint64 hash = HashSaveData(rows.data(), rows.size());
+    if (hash == m_savedAurasHash)
+        return;
+    m_savedAurasHash = hash;
+
+    CharacterDatabase.PExecute("DELETE FROM character_aura WHERE guid = '%u'", GetGUIDLow());
+    if (!rows.empty())
+        CharacterDatabase.Execute(("INSERT INTO character_aura (guid,caster_guid,item_caster_guid,spell,effect_index,stackcount,amount,maxduration,remaintime,remaincharges) VALUES " + rows).c_str());
 }
 
 void Player::_SaveInventory()
@@ -16565,6 +16800,10 @@ void Player::_SaveInventory()
     if (m_itemUpdateQueue.empty())
         return;
 
+    SqlBatch upsert(CharacterDatabase, "INSERT INTO character_inventory (guid,bag,slot,item,item_template) VALUES ",
+                    " ON DUPLICATE KEY UPDATE guid=VALUES(guid),bag=VALUES(bag),slot=VALUES(slot),item_template=VALUES(item_template)");
+    SqlBatch remove(CharacterDatabase, "DELETE FROM character_inventory WHERE item IN (", ")");
+
     // do not save if the update queue is corrupt
     uint32 lowGuid = GetGUIDLow();
     for (size_t i = 0; i < m_itemUpdateQueue.size(); ++i)
@@ -16610,13 +16849,11 @@ void Player::_SaveInventory()
         switch (item->GetState())
         {
             case ITEM_NEW:
-                CharacterDatabase.PExecute("INSERT INTO character_inventory (guid,bag,slot,item,item_template) VALUES ('%u', '%u', '%u', '%u', '%u')", lowGuid, bag_guid, item->GetSlot(), item->GetGUIDLow(), item->GetEntry());
-                break;
             case ITEM_CHANGED:
-                CharacterDatabase.PExecute("UPDATE character_inventory SET guid='%u', bag='%u', slot='%u', item_template='%u' WHERE item='%u'", lowGuid, bag_guid, item->GetSlot(), item->GetEntry(), item->GetGUIDLow());
+                upsert.AddRow("(%u,%u,%u,%u,%u)", lowGuid, bag_guid, item->GetSlot(), item->GetGUIDLow(), item->GetEntry());
                 break;
             case ITEM_REMOVED:
-                CharacterDatabase.PExecute("DELETE FROM character_inventory WHERE item = '%u'", item->GetGUIDLow());
+                remove.AddRow("%u", item->GetGUIDLow());
                 break;
             case ITEM_UNCHANGED:
                 break;
@@ -16678,19 +16915,19 @@ void Player::_SaveMail()
 
 void Player::_SaveQuestStatus()
 {
-    // we don't need transactions here.
+    SqlBatch upsert(CharacterDatabase, "INSERT INTO character_queststatus (guid,quest,status,rewarded,explored,timer,mobcount1,mobcount2,mobcount3,mobcount4,itemcount1,itemcount2,itemcount3,itemcount4) VALUES ",
+                    " ON DUPLICATE KEY UPDATE status=VALUES(status),rewarded=VALUES(rewarded),explored=VALUES(explored),timer=VALUES(timer),"
+                    "mobcount1=VALUES(mobcount1),mobcount2=VALUES(mobcount2),mobcount3=VALUES(mobcount3),mobcount4=VALUES(mobcount4),"
+                    "itemcount1=VALUES(itemcount1),itemcount2=VALUES(itemcount2),itemcount3=VALUES(itemcount3),itemcount4=VALUES(itemcount4)");
+
     for (QuestStatusMap::iterator i = mQuestStatus.begin(); i != mQuestStatus.end(); ++i)
     {
         switch (i->second.uState)
         {
             case QUEST_NEW:
-                CharacterDatabase.PExecute("INSERT INTO character_queststatus (guid,quest,status,rewarded,explored,timer,mobcount1,mobcount2,mobcount3,mobcount4,itemcount1,itemcount2,itemcount3,itemcount4) "
-                                           "VALUES ('%u', '%u', '%u', '%u', '%u', '" UI64FMTD "', '%u', '%u', '%u', '%u', '%u', '%u', '%u', '%u')",
-                                           GetGUIDLow(), i->first, i->second.m_status, i->second.m_rewarded, i->second.m_explored, uint64(i->second.m_timer / IN_MILLISECONDS + sWorld.GetGameTime()), i->second.m_creatureOrGOcount[0], i->second.m_creatureOrGOcount[1], i->second.m_creatureOrGOcount[2], i->second.m_creatureOrGOcount[3], i->second.m_itemcount[0], i->second.m_itemcount[1], i->second.m_itemcount[2], i->second.m_itemcount[3]);
-                break;
             case QUEST_CHANGED:
-                CharacterDatabase.PExecute("UPDATE character_queststatus SET status = '%u',rewarded = '%u',explored = '%u',timer = '" UI64FMTD "',mobcount1 = '%u',mobcount2 = '%u',mobcount3 = '%u',mobcount4 = '%u',itemcount1 = '%u',itemcount2 = '%u',itemcount3 = '%u',itemcount4 = '%u'  WHERE guid = '%u' AND quest = '%u' ",
-                                           i->second.m_status, i->second.m_rewarded, i->second.m_explored, uint64(i->second.m_timer / IN_MILLISECONDS + sWorld.GetGameTime()), i->second.m_creatureOrGOcount[0], i->second.m_creatureOrGOcount[1], i->second.m_creatureOrGOcount[2], i->second.m_creatureOrGOcount[3], i->second.m_itemcount[0], i->second.m_itemcount[1], i->second.m_itemcount[2], i->second.m_itemcount[3], GetGUIDLow(), i->first);
+                upsert.AddRow("(%u,%u,%u,%u,%u," UI64FMTD ",%u,%u,%u,%u,%u,%u,%u,%u)",
+                              GetGUIDLow(), i->first, i->second.m_status, i->second.m_rewarded, i->second.m_explored, uint64(i->second.m_timer / IN_MILLISECONDS + sWorld.GetGameTime()), i->second.m_creatureOrGOcount[0], i->second.m_creatureOrGOcount[1], i->second.m_creatureOrGOcount[2], i->second.m_creatureOrGOcount[3], i->second.m_itemcount[0], i->second.m_itemcount[1], i->second.m_itemcount[2], i->second.m_itemcount[3]);
                 break;
             case QUEST_UNCHANGED:
                 break;
@@ -16710,15 +16947,20 @@ void Player::_SaveDailyQuestStatus()
 
     // we don't need transactions here.
     CharacterDatabase.PExecute("DELETE FROM character_queststatus_daily WHERE guid = '%u'", GetGUIDLow());
+    SqlBatch insert(CharacterDatabase, "INSERT INTO character_queststatus_daily (guid,quest,time) VALUES ");
     for (uint32 quest_daily_idx = 0; quest_daily_idx < PLAYER_MAX_DAILY_QUESTS; ++quest_daily_idx)
         if (GetUInt32Value(PLAYER_FIELD_DAILY_QUESTS_1 + quest_daily_idx))
-            CharacterDatabase.PExecute("INSERT INTO character_queststatus_daily (guid,quest,time) VALUES ('%u', '%u','" UI64FMTD "')",
-                                       GetGUIDLow(), GetUInt32Value(PLAYER_FIELD_DAILY_QUESTS_1 + quest_daily_idx), uint64(m_lastDailyQuestTime));
+            insert.AddRow("(%u,%u," UI64FMTD ")", GetGUIDLow(), GetUInt32Value(PLAYER_FIELD_DAILY_QUESTS_1 + quest_daily_idx), uint64(m_lastDailyQuestTime));
 }
 
 void Player::_SaveSkills()
 {
-    // we don't need transactions here.
+    SqlBatch upsert(CharacterDatabase, "INSERT INTO character_skills (guid,skill,value,max) VALUES ",
+                    " ON DUPLICATE KEY UPDATE value=VALUES(value),max=VALUES(max)");
+    std::ostringstream del;
+    del << "DELETE FROM character_skills WHERE guid = '" << GetGUIDLow() << "' AND skill IN (";
+    SqlBatch remove(CharacterDatabase, del.str(), ")");
+
     for (SkillStatusMap::iterator itr = mSkillStatus.begin(); itr != mSkillStatus.end();)
     {
         if (itr->second.uState == SKILL_UNCHANGED)
@@ -16729,29 +16971,13 @@ void Player::_SaveSkills()
 
         if (itr->second.uState == SKILL_DELETED)
         {
-            CharacterDatabase.PExecute("DELETE FROM character_skills WHERE guid = '%u' AND skill = '%u'", GetGUIDLow(), itr->first);
+            remove.AddRow("%u", itr->first);
             mSkillStatus.erase(itr++);
             continue;
         }
 
         uint32 valueData = GetUInt32Value(PLAYER_SKILL_VALUE_INDEX(itr->second.pos));
-        uint16 value = SKILL_VALUE(valueData);
-        uint16 max = SKILL_MAX(valueData);
-
-        switch (itr->second.uState)
-        {
-            case SKILL_NEW:
-                CharacterDatabase.PExecute("INSERT INTO character_skills (guid, skill, value, max) VALUES ('%u', '%u', '%u', '%u')",
-                                           GetGUIDLow(), itr->first, value, max);
-                break;
-            case SKILL_CHANGED:
-                CharacterDatabase.PExecute("UPDATE character_skills SET value = '%u',max = '%u'WHERE guid = '%u' AND skill = '%u' ",
-                                           value, max, GetGUIDLow(), itr->first );
-                break;
-            case SKILL_UNCHANGED:
-            case SKILL_DELETED:
-                break;
-        };
+        upsert.AddRow("(%u,%u,%u,%u)", GetGUIDLow(), itr->first, uint32(SKILL_VALUE(valueData)), uint32(SKILL_MAX(valueData)));
         itr->second.uState = SKILL_UNCHANGED;
 
         ++itr;
@@ -16760,14 +16986,20 @@ void Player::_SaveSkills()
 
 void Player::_SaveSpells()
 {
+    SqlBatch upsert(CharacterDatabase, "INSERT INTO character_spell (guid,spell,active,disabled) VALUES ",
+                    " ON DUPLICATE KEY UPDATE active=VALUES(active),disabled=VALUES(disabled)");
+    std::ostringstream del;
+    del << "DELETE FROM character_spell WHERE guid = '" << GetGUIDLow() << "' AND spell IN (";
+    SqlBatch remove(CharacterDatabase, del.str(), ")");
+
     for (PlayerSpellMap::iterator itr = m_spells.begin(), next = itr; itr != m_spells.end(); itr = next)
     {
         ++next;
 
-        if (itr->second.state == PLAYERSPELL_REMOVED || itr->second.state == PLAYERSPELL_CHANGED)
-            CharacterDatabase.PExecute("DELETE FROM character_spell WHERE guid = '%u' and spell = '%u'", GetGUIDLow(), itr->first);
-        if (itr->second.state == PLAYERSPELL_NEW || itr->second.state == PLAYERSPELL_CHANGED)
-            CharacterDatabase.PExecute("INSERT INTO character_spell (guid,spell,active,disabled) VALUES ('%u', '%u', '%u', '%u')", GetGUIDLow(), itr->first, itr->second.active ? 1 : 0, itr->second.disabled ? 1 : 0);
+        if (itr->second.state == PLAYERSPELL_REMOVED)
+            remove.AddRow("%u", itr->first);
+        else if (itr->second.state == PLAYERSPELL_NEW || itr->second.state == PLAYERSPELL_CHANGED)
+            upsert.AddRow("(%u,%u,%u,%u)", GetGUIDLow(), itr->first, itr->second.active ? 1 : 0, itr->second.disabled ? 1 : 0);
 
         if (itr->second.state == PLAYERSPELL_REMOVED)
             m_spells.erase(itr->first);
@@ -18847,7 +19079,7 @@ void Player::UpdateTriggerVisibility()
         }
     }
     udata.BuildPacket(&packet);
-    GetSession()->SendPacket(&packet);
+    GetSession()->SendPacket(std::move(packet));
 }
 
 template<class T>
@@ -19555,7 +19787,7 @@ void Player::UpdateForQuestsGO()
         }
     }
     udata.BuildPacket(&packet);
-    GetSession()->SendPacket(&packet);
+    GetSession()->SendPacket(std::move(packet));
 }
 
 void Player::SetSummonPoint(uint32 mapid, float x, float y, float z)
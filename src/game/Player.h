@@ -36,9 +36,12 @@
 #include "Utilities/Util.h"                                           // for Tokens typedef
 #include "ReputationMgr.h"
 
+#include<atomic>
 #include<string>
 #include<vector>
 
+#include <ace/Thread_Mutex.h>
+
 struct Mail;
 class Channel;
 class DynamicObject;
@@ -723,10 +726,23 @@ enum PlayerLoginQueryIndex
     PLAYER_LOGIN_QUERY_LOADARENAINFO            = 18,
     PLAYER_LOGIN_QUERY_LOADBGDATA               = 19,
     PLAYER_LOGIN_QUERY_LOADSKILLS               = 20,
+    PLAYER_LOGIN_QUERY_LOADSTABLEDPETS          = 21,
 
     MAX_PLAYER_LOGIN_QUERY
 };
 
+// Pets kept at the stable master, cached from character_pet at login
+struct StabledPetInfo
+{
+    uint32 petnumber;
+    uint32 entry;
+    uint32 level;
+    uint32 loyalty;
+    std::string name;
+};
+
+typedef std::map<uint32 /*slot*/, StabledPetInfo> StabledPetMap;
+
 enum PlayerDelayedOperations
 {
     DELAYED_SAVE_PLAYER         = 0x01,
@@ -1080,6 +1096,7 @@ class Player : public Unit, public GridObject<Player>
 
         Pet* GetPet() const;
         Pet* SummonPet(uint32 entry, float x, float y, float z, float ang, PetType petType, uint32 despwtime);
+        void RemoveDemonicSacrifice();
         void RemovePet(Pet* pet, PetSaveMode mode, bool returnreagent = false);
 
         uint32 GetPhaseMaskForSpawn() const;                // used for proper set phase for DB at GM-mode creature/GO spawn
@@ -1301,6 +1318,15 @@ class Player : public Unit, public GridObject<Player>
 
         uint32 m_stableSlots;
 
+        // stable master listing, kept in sync by Pet::SavePetToDB and Pet::LoadPetFromDB
+        StabledPetMap const& GetStabledPets() const
+        {
+            return m_stabledPets;
+        }
+        StabledPetMap::const_iterator FindStabledPet(uint32 petnumber) const;
+        void SetStabledPet(uint32 slot, Pet* pet);
+        void RemoveStabledPet(uint32 petnumber);
+
         /*********************************************************/
         /***                   GOSSIP SYSTEM                  ***/
         /*********************************************************/
@@ -1988,6 +2014,15 @@ class Player : public Unit, public GridObject<Player>
         void SendMessageToSetInRange(WorldPacket* data, float fist, bool self) override;// overwrite Object::SendMessageToSetInRange
         void SendMessageToSetInRange(WorldPacket* data, float dist, bool self, bool own_team_only);
 
+        // movement packets of other units, sent together once per map update. Packets
+        // that must not overtake them (destroy, teleport, own movement changes) flush
+        // the queue first, see WorldSession::PrepareSendPacket
+        void QueueCompressedMove(WorldPacket const* data, uint64 mover);
+        void SendCompressedMoves();
+        void SendCompressedMovesFor(uint64 mover);
+        void SendCompressedMovesFor(std::set<uint64> const& movers);
+        void ClearCompressedMoves();
+
         Corpse* GetCorpse() const;
         void SpawnCorpseBones();
         void CreateCorpse();
@@ -2038,6 +2073,10 @@ class Player : public Unit, public GridObject<Player>
         {
             return m_teleport_dest;
         }
+        uint32 GetTeleportOptions() const
+        {
+            return m_teleport_options;
+        }
         bool IsBeingTeleported() const
         {
             return mSemaphoreTeleport_Near || mSemaphoreTeleport_Far;
@@ -2349,6 +2388,11 @@ class Player : public Unit, public GridObject<Player>
         float  m_lastFallZ;
         Unit* m_mover;
         WorldObject* m_seer;
+
+        ByteBuffer m_compressedMoves;
+        std::atomic<uint32> m_compressedMoveCount;
+        std::vector<uint64> m_compressedMovers;             // units with a queued move
+        ACE_Thread_Mutex m_compressedMovesLock;
         void SetFallInformation(uint32 time, float z)
         {
             m_lastFallTime = time;
@@ -2732,6 +2776,7 @@ class Player : public Unit, public GridObject<Player>
         void _LoadDeclinedNames(QueryResult_AutoPtr result);
         void _LoadArenaTeamInfo(QueryResult_AutoPtr result);
         void _LoadBGData(QueryResult_AutoPtr result);
+        void _LoadStabledPets(QueryResult_AutoPtr result);
 
         /*********************************************************/
         /***                  SAVE SYSTEM                     ***/
@@ -2772,6 +2817,7 @@ class Player : public Unit, public GridObject<Player>
 
         uint32 m_team;
         uint32 m_nextSave;
+        uint32 m_saveDelayed;                               // time the pending autosave was held back
         time_t m_speakTime;
         uint32 m_speakCount;
         DungeonDifficulty m_dungeonDifficulty;
@@ -2836,6 +2882,12 @@ class Player : public Unit, public GridObject<Player>
         bool   m_DailyQuestChanged;
         time_t m_lastDailyQuestTime;
 
+        // hashes of what the last save wrote, 0 until written once;
+        // unchanged sections are not rewritten on the next save
+        uint64 m_savedDataHash;
+        uint64 m_savedAurasHash;
+        uint64 m_savedCooldownsHash;
+
         uint32 m_regenTimer;
         uint32 m_drunkTimer;
         uint16 m_drunk;
@@ -2957,6 +3009,8 @@ class Player : public Unit, public GridObject<Player>
 
         RAFLinkStatus m_rafLink;
 
+        StabledPetMap m_stabledPets;
+
         // Temporary removed pet cache
         uint32 m_temporaryUnsummonedPetNumber;
         uint32 m_oldpetspell;
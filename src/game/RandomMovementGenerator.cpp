@@ -24,6 +24,7 @@
 #include "MoveSpline.h"
 
 #define RUNNING_CHANCE_RANDOMMV 20                                  //will be "1 / RUNNING_CHANCE_RANDOMMV"
+#define RANDOM_MOVE_CANDIDATES  4                                   // destinations checked per move
 
 template<>
 void
@@ -44,42 +45,73 @@ RandomMovementGenerator<Creature>::_setRandomLocation(Creature& creature)
     //bool is_water_ok = creature.canSwim();
     bool is_air_ok   = creature.CanFly();
 
-    const float angle = rand_norm() * (M_PI * 2);
-    const float range = rand_norm() * wander_distance;
-    const float distanceX = range * cos(angle);
-    const float distanceY = range * sin(angle);
+    // Several destinations are drawn at once and their .map heights looked up
+    // in one batch, the first one passing the map check is taken
+    float xs[RANDOM_MOVE_CANDIDATES], ys[RANDOM_MOVE_CANDIDATES], dists[RANDOM_MOVE_CANDIDATES], heights[RANDOM_MOVE_CANDIDATES];
+    for (uint32 i = 0; i < RANDOM_MOVE_CANDIDATES; ++i)
+    {
+        const float angle = rand_norm() * (M_PI * 2);
+        const float range = rand_norm() * wander_distance;
+
+        nx = X + range * cos(angle);
+        ny = Y + range * sin(angle);
+
+        // prevent invalid coordinates generation
+        Oregon::NormalizeMapCoord(nx);
+        Oregon::NormalizeMapCoord(ny);
 
-    nx = X + distanceX;
-    ny = Y + distanceY;
+        xs[i] = nx;
+        ys[i] = ny;
+        dists[i] = (nx - X) * (nx - X) + (ny - Y) * (ny - Y);
+    }
 
-    // prevent invalid coordinates generation
-    Oregon::NormalizeMapCoord(nx);
-    Oregon::NormalizeMapCoord(ny);
+    map->GetGridHeights(xs, ys, heights, RANDOM_MOVE_CANDIDATES);
 
-    dist = (nx - X) * (nx - X) + (ny - Y) * (ny - Y);
-    
+    uint32 pick = 0;
     if (is_air_ok)                                          // 3D system above ground and above water (flying mode)
     {
-        // Limit height change
-        const float distanceZ = rand_norm() * sqrtf(dist) / 2.0f;
-        nz = Z + distanceZ;
-        float tz = map->GetHeight(nx, ny, nz - 2.0f, false); // Map check only, vmap needed here but need to alter vmaps checks for height.
-        float wz = map->GetWaterLevel(nx, ny);
-
-        // Problem here, we must fly above the ground and water, not under. Let's try on next tick
-        if (tz >= nz || wz >= nz)
+        float waterLevels[RANDOM_MOVE_CANDIDATES];
+        map->GetWaterLevels(xs, ys, waterLevels, RANDOM_MOVE_CANDIDATES);
+
+        // we must fly above the ground and water, not under
+        for (; pick < RANDOM_MOVE_CANDIDATES; ++pick)
+        {
+            // Limit height change
+            nz = Z + rand_norm() * sqrtf(dists[pick]) / 2.0f;
+            if (heights[pick] < nz && waterLevels[pick] < nz)
+                break;
+        }
+
+        // Problem here, no destination is usable. Let's try on next tick
+        if (pick == RANDOM_MOVE_CANDIDATES)
             return;
+
+        nx = xs[pick];
+        ny = ys[pick];
     }
     //else if (is_water_ok)                                 // 3D system under water and above ground (swimming mode)
     else                                                    // 2D only
     {
-        dist = dist >= 100.0f ? 10.0f : sqrtf(dist);        // 10.0 is the max that vmap high can check (MAX_CAN_FALL_DISTANCE)
+        for (uint32 i = 0; i < RANDOM_MOVE_CANDIDATES; ++i)
+            dists[i] = dists[i] >= 100.0f ? 10.0f : sqrtf(dists[i]);    // 10.0 is the max that vmap high can check (MAX_CAN_FALL_DISTANCE)
 
-        // The fastest way to get an accurate result 90% of the time.
+        // Map check, the fastest way to get an accurate result 90% of the time.
         // Better result can be obtained like 99% accuracy with a ray light, but the cost is too high and the code is too long.
-        nz = map->GetHeight(nx, ny, Z + dist - 2.0f, false);
+        for (; pick < RANDOM_MOVE_CANDIDATES; ++pick)
+            if (heights[pick] < Z + dists[pick] && fabs(heights[pick] - Z) <= dists[pick])
+                break;
+
+        // without a .map floor in reach the vmaps decide for the first one
+        bool mapHit = pick < RANDOM_MOVE_CANDIDATES;
+        if (!mapHit)
+            pick = 0;
+
+        nx = xs[pick];
+        ny = ys[pick];
+        dist = dists[pick];
+        nz = heights[pick];
 
-        if (fabs(nz - Z) > dist)                            // Map check
+        if (!mapHit)
         {
             nz = map->GetHeight(nx, ny, Z - 2.0f, true);    // Vmap Horizontal or above
 
@@ -20,6 +20,7 @@
 #include "Player.h"
 #include "WorldPacket.h"
 #include "ObjectMgr.h"
+#include "Database/SqlBatch.h"
 
 const int32 ReputationMgr::PointsInRank[MAX_REPUTATION_RANK] = { 36000, 3000, 3000, 3000, 6000, 12000, 21000, 1000 };
 
@@ -465,15 +466,15 @@ void ReputationMgr::LoadFromDB(QueryResult_AutoPtr result)
 
 void ReputationMgr::SaveToDB()
 {
+    SqlBatch upsert(CharacterDatabase, "INSERT INTO character_reputation (guid,faction,standing,flags) VALUES ",
+                    " ON DUPLICATE KEY UPDATE standing=VALUES(standing),flags=VALUES(flags)");
+
     for (FactionStateList::iterator itr = _factions.begin(); itr != _factions.end(); ++itr)
     {
         if (itr->second.needSave)
         {
-            CharacterDatabase.PExecute("DELETE FROM character_reputation WHERE guid = '%u' AND faction='%u'", _player->GetGUIDLow(), itr->second.ID);
-            CharacterDatabase.PExecute("INSERT INTO character_reputation (guid,faction,standing,flags) VALUES ('%u', '%u', '%i', '%u')", _player->GetGUIDLow(), itr->second.ID, itr->second.Standing, itr->second.Flags);
-                {
-                    itr->second.needSave = false;
-                }
+            upsert.AddRow("(%u,%u,%i,%u)", _player->GetGUIDLow(), itr->second.ID, itr->second.Standing, itr->second.Flags);
+            itr->second.needSave = false;
         }
     }
 }
\ No newline at end of file
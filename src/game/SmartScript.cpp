@@ -73,6 +73,7 @@ SmartScript::SmartScript()
     mTemplate = SMARTAI_TEMPLATE_BASIC;
     mScriptType = SMART_SCRIPT_TYPE_CREATURE;
     isProcessingTimedActionList = false;
+    memset(mEventIndexStart, 0, sizeof(mEventIndexStart));
 }
 
 SmartScript::~SmartScript()
@@ -102,23 +103,42 @@ void SmartScript::OnReset()
 
 void SmartScript::ProcessEventsFor(SMART_EVENT e, Unit* unit, uint32 var0, uint32 var1, bool bvar, const SpellEntry* spell, GameObject* gob)
 {
-    for (SmartAIEventList::iterator i = mEvents.begin(); i != mEvents.end(); ++i)
+    if (e >= SMART_EVENT_END || e == SMART_EVENT_LINK)//special handling
+        return;
+
+    // only visit the events of this type, not the whole script
+    for (uint32 n = mEventIndexStart[e]; n < mEventIndexStart[e + 1]; ++n)
     {
-        SMART_EVENT eventType = SMART_EVENT(i->GetEventType());
-        if (eventType == SMART_EVENT_LINK)//special handling
-            continue;
+        SmartScriptHolder& holder = mEvents[mEventIndex[n]];
 
-        if (eventType == e)
-        {
-            ConditionList conds = sConditionMgr.GetConditionsForSmartEvent(i->entryOrGuid, i->event_id, i->source_type);
-            ConditionSourceInfo info = ConditionSourceInfo(unit, GetBaseObject());
+        ConditionList const& conds = sConditionMgr.GetConditionsForSmartEvent(holder.entryOrGuid, holder.event_id, holder.source_type);
+        ConditionSourceInfo info = ConditionSourceInfo(unit, GetBaseObject());
 
-            if (sConditionMgr.IsObjectMeetToConditions(info, conds))
-                ProcessEvent(*i, unit, var0, var1, bvar, spell, gob);
-        }
+        if (sConditionMgr.IsObjectMeetToConditions(info, conds))
+            ProcessEvent(holder, unit, var0, var1, bvar, spell, gob);
     }
 }
 
+void SmartScript::IndexEvents()
+{
+    // counting sort of the event positions by event type
+    memset(mEventIndexStart, 0, sizeof(mEventIndexStart));
+    for (SmartAIEventList::const_iterator i = mEvents.begin(); i != mEvents.end(); ++i)
+        if (i->GetEventType() < SMART_EVENT_END)
+            ++mEventIndexStart[i->GetEventType() + 1];
+
+    for (uint32 type = 0; type < SMART_EVENT_END; ++type)
+        mEventIndexStart[type + 1] += mEventIndexStart[type];
+
+    uint32 next[SMART_EVENT_END];
+    memcpy(next, mEventIndexStart, sizeof(next));
+
+    mEventIndex.resize(mEventIndexStart[SMART_EVENT_END]);
+    for (uint32 pos = 0; pos < mEvents.size(); ++pos)
+        if (mEvents[pos].GetEventType() < SMART_EVENT_END)
+            mEventIndex[next[mEvents[pos].GetEventType()]++] = pos;
+}
+
 void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, uint32 var1, bool bvar, const SpellEntry* spell, GameObject* gob)
 {
     // calc random
@@ -2331,7 +2351,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
 
 void SmartScript::ProcessTimedAction(SmartScriptHolder& e, uint32 const& min, uint32 const& max, Unit* unit, uint32 var0, uint32 var1, bool bvar, const SpellEntry* spell, GameObject* gob)
 {
-    ConditionList const conds = sConditionMgr.GetConditionsForSmartEvent(e.entryOrGuid, e.event_id, e.source_type);
+    ConditionList const& conds = sConditionMgr.GetConditionsForSmartEvent(e.entryOrGuid, e.event_id, e.source_type);
     ConditionSourceInfo info = ConditionSourceInfo(unit, GetBaseObject());
 
     if (sConditionMgr.IsObjectMeetToConditions(info, conds))
@@ -3402,6 +3422,7 @@ void SmartScript::InstallEvents()
             mEvents.push_back(*i);//must be before UpdateTimers
 
         mInstallEvents.clear();
+        IndexEvents();
     }
 }
 
@@ -3459,7 +3480,7 @@ void SmartScript::OnUpdate(uint32 const diff)
     }
 }
 
-void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTriggerEntry const* at)
+void SmartScript::FillScript(SmartAIEventList const& e, WorldObject* obj, AreaTriggerEntry const* at)
 {
     if (e.empty())
     {
@@ -3469,7 +3490,8 @@ void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTriggerEn
             sLog.outDebug("SmartScript: EventMap for AreaTrigger %u is empty but is using SmartScript.", at->id);
         return;
     }
-    for (SmartAIEventList::iterator i = e.begin(); i != e.end(); ++i)
+    mEvents.reserve(mEvents.size() + e.size());
+    for (SmartAIEventList::const_iterator i = e.begin(); i != e.end(); ++i)
     {
         #ifndef TRINITY_DEBUG
             if ((*i).event.event_flags & SMART_EVENT_FLAG_DEBUG_ONLY)
@@ -3489,29 +3511,31 @@ void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTriggerEn
         }
         mEvents.push_back((*i));//NOTE: 'world(0)' events still get processed in ANY instance mode
     }
+    IndexEvents();
 }
 
 void SmartScript::GetScript()
 {
-    SmartAIEventList e;
+    // the loaded scripts are shared, only the events used by this object get copied
+    SmartAIEventList const* e;
     if (me)
     {
-        e = sSmartScriptMgr->GetScript(-((int32)me->GetDBTableGUIDLow()), mScriptType);
-        if (e.empty())
-            e = sSmartScriptMgr->GetScript((int32)me->GetEntry(), mScriptType);
-        FillScript(e, me, NULL);
+        e = &sSmartScriptMgr->GetScript(-((int32)me->GetDBTableGUIDLow()), mScriptType);
+        if (e->empty())
+            e = &sSmartScriptMgr->GetScript((int32)me->GetEntry(), mScriptType);
+        FillScript(*e, me, NULL);
     }
     else if (go)
     {
-        e = sSmartScriptMgr->GetScript(-((int32)go->GetDBTableGUIDLow()), mScriptType);
-        if (e.empty())
-            e = sSmartScriptMgr->GetScript((int32)go->GetEntry(), mScriptType);
-        FillScript(e, go, NULL);
+        e = &sSmartScriptMgr->GetScript(-((int32)go->GetDBTableGUIDLow()), mScriptType);
+        if (e->empty())
+            e = &sSmartScriptMgr->GetScript((int32)go->GetEntry(), mScriptType);
+        FillScript(*e, go, NULL);
     }
     else if (trigger)
     {
-        e = sSmartScriptMgr->GetScript((int32)trigger->id, mScriptType);
-        FillScript(e, NULL, trigger);
+        e = &sSmartScriptMgr->GetScript((int32)trigger->id, mScriptType);
+        FillScript(*e, NULL, trigger);
     }
 }
 
@@ -36,7 +36,7 @@ class SmartScript
 
         void OnInitialize(WorldObject* obj, AreaTriggerEntry const* at = NULL);
         void GetScript();
-        void FillScript(SmartAIEventList e, WorldObject* obj, AreaTriggerEntry const* at);
+        void FillScript(SmartAIEventList const& e, WorldObject* obj, AreaTriggerEntry const* at);
 
         void ProcessEventsFor(SMART_EVENT e, Unit* unit = NULL, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, const SpellEntry* spell = NULL, GameObject* gob = NULL);
         void ProcessEvent(SmartScriptHolder& e, Unit* unit = NULL, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, const SpellEntry* spell = NULL, GameObject* gob = NULL);
@@ -260,6 +260,11 @@ class SmartScript
         void SetPhase(uint32 p = 0) { mEventPhase = p; }
 
         SmartAIEventList mEvents;
+        // positions in mEvents grouped by event type, events of type t are
+        // mEventIndex[mEventIndexStart[t]] up to mEventIndex[mEventIndexStart[t + 1]]
+        std::vector<uint32> mEventIndex;
+        uint32 mEventIndexStart[SMART_EVENT_END + 1];
+        void IndexEvents();
         SmartAIEventList mInstallEvents;
         SmartAIEventList mTimedActionList;
         bool isProcessingTimedActionList;
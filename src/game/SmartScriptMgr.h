@@ -1489,11 +1489,12 @@ class SmartAIMgr
 
         void LoadSmartAIFromDB();
 
-        SmartAIEventList GetScript(int32 entry, SmartScriptType type)
+        SmartAIEventList const& GetScript(int32 entry, SmartScriptType type) const
         {
-            SmartAIEventList temp;
-            if (mEventMap[uint32(type)].find(entry) != mEventMap[uint32(type)].end())
-                return mEventMap[uint32(type)][entry];
+            static SmartAIEventList const temp;
+            SmartAIEventMap::const_iterator itr = mEventMap[uint32(type)].find(entry);
+            if (itr != mEventMap[uint32(type)].end())
+                return itr->second;
             else
             {
                 if (entry > 0)//first search is for guid (negative), do not drop error if not found
@@ -21,6 +21,7 @@
 #include "GridDefines.h"
 #include "SpellMgr.h"
 #include "SharedDefines.h"
+#include "Utilities/PacketBufferPool.h"
 
 static const uint32 MAX_SPELL_ID = 53085;
 
@@ -218,6 +219,9 @@ struct SpellValue
     uint32    MaxAffectedTargets;
     uint32    Duration;
     bool      CustomDuration;
+
+    static void* operator new(size_t size) { return PacketBufferPool::Allocate(size); }
+    static void operator delete(void* ptr, size_t size) { PacketBufferPool::Deallocate(ptr, size); }
 };
 
 enum SpellState
@@ -354,6 +358,11 @@ class Spell
         Spell(Unit* Caster, SpellEntry const* info, bool triggered, uint64 originalCasterGUID = 0, Spell** triggeringContainer = NULL, bool skipCheck = false);
         ~Spell();
 
+        // Spells, their events and their target lists are created for every
+        // cast, they are kept in the thread caches of the buffer pool
+        static void* operator new(size_t size) { return PacketBufferPool::Allocate(size); }
+        static void operator delete(void* ptr, size_t size) { PacketBufferPool::Deallocate(ptr, size); }
+
         void prepare(SpellCastTargets* targets, Aura* triggeredByAura = NULL);
         void cancel(bool sendInterrupt = true);
         void update(uint32 difftime);
@@ -623,7 +632,9 @@ class Spell
             int32  damage;
             bool   crit;
         };
-        std::list<TargetInfo> m_UniqueTargetInfo;
+        // lists and not vectors: effects may add targets while the list is walked
+        typedef std::list<TargetInfo, PacketBufferAllocator<TargetInfo> > TargetInfoList;
+        TargetInfoList m_UniqueTargetInfo;
         uint8 m_needAliveTargetMask;                        // Mask req. alive targets
         bool m_destroyed;
 
@@ -635,14 +646,16 @@ class Spell
             bool   processed: 1;
             bool   deleted: 1;
         };
-        std::list<GOTargetInfo> m_UniqueGOTargetInfo;
+        typedef std::list<GOTargetInfo, PacketBufferAllocator<GOTargetInfo> > GOTargetInfoList;
+        GOTargetInfoList m_UniqueGOTargetInfo;
 
         struct ItemTargetInfo
         {
             Item*  item;
             uint8 effectMask;
         };
-        std::list<ItemTargetInfo> m_UniqueItemInfo;
+        typedef std::list<ItemTargetInfo, PacketBufferAllocator<ItemTargetInfo> > ItemTargetInfoList;
+        ItemTargetInfoList m_UniqueItemInfo;
 
         void AddUnitTarget(Unit* target, uint32 effIndex);
         void AddUnitTarget(uint64 unitGUID, uint32 effIndex);
@@ -654,8 +667,8 @@ class Spell
         void DoAllEffectOnTarget(GOTargetInfo* target);
         void DoAllEffectOnTarget(ItemTargetInfo* target);
         bool IsAliveUnitPresentInTargetList();
-        void SearchAreaTarget(std::list<Unit*>& unitList, float radius, const uint32 type, SpellTargets TargetType, uint32 entry = 0);
-        void SearchChainTarget(std::list<Unit*>& unitList, float radius, uint32 unMaxTargets, SpellTargets TargetType);
+        void SearchAreaTarget(UnitSearchList& unitList, float radius, const uint32 type, SpellTargets TargetType, uint32 entry = 0);
+        void SearchChainTarget(UnitSearchList& unitList, float radius, uint32 unMaxTargets, SpellTargets TargetType);
         WorldObject* SearchNearbyTarget(float range, SpellTargets TargetType);
         bool IsValidSingleTargetEffect(Unit const* target, Targets type) const;
         bool IsValidSingleTargetSpell(Unit const* target) const;
@@ -672,9 +685,10 @@ class Spell
         // -------------------------------------------
 
         //List For Triggered Spells
-        typedef std::vector<SpellEntry const*> TriggerSpells;
+        typedef std::vector<SpellEntry const*, PacketBufferAllocator<SpellEntry const*> > TriggerSpells;
         TriggerSpells m_TriggerSpells;
-        typedef std::vector< std::pair<SpellEntry const*, int32> > ChanceTriggerSpells;
+        typedef std::pair<SpellEntry const*, int32> ChanceTriggerSpell;
+        typedef std::vector<ChanceTriggerSpell, PacketBufferAllocator<ChanceTriggerSpell> > ChanceTriggerSpells;
         ChanceTriggerSpells m_ChanceTriggerSpells;
 
         uint32 m_spellState;
@@ -699,7 +713,7 @@ namespace Oregon
 {
 struct SpellNotifierCreatureAndPlayer
 {
-    std::list<Unit*>* i_data;
+    UnitSearchList* i_data;
     Spell& i_spell;
     const uint32& i_push_type;
     float i_radius, i_radiusSq;
@@ -709,7 +723,7 @@ struct SpellNotifierCreatureAndPlayer
     const Position* const i_pos;
     SpellEntry const* i_spellProto;
 
-    SpellNotifierCreatureAndPlayer(Spell& spell, std::list<Unit*>& data, float radius, const uint32& type,
+    SpellNotifierCreatureAndPlayer(Spell& spell, UnitSearchList& data, float radius, const uint32& type,
                                    SpellTargets TargetType = SPELL_TARGETS_ENEMY, const Position* pos = NULL, uint32 entry = 0, SpellEntry const* spellProto = NULL)
         : i_data(&data), i_spell(spell), i_push_type(type), i_radius(radius), i_radiusSq(radius* radius),
           i_TargetType(TargetType), i_caster(spell.GetCaster()), i_entry(entry), i_pos(pos), i_spellProto(spellProto)
@@ -723,79 +737,105 @@ struct SpellNotifierCreatureAndPlayer
         if (!i_caster)
             return;
 
-        for (typename GridRefManager<T>::iterator itr = m.begin(); itr != m.end(); ++itr)
-        {
-            if (!itr->GetSource()->IsAlive() || (itr->GetSource()->GetTypeId() == TYPEID_PLAYER && ((Player*)itr->GetSource())->IsInFlight()))
-                continue;
-
-            switch (i_TargetType)
-            {
-            case SPELL_TARGETS_ALLY:
-                if (!i_caster->_IsValidAssistTarget(itr->GetSource(), i_spellProto))
-                    continue;
-                if (itr->GetSource()->HasFlag(UNIT_FIELD_FLAGS, UNIT_FLAG_NOT_SELECTABLE))
-                    continue;
-                if (itr->GetSource()->GetTypeId() == TYPEID_PLAYER && itr->GetSource()->ToPlayer()->IsGameMaster())
-                    continue;
-                break;
-            case SPELL_TARGETS_ENEMY:
-                {
-                    if (itr->GetSource()->GetTypeId() == TYPEID_UNIT && ((Creature*)itr->GetSource())->IsTotem())
-                        continue;
-
-                    if (i_caster->GetCreatureType() == CREATURE_TYPE_TOTEM)
-                    {
-                        if (!itr->GetSource()->isAttackableByAOE(i_pos->GetPositionX(), i_pos->GetPositionY(), i_pos->GetPositionZ(), true))
-                            continue;
-                    }
-                    else
-                    {
-                        if (!itr->GetSource()->isAttackableByAOE())
-                            continue;
-                    }
-
-                    if (!i_caster->_IsValidAttackTarget(itr->GetSource(), i_spellProto))
-                        continue;
+        // every object linked into the cell is indexed, no index means nothing to find
+        GridSpatialIndex const* index = m.FindSpatialIndex();
+        if (!index)
+            return;
 
-                }
-                break;
-            case SPELL_TARGETS_ENTRY:
-                {
-                    if (itr->GetSource()->GetEntry() != i_entry)
-                        continue;
-                }
+        // filter on packed positions first, the checks below are exact. The small
+        // slack covers rounding differences to the distance checks of the targets.
+        switch (i_push_type)
+        {
+            case PUSH_IN_LINE:
+                // only the width of the line is checked, nothing to filter on
+                for (typename GridRefManager<T>::iterator itr = m.begin(); itr != m.end(); ++itr)
+                    (*this)(itr->GetSource());
                 break;
-            default:
-                continue;
-            }
-
-            switch (i_push_type)
-            {
             case PUSH_IN_FRONT:
-                if (i_caster->isInFrontInMap((Unit*)(itr->GetSource()), i_radius, float(M_PI) / 3))
-                    i_data->push_back(itr->GetSource());
-                break;
             case PUSH_IN_BACK:
-                if (i_caster->isInBackInMap((Unit*)(itr->GetSource()), i_radius, float(M_PI) / 3))
-                    i_data->push_back(itr->GetSource());
-                break;
-            case PUSH_IN_LINE:
-                if (i_caster->HasInLine((Unit*)(itr->GetSource()), i_caster->GetObjectSize()))
-                    i_data->push_back(itr->GetSource());
+                index->template VisitInRange<T>(i_caster->GetPositionX(), i_caster->GetPositionY(), i_radius + i_caster->GetObjectSize() + 0.01f, true, PHASEMASK_ANYWHERE, *this);
                 break;
             default:
-                if (i_TargetType != SPELL_TARGETS_ENTRY && i_push_type == PUSH_SRC_CENTER && i_caster) // if caster then check distance from caster to target (because of model collision)
+                if (i_TargetType != SPELL_TARGETS_ENTRY && i_push_type == PUSH_SRC_CENTER)
+                    index->template VisitInRange<T>(i_caster->GetPositionX(), i_caster->GetPositionY(), i_radius + i_caster->GetObjectSize() + 0.01f, true, PHASEMASK_ANYWHERE, *this);
+                else
+                    index->template VisitInRange<T>(i_pos->GetPositionX(), i_pos->GetPositionY(), i_radius + 0.01f, false, PHASEMASK_ANYWHERE, *this);
+                break;
+        }
+    }
+
+    template<class T> inline void operator()(T* target)
+    {
+        if (!target->IsAlive() || (target->GetTypeId() == TYPEID_PLAYER && ((Player*)target)->IsInFlight()))
+            return;
+
+        switch (i_TargetType)
+        {
+        case SPELL_TARGETS_ALLY:
+            if (!i_caster->_IsValidAssistTarget(target, i_spellProto))
+                return;
+            if (target->HasFlag(UNIT_FIELD_FLAGS, UNIT_FLAG_NOT_SELECTABLE))
+                return;
+            if (target->GetTypeId() == TYPEID_PLAYER && target->ToPlayer()->IsGameMaster())
+                return;
+            break;
+        case SPELL_TARGETS_ENEMY:
+            {
+                if (target->GetTypeId() == TYPEID_UNIT && ((Creature*)target)->IsTotem())
+                    return;
+
+                if (i_caster->GetCreatureType() == CREATURE_TYPE_TOTEM)
                 {
-                    if (i_caster->IsWithinDistInMap(itr->GetSource(), i_radius))
-                        i_data->push_back(itr->GetSource());
+                    if (!target->isAttackableByAOE(i_pos->GetPositionX(), i_pos->GetPositionY(), i_pos->GetPositionZ(), true))
+                        return;
                 }
                 else
                 {
-                    if ((itr->GetSource()->GetExactDistSq(i_pos) < i_radiusSq))
-                        i_data->push_back(itr->GetSource());
+                    if (!target->isAttackableByAOE())
+                        return;
                 }
-                break;
+
+                if (!i_caster->_IsValidAttackTarget(target, i_spellProto))
+                    return;
+
+            }
+            break;
+        case SPELL_TARGETS_ENTRY:
+            {
+                if (target->GetEntry() != i_entry)
+                    return;
             }
+            break;
+        default:
+            return;
+        }
+
+        switch (i_push_type)
+        {
+        case PUSH_IN_FRONT:
+            if (i_caster->isInFrontInMap((Unit*)(target), i_radius, float(M_PI) / 3))
+                i_data->push_back(target);
+            break;
+        case PUSH_IN_BACK:
+            if (i_caster->isInBackInMap((Unit*)(target), i_radius, float(M_PI) / 3))
+                i_data->push_back(target);
+            break;
+        case PUSH_IN_LINE:
+            if (i_caster->HasInLine((Unit*)(target), i_caster->GetObjectSize()))
+                i_data->push_back(target);
+            break;
+        default:
+            if (i_TargetType != SPELL_TARGETS_ENTRY && i_push_type == PUSH_SRC_CENTER && i_caster) // if caster then check distance from caster to target (because of model collision)
+            {
+                if (i_caster->IsWithinDistInMap(target, i_radius))
+                    i_data->push_back(target);
+            }
+            else
+            {
+                if ((target->GetExactDistSq(i_pos) < i_radiusSq))
+                    i_data->push_back(target);
+            }
+            break;
         }
     }
 
@@ -821,6 +861,9 @@ class SpellEvent : public BasicEvent
         SpellEvent(Spell* spell);
         virtual ~SpellEvent();
 
+        static void* operator new(size_t size) { return PacketBufferPool::Allocate(size); }
+        static void operator delete(void* ptr, size_t size) { PacketBufferPool::Deallocate(ptr, size); }
+
         virtual bool Execute(uint64 e_time, uint32 p_time);
         virtual void Abort(uint64 e_time);
         virtual bool IsDeletable() const;
@@ -674,7 +674,7 @@ void AreaAura::Update(uint32 diff)
 
         if (!caster->HasUnitState(UNIT_STATE_ISOLATED))
         {
-            std::list<Unit* > targets;
+            UnitSearchList targets;
 
             switch (m_areaAuraType)
             {
@@ -684,14 +684,14 @@ void AreaAura::Update(uint32 diff)
             case AREA_AURA_FRIEND:
                 {
                     Oregon::AnyFriendlyUnitInObjectRangeCheck u_check(caster, caster, m_radius);
-                    Oregon::UnitListSearcher<Oregon::AnyFriendlyUnitInObjectRangeCheck> searcher(caster, targets, u_check);
+                    Oregon::UnitListSearcher<Oregon::AnyFriendlyUnitInObjectRangeCheck, UnitSearchList> searcher(caster, targets, u_check);
                     caster->VisitNearbyObject(m_radius, searcher);
                     break;
                 }
             case AREA_AURA_ENEMY:
                 {
                     Oregon::AnyAoETargetUnitInObjectRangeCheck u_check(caster, caster, m_radius); // No GetCharmer in searcher
-                    Oregon::UnitListSearcher<Oregon::AnyAoETargetUnitInObjectRangeCheck> searcher(caster, targets, u_check);
+                    Oregon::UnitListSearcher<Oregon::AnyAoETargetUnitInObjectRangeCheck, UnitSearchList> searcher(caster, targets, u_check);
                     caster->VisitNearbyObject(m_radius, searcher);
                     break;
                 }
@@ -704,7 +704,7 @@ void AreaAura::Update(uint32 diff)
                 }
             }
 
-            for (std::list<Unit* >::iterator tIter = targets.begin(); tIter != targets.end(); tIter++)
+            for (UnitSearchList::iterator tIter = targets.begin(); tIter != targets.end(); tIter++)
             {
                 if (!CheckTarget(*tIter))
                     continue;
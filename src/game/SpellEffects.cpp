@@ -334,7 +334,7 @@ void Spell::SpellDamageSchoolDmg(SpellEffIndex effIndex)
                 if (m_customAttr & SPELL_ATTR_CU_SHARE_DAMAGE)
                 {
                     uint32 count = 0;
-                    for (std::list<TargetInfo>::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+                    for (TargetInfoList::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
                     {
                         if (ihit->deleted)
                             continue;
@@ -675,7 +675,7 @@ void Spell::EffectDummy(SpellEffIndex effIndex)
             case 42784:
                 {
                     uint32 count = 0;
-                    for (std::list<TargetInfo>::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+                    for (TargetInfoList::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
                     {
                         if (ihit->deleted)
                             continue;
@@ -690,7 +690,7 @@ void Spell::EffectDummy(SpellEffIndex effIndex)
                     SpellEntry const* spellInfo = sSpellStore.LookupEntry(42784);
 
                     // now deal the damage
-                    for (std::list<TargetInfo>::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+                    for (TargetInfoList::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
                     {
                         if (ihit->deleted)
                             continue;
@@ -2084,7 +2084,7 @@ void Spell::EffectDummy(SpellEffIndex effIndex)
 
                 // Righteous Defense (step 2) (in old version 31980 dummy effect)
                 // Clear targets for eff 1
-                for (std::list<TargetInfo>::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+                for (TargetInfoList::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
                 {
                     if (ihit->deleted)
                         continue;
@@ -6706,7 +6706,15 @@ void Spell::EffectSummonDeadPet(SpellEffIndex /*effIndex*/)
     if (!pet)
     {
         _player->GetClosePoint(px, py, pz, _player->GetObjectSize(), PET_FOLLOW_DIST, PET_FOLLOW_ANGLE);
-        _player->SummonPet(0, px, py, pz, _player->GetOrientation(), SUMMON_PET, 0);
+
+        // revived right below, so it can't wait for the asynchronous load of SummonPet
+        _player->SetPetStatus(PET_STATUS_CURRENT);
+        Pet* newPet = new Pet(_player, SUMMON_PET);
+        if (!newPet->LoadPetFromDB(_player))
+        {
+            delete newPet;
+            return; // Something has gone wrong and the pet was not summoned
+        }
 
         // Make sure the pet has been summoned and exists in the world
         if (Pet* currentPet = _player->GetPet())
@@ -525,7 +525,7 @@ void Unit::Update(uint32 p_time)
     // WARNING! Order of execution here is important, do not change.
     // Spells must be processed with event system BEFORE they go to _UpdateSpells.
     // Or else we may have some SPELL_STATE_FINISHED spells stalled in pointers, that is bad.
-    m_Events.Update(p_time);
+    // m_Events is driven by the map's event wheel at the start of Map::Update.
 
     if (!IsInWorld())
         return;
@@ -11164,7 +11164,10 @@ uint32 Unit::GetCreatePowers(Powers power) const
 void Unit::AddToWorld()
 {
     if (!IsInWorld())
+    {
         WorldObject::AddToWorld();
+        m_Events.AttachTo(&GetMap()->GetEventWheel());
+    }
 }
 
 void Unit::RemoveFromWorld()
@@ -11193,6 +11196,7 @@ void Unit::RemoveFromWorld()
             sLog.outFatal("Crash alert! Unit %u has charmer guid when removed from world", GetEntry());
 
         WorldObject::RemoveFromWorld();
+        m_Events.Detach();
         m_duringRemoveFromWorld = false;
     }
 }
@@ -13422,7 +13426,7 @@ bool Unit::IsInRaidWith(Unit const* unit) const
         return false;
 }
 
-void Unit::GetRaidMember(std::list<Unit*>& nearMembers, float radius)
+void Unit::GetRaidMember(UnitSearchList& nearMembers, float radius)
 {
     Player* owner = GetCharmerOrOwnerPlayerOrPlayerItself();
     if (!owner)
@@ -13443,7 +13447,7 @@ void Unit::GetRaidMember(std::list<Unit*>& nearMembers, float radius)
     }
 }
 
-void Unit::GetPartyMember(std::list<Unit*>& TagUnitMap, float radius)
+void Unit::GetPartyMember(UnitSearchList& TagUnitMap, float radius)
 {
     Unit* owner = GetCharmerOrOwnerOrSelf();
     Group* pGroup = NULL;
@@ -13719,6 +13723,20 @@ void Unit::SendMonsterMoveWithSpeedToCurrentDestination(float speed)
     MonsterMoveWithSpeed(x, y, z, speed, true);
 }
 
+void Unit::SendMonsterMoveToSet(WorldPacket* data)
+{
+    // players get their own moves right away, moves of everything else are
+    // batched into SMSG_COMPRESSED_MOVES at the end of the map update
+    if (GetTypeId() == TYPEID_PLAYER || !sWorld.getConfig(CONFIG_COMPRESSED_MOVES))
+    {
+        SendMessageToSet(data, true);
+        return;
+    }
+
+    Oregon::MessageDistDeliverer notifier(this, data, GetVisibilityRange(), false, true);
+    VisitNearbyWorldObject(GetVisibilityRange(), notifier);
+}
+
 bool Unit::IsFalling() const
 {
     return m_movementInfo.HasMovementFlag((MovementFlags)(MOVEMENTFLAG_FALLING | MOVEMENTFLAG_FALLINGFAR)) || movespline->isFalling();
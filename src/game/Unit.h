@@ -31,6 +31,7 @@
 #include "FollowerReference.h"
 #include "FollowerRefManager.h"
 #include "Utilities/EventProcessor.h"
+#include "Utilities/SmallVector.h"
 #include "MotionMaster.h"
 #include "DBCStructure.h"
 #include <list>
@@ -779,6 +780,9 @@ struct CharmSpellEntry
 
 typedef std::list<Player*> SharedVisionList;
 
+// Result list of spell and area aura target searches, a raid fits without allocating
+typedef SmallVector<Unit*, 64> UnitSearchList;
+
 enum CharmType
 {
     CHARM_TYPE_CHARM,
@@ -1126,8 +1130,8 @@ class Unit : public WorldObject
         bool IsNeutralToAll() const;
         bool IsInPartyWith(Unit const* unit) const;
         bool IsInRaidWith(Unit const* unit) const;
-        void GetPartyMember(std::list<Unit*>& units, float dist);
-        void GetRaidMember(std::list<Unit*>& units, float dist);
+        void GetPartyMember(UnitSearchList& units, float dist);
+        void GetRaidMember(UnitSearchList& units, float dist);
         bool IsContestedGuard() const
         {
             if (FactionTemplateEntry const* entry = GetFactionTemplateEntry())
@@ -1916,6 +1920,7 @@ class Unit : public WorldObject
 
         void MonsterMoveWithSpeed(float x, float y, float z, float speed, bool generatePath = false, bool forceDestination = false);
         void SendMonsterMoveWithSpeedToCurrentDestination(float speed);
+        void SendMonsterMoveToSet(WorldPacket* data);
 
         void AddComboPointHolder(uint32 lowguid)
         {
@@ -2123,6 +2128,13 @@ void RandomResizeList(std::list<T>& _list, uint32 _size)
         _list.erase(itr);
     }
 }
+
+template<class T, uint32 N>
+void RandomResizeList(SmallVector<T, N>& _list, uint32 _size)
+{
+    while (_list.size() > _size)
+        _list.erase(_list.begin() + urand(0, _list.size() - 1));
+}
 }
 
 #endif
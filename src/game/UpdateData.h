@@ -63,12 +63,12 @@ class UpdateData
             return m_outOfRangeGUIDs;
         }
 
+        static void Compress(void* dst, uint32* dst_size, void* src, int src_size);
+
     protected:
         uint32 m_blockCount;
         std::set<uint64> m_outOfRangeGUIDs;
         ByteBuffer m_data;
-
-        void Compress(void* dst, uint32* dst_size, void* src, int src_size);
 };
 #endif
 
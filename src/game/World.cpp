@@ -98,6 +98,8 @@ World::World()
     m_resultQueue = NULL;
     m_NextDailyQuestReset = 0;
     m_scheduledScripts = 0;
+    m_autoSaveBudget = 0;
+    m_autoSaveCredit = 0;
 
     m_defaultDbcLocale = LOCALE_enUS;
     m_availableDbcLocaleMask = 0;
@@ -547,9 +549,12 @@ void World::LoadConfigSettings(bool reload)
         sLog.outError("Compression level (%i) must be in range 1..9. Using default compression level (1).", m_configs[CONFIG_COMPRESSION]);
         m_configs[CONFIG_COMPRESSION] = 1;
     }
+    m_configs[CONFIG_COMPRESSED_MOVES] = sConfig.GetBoolDefault("CompressedMoves", true);
     m_configs[CONFIG_ADDON_CHANNEL] = sConfig.GetBoolDefault("AddonChannel", true);
     m_configs[CONFIG_GRID_UNLOAD] = sConfig.GetBoolDefault("GridUnload", true);
     m_configs[CONFIG_INTERVAL_SAVE] = sConfig.GetIntDefault("PlayerSaveInterval", 900000);
+    m_configs[CONFIG_SAVE_MAX_PER_TICK] = sConfig.GetIntDefault("PlayerSaveMaxPerTick", 10);
+    m_configs[CONFIG_SAVE_MAX_DB_QUEUE] = sConfig.GetIntDefault("PlayerSaveMaxDBQueue", 1000);
     m_configs[CONFIG_INTERVAL_DISCONNECT_TOLERANCE] = sConfig.GetIntDefault("DisconnectToleranceInterval", 0);
 
     m_configs[CONFIG_INTERVAL_GRIDCLEAN] = sConfig.GetIntDefault("GridCleanUpDelay", 60000);
@@ -910,6 +915,7 @@ void World::LoadConfigSettings(bool reload)
     m_configs[CONFIG_BATTLEGROUND_PREMATURE_REWARD]             = sConfig.GetBoolDefault("Battleground.PrematureReward", true);
     m_configs[CONFIG_BATTLEGROUND_PREMATURE_FINISH_TIMER]       = sConfig.GetIntDefault("Battleground.PrematureFinishTimer", 5 * MINUTE * IN_MILLISECONDS);
     m_configs[CONFIG_BATTLEGROUND_WRATH_LEAVE_MODE]             = sConfig.GetBoolDefault("Battleground.LeaveWrathMode", false);
+    m_configs[CONFIG_BATTLEGROUND_QUEUE_UPDATE_INTERVAL]        = sConfig.GetIntDefault("Battleground.QueueUpdateInterval", 1000);
     m_configs[CONFIG_ARENA_MAX_RATING_DIFFERENCE]               = sConfig.GetIntDefault("Arena.MaxRatingDifference", 0);
     m_configs[CONFIG_ARENA_RATING_DISCARD_TIMER]                = sConfig.GetIntDefault("Arena.RatingDiscardTimer", 10 * MINUTE * IN_MILLISECONDS);
     m_configs[CONFIG_ARENA_AUTO_DISTRIBUTE_POINTS]              = sConfig.GetBoolDefault("Arena.AutoDistributePoints", false);
@@ -1016,6 +1022,15 @@ void World::LoadConfigSettings(bool reload)
     m_configs[CONFIG_INTERVAL_LOG_UPDATE] = sConfig.GetIntDefault("RecordUpdateTimeDiffInterval", 60000);
     m_configs[CONFIG_MIN_LOG_UPDATE] = sConfig.GetIntDefault("MinRecordUpdateTimeDiff", 100);
     m_configs[CONFIG_NUMTHREADS] = sConfig.GetIntDefault("MapUpdate.Threads", 1);
+    m_configs[CONFIG_MAPUPDATE_REGION_SIZE] = sConfig.GetIntDefault("MapUpdate.Regions.Size", 0);
+    if (m_configs[CONFIG_MAPUPDATE_REGION_SIZE] > MAX_NUMBER_OF_GRIDS / 2)
+    {
+        sLog.outError("MapUpdate.Regions.Size (%u) must be at most %u. Use this maximal value.", m_configs[CONFIG_MAPUPDATE_REGION_SIZE], MAX_NUMBER_OF_GRIDS / 2);
+        m_configs[CONFIG_MAPUPDATE_REGION_SIZE] = MAX_NUMBER_OF_GRIDS / 2;
+    }
+    m_configs[CONFIG_MAPUPDATE_REGION_MIN_PLAYERS] = sConfig.GetIntDefault("MapUpdate.Regions.MinPlayers", 200);
+    m_configs[CONFIG_MAPUPDATE_REGION_THREADS] = sConfig.GetIntDefault("MapUpdate.Regions.Threads", 4);
+    m_configs[CONFIG_GUID_RECYCLE_DELAY] = sConfig.GetIntDefault("Guid.RecycleDelay", 600);
     m_configs[CONFIG_DUEL_MOD] = sConfig.GetBoolDefault("DuelMod.Enable", false);
     m_configs[CONFIG_DUEL_CD_RESET] = sConfig.GetBoolDefault("DuelMod.Cooldowns", false);
     m_configs[CONFIG_AUTOBROADCAST_TIMER] = sConfig.GetIntDefault("AutoBroadcast.Timer", 60000);
@@ -1912,6 +1927,7 @@ void World::Update(uint32 diff)
 
     // Handle all other objects
     // Update objects when the timer has passed (maps, transport, creatures,...)
+    UpdateAutoSaveBudget(diff);
     MapManager::Instance().Update(diff);                // As interval = 0
 
     if (m_configs[CONFIG_AUTOBROADCAST_ENABLED])
@@ -1974,6 +1990,7 @@ void World::ForceGameEventUpdate()
 // Send a packet to all players (except self if mentioned)
 void World::SendGlobalMessage(WorldPacket* packet, WorldSession* self, uint32 team)
 {
+    WorldPacket_AutoPtr shared;
     SessionMap::iterator itr;
     for (itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
     {
@@ -1982,13 +1999,14 @@ void World::SendGlobalMessage(WorldPacket* packet, WorldSession* self, uint32 te
             itr->second->GetPlayer()->IsInWorld() &&
             itr->second != self &&
             (team == 0 || itr->second->GetPlayer()->GetTeam() == team))
-            itr->second->SendPacket(packet);
+            itr->second->SendPacket(packet, shared);
     }
 }
 
 // Send a packet to all GMs (except self if mentioned)
 void World::SendGlobalGMMessage(WorldPacket* packet, WorldSession* self, uint32 team)
 {
+    WorldPacket_AutoPtr shared;
     SessionMap::iterator itr;
     for (itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
     {
@@ -1998,7 +2016,7 @@ void World::SendGlobalGMMessage(WorldPacket* packet, WorldSession* self, uint32
             itr->second != self &&
             itr->second->GetSecurity() > SEC_PLAYER &&
             (team == 0 || itr->second->GetPlayer()->GetTeam() == team))
-            itr->second->SendPacket(packet);
+            itr->second->SendPacket(packet, shared);
     }
 }
 
@@ -2132,6 +2150,7 @@ void World::SendGlobalText(const char* text, WorldSession* self)
 bool World::SendZoneMessage(uint32 zone, WorldPacket* packet, WorldSession* self, uint32 team)
 {
     bool foundPlayerToSend = false;
+    WorldPacket_AutoPtr shared;
     SessionMap::iterator itr;
 
     for (itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
@@ -2143,7 +2162,7 @@ bool World::SendZoneMessage(uint32 zone, WorldPacket* packet, WorldSession* self
             itr->second != self &&
             (team == 0 || itr->second->GetPlayer()->GetTeam() == team))
         {
-            itr->second->SendPacket(packet);
+            itr->second->SendPacket(packet, shared);
             foundPlayerToSend = true;
         }
     }
@@ -2292,8 +2311,8 @@ bool World::RemoveBanAccount(BanMode mode, std::string nameOrIP)
 // Update the game time
 void World::_UpdateGameTime()
 {
-    // update the time
-    time_t thisTime = time(NULL);
+    // update the time, a packet replay runs on the time of the capture
+    time_t thisTime = SimulatedClock::IsActive() ? SimulatedClock::GetUnixTime() : time(NULL);
     uint32 elapsed = uint32(thisTime - m_gameTime);
     m_gameTime = thisTime;
 
@@ -2403,6 +2422,38 @@ void World::SendServerMessage(ServerMessageType type, const char* text, Player*
         SendGlobalMessage(&data);
 }
 
+void World::UpdateAutoSaveBudget(uint32 diff)
+{
+    if (!m_configs[CONFIG_INTERVAL_SAVE] || !m_configs[CONFIG_SAVE_MAX_PER_TICK])
+        return;
+
+    // character DB is behind, hold autosaves back until it catches up
+    if (m_configs[CONFIG_SAVE_MAX_DB_QUEUE] && CharacterDatabase.GetQueueSize() > m_configs[CONFIG_SAVE_MAX_DB_QUEUE])
+    {
+        m_autoSaveBudget = 0;
+        return;
+    }
+
+    // spread the saves of all online players over the save interval,
+    // at twice the average rate so deferred saves can catch up
+    m_autoSaveCredit += uint64(GetActiveSessionCount()) * diff * 2;
+    long slots = long(m_autoSaveCredit / m_configs[CONFIG_INTERVAL_SAVE]);
+    m_autoSaveCredit %= m_configs[CONFIG_INTERVAL_SAVE];
+
+    m_autoSaveBudget = std::min<long>(std::max<long>(m_autoSaveBudget.value(), 0) + slots, m_configs[CONFIG_SAVE_MAX_PER_TICK]);
+}
+
+bool World::TakeAutoSaveSlot()
+{
+    if (!m_configs[CONFIG_SAVE_MAX_PER_TICK])
+        return true;
+
+    if (m_autoSaveBudget.value() <= 0)
+        return false;
+
+    return --m_autoSaveBudget >= 0;
+}
+
 void World::UpdateSessions(time_t diff)
 {
     // Add new sessions
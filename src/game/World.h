@@ -82,8 +82,11 @@ enum WorldTimers
 enum WorldConfigs
 {
     CONFIG_COMPRESSION = 0,
+    CONFIG_COMPRESSED_MOVES,
     CONFIG_GRID_UNLOAD,
     CONFIG_INTERVAL_SAVE,
+    CONFIG_SAVE_MAX_PER_TICK,
+    CONFIG_SAVE_MAX_DB_QUEUE,
     CONFIG_INTERVAL_GRIDCLEAN,
     CONFIG_INTERVAL_MAPUPDATE,
     CONFIG_INTERVAL_CHANGEWEATHER,
@@ -207,6 +210,7 @@ enum WorldConfigs
     CONFIG_BATTLEGROUND_PREMATURE_REWARD,
     CONFIG_BATTLEGROUND_PREMATURE_FINISH_TIMER,
     CONFIG_BATTLEGROUND_WRATH_LEAVE_MODE,
+    CONFIG_BATTLEGROUND_QUEUE_UPDATE_INTERVAL,
     CONFIG_ARENA_MAX_RATING_DIFFERENCE,
     CONFIG_ARENA_RATING_DISCARD_TIMER,
     CONFIG_ARENA_AUTO_DISTRIBUTE_POINTS,
@@ -232,6 +236,10 @@ enum WorldConfigs
     CONFIG_PET_LOS,
     CONFIG_VMAP_TOTEM,
     CONFIG_NUMTHREADS,
+    CONFIG_MAPUPDATE_REGION_SIZE,
+    CONFIG_MAPUPDATE_REGION_MIN_PLAYERS,
+    CONFIG_MAPUPDATE_REGION_THREADS,
+    CONFIG_GUID_RECYCLE_DELAY,
     CONFIG_CHATLOG_CHANNEL,
     CONFIG_CHATLOG_WHISPER,
     CONFIG_CHATLOG_SYSCHAN,
@@ -477,6 +485,10 @@ class World
         {
             return m_sessions.size() - m_QueuedPlayer.size();
         }
+        // Autosave rate limit, refilled every world update and taken by Player::Update
+        void UpdateAutoSaveBudget(uint32 diff);
+        bool TakeAutoSaveSlot();
+
         uint32 GetQueuedSessionCount() const
         {
             return m_QueuedPlayer.size();
@@ -738,6 +750,7 @@ class World
 
         void UpdateResultQueue();
         void InitResultQueue();
+        SqlResultQueue* GetResultQueue() const { return m_resultQueue; }
 
         void ForceGameEventUpdate();
 
@@ -791,6 +804,10 @@ class World
         //atomic op counter for active scripts amount
         ACE_Atomic_Op<ACE_Thread_Mutex, long> m_scheduledScripts;
 
+        // autosaves allowed until the next refill, players update from several map threads
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> m_autoSaveBudget;
+        uint64 m_autoSaveCredit;
+
         time_t m_startTime;
         time_t m_gameTime;
         IntervalTimer m_timers[WUPDATE_COUNT];
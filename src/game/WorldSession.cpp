@@ -34,6 +34,7 @@
 #include "ScriptMgr.h"
 #include "WardenWin.h"
 #include "WardenMac.h"
+#include "PacketCapture.h"
 
 // WorldSession constructor
 WorldSession::WorldSession(uint32 id, WorldSocket* sock, uint32 sec, uint8 expansion, time_t mute_time, LocaleConstant locale) :
@@ -41,7 +42,7 @@ WorldSession::WorldSession(uint32 id, WorldSocket* sock, uint32 sec, uint8 expan
     _player(NULL), m_Socket(sock), _security(sec), _accountId(id), m_expansion(expansion), m_Warden(NULL),
     m_inQueue(false), m_playerLoading(false), m_playerLogout(false), m_playerRecentlyLogout(false), m_playerSave(false),
     m_sessionDbcLocale(sWorld.GetAvailableDbcLocale(locale)), m_sessionDbLocaleIndex(sObjectMgr.GetIndexForLocale(locale)),
-    _logoutTime(0), m_latency(0), m_clientTimeDelay(0)
+    _logoutTime(0), m_latency(0), m_clientTimeDelay(0), m_replayConnected(false)
 {
     if (sock)
     {
@@ -94,9 +95,36 @@ char const* WorldSession::GetPlayerName() const
 // Send a packet to the client
 void WorldSession::SendPacket(WorldPacket const* packet)
 {
-    if (!m_Socket)
+    if (!PrepareSendPacket(packet))
+        return;
+
+    if (m_Socket->SendPacket(*packet) == -1)
+        m_Socket->CloseSocket();
+}
+
+void WorldSession::SendPacket(WorldPacket&& packet)
+{
+    if (!PrepareSendPacket(&packet))
         return;
 
+    if (m_Socket->SendPacket(std::move(packet)) == -1)
+        m_Socket->CloseSocket();
+}
+
+void WorldSession::SendPacket(WorldPacket const* packet, WorldPacket_AutoPtr& shared)
+{
+    if (!PrepareSendPacket(packet))
+        return;
+
+    if (m_Socket->SendPacket(*packet, shared) == -1)
+        m_Socket->CloseSocket();
+}
+
+bool WorldSession::PrepareSendPacket(WorldPacket const* packet)
+{
+    if (!m_Socket)
+        return false;
+
     #ifdef OREGON_DEBUG
 
     // Code for network use statistic
@@ -133,8 +161,44 @@ void WorldSession::SendPacket(WorldPacket const* packet)
 
     #endif                                                  // !OREGON_DEBUG
 
-    if (m_Socket->SendPacket(*packet) == -1)
-        m_Socket->CloseSocket();
+    // creature moves are batched until the end of the map update, only packets that
+    // remove a mover or move the player itself must not overtake them
+    switch (packet->GetOpcode())
+    {
+        case SMSG_DESTROY_OBJECT:
+            if (_player && packet->size() >= sizeof(uint64))
+                _player->SendCompressedMovesFor(packet->read<uint64>(0));
+            break;
+        case SMSG_NEW_WORLD:
+        case SMSG_TRANSFER_PENDING:
+        case MSG_MOVE_TELEPORT_ACK:
+        case SMSG_MOVE_KNOCK_BACK:
+        case SMSG_FORCE_MOVE_ROOT:
+        case SMSG_FORCE_MOVE_UNROOT:
+        case SMSG_MOVE_WATER_WALK:
+        case SMSG_MOVE_LAND_WALK:
+        case SMSG_MOVE_FEATHER_FALL:
+        case SMSG_MOVE_NORMAL_FALL:
+        case SMSG_MOVE_SET_HOVER:
+        case SMSG_MOVE_UNSET_HOVER:
+        case SMSG_MOVE_SET_CAN_FLY:
+        case SMSG_MOVE_UNSET_CAN_FLY:
+        case SMSG_FORCE_WALK_SPEED_CHANGE:
+        case SMSG_FORCE_RUN_SPEED_CHANGE:
+        case SMSG_FORCE_RUN_BACK_SPEED_CHANGE:
+        case SMSG_FORCE_SWIM_SPEED_CHANGE:
+        case SMSG_FORCE_SWIM_BACK_SPEED_CHANGE:
+        case SMSG_FORCE_TURN_RATE_CHANGE:
+        case SMSG_FORCE_FLIGHT_SPEED_CHANGE:
+        case SMSG_FORCE_FLIGHT_BACK_SPEED_CHANGE:
+            if (_player)
+                _player->SendCompressedMoves();
+            break;
+        default:
+            break;
+    }
+
+    return true;
 }
 
 // Add an incoming packet to the queue
@@ -176,14 +240,14 @@ bool WorldSession::Update(uint32 diff)
     ///- Before we process anything:
     /// If necessary, kick the player from the character select screen
     if (IsConnectionIdle())
-        m_Socket->CloseSocket();
+        KickPlayer();
 
     // Retrieve packets from the receive queue and call the appropriate handlers
     // not proccess packets if socket already closed
     WorldPacket* packet;
     uint64 now = getMSTime64();
     uint32 packetsThisCycle = 0;
-    while (m_Socket && !m_Socket->IsClosed() && ++packetsThisCycle <= 20 && _recvQueue.next(packet))
+    while ((m_Socket ? !m_Socket->IsClosed() : m_replayConnected) && ++packetsThisCycle <= 20 && _recvQueue.next(packet))
     {
         /*#if 1
         sLog.outError("MOEP: %s (0x%.4X)",
@@ -306,11 +370,17 @@ bool WorldSession::Update(uint32 diff)
     // Cleanup socket pointer if need (disconnect)
     if (m_Socket && m_Socket->IsClosed())
     {
+        sPacketCapture.RecordSessionClose(this);
+
         m_Socket->RemoveReference();
         m_Socket = NULL;
         return false;
     }
 
+    // replayed session closed by the capture or kicked
+    if (!m_Socket && !m_replayConnected)
+        return false;
+
     return true;
 }
 
@@ -483,6 +553,8 @@ void WorldSession::KickPlayer()
 {
     if (m_Socket && !m_Socket->IsClosed())
         m_Socket->CloseSocket();
+
+    m_replayConnected = false;
 }
 
 // Cancel channeling handler
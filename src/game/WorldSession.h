@@ -19,6 +19,7 @@
 #define __WORLDSESSION_H
 
 #include "Common.h"
+#include "WorldPacket.h"
 #include "Database/QueryResult.h"
 #include "World.h"
 #include "WardenBase.h"
@@ -32,7 +33,6 @@ class Item;
 class Object;
 class Player;
 class Unit;
-class WorldPacket;
 class WorldSocket;
 class QueryResult;
 class LoginQueryHolder;
@@ -86,6 +86,10 @@ class WorldSession
         void SizeError(WorldPacket const& packet, uint32 size) const;
 
         void SendPacket(WorldPacket const* packet);
+        // takes over the buffer of a packet that is not used afterwards
+        void SendPacket(WorldPacket&& packet);
+        // one packet of a broadcast, see WorldSocket::SendPacket
+        void SendPacket(WorldPacket const* packet, WorldPacket_AutoPtr& shared);
         void SendNotification(const char* format, ...) ATTR_PRINTF(2, 3);
         void SendNotification(int32 string_id, ...);
         void SendPetNameInvalid(uint32 error, const std::string& name, DeclinedName* declinedName);
@@ -155,6 +159,12 @@ class WorldSession
         void QueuePacket(WorldPacket* new_packet);
         bool Update(uint32 diff);
 
+        // sessions replayed from a packet capture have no socket, they stay connected until the capture closes them
+        void SetReplayConnected(bool connected)
+        {
+            m_replayConnected = connected;
+        }
+
         // Handle the authentication waiting queue (to be completed)
         void SendAuthWaitQue(uint32 position);
 
@@ -715,6 +725,9 @@ class WorldSession
 
         void ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket* packet);
 
+        // bookkeeping before a packet is handed to the socket, false if there is no socket
+        bool PrepareSendPacket(WorldPacket const* packet);
+
         // logging helper
         void LogUnexpectedOpcode(WorldPacket* packet, const char* reason);
         void LogUnprocessedTail(WorldPacket* packet);
@@ -749,6 +762,7 @@ class WorldSession
         time_t _logoutTime;
         uint32 m_latency;
         uint32 m_clientTimeDelay;
+        bool m_replayConnected;
 
         struct ProtectedOpcodeStatus
         {
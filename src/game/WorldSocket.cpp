@@ -41,6 +41,7 @@
 #include "WorldSocketMgr.h"
 #include "Log.h"
 #include "DBCStores.h"
+#include "PacketCapture.h"
 
 #if defined(__GNUC__)
 #pragma pack(1)
@@ -77,6 +78,8 @@ WorldSocket::WorldSocket (void) :
     m_OutBuffer(0),
     m_OutBufferSize(65536),
     m_OutActive(false),
+    m_OutQueued(false),
+    m_NetThread(0),
     m_Seed(rand32())
 {
     reference_counting_policy().value (ACE_Event_Handler::Reference_Counting_Policy::ENABLED);
@@ -93,9 +96,7 @@ WorldSocket::~WorldSocket (void)
 
     peer().close();
 
-    WorldPacket* pct;
-    while (m_PacketQueue.dequeue_head (pct) == 0)
-        delete pct;
+    m_PacketQueue.reset();
 }
 
 bool WorldSocket::IsClosed (void) const
@@ -113,6 +114,9 @@ void WorldSocket::CloseSocket (void)
 
         closing_ = true;
         peer().close_writer();
+
+        // let the network thread drop the socket
+        schedule_flush (Guard);
     }
 
     {
@@ -131,45 +135,65 @@ int WorldSocket::SendPacket (const WorldPacket& pct)
 {
     ACE_GUARD_RETURN (LockType, Guard, m_OutBufferLock, -1);
 
-    if (closing_)
-        return -1;
-
-    // Dump outgoing packet.
-    if (sLog.IsLogTypeEnabled(LOG_TYPE_NETWORK))
+    int res = iBeginSendPacket (pct);
+    if (res == 1)
     {
-        sLog.outNetwork ("SERVER:\nSOCKET: %u\nLENGTH: %u\nOPCODE: %s (0x%.4X)\nDATA:\n",
-                                   (uint32) get_handle(),
-                                   pct.size(),
-                                   LookupOpcodeName (pct.GetOpcode()),
-                                   pct.GetOpcode());
-
-        uint32 p = 0;
-        while (p < pct.size())
-        {
-            for (uint32 j = 0; j < 16 && p < pct.size(); j++)
-                sLog.outNetwork("%.2X ", const_cast<WorldPacket&>(pct)[p++]);
+        WorldPacket* npct;
+        ACE_NEW_RETURN (npct, WorldPacket (pct), -1);
 
-            sLog.outNetwork("");
-        }
-        sLog.outNetwork("");
+        res = iQueuePacket (WorldPacket_AutoPtr (npct));
     }
 
-    if (iSendPacket (pct) == -1)
+    if (res == -1)
+        return -1;
+
+    iEndSendPacket (Guard);
+    return 0;
+}
+
+int WorldSocket::SendPacket (WorldPacket&& pct)
+{
+    ACE_GUARD_RETURN (LockType, Guard, m_OutBufferLock, -1);
+
+    int res = iBeginSendPacket (pct);
+    if (res == 1)
     {
         WorldPacket* npct;
+        ACE_NEW_RETURN (npct, WorldPacket (std::move (pct)), -1);
 
-        ACE_NEW_RETURN (npct, WorldPacket (pct), -1);
+        res = iQueuePacket (WorldPacket_AutoPtr (npct));
+    }
+
+    if (res == -1)
+        return -1;
+
+    iEndSendPacket (Guard);
+    return 0;
+}
+
+int WorldSocket::SendPacket (const WorldPacket& pct, WorldPacket_AutoPtr& shared)
+{
+    ACE_GUARD_RETURN (LockType, Guard, m_OutBufferLock, -1);
 
-        // NOTE maybe check of the size of the queue can be good ?
-        // to make it bounded instead of unbounded
-        if (m_PacketQueue.enqueue_tail (npct) == -1)
+    int res = iBeginSendPacket (pct);
+    if (res == 1)
+    {
+        // the first socket of the broadcast that falls behind copies the packet once
+        if (!shared.get())
         {
-            delete npct;
-            sLog.outError ("WorldSocket::SendPacket: m_PacketQueue.enqueue_tail failed");
-            return -1;
+            WorldPacket* npct;
+            ACE_NEW_RETURN (npct, WorldPacket (pct), -1);
+
+            shared.reset (npct);
         }
+
+        res = iQueuePacket (shared);
     }
 
+    if (res == -1)
+        return -1;
+
+    iEndSendPacket (Guard);
     return 0;
 }
 
@@ -217,7 +241,7 @@ int WorldSocket::open (void* a)
     WorldPacket packet (SMSG_AUTH_CHALLENGE, 4);
     packet << m_Seed;
 
-    if (SendPacket (packet) == -1)
+    if (SendPacket (std::move (packet)) == -1)
         return -1;
 
     // Register with ACE Reactor
@@ -339,6 +363,8 @@ int WorldSocket::handle_close (ACE_HANDLE h, ACE_Reactor_Mask)
 
         if (h == ACE_INVALID_HANDLE)
             peer().close_writer();
+
+        schedule_flush (Guard);
     }
 
     // Critical section
@@ -363,6 +389,18 @@ int WorldSocket::Update (void)
     return handle_output (get_handle ());
 }
 
+int WorldSocket::FlushOutput (void)
+{
+    {
+        ACE_GUARD_RETURN (LockType, Guard, m_OutBufferLock, -1);
+
+        // packets sent from now on need another flush
+        m_OutQueued = false;
+    }
+
+    return Update();
+}
+
 int WorldSocket::handle_input_header (void)
 {
     ACE_ASSERT (m_RecvWPct == NULL);
@@ -551,6 +589,19 @@ int WorldSocket::schedule_wakeup_output (GuardType& g)
     return 0;
 }
 
+void WorldSocket::schedule_flush (GuardType& g)
+{
+    if (m_OutQueued)
+        return;
+
+    m_OutQueued = true;
+
+    // the network thread may be waiting on m_OutBufferLock
+    g.release();
+
+    sWorldSocketMgr->OnSocketOutput (this);
+}
+
 int WorldSocket::ProcessIncoming (WorldPacket* new_pct)
 {
     ACE_ASSERT (new_pct);
@@ -611,6 +662,8 @@ int WorldSocket::ProcessIncoming (WorldPacket* new_pct)
                     // Catches people idling on the login screen and any lingering ingame connections.
                     m_Session->ResetTimeOutTime();
 
+                    sPacketCapture.RecordPacket(m_Session, *new_pct);
+
                     // OK ,give the packet to WorldSession
                     aptr.release();
                     // WARNINIG here we call it with locks held.
@@ -871,11 +924,13 @@ int WorldSocket::HandleAuthSession (WorldPacket& recvPacket)
     uint32 sleepTime = sWorld.getConfig(CONFIG_SESSION_ADD_DELAY);
     ACE_OS::sleep(ACE_Time_Value (0, sleepTime));
 
+    sPacketCapture.RecordSessionOpen(id, security, expansion, mutetime, locale);
+
     sWorld.AddSession (m_Session);
 
     // Create and send the Addon packet
     if (sAddOnHandler.BuildAddonPacket (&recvPacket, &SendAddonPacked))
-        SendPacket(SendAddonPacked);
+        SendPacket(std::move (SendAddonPacked));
 
     return 0;
 }
@@ -943,7 +998,59 @@ int WorldSocket::HandlePing (WorldPacket& recvPacket)
 
     WorldPacket packet (SMSG_PONG, 4);
     packet << ping;
-    return SendPacket (packet);
+    return SendPacket (std::move (packet));
+}
+
+int WorldSocket::iBeginSendPacket (const WorldPacket& pct)
+{
+    if (closing_)
+        return -1;
+
+    // Dump outgoing packet.
+    if (sLog.IsLogTypeEnabled(LOG_TYPE_NETWORK))
+    {
+        sLog.outNetwork ("SERVER:\nSOCKET: %u\nLENGTH: %u\nOPCODE: %s (0x%.4X)\nDATA:\n",
+                                   (uint32) get_handle(),
+                                   pct.size(),
+                                   LookupOpcodeName (pct.GetOpcode()),
+                                   pct.GetOpcode());
+
+        uint32 p = 0;
+        while (p < pct.size())
+        {
+            for (uint32 j = 0; j < 16 && p < pct.size(); j++)
+                sLog.outNetwork("%.2X ", const_cast<WorldPacket&>(pct)[p++]);
+
+            sLog.outNetwork("");
+        }
+        sLog.outNetwork("");
+    }
+
+    // a packet that fits must still wait behind the queued ones
+    if (!m_PacketQueue.is_empty () || iSendPacket (pct) == -1)
+        return 1;
+
+    return 0;
+}
+
+int WorldSocket::iQueuePacket (const WorldPacket_AutoPtr& pct)
+{
+    // NOTE maybe check of the size of the queue can be good ?
+    // to make it bounded instead of unbounded
+    if (m_PacketQueue.enqueue_tail (pct) == -1)
+    {
+        sLog.outError ("WorldSocket::SendPacket: m_PacketQueue.enqueue_tail failed");
+        return -1;
+    }
+
+    return 0;
+}
+
+void WorldSocket::iEndSendPacket (GuardType& g)
+{
+    // if the reactor is not already writing, the first packet since the last flush wakes the network thread
+    if (!m_OutActive)
+        schedule_flush (g);
 }
 
 int WorldSocket::iSendPacket (const WorldPacket& pct)
@@ -976,7 +1083,7 @@ int WorldSocket::iSendPacket (const WorldPacket& pct)
 
 bool WorldSocket::iFlushPacketQueue ()
 {
-    WorldPacket* pct;
+    WorldPacket_AutoPtr pct;
     bool haveone = false;
 
     while (m_PacketQueue.dequeue_head (pct) == 0)
@@ -985,7 +1092,6 @@ bool WorldSocket::iFlushPacketQueue ()
         {
             if (m_PacketQueue.enqueue_head (pct) == -1)
             {
-                delete pct;
                 sLog.outError ("WorldSocket::iFlushPacketQueue m_PacketQueue->enqueue_head");
                 return false;
             }
@@ -993,10 +1099,7 @@ bool WorldSocket::iFlushPacketQueue ()
             break;
         }
         else
-        {
             haveone = true;
-            delete pct;
-        }
     }
 
     return haveone;
@@ -35,9 +35,9 @@
 
 #include "Common.h"
 #include "Auth/AuthCrypt.h"
+#include "WorldPacket.h"
 
 class ACE_Message_Block;
-class WorldPacket;
 class WorldSession;
 
 // Handler that can communicate over stream sockets.
@@ -57,14 +57,15 @@ typedef ACE_Svc_Handler<ACE_SOCK_STREAM, ACE_NULL_SYNCH> WorldHandler;
  * does really a lot of small-size writes to it, and it doesn't
  * scale well to allocate memory for every. When something is
  * written to the output buffer the socket is not immediately
- * activated for output (again for the same reason), there
- * is 10ms celling (thats why there is Update() method).
- * This concept is similar to TCP_CORK, but TCP_CORK
- * uses 200ms celling. As result overhead generated by
- * sending packets from "producer" threads is minimal,
- * and doing a lot of writes with small size is tolerated.
+ * activated for output (again for the same reason), instead
+ * the first write after a flush hands the socket to its
+ * network thread, which is woken up through the reactor
+ * notification pipe and flushes all handed over sockets at
+ * once. Later writes only append until the next flush, so
+ * overhead generated by sending packets from "producer"
+ * threads is minimal and idle sockets are never touched.
  *
- * The calls to Update() method are managed by WorldSocketMgr
+ * The calls to FlushOutput() method are managed by WorldSocketMgr
  * and ReactorRunnable.
  *
  * For input ,the class uses one 1024 bytes buffer on stack
@@ -95,7 +96,7 @@ class WorldSocket : protected WorldHandler
         typedef ACE_Guard<LockType> GuardType;
 
         // Queue for storing packets for which there is no space.
-        typedef ACE_Unbounded_Queue< WorldPacket* > PacketQueueT;
+        typedef ACE_Unbounded_Queue< WorldPacket_AutoPtr > PacketQueueT;
 
         // Check if socket is closed.
         bool IsClosed (void) const;
@@ -111,6 +112,13 @@ class WorldSocket : protected WorldHandler
         // return -1 of failure
         int SendPacket (const WorldPacket& pct);
 
+        // Same as above, but takes over the buffer of pct if it has to be queued.
+        int SendPacket (WorldPacket&& pct);
+
+        // Send one packet of a broadcast. If pct has to be queued, shared is used
+        // instead of a copy, the first socket that needs it creates it from pct.
+        int SendPacket (const WorldPacket& pct, WorldPacket_AutoPtr& shared);
+
         // Add reference to this object.
         long AddReference (void);
 
@@ -141,6 +149,9 @@ class WorldSocket : protected WorldHandler
         // Called by WorldSocketMgr/ReactorRunnable.
         int Update (void);
 
+        // Called by ReactorRunnable for sockets handed over by schedule_flush().
+        int FlushOutput (void);
+
     private:
         // Helper functions for processing incoming data.
         int handle_input_header (void);
@@ -152,6 +163,10 @@ class WorldSocket : protected WorldHandler
         int cancel_wakeup_output (GuardType& g);
         int schedule_wakeup_output (GuardType& g);
 
+        // Hand the socket to its network thread for flushing, or for removal once closed.
+        // param g the guard is for m_OutBufferLock, the function will release it
+        void schedule_flush (GuardType& g);
+
         // process one incoming packet.
         // param new_pct received packet ,note that you need to delete it.
         int ProcessIncoming (WorldPacket* new_pct);
@@ -166,6 +181,19 @@ class WorldSocket : protected WorldHandler
         // Need to be called with m_OutBufferLock lock held
         int iSendPacket (const WorldPacket& pct);
 
+        // Dump pct to the network log and try to write it to m_OutBuffer behind
+        // the queued packets, return 1 if it has to be queued, -1 on failure.
+        // Need to be called with m_OutBufferLock lock held
+        int iBeginSendPacket (const WorldPacket& pct);
+
+        // Queue a packet that did not fit into m_OutBuffer.
+        // Need to be called with m_OutBufferLock lock held
+        int iQueuePacket (const WorldPacket_AutoPtr& pct);
+
+        // Wake up the network thread after a write to m_OutBuffer.
+        // Need to be called with m_OutBufferLock lock held
+        void iEndSendPacket (GuardType& g);
+
         // Flush m_PacketQueue if there are packets in it
         // Need to be called with m_OutBufferLock lock held
         // return true if it wrote to the buffer (AKA you need
@@ -218,6 +246,12 @@ class WorldSocket : protected WorldHandler
         // True if the socket is registered with the reactor for output
         bool m_OutActive;
 
+        // True if the socket waits in the flush list of its network thread
+        bool m_OutQueued;
+
+        // Network thread the socket was assigned to, set by WorldSocketMgr
+        size_t m_NetThread;
+
         uint32 m_Seed;
 };
 
@@ -31,6 +31,7 @@
 #include <ace/os_include/sys/os_socket.h>
 
 #include <set>
+#include <vector>
 
 #include "Log.h"
 #include "Common.h"
@@ -38,6 +39,24 @@
 #include "Database/DatabaseEnv.h"
 #include "WorldSocket.h"
 
+class ReactorRunnable;
+
+/**
+* Notification target of a network thread, flushes the sockets
+* that were handed over since the last wakeup.
+*/
+class OutputFlushHandler : public ACE_Event_Handler
+{
+    public:
+
+        explicit OutputFlushHandler (ReactorRunnable* owner) : m_Owner(owner) {}
+
+        virtual int handle_exception (ACE_HANDLE);
+
+    private:
+        ReactorRunnable* m_Owner;
+};
+
 /**
 * This is a helper class to WorldSocketMgr ,that manages
 * network threads, and assigning connections from acceptor thread
@@ -50,7 +69,9 @@ class ReactorRunnable : protected ACE_Task_Base
         ReactorRunnable() :
             m_Reactor(0),
             m_Connections(0),
-            m_ThreadId(-1)
+            m_ThreadId(-1),
+            m_OutputFlusher(this),
+            m_FlushSignaled(false)
         {
             ACE_Reactor_Impl* imp = 0;
 
@@ -77,6 +98,9 @@ class ReactorRunnable : protected ACE_Task_Base
             Wait();
 
             delete m_Reactor;
+
+            for (SocketList::iterator i = m_FlushSockets.begin(); i != m_FlushSockets.end(); ++i)
+                (*i)->RemoveReference();
         }
 
         void Stop()
@@ -119,6 +143,71 @@ class ReactorRunnable : protected ACE_Task_Base
             return m_Reactor;
         }
 
+        // Called from any thread, the first socket since the last flush wakes up the reactor
+        void QueueOutput (WorldSocket* sock)
+        {
+            {
+                ACE_GUARD (ACE_Thread_Mutex, Guard, m_FlushSockets_Lock);
+
+                sock->AddReference();
+                m_FlushSockets.push_back (sock);
+
+                if (m_FlushSignaled)
+                    return;
+
+                m_FlushSignaled = true;
+            }
+
+            Signal();
+        }
+
+        // Called at the end of a world tick, wakes up the reactor if a former notification failed
+        void SignalOutput()
+        {
+            {
+                ACE_GUARD (ACE_Thread_Mutex, Guard, m_FlushSockets_Lock);
+
+                if (m_FlushSignaled || m_FlushSockets.empty())
+                    return;
+
+                m_FlushSignaled = true;
+            }
+
+            Signal();
+        }
+
+        // Called by the reactor thread only
+        void FlushOutput()
+        {
+            SocketList sockets;
+
+            {
+                ACE_GUARD (ACE_Thread_Mutex, Guard, m_FlushSockets_Lock);
+
+                sockets.swap (m_FlushSockets);
+                m_FlushSignaled = false;
+            }
+
+            for (SocketList::iterator i = sockets.begin(); i != sockets.end(); ++i)
+            {
+                WorldSocket* sock = (*i);
+
+                if (sock->FlushOutput() == -1)
+                {
+                    sock->CloseSocket();
+
+                    // not yet moved over by AddNewSockets or already dropped
+                    if (m_Sockets.erase (sock))
+                    {
+                        sock->RemoveReference();
+                        --m_Connections;
+                    }
+                }
+
+                sock->RemoveReference();
+            }
+        }
+
     protected:
 
         void AddNewSockets()
@@ -144,6 +233,20 @@ class ReactorRunnable : protected ACE_Task_Base
             m_NewSockets.clear();
         }
 
+        void Signal()
+        {
+            // never block a producer thread on a full notification pipe,
+            // the sockets stay queued and SignalOutput() retries
+            ACE_Time_Value timeout (ACE_Time_Value::zero);
+
+            if (m_Reactor->notify (&m_OutputFlusher, ACE_Event_Handler::EXCEPT_MASK, &timeout) == -1)
+            {
+                ACE_GUARD (ACE_Thread_Mutex, Guard, m_FlushSockets_Lock);
+
+                m_FlushSignaled = false;
+            }
+        }
+
         virtual int svc()
         {
             DEBUG_LOG ("Network Thread Starting");
@@ -152,8 +255,6 @@ class ReactorRunnable : protected ACE_Task_Base
 
             ACE_ASSERT (m_Reactor);
 
-            SocketSet::iterator i, t;
-
             while (!m_Reactor->reactor_event_loop_done())
             {
                 // dont be too smart to move this outside the loop
@@ -163,22 +264,8 @@ class ReactorRunnable : protected ACE_Task_Base
                 if (m_Reactor->run_reactor_event_loop (interval) == -1)
                     break;
 
+                // output and closed sockets are handled by m_OutputFlusher
                 AddNewSockets();
-
-                for (i = m_Sockets.begin(); i != m_Sockets.end();)
-                {
-                    if ((*i)->Update() == -1)
-                    {
-                        t = i;
-                        ++i;
-                        (*t)->CloseSocket();
-                        (*t)->RemoveReference();
-                        --m_Connections;
-                        m_Sockets.erase (t);
-                    }
-                    else
-                        ++i;
-                }
             }
 
             WorldDatabase.ThreadEnd();
@@ -191,6 +278,7 @@ class ReactorRunnable : protected ACE_Task_Base
     private:
         typedef ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> AtomicInt;
         typedef std::set<WorldSocket*> SocketSet;
+        typedef std::vector<WorldSocket*> SocketList;
 
         ACE_Reactor* m_Reactor;
         AtomicInt m_Connections;
@@ -200,8 +288,21 @@ class ReactorRunnable : protected ACE_Task_Base
 
         SocketSet m_NewSockets;
         ACE_Thread_Mutex m_NewSockets_Lock;
+
+        OutputFlushHandler m_OutputFlusher;
+
+        // sockets with output or closed since the last flush, may hold a socket twice
+        SocketList m_FlushSockets;
+        bool m_FlushSignaled;
+        ACE_Thread_Mutex m_FlushSockets_Lock;
 };
 
+int OutputFlushHandler::handle_exception (ACE_HANDLE)
+{
+    m_Owner->FlushOutput();
+    return 0;
+}
+
 WorldSocketMgr::WorldSocketMgr() :
     m_NetThreads(0),
     m_NetThreadsCount(0),
@@ -349,9 +450,24 @@ WorldSocketMgr::OnSocketOpen (WorldSocket* sock)
         if (m_NetThreads[i].Connections() < m_NetThreads[min].Connections())
             min = i;
 
+    sock->m_NetThread = min;
+
     return m_NetThreads[min].AddSocket (sock);
 }
 
+void
+WorldSocketMgr::OnSocketOutput (WorldSocket* sock)
+{
+    m_NetThreads[sock->m_NetThread].QueueOutput (sock);
+}
+
+void
+WorldSocketMgr::FlushOutput()
+{
+    for (size_t i = 0; i < m_NetThreadsCount; ++i)
+        m_NetThreads[i].SignalOutput();
+}
+
 WorldSocketMgr*
 WorldSocketMgr::Instance()
 {
@@ -42,12 +42,17 @@ class WorldSocketMgr
         // Wait untill all network threads have "joined" .
         void Wait();
 
+        // Wake up network threads that still have sockets waiting for a flush, called once per world tick .
+        void FlushOutput();
+
         // Make this class singleton .
         static WorldSocketMgr* Instance();
 
     private:
         int OnSocketOpen(WorldSocket* sock);
 
+        void OnSocketOutput(WorldSocket* sock);
+
         int StartReactiveIO(ACE_UINT16 port, const char* address);
 
     private:
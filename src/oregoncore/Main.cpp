@@ -69,6 +69,7 @@ void usage(const char* prog)
                    "    -s uninstall             uninstall service\n\r"
                    #endif
                    "    -t --run-tests           run regression tests and exit\n\r"
+                   "    -r --replay capture_file replay a packet capture, report the world update times and exit\n\r"
                    , prog);
 }
 
@@ -79,16 +80,18 @@ extern int main(int argc, char** argv)
     char const* cfg_file = _OREGON_CORE_CONFIG;
 
     #ifdef _WIN32
-    char const* options = ":c:s:";
+    char const* options = ":c:s:r:";
     #else
-    char const* options = ":c:";
+    char const* options = ":c:r:";
     #endif
 
     bool runRegressionTtests = false;
+    char const* replayFile = NULL;
 
     ACE_Get_Opt cmd_opts(argc, argv, options);
     cmd_opts.long_option("version", 'v');
     cmd_opts.long_option("run-tests", 't');
+    cmd_opts.long_option("replay", 'r', ACE_Get_Opt::ARG_REQUIRED);
 
     int option;
     while ((option = cmd_opts()) != EOF)
@@ -132,6 +135,9 @@ extern int main(int argc, char** argv)
         case 't':
             runRegressionTtests = true;
             break;
+        case 'r':
+            replayFile = cmd_opts.opt_arg();
+            break;
         case ':':
             sLog.outError("Runtime-Error: -%c option requires an input argument", cmd_opts.opt_opt());
             usage(argv[0]);
@@ -168,7 +174,7 @@ extern int main(int argc, char** argv)
 
     // and run the 'Master'
     // todo - Why do we need this 'Master'? Can't all of this be in the Main as for Realmd?
-    int exitcode = sMaster.Run(runRegressionTtests);
+    int exitcode = sMaster.Run(runRegressionTtests, replayFile);
     if (exitcode == 2)
     {
         /* We need to close all fds except the standard ones,
@@ -36,6 +36,8 @@
 #include "MapManager.h"
 #include "BattlegroundMgr.h"
 #include "CreatureGroups.h"
+#include "PacketCapture.h"
+#include "PacketReplay.h"
 #include "Database/DatabaseEnv.h"
 
 #ifdef _WIN32
@@ -105,7 +107,7 @@ Master::~Master()
 }
 
 // Main function
-int Master::Run(bool runTests)
+int Master::Run(bool runTests, char const* replayFile)
 {
     int defaultStderr = dup(2);
 
@@ -223,6 +225,10 @@ int Master::Run(bool runTests)
     }
 
     // Launch the world listener socket
+    // Record the packets of the clients for a later replay
+    if (!replayFile)
+        sPacketCapture.Initialize();
+
     uint16 wsport = sWorld.getConfig(CONFIG_PORT_WORLD);
     std::string bind_ip = sConfig.GetStringDefault ("BindIP", "0.0.0.0");
 
@@ -251,6 +257,15 @@ int Master::Run(bool runTests)
             World::StopNow(ERROR_EXIT_CODE);
     }
 
+    // Replay a packet capture instead of serving clients, then gracefully exit
+    if (replayFile)
+    {
+        if (RunPacketReplay(replayFile))
+            World::StopNow(SHUTDOWN_EXIT_CODE);
+        else
+            World::StopNow(ERROR_EXIT_CODE);
+    }
+
     // Run our World, we use main thread for this,
     MainLoop();
 
@@ -263,6 +278,8 @@ int Master::Run(bool runTests)
 
     sWorldSocketMgr->StopNetwork();
 
+    sPacketCapture.Close();
+
     MapManager::Instance().UnloadAll();            // unload all grids (including locked in memory)
 
     // End the database thread
@@ -431,6 +448,15 @@ bool Master::RunRegressionTests()
     return suite.RunAll();
 }
 
+bool Master::RunPacketReplay(char const* filename)
+{
+    PacketReplay replay;
+    if (!replay.Open(filename))
+        return false;
+
+    return replay.Run(sConfig.GetIntDefault("PacketReplay.TickDiff", 50), sConfig.GetIntDefault("PacketReplay.Seed", 1));
+}
+
 // Heartbeat for the World
 void Master::MainLoop()
 {
@@ -448,6 +474,7 @@ void Master::MainLoop()
         uint32 diff = getMSTimeDiff(realPrevTime, realCurrTime);
 
         sWorld.Update(diff);
+        sWorldSocketMgr->FlushOutput();
         realPrevTime = realCurrTime;
 
         // diff (D0) include time of previous sleep (d0) + tick time (t0)
@@ -28,10 +28,11 @@ class Master
     public:
         Master();
         ~Master();
-        int Run(bool runTests);
+        int Run(bool runTests, char const* replayFile);
         static volatile uint32 m_masterLoopCounter;
 
         bool RunRegressionTests();
+        bool RunPacketReplay(char const* filename);
     private:
         void _StartDB();
 
@@ -23,6 +23,7 @@
 #include "AuthSocket.h"
 #include "AuthCodes.h"
 #include "PatchHandler.h"
+#include "DelayExecutor.h"
 
 #include <openssl/md5.h>
 //#include "Util.h" -- for commented utf8ToUpperOnlyLatin
@@ -30,6 +31,10 @@
 #include <ace/OS_NS_unistd.h>
 #include <ace/OS_NS_fcntl.h>
 #include <ace/OS_NS_sys_stat.h>
+#include <ace/Method_Request.h>
+#include <ace/Guard_T.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/Reactor.h>
 
 extern DatabaseType LoginDatabase;
 
@@ -160,6 +165,156 @@ const AuthHandler table[] =
 
 #define AUTH_TOTAL_COMMANDS sizeof(table)/sizeof(AuthHandler)
 
+class LoginDBThreadStartReq : public ACE_Method_Request
+{
+    public:
+
+        LoginDBThreadStartReq()
+        {
+        }
+
+        virtual int call()
+        {
+            LoginDatabase.ThreadStart();
+            return 0;
+        }
+};
+
+class LoginDBThreadEndReq : public ACE_Method_Request
+{
+    public:
+
+        LoginDBThreadEndReq()
+        {
+        }
+
+        virtual int call()
+        {
+            LoginDatabase.ThreadEnd();
+            return 0;
+        }
+};
+
+// Sockets whose finished job could not be announced through the reactor notify
+// pipe, handed back to the reactor thread by ProcessFinishedJobs()
+static ACE_Thread_Mutex s_finishedJobsLock;
+static std::vector<AuthSocket*> s_finishedJobs;
+
+class AuthJobRequest : public ACE_Method_Request
+{
+    private:
+
+        AuthSocket& m_socket;
+        AuthSocket::AuthJob m_job;
+        AuthSocket::AuthJob m_finish;
+
+    public:
+
+        AuthJobRequest(AuthSocket& socket, AuthSocket::AuthJob job, AuthSocket::AuthJob finish)
+            : m_socket(socket), m_job(job), m_finish(finish)
+        {
+        }
+
+        virtual int call()
+        {
+            m_socket.RunJob(m_job, m_finish);
+            return 0;
+        }
+};
+
+// Character counts of the accounts which recently asked for the realm list.
+// Clients poll the realm list while they sit in the realm selection screen,
+// so this keeps it at one realmcharacters query per account and cache period.
+class RealmCharacterCache
+{
+    public:
+        typedef std::map<uint32, uint8> CountMap;           // realmid -> numchars
+
+        RealmCharacterCache() : m_expireDelay(0), m_nextPurge(0) {}
+
+        void SetExpireDelay(uint32 seconds)
+        {
+            m_expireDelay = seconds;
+        }
+
+        bool Get(uint32 acctid, CountMap& counts)
+        {
+            if (!m_expireDelay)
+                return false;
+
+            ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_lock, false);
+
+            Entries::const_iterator itr = m_entries.find(acctid);
+            if (itr == m_entries.end() || itr->second.expireTime <= time(NULL))
+                return false;
+
+            counts = itr->second.counts;
+            return true;
+        }
+
+        void Set(uint32 acctid, CountMap const& counts)
+        {
+            if (!m_expireDelay)
+                return;
+
+            time_t now = time(NULL);
+
+            ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+
+            Entry& entry = m_entries[acctid];
+            entry.expireTime = now + m_expireDelay;
+            entry.counts = counts;
+
+            // drop the expired accounts once per cache period
+            if (m_nextPurge <= now)
+            {
+                for (Entries::iterator itr = m_entries.begin(); itr != m_entries.end();)
+                {
+                    if (itr->second.expireTime <= now)
+                        itr = m_entries.erase(itr);
+                    else
+                        ++itr;
+                }
+
+                m_nextPurge = now + m_expireDelay;
+            }
+        }
+
+    private:
+        struct Entry
+        {
+            time_t expireTime;
+            CountMap counts;
+        };
+
+        typedef UNORDERED_MAP<uint32, Entry> Entries;
+
+        Entries m_entries;
+        ACE_Thread_Mutex m_lock;
+        uint32 m_expireDelay;
+        time_t m_nextPurge;
+};
+
+static RealmCharacterCache sRealmCharacterCache;
+
+bool AuthSocket::StartWorkers(uint32 threads)
+{
+    if (!threads)
+        return true;
+
+    return DelayExecutor::instance()->activate(threads, new LoginDBThreadStartReq, new LoginDBThreadEndReq) != -1;
+}
+
+void AuthSocket::StopWorkers()
+{
+    DelayExecutor::instance()->deactivate();
+}
+
+void AuthSocket::SetCharacterCountCacheTime(uint32 seconds)
+{
+    sRealmCharacterCache.SetExpireDelay(seconds);
+}
+
 // Constructor - set the N and g values for SRP6
 AuthSocket::AuthSocket()
 {
@@ -168,9 +323,15 @@ AuthSocket::AuthSocket()
     _status = STATUS_CHALLENGE;
 
     _accountSecurityLevel = SEC_PLAYER;
+    _accountId = 0;
 
     _build = 0;
     patch_ = ACE_INVALID_HANDLE;
+
+    _jobPending = false;
+    _closePending = false;
+    _jobResult = false;
+    _jobFinish = NULL;
 }
 
 // Close patch file descriptor before leaving
@@ -195,6 +356,10 @@ void AuthSocket::OnRead()
     uint8 _cmd;
     while (1)
     {
+        // the rest of the input is handled once the worker is done with this socket
+        if (_jobPending)
+            return;
+
         if(!recv_soft((char*)&_cmd, 1))
             return;
 
@@ -221,8 +386,11 @@ void AuthSocket::OnRead()
 
                 if (!(*this.*table[i].handler)())
                 {
-                    DEBUG_LOG("Command handler failed for cmd %u recv length %u",
-                              (uint32)_cmd, (uint32)recv_len());
+                    if (!_jobPending)
+                    {
+                        DEBUG_LOG("Command handler failed for cmd %u recv length %u",
+                                  (uint32)_cmd, (uint32)recv_len());
+                    }
 
                     return;
                 }
@@ -241,6 +409,102 @@ void AuthSocket::OnRead()
     }
 }
 
+// Run the expensive part of a command handler. With auth workers the job runs in
+// a worker thread and the socket stops reading commands until handle_exception()
+// has sent the reply, without workers it runs right away like any other handler.
+bool AuthSocket::QueueJob(AuthJob job, AuthJob finish)
+{
+    if (!DelayExecutor::instance()->activated())
+    {
+        ByteBuffer pkt;
+        bool result = (this->*job)(pkt);
+        return FinishJob(finish, result, pkt);
+    }
+
+    _jobPending = true;
+    _jobReply.clear();
+
+    if (DelayExecutor::instance()->execute(new AuthJobRequest(*this, job, finish)) == -1)
+    {
+        sLog.outError("[Auth] failed to schedule auth job for '%s'", getRemoteAddress().c_str());
+        _jobPending = false;
+        close_connection();
+    }
+
+    return false;
+}
+
+void AuthSocket::RunJob(AuthJob job, AuthJob finish)
+{
+    _jobResult = (this->*job)(_jobReply);
+    _jobFinish = finish;
+
+    // hand the socket back to the reactor thread, the socket itself must not be
+    // touched here any more
+    if (reactor()->notify(this, ACE_Event_Handler::EXCEPT_MASK) == -1)
+    {
+        sLog.outError("[Auth] failed to notify reactor about finished auth job, queueing it");
+
+        ACE_GUARD(ACE_Thread_Mutex, guard, s_finishedJobsLock);
+        s_finishedJobs.push_back(this);
+    }
+}
+
+// Called in the reactor thread between event loop runs
+void AuthSocket::ProcessFinishedJobs()
+{
+    std::vector<AuthSocket*> finished;
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, s_finishedJobsLock);
+        finished.swap(s_finishedJobs);
+    }
+
+    // same as a notify dispatched by the reactor
+    for (std::vector<AuthSocket*>::const_iterator itr = finished.begin(); itr != finished.end(); ++itr)
+        if ((*itr)->handle_exception() == -1)
+            (*itr)->handle_close(ACE_INVALID_HANDLE, ACE_Event_Handler::EXCEPT_MASK);
+}
+
+bool AuthSocket::FinishJob(AuthJob finish, bool result, ByteBuffer& pkt)
+{
+    if (result && finish)
+        result = (this->*finish)(pkt);
+
+    if (pkt.size())
+        send((char const*)pkt.contents(), pkt.size());
+
+    return result;
+}
+
+int AuthSocket::handle_exception(ACE_HANDLE)
+{
+    if (!_jobPending)
+        return 0;
+
+    _jobPending = false;
+
+    // the peer went away while the worker was busy, handle_close() does the cleanup now
+    if (_closePending)
+        return -1;
+
+    if (FinishJob(_jobFinish, _jobResult, _jobReply))
+        OnRead();
+
+    return 0;
+}
+
+int AuthSocket::handle_close(ACE_HANDLE h, ACE_Reactor_Mask mask)
+{
+    // the worker still uses this socket, delay the destruction until it is done
+    if (_jobPending)
+    {
+        _closePending = true;
+        return 0;
+    }
+
+    return BufferedSocket::handle_close(h, mask);
+}
+
 // Make the SRP6 calculation from hash in dB
 void AuthSocket::_SetVSFields(const std::string& rI)
 {
@@ -273,7 +537,7 @@ void AuthSocket::_SetVSFields(const std::string& rI)
     OPENSSL_free((void*)s_hex);
 }
 
-void AuthSocket::SendProof(Sha1Hash sha)
+void AuthSocket::SendProof(ByteBuffer& pkt, Sha1Hash& sha)
 {
     switch (_build)
     {
@@ -286,7 +550,7 @@ void AuthSocket::SendProof(Sha1Hash sha)
             proof.error = 0;
             proof.unk2 = 0x00;
 
-            send((char*)&proof, sizeof(proof));
+            pkt.append((uint8*)&proof, sizeof(proof));
             break;
         }
     case 8606:                                          // 2.4.3
@@ -305,7 +569,7 @@ void AuthSocket::SendProof(Sha1Hash sha)
             proof.unk2 = 0x00;
             proof.unk3 = 0x00;
 
-            send((char*)&proof, sizeof(proof));
+            pkt.append((uint8*)&proof, sizeof(proof));
             break;
         }
     }
@@ -353,8 +617,6 @@ bool AuthSocket::_HandleLogonChallenge()
     EndianConvert(ch->timezone_bias);
     EndianConvert(ch->ip);
 
-    ByteBuffer pkt;
-
     _login = (const char*)ch->I;
     _build = ch->build;
 
@@ -371,6 +633,15 @@ bool AuthSocket::_HandleLogonChallenge()
     _safelogin = _login;
     LoginDatabase.escape_string(_safelogin);
 
+    _localizationName.resize(4);
+    for (int i = 0; i < 4; ++i)
+        _localizationName[i] = ch->country[4 - i - 1];
+
+    return QueueJob(&AuthSocket::_ProcessLogonChallenge);
+}
+
+bool AuthSocket::_ProcessLogonChallenge(ByteBuffer& pkt)
+{
     pkt << (uint8) CMD_AUTH_LOGON_CHALLENGE;
     pkt << (uint8) 0x00;
 
@@ -499,12 +770,9 @@ bool AuthSocket::_HandleLogonChallenge()
 
                     uint8 secLevel = (*result)[4].GetUInt8();
                     _accountSecurityLevel = secLevel <= SEC_ADMINISTRATOR ? AccountTypes(secLevel) : SEC_ADMINISTRATOR;
+                    _accountId = (*result)[1].GetUInt32();
 
-                    _localizationName.resize(4);
-                    for (int i = 0; i < 4; ++i)
-                        _localizationName[i] = ch->country[4 - i - 1];
-
-                    sLog.outBasic("[AuthChallenge] account %s is using '%c%c%c%c' locale (%u)", _login.c_str (), ch->country[3], ch->country[2], ch->country[1], ch->country[0], GetLocaleByName(_localizationName));
+                    sLog.outBasic("[AuthChallenge] account %s is using '%s' locale (%u)", _login.c_str (), _localizationName.c_str(), GetLocaleByName(_localizationName));
 
                     _status = STATUS_LOGON_PROOF;
                 }
@@ -513,7 +781,6 @@ bool AuthSocket::_HandleLogonChallenge()
         else                                                // no account
             pkt << (uint8) WOW_FAIL_UNKNOWN_ACCOUNT;
     }
-    send((char const*)pkt.contents(), pkt.size());
     return true;
 }
 
@@ -586,10 +853,18 @@ bool AuthSocket::_HandleLogonProof()
         return true;
     }
 
+    memcpy(_clientA, lp.A, sizeof(_clientA));
+    memcpy(_clientM1, lp.M1, sizeof(_clientM1));
+
+    return QueueJob(&AuthSocket::_ProcessLogonProof);
+}
+
+bool AuthSocket::_ProcessLogonProof(ByteBuffer& pkt)
+{
     // Continue the SRP6 calculation based on data received from the client
     BigNumber A;
 
-    A.SetBinary(lp.A, 32);
+    A.SetBinary(_clientA, 32);
 
     // SRP safeguard: abort if A==0 or A % N == 0
     if (A.isZero() || (A % N).isZero())
@@ -651,7 +926,7 @@ bool AuthSocket::_HandleLogonProof()
     M.SetBinary(sha.GetDigest(), 20);
 
     // Check if SRP6 results match (password is correct), else send an error
-    if (!memcmp(M.AsByteArray(), lp.M1, 20))
+    if (!memcmp(M.AsByteArray(), _clientM1, 20))
     {
         sLog.outBasic("User '%s' successfully authenticated", _login.c_str());
 
@@ -666,7 +941,7 @@ bool AuthSocket::_HandleLogonProof()
         sha.UpdateBigNumbers(&A, &M, &K, NULL);
         sha.Finalize();
 
-        SendProof(sha);
+        SendProof(pkt, sha);
 
         // Set _status to authed
         _status = STATUS_AUTHED;
@@ -675,14 +950,14 @@ bool AuthSocket::_HandleLogonProof()
     {
         if (_build > 6005)                                  // > 1.12.2
         {
-            char data[4] = { CMD_AUTH_LOGON_PROOF, WOW_FAIL_UNKNOWN_ACCOUNT, 3, 0};
-            send(data, sizeof(data));
+            uint8 data[4] = { CMD_AUTH_LOGON_PROOF, WOW_FAIL_UNKNOWN_ACCOUNT, 3, 0};
+            pkt.append(data, sizeof(data));
         }
         else
         {
             // 1.x not react incorrectly at 4-byte message use 3 as real error
-            char data[2] = { CMD_AUTH_LOGON_PROOF, WOW_FAIL_UNKNOWN_ACCOUNT};
-            send(data, sizeof(data));
+            uint8 data[2] = { CMD_AUTH_LOGON_PROOF, WOW_FAIL_UNKNOWN_ACCOUNT};
+            pkt.append(data, sizeof(data));
         }
         sLog.outBasic("[AuthChallenge] account %s tried to login with wrong password!", _login.c_str ());
 
@@ -774,7 +1049,12 @@ bool AuthSocket::_HandleReconnectChallenge()
     // Restore string order as its byte order is reversed
     std::reverse(_os.begin(), _os.end());
 
-    QueryResult_AutoPtr result = LoginDatabase.PQuery ("SELECT sessionkey FROM account WHERE username = '%s'", _safelogin.c_str ());
+    return QueueJob(&AuthSocket::_ProcessReconnectChallenge);
+}
+
+bool AuthSocket::_ProcessReconnectChallenge(ByteBuffer& pkt)
+{
+    QueryResult_AutoPtr result = LoginDatabase.PQuery ("SELECT sessionkey, id FROM account WHERE username = '%s'", _safelogin.c_str ());
 
     // Stop if the account is not found
     if (!result)
@@ -786,17 +1066,16 @@ bool AuthSocket::_HandleReconnectChallenge()
 
     Field* fields = result->Fetch ();
     K.SetHexStr (fields[0].GetString ());
+    _accountId = fields[1].GetUInt32();
 
     _status = STATUS_RECON_PROOF;
 
     // Sending response
-    ByteBuffer pkt;
     pkt << (uint8)  CMD_AUTH_RECONNECT_CHALLENGE;
     pkt << (uint8)  0x00;
     _reconnectProof.SetRand(16 * 8);
     pkt.append(_reconnectProof.AsByteArray(16), 16);        // 16 bytes random
     pkt << (uint64) 0x00 << (uint64) 0x00;                  // 16 bytes zeros
-    send((char const*)pkt.contents(), pkt.size());
     return true;
 }
 
@@ -854,10 +1133,29 @@ bool AuthSocket::_HandleRealmList()
 
     recv_skip(5);
 
-    // Get the user id (else close the connection)
-    // No SQL injection (escaped user name)
+    // Only go to the database if the character counts of this account are not cached
+    if (sRealmCharacterCache.Get(_accountId, _realmCharacters))
+    {
+        ByteBuffer pkt;
+        _BuildRealmList(pkt);
+        send((char const*)pkt.contents(), pkt.size());
+        return true;
+    }
 
-    QueryResult_AutoPtr result = LoginDatabase.PQuery("SELECT id,sha_pass_hash FROM account WHERE username = '%s'", _safelogin.c_str());
+    return QueueJob(&AuthSocket::_LoadRealmCharacters, &AuthSocket::_BuildRealmList);
+}
+
+bool AuthSocket::_LoadRealmCharacters(ByteBuffer& /*pkt*/)
+{
+    _realmCharacters.clear();
+
+    // Get the user id (else close the connection) and the number of characters on all realms at once
+    // No SQL injection (escaped user name)
+    QueryResult_AutoPtr result = LoginDatabase.PQuery("SELECT a.id, rc.realmid, rc.numchars "
+                                                      "FROM account a "
+                                                      "LEFT JOIN realmcharacters rc "
+                                                      "ON (rc.acctid = a.id) "
+                                                      "WHERE a.username = '%s'", _safelogin.c_str());
     if (!result)
     {
         sLog.outError("[ERROR] user %s tried to login and we cannot find him in the database.", _login.c_str());
@@ -865,27 +1163,38 @@ bool AuthSocket::_HandleRealmList()
         return false;
     }
 
-    uint32 id = (*result)[0].GetUInt32();
-    std::string rI = (*result)[1].GetCppString();
+    _accountId = (*result)[0].GetUInt32();
+
+    do
+    {
+        Field* fields = result->Fetch();
+        if (fields[1].GetString())                           // NULL if the account has no characters
+            _realmCharacters[fields[1].GetUInt32()] = fields[2].GetUInt8();
+    }
+    while (result->NextRow());
+
+    sRealmCharacterCache.Set(_accountId, _realmCharacters);
+    return true;
+}
 
+// Called in the reactor thread, the realm list is not guarded against concurrent updates
+bool AuthSocket::_BuildRealmList(ByteBuffer& hdr)
+{
     // Update realm list if need
     sRealmList->UpdateIfNeed();
 
     // Circle through realms in the RealmList and construct the return packet (including # of user characters in each realm)
     ByteBuffer pkt;
-    LoadRealmlist(pkt, id);
+    LoadRealmlist(pkt);
 
-    ByteBuffer hdr;
     hdr << (uint8) CMD_REALM_LIST;
     hdr << (uint16)pkt.size();
     hdr.append(pkt);
 
-    send((char const*)hdr.contents(), hdr.size());
-
     return true;
 }
 
-void AuthSocket::LoadRealmlist(ByteBuffer& pkt, uint32 acctid)
+void AuthSocket::LoadRealmlist(ByteBuffer& pkt)
 {
     switch (_build)
     {
@@ -897,17 +1206,8 @@ void AuthSocket::LoadRealmlist(ByteBuffer& pkt, uint32 acctid)
 
             for (RealmList::RealmMap::const_iterator  i = sRealmList->begin(); i != sRealmList->end(); ++i)
             {
-                uint8 AmountOfCharacters;
-
-                // No SQL injection. id of realm is controlled by the database.
-                QueryResult_AutoPtr result = LoginDatabase.PQuery( "SELECT numchars FROM realmcharacters WHERE realmid = '%d' AND acctid='%u'", i->second.m_ID, acctid);
-                if ( result )
-                {
-                    Field* fields = result->Fetch();
-                    AmountOfCharacters = fields[0].GetUInt8();
-                }
-                else
-                    AmountOfCharacters = 0;
+                std::map<uint32, uint8>::const_iterator chars = _realmCharacters.find(i->second.m_ID);
+                uint8 AmountOfCharacters = chars != _realmCharacters.end() ? chars->second : 0;
 
                 bool ok_build = std::find(i->second.realmbuilds.begin(), i->second.realmbuilds.end(), _build) != i->second.realmbuilds.end();
 
@@ -958,17 +1258,8 @@ void AuthSocket::LoadRealmlist(ByteBuffer& pkt, uint32 acctid)
 
             for (RealmList::RealmMap::const_iterator  i = sRealmList->begin(); i != sRealmList->end(); ++i)
             {
-                uint8 AmountOfCharacters;
-
-                // No SQL injection. id of realm is controlled by the database.
-                QueryResult_AutoPtr result = LoginDatabase.PQuery("SELECT numchars FROM realmcharacters WHERE realmid = '%d' AND acctid='%u'", i->second.m_ID, acctid);
-                if ( result )
-                {
-                    Field* fields = result->Fetch();
-                    AmountOfCharacters = fields[0].GetUInt8();
-                }
-                else
-                    AmountOfCharacters = 0;
+                std::map<uint32, uint8>::const_iterator chars = _realmCharacters.find(i->second.m_ID);
+                uint8 AmountOfCharacters = chars != _realmCharacters.end() ? chars->second : 0;
 
                 bool ok_build = std::find(i->second.realmbuilds.begin(), i->second.realmbuilds.end(), _build) != i->second.realmbuilds.end();
 
@@ -25,6 +25,9 @@
 
 #include "BufferedSocket.h"
 
+#include <atomic>
+#include <map>
+
 enum eStatus
 {
     STATUS_CHALLENGE,
@@ -41,13 +44,29 @@ class AuthSocket: public BufferedSocket
     public:
         const static int s_BYTE_SIZE = 32;
 
+        // Expensive part of a command handler (SRP6 math, database queries), run by the auth workers
+        typedef bool (AuthSocket::*AuthJob)(ByteBuffer& pkt);
+
         AuthSocket();
         ~AuthSocket();
 
+        static bool StartWorkers(uint32 threads);
+        static void StopWorkers();
+        static void SetCharacterCountCacheTime(uint32 seconds);
+
         void OnAccept();
         void OnRead();
-        void SendProof(Sha1Hash sha);
-        void LoadRealmlist(ByteBuffer& pkt, uint32 acctid);
+        void SendProof(ByteBuffer& pkt, Sha1Hash& sha);
+        void LoadRealmlist(ByteBuffer& pkt);
+
+        // called in the worker thread
+        void RunJob(AuthJob job, AuthJob finish);
+        // called in the reactor thread, finishes jobs RunJob() could not notify the reactor about
+        static void ProcessFinishedJobs();
+
+        int handle_exception(ACE_HANDLE = ACE_INVALID_HANDLE) override;
+        int handle_close(ACE_HANDLE = ACE_INVALID_HANDLE,
+                         ACE_Reactor_Mask = ACE_Event_Handler::ALL_EVENTS_MASK) override;
 
         bool _HandleLogonChallenge();
         bool _HandleLogonProof();
@@ -64,6 +83,15 @@ class AuthSocket: public BufferedSocket
 
     private:
 
+        bool _ProcessLogonChallenge(ByteBuffer& pkt);
+        bool _ProcessLogonProof(ByteBuffer& pkt);
+        bool _ProcessReconnectChallenge(ByteBuffer& pkt);
+        bool _LoadRealmCharacters(ByteBuffer& pkt);
+        bool _BuildRealmList(ByteBuffer& pkt);
+
+        bool QueueJob(AuthJob job, AuthJob finish = NULL);
+        bool FinishJob(AuthJob finish, bool result, ByteBuffer& pkt);
+
         BigNumber N, s, g, v;
         BigNumber b, B;
         BigNumber K;
@@ -80,6 +108,22 @@ class AuthSocket: public BufferedSocket
         std::string _os;
         uint16 _build;
         AccountTypes _accountSecurityLevel;
+        uint32 _accountId;
+
+        // logon proof data handed over to the worker
+        uint8 _clientA[32];
+        uint8 _clientM1[20];
+
+        // realmid -> numchars for this account
+        std::map<uint32, uint8> _realmCharacters;
+
+        // Worker job state. _jobPending and _closePending are only touched by the reactor
+        // thread, the job fields are written by the worker before it hands the socket back
+        std::atomic<bool> _jobPending;
+        bool _closePending;
+        bool _jobResult;
+        AuthJob _jobFinish;
+        ByteBuffer _jobReply;
 
         ACE_HANDLE patch_;
 
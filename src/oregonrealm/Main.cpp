@@ -216,6 +216,14 @@ extern int main(int argc, char** argv)
         return 1;
     }
 
+    // Start the workers for the SRP6 and database part of the authentication
+    AuthSocket::SetCharacterCountCacheTime(sConfig.GetIntDefault("RealmsCharacterCountCacheTime", 10));
+    if (!AuthSocket::StartWorkers(sConfig.GetIntDefault("AuthWorkerThreads", 2)))
+    {
+        sLog.outError("Cannot start the auth worker threads.");
+        return 1;
+    }
+
     // cleanup query
     // set expired bans to inactive
     LoginDatabase.Execute("UPDATE account_banned SET active = 0 WHERE unbandate<=UNIX_TIMESTAMP() AND unbandate<>bandate");
@@ -292,6 +300,8 @@ extern int main(int argc, char** argv)
         if (ACE_Reactor::instance()->run_reactor_event_loop(interval) == -1)
             break;
 
+        AuthSocket::ProcessFinishedJobs();
+
         if ( (++loopCounter) == numLoops )
         {
             loopCounter = 0;
@@ -304,6 +314,9 @@ extern int main(int argc, char** argv)
         #endif
     }
 
+    // Stop the auth workers before the database goes away
+    AuthSocket::StopWorkers();
+
     // Wait for the delay thread to exit
     LoginDatabase.HaltDelayThread();
 
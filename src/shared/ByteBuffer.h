@@ -22,6 +22,7 @@
 #include "Errors.h"
 #include "Log.h"
 #include "Utilities/ByteConverter.h"
+#include "Utilities/PacketBufferPool.h"
 
 class ByteBufferException
 {
@@ -70,6 +71,35 @@ class ByteBuffer
         // copy constructor
         ByteBuffer(const ByteBuffer& buf): _rpos(buf._rpos), _wpos(buf._wpos), _storage(buf._storage) { }
 
+        // move constructor, takes over the storage without copying it
+        ByteBuffer(ByteBuffer&& buf): _rpos(buf._rpos), _wpos(buf._wpos), _storage(std::move(buf._storage))
+        {
+            buf._rpos = buf._wpos = 0;
+        }
+
+        ByteBuffer& operator=(const ByteBuffer& buf)
+        {
+            if (this != &buf)
+            {
+                _rpos = buf._rpos;
+                _wpos = buf._wpos;
+                _storage = buf._storage;
+            }
+            return *this;
+        }
+
+        ByteBuffer& operator=(ByteBuffer&& buf)
+        {
+            if (this != &buf)
+            {
+                _rpos = buf._rpos;
+                _wpos = buf._wpos;
+                _storage = std::move(buf._storage);
+                buf._rpos = buf._wpos = 0;
+            }
+            return *this;
+        }
+
         void clear()
         {
             _storage.clear();
@@ -503,8 +533,11 @@ class ByteBuffer
         }
 
     protected:
+        // storage comes from size classed per thread pools instead of the heap
+        typedef std::vector<uint8, PacketBufferAllocator<uint8> > StorageType;
+
         size_t _rpos, _wpos;
-        std::vector<uint8> _storage;
+        StorageType _storage;
 };
 
 template <typename T>
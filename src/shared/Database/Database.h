@@ -65,6 +65,8 @@ class Database
 
         void InitDelayThread();
         void HaltDelayThread();
+        // Async statements and transactions not yet executed by the delay thread
+        size_t GetQueueSize() const { return m_threadBody ? m_threadBody->GetQueueSize() : 0; }
 
         QueryResult_AutoPtr Query(const char* sql);
         QueryResult_AutoPtr PQuery(const char* format, ...) ATTR_PRINTF(2, 3);
@@ -110,6 +112,9 @@ class Database
         bool DelayQueryHolder(Class* object, void (Class::*method)(QueryResult_AutoPtr, SqlQueryHolder*), SqlQueryHolder* holder);
         template<class Class, typename ParamType1>
         bool DelayQueryHolder(Class* object, void (Class::*method)(QueryResult_AutoPtr, SqlQueryHolder*, ParamType1), SqlQueryHolder* holder, ParamType1 param1);
+        // for threads without a result queue, the callback is run by the thread updating queue
+        template<class Class>
+        bool DelayQueryHolder(Class* object, void (Class::*method)(QueryResult_AutoPtr, SqlQueryHolder*), SqlQueryHolder* holder, SqlResultQueue* queue);
 
         bool Execute(const char* sql);
         bool PExecute(const char* format, ...) ATTR_PRINTF(2, 3);
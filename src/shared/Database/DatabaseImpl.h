@@ -199,6 +199,16 @@ Database::DelayQueryHolder(Class* object, void (Class::*method)(QueryResult_Auto
     return holder->Execute(new Oregon::QueryCallback<Class, SqlQueryHolder*, ParamType1>(object, method, QueryResult_AutoPtr(NULL), holder, param1), m_threadBody, itr->second);
 }
 
+template<class Class>
+bool
+Database::DelayQueryHolder(Class* object, void (Class::*method)(QueryResult_AutoPtr, SqlQueryHolder*), SqlQueryHolder* holder, SqlResultQueue* queue)
+{
+    if (!holder || !queue)
+        return false;
+
+    return holder->Execute(new Oregon::QueryCallback<Class, SqlQueryHolder*>(object, method, QueryResult_AutoPtr(NULL), holder), m_threadBody, queue);
+}
+
 #undef ASYNC_QUERY_BODY
 #undef ASYNC_PQUERY_BODY
 #undef ASYNC_DELAYHOLDER_BODY
@@ -0,0 +1,59 @@
+/*
+ * This file is part of the OregonCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SQLBATCH_H
+#define __SQLBATCH_H
+
+#include "Common.h"
+
+class Database;
+
+// Collects the rows of a multi-row statement and executes them as a single
+// statement instead of one statement per row. The rows are joined with ','
+// and wrapped in head/tail, e.g.
+//   head: "INSERT INTO character_spell (guid,spell,active,disabled) VALUES "
+//   rows: "(1,133,1,0)", "(1,168,1,0)"
+//   tail: " ON DUPLICATE KEY UPDATE active=VALUES(active),disabled=VALUES(disabled)"
+// or for deletes
+//   head: "DELETE FROM character_spell WHERE guid = 1 AND spell IN ("
+//   rows: "133", "168"
+//   tail: ")"
+// Pending rows are flushed when the statement grows past SQL_BATCH_MAX_LEN
+// and when the batch goes out of scope.
+class SqlBatch
+{
+    public:
+        SqlBatch(Database& db, std::string const& head, std::string const& tail = "");
+        ~SqlBatch() { Flush(); }
+
+        void AddRow(const char* format, ...) ATTR_PRINTF(2, 3);
+        void Flush();
+
+        bool IsEmpty() const { return m_rows == 0; }
+
+    private:
+        SqlBatch(SqlBatch const&);
+        SqlBatch& operator=(SqlBatch const&);
+
+        Database& m_db;
+        std::string m_head;
+        std::string m_tail;
+        std::string m_sql;
+        uint32 m_rows;
+};
+
+#endif
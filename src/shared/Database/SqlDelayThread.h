@@ -40,6 +40,8 @@ class SqlDelayThread : public ACE_Based::Runnable
 
         // Put sql statement to delay queue
         bool Delay(SqlOperation* sql);
+        // Number of operations waiting to be executed
+        size_t GetQueueSize() const { return m_sqlQueue.method_count(); }
 
         void Stop();                                // Stop event
         void run() override;                                 // Main Thread loop
@@ -142,6 +142,28 @@ SqlQueryHolder::~SqlQueryHolder()
     }
 }
 
+void SqlQueryHolder::DirectExecute(Database* db)
+{
+    for (size_t i = 0; i < m_queries.size(); i++)
+    {
+        // execute all queries in the holder and pass the results
+        char const* sql = m_queries[i].first;
+        if (sql) SetResult(i, db->Query(sql));
+    }
+}
+
+void SqlQueryHolder::DirectExecute(Database* db, size_t index)
+{
+    if (index >= m_queries.size() || !m_queries[index].first)
+        return;
+
+    SetResult(index, db->Query(m_queries[index].first));
+
+    // executed, the result stays until the holder is deleted
+    free((void*)(const_cast<char*>(m_queries[index].first)));
+    m_queries[index].first = NULL;
+}
+
 void SqlQueryHolder::SetSize(size_t size)
 {
     // to optimize push_back, reserve the number of queries about to be executed
@@ -153,15 +175,7 @@ void SqlQueryHolderEx::Execute(Database* db)
     if (!m_holder || !m_callback || !m_queue)
         return;
 
-    // we can do this, we are friends
-    std::vector<SqlQueryHolder::SqlResultPair>& queries = m_holder->m_queries;
-
-    for (size_t i = 0; i < queries.size(); i++)
-    {
-        // execute all queries in the holder and pass the results
-        char const* sql = queries[i].first;
-        if (sql) m_holder->SetResult(i, db->Query(sql));
-    }
+    m_holder->DirectExecute(db);
 
     // sync with the caller thread
     m_queue->add(m_callback);
@@ -185,6 +185,8 @@ class SqlQueryHolder
         QueryResult_AutoPtr GetResult(size_t index);
         void SetResult(size_t index, QueryResult_AutoPtr result);
         bool Execute(Oregon::IQueryCallback* callback, SqlDelayThread* thread, SqlResultQueue* queue);
+        void DirectExecute(Database* db);                   // run all queries in the calling thread
+        void DirectExecute(Database* db, size_t index);     // run one of them now, DirectExecute(db) skips it later
 };
 
 class SqlQueryHolderEx : public SqlOperation
@@ -19,6 +19,7 @@
 #define _GRIDREFMANAGER
 
 #include "Utilities/LinkedReference/RefManager.h"
+#include "GridSpatialIndex.h"
 
 template<class OBJECT>
 class GridReference;
@@ -29,6 +30,23 @@ class GridRefManager : public RefManager<GridRefManager<OBJECT>, OBJECT>
     public:
         typedef LinkedListHead::Iterator< GridReference<OBJECT> > iterator;
 
+        GridRefManager() : i_spatialIndex(NULL) { }
+        ~GridRefManager() override
+        {
+            // references may still use the index while they are invalidated
+            this->clearReferences();
+            delete i_spatialIndex;
+        }
+
+        // created on first use, only world objects are indexed
+        GridSpatialIndex& GetSpatialIndex()
+        {
+            if (!i_spatialIndex)
+                i_spatialIndex = new GridSpatialIndex();
+            return *i_spatialIndex;
+        }
+        GridSpatialIndex const* FindSpatialIndex() const { return i_spatialIndex; }
+
         GridReference<OBJECT>* getFirst()
         {
             return (GridReference<OBJECT>*)RefManager<GridRefManager<OBJECT>, OBJECT>::getFirst();
@@ -54,6 +72,12 @@ class GridRefManager : public RefManager<GridRefManager<OBJECT>, OBJECT>
         {
             return iterator(NULL);
         }
+
+    private:
+        GridSpatialIndex* i_spatialIndex;
+
+        GridRefManager(GridRefManager const&);
+        GridRefManager& operator=(GridRefManager const&);
 };
 #endif
 
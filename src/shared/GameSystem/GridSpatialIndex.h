@@ -0,0 +1,143 @@
+/*
+ * This file is part of the OregonCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _GRIDSPATIALINDEX_H
+#define _GRIDSPATIALINDEX_H
+
+#include "Platform/Define.h"
+
+#include <vector>
+
+class GridSpatialIndex;
+
+// Where an object is stored in the spatial index of its grid cell
+struct GridSpatialSlot
+{
+    GridSpatialSlot() : index(NULL), slot(0) { }
+
+    GridSpatialIndex* index;
+    uint32 slot;
+};
+
+// Positions of the objects linked into one grid cell container, kept as
+// separate arrays so range queries scan packed floats instead of walking
+// the object list and dereferencing every object.
+class GridSpatialIndex
+{
+    public:
+        // number of entries tested per pass, the hit flags of one pass stay on the stack
+        enum { CHUNK_SIZE = 64 };
+
+        uint32 Size() const { return uint32(m_objects.size()); }
+
+        void Insert(GridSpatialSlot* handle, void* object, float x, float y, float z, float size, uint32 phaseMask)
+        {
+            handle->index = this;
+            handle->slot = Size();
+
+            m_x.push_back(x);
+            m_y.push_back(y);
+            m_z.push_back(z);
+            m_size.push_back(size);
+            m_phaseMask.push_back(phaseMask);
+            m_objects.push_back(object);
+            m_handles.push_back(handle);
+        }
+
+        void Remove(GridSpatialSlot* handle)
+        {
+            uint32 slot = handle->slot;
+            uint32 last = Size() - 1;
+
+            // move the last entry into the hole
+            if (slot != last)
+            {
+                m_x[slot] = m_x[last];
+                m_y[slot] = m_y[last];
+                m_z[slot] = m_z[last];
+                m_size[slot] = m_size[last];
+                m_phaseMask[slot] = m_phaseMask[last];
+                m_objects[slot] = m_objects[last];
+                m_handles[slot] = m_handles[last];
+                m_handles[slot]->slot = slot;
+            }
+
+            m_x.pop_back();
+            m_y.pop_back();
+            m_z.pop_back();
+            m_size.pop_back();
+            m_phaseMask.pop_back();
+            m_objects.pop_back();
+            m_handles.pop_back();
+
+            handle->index = NULL;
+            handle->slot = 0;
+        }
+
+        void Relocate(uint32 slot, float x, float y, float z, float size)
+        {
+            m_x[slot] = x;
+            m_y[slot] = y;
+            m_z[slot] = z;
+            m_size[slot] = size;
+        }
+
+        void SetPhaseMask(uint32 slot, uint32 phaseMask)
+        {
+            m_phaseMask[slot] = phaseMask;
+        }
+
+        // Calls do(T*) for every object sharing a phase with phaseMask whose center lies
+        // within radius of (x, y) in 2d, the object's own size is added if addSize is set.
+        // do must not add, remove or move objects of this cell.
+        template<class T, class Do>
+        void VisitInRange(float x, float y, float radius, bool addSize, uint32 phaseMask, Do& _do) const
+        {
+            uint8 hits[CHUNK_SIZE];
+            uint32 count = Size();
+            float sizeFactor = addSize ? 1.0f : 0.0f;
+
+            for (uint32 begin = 0; begin < count; begin += CHUNK_SIZE)
+            {
+                uint32 end = begin + CHUNK_SIZE < count ? begin + CHUNK_SIZE : count;
+
+                // branch free so the compiler can vectorize it
+                for (uint32 i = begin; i < end; ++i)
+                {
+                    float dx = m_x[i] - x;
+                    float dy = m_y[i] - y;
+                    float maxDist = radius + m_size[i] * sizeFactor;
+                    hits[i - begin] = uint8((dx * dx + dy * dy <= maxDist * maxDist) & ((m_phaseMask[i] & phaseMask) != 0));
+                }
+
+                for (uint32 i = begin; i < end; ++i)
+                    if (hits[i - begin])
+                        _do(static_cast<T*>(m_objects[i]));
+            }
+        }
+
+    private:
+        std::vector<float> m_x;
+        std::vector<float> m_y;
+        std::vector<float> m_z;
+        std::vector<float> m_size;
+        std::vector<uint32> m_phaseMask;
+        std::vector<void*> m_objects;
+        std::vector<GridSpatialSlot*> m_handles;
+};
+
+#endif
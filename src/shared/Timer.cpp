@@ -0,0 +1,30 @@
+/*
+ * This file is part of the OregonCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "Timer.h"
+
+bool SimulatedClock::m_active = false;
+uint64 SimulatedClock::m_msTime = 0;
+uint64 SimulatedClock::m_startMSTime = 0;
+time_t SimulatedClock::m_startUnixTime = 0;
+
+void SimulatedClock::Start(uint64 msTime, time_t unixTime)
+{
+    m_msTime = m_startMSTime = msTime;
+    m_startUnixTime = unixTime;
+    m_active = true;
+}
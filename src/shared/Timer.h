@@ -28,14 +28,44 @@
 #   include <sys/timeb.h>
 #endif
 
+/**
+ * Clock the server runs on while a packet capture is replayed.
+ *
+ * The replay advances it by a fixed step per world tick, so getMSTime()
+ * and the game time are the same on every run of the same capture.
+ */
+class SimulatedClock
+{
+    public:
+        static void Start(uint64 msTime, time_t unixTime);
+        static void Stop() { m_active = false; }
+        static void Advance(uint32 diff) { m_msTime += diff; }
+
+        static bool IsActive() { return m_active; }
+        static uint64 GetMSTime() { return m_msTime; }
+        static time_t GetUnixTime() { return m_startUnixTime + time_t((m_msTime - m_startMSTime) / IN_MILLISECONDS); }
+
+    private:
+        static bool m_active;
+        static uint64 m_msTime;
+        static uint64 m_startMSTime;
+        static time_t m_startUnixTime;
+};
+
 #if PLATFORM == PLATFORM_WINDOWS
 inline uint32 getMSTime()
 {
+    if (SimulatedClock::IsActive())
+        return uint32(SimulatedClock::GetMSTime());
+
     return GetTickCount();
 }
 
 inline uint64 getMSTime64()
 {
+    if (SimulatedClock::IsActive())
+        return SimulatedClock::GetMSTime();
+
     #if _WIN32_WINNT >= 0x0600 // Vista and higher
     return GetTickCount64();
     #else // Backwards compatibility for XP and lower
@@ -50,6 +80,9 @@ inline uint64 getMSTime64()
 #else
 inline uint32 getMSTime()
 {
+    if (SimulatedClock::IsActive())
+        return uint32(SimulatedClock::GetMSTime());
+
     #if defined(_POSIX_C_SOURCE) && _POSIX_C_SOURCE >= 199309L
     struct timespec tp;
     clock_gettime(CLOCK_MONOTONIC, &tp);
@@ -63,6 +96,9 @@ inline uint32 getMSTime()
 
 inline uint64 getMSTime64()
 {
+    if (SimulatedClock::IsActive())
+        return SimulatedClock::GetMSTime();
+
     #if defined(_POSIX_C_SOURCE) && _POSIX_C_SOURCE >= 199309L
     struct timespec tp;
     clock_gettime(CLOCK_MONOTONIC, &tp);
@@ -17,9 +17,78 @@
 
 #include "EventMap.h"
 
+EventMap::EventMap(EventMap const& right) : _time(right._time), _phase(right._phase),
+    _events(_inline), _size(0), _capacity(EVENTMAP_INLINE_CAPACITY), _lastEvent(right._lastEvent)
+{
+    Assign(right._events, right._size);
+}
+
+EventMap::~EventMap()
+{
+    if (_events != _inline)
+        delete[] _events;
+}
+
+EventMap& EventMap::operator=(EventMap const& right)
+{
+    if (this != &right)
+    {
+        _time = right._time;
+        _phase = right._phase;
+        _lastEvent = right._lastEvent;
+        Assign(right._events, right._size);
+    }
+
+    return *this;
+}
+
+void EventMap::Assign(Event const* events, uint32 size)
+{
+    _size = 0;
+    while (_capacity < size)
+        Grow();
+
+    memcpy(_events, events, size * sizeof(Event));
+    _size = size;
+}
+
+void EventMap::Grow()
+{
+    Event* events = new Event[_capacity * 2];
+    memcpy(events, _events, _size * sizeof(Event));
+
+    if (_events != _inline)
+        delete[] _events;
+
+    _events = events;
+    _capacity *= 2;
+}
+
+void EventMap::Insert(uint32 time, uint32 data)
+{
+    if (_size == _capacity)
+        Grow();
+
+    // descending order, events of the same time stay closer to the end and run first
+    uint32 lo = 0, hi = _size;
+    while (lo < hi)
+    {
+        uint32 mid = (lo + hi) / 2;
+        if (_events[mid].time > time)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    memmove(&_events[lo + 1], &_events[lo], (_size - lo) * sizeof(Event));
+    _events[lo].time = time;
+    _events[lo].data = data;
+    ++_size;
+}
+
 void EventMap::Reset()
 {
-    _eventMap.clear();
+    _size = 0;
     _time = 0;
     _phase = 0;
 }
@@ -40,24 +109,24 @@ void EventMap::ScheduleEvent(uint32 eventId, uint32 time, uint32 group /*= 0*/,
     if (phase && phase <= 8)
         eventId |= (1 << (phase + 23));
 
-    _eventMap.insert(EventStore::value_type(_time + time, eventId));
+    Insert(_time + time, eventId);
 }
 
 uint32 EventMap::ExecuteEvent()
 {
     while (!Empty())
     {
-        EventStore::iterator itr = _eventMap.begin();
+        Event const& event = _events[_size - 1];
 
-        if (itr->first > _time)
+        if (event.time > _time)
             return 0;
-        else if (_phase && (itr->second & 0xFF000000) && !((itr->second >> 24) & _phase))
-            _eventMap.erase(itr);
+        else if (_phase && (event.data & 0xFF000000) && !((event.data >> 24) & _phase))
+            --_size;
         else
         {
-            uint32 eventId = (itr->second & 0x0000FFFF);
-            _lastEvent = itr->second; // include phase/group
-            _eventMap.erase(itr);
+            uint32 eventId = (event.data & 0x0000FFFF);
+            _lastEvent = event.data; // include phase/group
+            --_size;
             return eventId;
         }
     }
@@ -70,20 +139,24 @@ void EventMap::DelayEvents(uint32 delay, uint32 group)
     if (!group || group > 8 || Empty())
         return;
 
-    EventStore delayed;
+    uint32 mask = (1 << (group + 15));
+    std::vector<Event> delayed;
 
-    for (EventStore::iterator itr = _eventMap.begin(); itr != _eventMap.end();)
+    // pull the group out, keeping the remaining events in place
+    uint32 kept = 0;
+    for (uint32 i = 0; i < _size; ++i)
     {
-        if (itr->second & (1 << (group + 15)))
-        {
-            delayed.insert(EventStore::value_type(itr->first + delay, itr->second));
-            _eventMap.erase(itr++);
-        }
+        if (_events[i].data & mask)
+            delayed.push_back(_events[i]);
         else
-            ++itr;
+            _events[kept++] = _events[i];
     }
 
-    _eventMap.insert(delayed.begin(), delayed.end());
+    _size = kept;
+
+    // reinsert in execution order, behind undelayed events of the same time
+    for (std::vector<Event>::reverse_iterator itr = delayed.rbegin(); itr != delayed.rend(); ++itr)
+        Insert(itr->time + delay, itr->data);
 }
 
 void EventMap::CancelEvent(uint32 eventId)
@@ -91,13 +164,12 @@ void EventMap::CancelEvent(uint32 eventId)
     if (Empty())
         return;
 
-    for (EventStore::iterator itr = _eventMap.begin(); itr != _eventMap.end();)
-    {
-        if (eventId == (itr->second & 0x0000FFFF))
-            _eventMap.erase(itr++);
-        else
-            ++itr;
-    }
+    uint32 kept = 0;
+    for (uint32 i = 0; i < _size; ++i)
+        if (eventId != (_events[i].data & 0x0000FFFF))
+            _events[kept++] = _events[i];
+
+    _size = kept;
 }
 
 void EventMap::CancelEventGroup(uint32 group)
@@ -105,13 +177,13 @@ void EventMap::CancelEventGroup(uint32 group)
     if (!group || group > 8 || Empty())
         return;
 
-    for (EventStore::iterator itr = _eventMap.begin(); itr != _eventMap.end();)
-    {
-        if (itr->second & (1 << (group + 15)))
-            _eventMap.erase(itr++);
-        else
-            ++itr;
-    }
+    uint32 mask = (1 << (group + 15));
+    uint32 kept = 0;
+    for (uint32 i = 0; i < _size; ++i)
+        if (!(_events[i].data & mask))
+            _events[kept++] = _events[i];
+
+    _size = kept;
 }
 
 uint32 EventMap::GetNextEventTime(uint32 eventId) const
@@ -119,18 +191,18 @@ uint32 EventMap::GetNextEventTime(uint32 eventId) const
     if (Empty())
         return 0;
 
-    for (EventStore::const_iterator itr = _eventMap.begin(); itr != _eventMap.end(); ++itr)
-        if (eventId == (itr->second & 0x0000FFFF))
-            return itr->first;
+    for (uint32 i = _size; i > 0; --i)
+        if (eventId == (_events[i - 1].data & 0x0000FFFF))
+            return _events[i - 1].time;
 
     return 0;
 }
 
 uint32 EventMap::GetTimeUntilEvent(uint32 eventId) const
 {
-    for (EventStore::const_iterator itr = _eventMap.begin(); itr != _eventMap.end(); ++itr)
-        if (eventId == (itr->second & 0x0000FFFF))
-            return itr->first - _time;
+    for (uint32 i = _size; i > 0; --i)
+        if (eventId == (_events[i - 1].data & 0x0000FFFF))
+            return _events[i - 1].time - _time;
 
     return std::numeric_limits<uint32>::max();
 }
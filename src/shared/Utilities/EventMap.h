@@ -21,23 +21,41 @@
 #include "Common.h"
 #include "Util.h"
 
+/**
+* Number of events an EventMap holds without allocating.
+*/
+#define EVENTMAP_INLINE_CAPACITY 16
+
 class EventMap
 {
     /**
     * Internal storage type.
-    * Key: Time as uint32 when the event should occur.
-    * Value: The event data as uint32.
+    * Time: Time as uint32 when the event should occur.
+    * Data: The event data as uint32.
     *
     * Structure of event data:
     * - Bit  0 - 15: Event Id.
     * - Bit 16 - 23: Group
     * - Bit 24 - 31: Phase
     * - Pattern: 0xPPGGEEEE
+    *
+    * Events are kept in an array sorted by descending time, so the
+    * next event is always the last element. Events with equal time
+    * keep their scheduling order. The first EVENTMAP_INLINE_CAPACITY
+    * events are stored inside the map itself.
     */
-    typedef std::multimap<uint32, uint32> EventStore;
+    struct Event
+    {
+        uint32 time;
+        uint32 data;
+    };
 
 public:
-    EventMap() : _time(0), _phase(0), _lastEvent(0) { }
+    EventMap() : _time(0), _phase(0), _events(_inline), _size(0), _capacity(EVENTMAP_INLINE_CAPACITY), _lastEvent(0) { }
+    EventMap(EventMap const& right);
+    ~EventMap();
+
+    EventMap& operator=(EventMap const& right);
 
     /**
     * @name Reset
@@ -79,7 +97,7 @@ public:
     */
     bool Empty() const
     {
-        return _eventMap.empty();
+        return !_size;
     }
 
     /**
@@ -142,7 +160,7 @@ public:
     */
     void Repeat(uint32 time)
     {
-        _eventMap.insert(EventStore::value_type(_time + time, _lastEvent));
+        Insert(_time + time, _lastEvent);
     }
 
     /**
@@ -209,7 +227,7 @@ public:
     */
     uint32 GetNextEventTime() const
     {
-        return Empty() ? 0 : _eventMap.begin()->first;
+        return Empty() ? 0 : _events[_size - 1].time;
     }
 
     /**
@@ -232,6 +250,24 @@ public:
     uint32 GetTimeUntilEvent(uint32 eventId) const;
 
 private:
+    /**
+    * @name Insert
+    * @brief Inserts an event so it runs after all events with the same or an earlier time.
+    */
+    void Insert(uint32 time, uint32 data);
+
+    /**
+    * @name Grow
+    * @brief Moves the events to a heap block of twice the capacity.
+    */
+    void Grow();
+
+    /**
+    * @name Assign
+    * @brief Replaces stored events with a copy of the given ones.
+    */
+    void Assign(Event const* events, uint32 size);
+
     /**
     * @name _time
     * @brief Internal timer.
@@ -255,13 +291,17 @@ private:
     uint8 _phase;
 
     /**
-    * @name _eventMap
-    * @brief Internal event storage map. Contains the scheduled events.
+    * @name _events
+    * @brief Internal event storage. Contains the scheduled events.
     *
-    * See typedef at the beginning of the class for more
-    * details.
+    * Points to _inline until more than EVENTMAP_INLINE_CAPACITY
+    * events are scheduled. See Event at the beginning of the class
+    * for more details.
     */
-    EventStore _eventMap;
+    Event* _events;
+    uint32 _size;
+    uint32 _capacity;
+    Event _inline[EVENTMAP_INLINE_CAPACITY];
 
     /**
     * @name _lastEvent
@@ -17,9 +17,17 @@
 
 #include "EventProcessor.h"
 
+void BasicEvent::OnExpire(uint64 /*now*/, uint32 p_time)
+{
+    m_owner->Execute(this, p_time);
+}
+
 EventProcessor::EventProcessor()
 {
     m_time = 0;
+    m_timeOffset = 0;
+    m_wheel = NULL;
+    m_events = NULL;
     m_aborting = false;
 }
 
@@ -28,33 +36,61 @@ EventProcessor::~EventProcessor()
     KillAllEvents(true);
 }
 
-void EventProcessor::Update(uint32 p_time)
+uint64 EventProcessor::GetTime() const
 {
-    // update time
-    m_time += p_time;
+    if (m_wheel)
+        return uint64(int64(m_wheel->GetTime()) + m_timeOffset);
 
-    // main event loop
-    EventList::iterator i;
-    while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
-    {
-        // get and remove event from queue
-        BasicEvent* Event = i->second;
-        m_events.erase(i);
+    return m_time;
+}
 
-        if (!Event->to_Abort)
-        {
-            if (Event->Execute(m_time, p_time))
-            {
-                // completely destroy event if it is not re-added
-                delete Event;
-            }
-        }
-        else
+void EventProcessor::Link(BasicEvent* Event)
+{
+    Event->m_owner = this;
+    Event->m_ownerPrev = NULL;
+    Event->m_ownerNext = m_events;
+    if (m_events)
+        m_events->m_ownerPrev = Event;
+    m_events = Event;
+}
+
+void EventProcessor::Unlink(BasicEvent* Event)
+{
+    Event->Unschedule();
+
+    if (Event->m_ownerPrev)
+        Event->m_ownerPrev->m_ownerNext = Event->m_ownerNext;
+    else
+        m_events = Event->m_ownerNext;
+
+    if (Event->m_ownerNext)
+        Event->m_ownerNext->m_ownerPrev = Event->m_ownerPrev;
+
+    Event->m_owner = NULL;
+    Event->m_ownerPrev = NULL;
+    Event->m_ownerNext = NULL;
+}
+
+void EventProcessor::Execute(BasicEvent* Event, uint32 p_time)
+{
+    // remove event from queue
+    Unlink(Event);
+
+    uint64 e_time = GetTime();
+
+    if (!Event->to_Abort)
+    {
+        if (Event->Execute(e_time, p_time))
         {
-            Event->Abort(m_time);
+            // completely destroy event if it is not re-added
             delete Event;
         }
     }
+    else
+    {
+        Event->Abort(e_time);
+        delete Event;
+    }
 }
 
 void EventProcessor::KillAllEvents(bool force)
@@ -62,37 +98,75 @@ void EventProcessor::KillAllEvents(bool force)
     // prevent event insertions
     m_aborting = true;
 
-    // first, abort all existing events
-    for (EventList::iterator i = m_events.begin(); i != m_events.end();)
+    uint64 e_time = GetTime();
+
+    // abort all existing events
+    for (BasicEvent* Event = m_events; Event;)
     {
-        EventList::iterator i_old = i;
-        ++i;
+        BasicEvent* next = Event->m_ownerNext;
 
-        i_old->second->to_Abort = true;
-        i_old->second->Abort(m_time);
-        if (force || i_old->second->IsDeletable())
+        Event->to_Abort = true;
+        Event->Abort(e_time);
+        if (force || Event->IsDeletable())
         {
-            delete i_old->second;
-
-            if (!force)                                      // need per-element cleanup
-                m_events.erase (i_old);
+            // non-deletable events stay queued and get deleted when they fire
+            Unlink(Event);
+            delete Event;
         }
-    }
 
-    // fast clear event list (in force case)
-    if (force)
-        m_events.clear();
+        Event = next;
+    }
 }
 
 void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime)
 {
-    if (set_addtime) Event->m_addTime = m_time;
+    if (Event->m_owner)
+        Event->m_owner->Unlink(Event);
+
+    if (set_addtime) Event->m_addTime = GetTime();
     Event->m_execTime = e_time;
-    m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+    Link(Event);
+
+    if (m_wheel)
+    {
+        int64 expires = int64(e_time) - m_timeOffset;
+        m_wheel->Schedule(Event, expires > 0 ? uint64(expires) : 0);
+    }
 }
 
 uint64 EventProcessor::CalculateTime(uint64 t_offset)
 {
-    return (m_time + t_offset);
+    return (GetTime() + t_offset);
+}
+
+void EventProcessor::AttachTo(TimerWheel* wheel)
+{
+    if (m_wheel == wheel)
+        return;
+
+    Detach();
+
+    // keep our own clock continuous, events were queued against it
+    m_timeOffset = int64(m_time) - int64(wheel->GetTime());
+    m_wheel = wheel;
+
+    for (BasicEvent* Event = m_events; Event; Event = Event->m_ownerNext)
+    {
+        int64 expires = int64(Event->m_execTime) - m_timeOffset;
+        m_wheel->Schedule(Event, expires > 0 ? uint64(expires) : 0);
+    }
 }
 
+void EventProcessor::Detach()
+{
+    if (!m_wheel)
+        return;
+
+    m_time = GetTime();
+
+    for (BasicEvent* Event = m_events; Event; Event = Event->m_ownerNext)
+        Event->Unschedule();
+
+    m_wheel = NULL;
+    m_timeOffset = 0;
+}
@@ -19,15 +19,16 @@
 #define __EVENTPROCESSOR_H
 
 #include "Platform/Define.h"
-
-#include<map>
+#include "TimerWheel.h"
 
 // Note. All times are in milliseconds here.
 
-class BasicEvent
+class EventProcessor;
+
+class BasicEvent : public TimerWheelNode
 {
     public:
-        BasicEvent()
+        BasicEvent() : m_owner(NULL), m_ownerPrev(NULL), m_ownerNext(NULL)
         {
             to_Abort = false;
         }
@@ -56,24 +57,46 @@ class BasicEvent
         // these can be used for time offset control
         uint64 m_addTime;                                   // time when the event was added to queue, filled by event handler
         uint64 m_execTime;                                  // planned time of next execution, filled by event handler
-};
 
-typedef std::multimap<uint64, BasicEvent*> EventList;
+    protected:
+        void OnExpire(uint64 now, uint32 p_time) override;
+
+    private:
+        friend class EventProcessor;
 
+        EventProcessor* m_owner;                            // processor the event is queued in
+        BasicEvent* m_ownerPrev;
+        BasicEvent* m_ownerNext;
+};
+
+// Per object event queue. The events themselves are kept in the timer wheel of
+// the map the owner is in, so only expiring events are visited on map update.
+// While detached (owner not in world) the processor's clock stands still.
 class EventProcessor
 {
     public:
         EventProcessor();
         ~EventProcessor();
 
-        void Update(uint32 p_time);
         void KillAllEvents(bool force);
         void AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime = true);
         uint64 CalculateTime(uint64 t_offset);
+
+        void AttachTo(TimerWheel* wheel);
+        void Detach();
+        bool IsAttached() const { return m_wheel != NULL; }
     protected:
-        uint64 m_time;
-        EventList m_events;
+        friend class BasicEvent;
+
+        uint64 GetTime() const;
+        void Link(BasicEvent* Event);
+        void Unlink(BasicEvent* Event);
+        void Execute(BasicEvent* Event, uint32 p_time);
+
+        uint64 m_time;                                      // own clock while detached
+        int64 m_timeOffset;                                 // own clock minus wheel clock while attached
+        TimerWheel* m_wheel;
+        BasicEvent* m_events;
         bool m_aborting;
 };
 #endif
-
@@ -0,0 +1,188 @@
+/*
+ * This file is part of the OregonCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "PacketBufferPool.h"
+
+#include <ace/Guard_T.h>
+#include <ace/Thread_Mutex.h>
+#include <new>
+#include <vector>
+
+#define POOL_SIZE_CLASSES   9                               // 64 bytes up to 16 KiB
+#define POOL_CACHE_BLOCKS   64                              // blocks a thread keeps per size class
+#define POOL_BATCH_BLOCKS   32                              // blocks moved between a thread and the depot at once
+#define POOL_DEPOT_BATCHES  64                              // batches the depot keeps per size class
+
+namespace
+{
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    struct FreeList
+    {
+        FreeList() : head(NULL), count(0) { }
+
+        FreeBlock* head;
+        uint32 count;
+    };
+
+    int GetSizeClass(size_t size)
+    {
+        if (size > PacketBufferPool::MAX_BLOCK_SIZE)
+            return -1;
+
+        int sizeClass = 0;
+        for (size_t blockSize = PacketBufferPool::MIN_BLOCK_SIZE; blockSize < size; blockSize <<= 1)
+            ++sizeClass;
+        return sizeClass;
+    }
+
+    size_t GetBlockSize(int sizeClass)
+    {
+        return PacketBufferPool::MIN_BLOCK_SIZE << sizeClass;
+    }
+
+    void FreeChain(FreeBlock* block)
+    {
+        while (block)
+        {
+            FreeBlock* next = block->next;
+            ::operator delete(block);
+            block = next;
+        }
+    }
+
+    // Batches of free blocks shared by all threads
+    class Depot
+    {
+        public:
+            void Put(int sizeClass, FreeBlock* batch)
+            {
+                {
+                    ACE_GUARD(ACE_Thread_Mutex, guard, _lock);
+                    if (_batches[sizeClass].size() < POOL_DEPOT_BATCHES)
+                    {
+                        _batches[sizeClass].push_back(batch);
+                        return;
+                    }
+                }
+
+                FreeChain(batch);
+            }
+
+            FreeBlock* Take(int sizeClass)
+            {
+                ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, _lock, NULL);
+                if (_batches[sizeClass].empty())
+                    return NULL;
+
+                FreeBlock* batch = _batches[sizeClass].back();
+                _batches[sizeClass].pop_back();
+                return batch;
+            }
+
+        private:
+            ACE_Thread_Mutex _lock;
+            std::vector<FreeBlock*> _batches[POOL_SIZE_CLASSES];
+    };
+
+    // never destroyed, buffers may still be released during static destruction
+    Depot& GetDepot()
+    {
+        static Depot* depot = new Depot();
+        return *depot;
+    }
+
+    struct ThreadCache
+    {
+        ~ThreadCache();
+
+        FreeList lists[POOL_SIZE_CLASSES];
+    };
+
+    thread_local ThreadCache tCache;
+    thread_local bool tCacheDestroyed = false;
+
+    ThreadCache::~ThreadCache()
+    {
+        // hand everything to the depot, later releases on this thread go to the heap
+        tCacheDestroyed = true;
+        for (int sizeClass = 0; sizeClass < POOL_SIZE_CLASSES; ++sizeClass)
+        {
+            if (lists[sizeClass].head)
+                GetDepot().Put(sizeClass, lists[sizeClass].head);
+            lists[sizeClass] = FreeList();
+        }
+    }
+}
+
+void* PacketBufferPool::Allocate(size_t size)
+{
+    int sizeClass = GetSizeClass(size);
+    if (sizeClass < 0 || tCacheDestroyed)
+        return ::operator new(sizeClass < 0 ? size : GetBlockSize(sizeClass));
+
+    FreeList& list = tCache.lists[sizeClass];
+    if (!list.head)
+    {
+        list.head = GetDepot().Take(sizeClass);
+        if (!list.head)
+            return ::operator new(GetBlockSize(sizeClass));
+
+        // batches left by exiting threads may be longer
+        list.count = 0;
+        for (FreeBlock* block = list.head; block; block = block->next)
+            ++list.count;
+    }
+
+    FreeBlock* block = list.head;
+    list.head = block->next;
+    --list.count;
+    return block;
+}
+
+void PacketBufferPool::Deallocate(void* ptr, size_t size)
+{
+    int sizeClass = GetSizeClass(size);
+    if (sizeClass < 0 || tCacheDestroyed)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    FreeList& list = tCache.lists[sizeClass];
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+    block->next = list.head;
+    list.head = block;
+
+    if (++list.count < POOL_CACHE_BLOCKS + POOL_BATCH_BLOCKS)
+        return;
+
+    // move a full batch to the depot, keep the rest for this thread
+    FreeBlock* batch = list.head;
+    FreeBlock* last = batch;
+    for (uint32 i = 1; i < POOL_BATCH_BLOCKS; ++i)
+        last = last->next;
+
+    list.head = last->next;
+    list.count -= POOL_BATCH_BLOCKS;
+    last->next = NULL;
+
+    GetDepot().Put(sizeClass, batch);
+}
@@ -0,0 +1,70 @@
+/*
+ * This file is part of the OregonCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _PACKET_BUFFER_POOL_H
+#define _PACKET_BUFFER_POOL_H
+
+#include "Platform/Define.h"
+#include <cstddef>
+
+/**
+ * Size classed free lists for ByteBuffer storage.
+ *
+ * Every thread caches free blocks per size class, so building and dropping a
+ * packet normally touches neither the heap nor a lock. When a cache runs empty
+ * or full it trades a batch of blocks with a shared depot, which keeps buffers
+ * released on another thread than the one which allocated them (received
+ * packets, queued outgoing packets) in circulation.
+ */
+class PacketBufferPool
+{
+    public:
+        static const size_t MIN_BLOCK_SIZE = 64;
+        static const size_t MAX_BLOCK_SIZE = 16 * 1024;     // bigger buffers come from the heap
+
+        static void* Allocate(size_t size);
+        static void Deallocate(void* ptr, size_t size);
+};
+
+// std allocator interface on top of PacketBufferPool
+template<class T>
+class PacketBufferAllocator
+{
+    public:
+        typedef T value_type;
+
+        PacketBufferAllocator() { }
+        template<class U> PacketBufferAllocator(const PacketBufferAllocator<U>&) { }
+
+        T* allocate(size_t n)
+        {
+            return static_cast<T*>(PacketBufferPool::Allocate(n * sizeof(T)));
+        }
+
+        void deallocate(T* ptr, size_t n)
+        {
+            PacketBufferPool::Deallocate(ptr, n * sizeof(T));
+        }
+};
+
+template<class T, class U>
+inline bool operator==(const PacketBufferAllocator<T>&, const PacketBufferAllocator<U>&) { return true; }
+
+template<class T, class U>
+inline bool operator!=(const PacketBufferAllocator<T>&, const PacketBufferAllocator<U>&) { return false; }
+
+#endif
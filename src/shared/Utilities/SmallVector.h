@@ -0,0 +1,171 @@
+/*
+ * This file is part of the OregonCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _SMALLVECTOR_H
+#define _SMALLVECTOR_H
+
+#include "Platform/Define.h"
+
+#include <cstring>
+#include <type_traits>
+
+// Vector of trivially copyable values (usually pointers) that keeps the first
+// N elements inside the object itself and only allocates when it grows past
+// them. Meant for short lived result lists on the stack, e.g. grid searches.
+template<class T, uint32 N>
+class SmallVector
+{
+        static_assert(std::is_trivially_copyable<T>::value, "SmallVector only holds trivially copyable values");
+
+    public:
+        typedef T value_type;
+        typedef T* iterator;
+        typedef T const* const_iterator;
+
+        SmallVector() : m_data(m_inline), m_size(0), m_capacity(N) { }
+
+        SmallVector(SmallVector const& right) : m_data(m_inline), m_size(0), m_capacity(N)
+        {
+            assign(right.begin(), right.end());
+        }
+
+        ~SmallVector()
+        {
+            if (m_data != m_inline)
+                delete[] m_data;
+        }
+
+        SmallVector& operator=(SmallVector const& right)
+        {
+            if (this != &right)
+                assign(right.begin(), right.end());
+            return *this;
+        }
+
+        iterator begin() { return m_data; }
+        iterator end() { return m_data + m_size; }
+        const_iterator begin() const { return m_data; }
+        const_iterator end() const { return m_data + m_size; }
+
+        uint32 size() const { return m_size; }
+        bool empty() const { return !m_size; }
+        void clear() { m_size = 0; }
+
+        T& operator[](uint32 i) { return m_data[i]; }
+        T const& operator[](uint32 i) const { return m_data[i]; }
+        T& front() { return m_data[0]; }
+        T const& front() const { return m_data[0]; }
+        T& back() { return m_data[m_size - 1]; }
+        T const& back() const { return m_data[m_size - 1]; }
+
+        void reserve(uint32 capacity)
+        {
+            if (capacity > m_capacity)
+                Reallocate(capacity);
+        }
+
+        void push_back(T const& value)
+        {
+            if (m_size == m_capacity)
+                Reallocate(m_capacity * 2);
+            m_data[m_size++] = value;
+        }
+
+        void pop_back() { --m_size; }
+
+        // shrinks only, like std::list::resize with fewer elements
+        void resize(uint32 size)
+        {
+            if (size < m_size)
+                m_size = size;
+        }
+
+        void assign(const_iterator first, const_iterator last)
+        {
+            m_size = 0;
+            reserve(uint32(last - first));
+            memcpy(m_data, first, (last - first) * sizeof(T));
+            m_size = uint32(last - first);
+        }
+
+        iterator erase(iterator pos)
+        {
+            return erase(pos, pos + 1);
+        }
+
+        iterator erase(iterator first, iterator last)
+        {
+            memmove(first, last, (end() - last) * sizeof(T));
+            m_size -= uint32(last - first);
+            return first;
+        }
+
+        // std::list style removal, keeps the order of the remaining elements
+        void remove(T const& value)
+        {
+            uint32 kept = 0;
+            for (uint32 i = 0; i < m_size; ++i)
+                if (!(m_data[i] == value))
+                    m_data[kept++] = m_data[i];
+            m_size = kept;
+        }
+
+        template<class Predicate>
+        void remove_if(Predicate pred)
+        {
+            uint32 kept = 0;
+            for (uint32 i = 0; i < m_size; ++i)
+                if (!pred(m_data[i]))
+                    m_data[kept++] = m_data[i];
+            m_size = kept;
+        }
+
+        // stable and without allocation, the lists held here are short and often
+        // already nearly sorted
+        template<class Compare>
+        void insertion_sort(Compare comp)
+        {
+            for (uint32 i = 1; i < m_size; ++i)
+            {
+                T value = m_data[i];
+                uint32 j = i;
+                for (; j > 0 && comp(value, m_data[j - 1]); --j)
+                    m_data[j] = m_data[j - 1];
+                m_data[j] = value;
+            }
+        }
+
+    private:
+        void Reallocate(uint32 capacity)
+        {
+            T* data = new T[capacity];
+            memcpy(data, m_data, m_size * sizeof(T));
+
+            if (m_data != m_inline)
+                delete[] m_data;
+
+            m_data = data;
+            m_capacity = capacity;
+        }
+
+        T* m_data;
+        uint32 m_size;
+        uint32 m_capacity;
+        T m_inline[N];
+};
+
+#endif
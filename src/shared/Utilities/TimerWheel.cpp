@@ -0,0 +1,172 @@
+/*
+ * This file is part of the OregonCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "TimerWheel.h"
+
+#include <ace/Guard_T.h>
+
+void TimerWheelNode::Unschedule()
+{
+    TimerWheel* wheel = m_wheel;
+    if (!wheel)
+        return;
+
+    if (wheel->m_lock)
+    {
+        ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, *wheel->m_lock);
+        if (m_wheel == wheel)
+            wheel->Unlink(this);
+    }
+    else
+        wheel->Unlink(this);
+}
+
+TimerWheel::TimerWheel() : m_overflow(NULL), m_time(0), m_cursor(0), m_diff(0), m_count(0), m_lock(NULL)
+{
+    for (uint32 level = 0; level < TIMERWHEEL_LEVELS; ++level)
+        for (uint32 i = 0; i < TIMERWHEEL_SLOTS; ++i)
+            m_slots[level][i] = NULL;
+}
+
+TimerWheel::~TimerWheel()
+{
+    // owners keep their nodes, just forget about them
+    for (uint32 level = 0; level < TIMERWHEEL_LEVELS; ++level)
+        for (uint32 i = 0; i < TIMERWHEEL_SLOTS; ++i)
+            while (m_slots[level][i])
+                Unlink(m_slots[level][i]);
+
+    while (m_overflow)
+        Unlink(m_overflow);
+}
+
+void TimerWheel::Schedule(TimerWheelNode* node, uint64 expires)
+{
+    node->Unschedule();
+
+    ACE_Recursive_Thread_Mutex* lock = m_lock;
+    if (lock)
+        lock->acquire();
+
+    // never link into the slot being processed, it would only be seen a full rotation later
+    node->m_expires = expires > m_cursor ? expires : m_cursor + 1;
+    node->m_wheel = this;
+    ++m_count;
+    Link(node);
+
+    if (lock)
+        lock->release();
+}
+
+void TimerWheel::Link(TimerWheelNode* node)
+{
+    uint64 delta = node->m_expires - m_cursor;
+
+    for (uint32 level = 0; level < TIMERWHEEL_LEVELS; ++level)
+    {
+        if (delta < (uint64(1) << (TIMERWHEEL_SLOT_BITS * (level + 1))))
+        {
+            LinkInto(node, m_slots[level][(node->m_expires >> (TIMERWHEEL_SLOT_BITS * level)) & TIMERWHEEL_SLOT_MASK]);
+            return;
+        }
+    }
+
+    LinkInto(node, m_overflow);
+}
+
+void TimerWheel::LinkInto(TimerWheelNode* node, Slot& slot)
+{
+    node->m_slot = &slot;
+    node->m_prev = NULL;
+    node->m_next = slot;
+    if (slot)
+        slot->m_prev = node;
+    slot = node;
+}
+
+void TimerWheel::Unlink(TimerWheelNode* node)
+{
+    if (node->m_prev)
+        node->m_prev->m_next = node->m_next;
+    else
+        *node->m_slot = node->m_next;
+
+    if (node->m_next)
+        node->m_next->m_prev = node->m_prev;
+
+    node->m_wheel = NULL;
+    node->m_slot = NULL;
+    node->m_prev = NULL;
+    node->m_next = NULL;
+    --m_count;
+}
+
+void TimerWheel::Cascade(Slot& slot)
+{
+    // relink every node of a coarse slot relative to the current tick
+    TimerWheelNode* node = slot;
+    slot = NULL;
+
+    while (node)
+    {
+        TimerWheelNode* next = node->m_next;
+        Link(node);
+        node = next;
+    }
+}
+
+void TimerWheel::Tick()
+{
+    uint64 tick = ++m_cursor;
+
+    // find the coarsest level whose lower levels have all wrapped on this tick
+    uint32 top = 0;
+    while (top + 1 < TIMERWHEEL_LEVELS && !(tick & ((uint64(1) << (TIMERWHEEL_SLOT_BITS * (top + 1))) - 1)))
+        ++top;
+
+    // cascade from the coarsest level down, so nodes can fall through several levels at once
+    if (top + 1 == TIMERWHEEL_LEVELS && !(tick & ((uint64(1) << (TIMERWHEEL_SLOT_BITS * TIMERWHEEL_LEVELS)) - 1)))
+        Cascade(m_overflow);
+
+    for (uint32 level = top; level > 0; --level)
+        Cascade(m_slots[level][(tick >> (TIMERWHEEL_SLOT_BITS * level)) & TIMERWHEEL_SLOT_MASK]);
+
+    Slot& slot = m_slots[0][tick & TIMERWHEEL_SLOT_MASK];
+    while (TimerWheelNode* node = slot)
+    {
+        Unlink(node);
+        node->OnExpire(m_time, m_diff);
+    }
+}
+
+void TimerWheel::Update(uint32 p_time)
+{
+    m_diff = p_time;
+    m_time += p_time;
+
+    // only slots that are reached are touched, an empty wheel just moves its clock
+    while (m_cursor < m_time)
+    {
+        if (!m_count)
+        {
+            m_cursor = m_time;
+            break;
+        }
+
+        Tick();
+    }
+}
@@ -0,0 +1,106 @@
+/*
+ * This file is part of the OregonCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __TIMERWHEEL_H
+#define __TIMERWHEEL_H
+
+#include "Platform/Define.h"
+
+#include <ace/Recursive_Thread_Mutex.h>
+
+// Hierarchical timing wheel, one tick is one millisecond.
+// Level 0 covers the next 64 ms, every further level is 64 times coarser,
+// timers past the last level wait in an overflow list.
+#define TIMERWHEEL_LEVELS       4
+#define TIMERWHEEL_SLOT_BITS    6
+#define TIMERWHEEL_SLOTS        (1 << TIMERWHEEL_SLOT_BITS)
+#define TIMERWHEEL_SLOT_MASK    (TIMERWHEEL_SLOTS - 1)
+
+class TimerWheel;
+
+// Intrusive timer handle, a node can be scheduled in at most one wheel at a time
+class TimerWheelNode
+{
+    public:
+        TimerWheelNode() : m_wheel(NULL), m_slot(NULL), m_prev(NULL), m_next(NULL), m_expires(0) { }
+        virtual ~TimerWheelNode() { Unschedule(); }
+
+        bool IsScheduled() const { return m_wheel != NULL; }
+        uint64 GetExpireTime() const { return m_expires; }
+
+        void Unschedule();
+
+    protected:
+        // called after the node has been unlinked, the node may be rescheduled or deleted here
+        // now is the wheel time at the end of the current update, p_time is the update interval
+        virtual void OnExpire(uint64 now, uint32 p_time) = 0;
+
+    private:
+        friend class TimerWheel;
+
+        TimerWheel* m_wheel;
+        TimerWheelNode** m_slot;                            // list head the node is linked into
+        TimerWheelNode* m_prev;
+        TimerWheelNode* m_next;
+        uint64 m_expires;
+
+        TimerWheelNode(TimerWheelNode const&);
+        TimerWheelNode& operator=(TimerWheelNode const&);
+};
+
+class TimerWheel
+{
+    public:
+        TimerWheel();
+        ~TimerWheel();
+
+        // schedules node to expire at absolute wheel time, already expired times fire on the next tick
+        void Schedule(TimerWheelNode* node, uint64 expires);
+        void Update(uint32 p_time);
+
+        uint64 GetTime() const { return m_time; }
+        uint32 GetScheduledCount() const { return m_count; }
+
+        // while set, scheduling and unscheduling take the lock, for owners that
+        // reschedule their nodes from several threads between two updates
+        void SetLock(ACE_Recursive_Thread_Mutex* lock) { m_lock = lock; }
+
+    private:
+        friend class TimerWheelNode;
+
+        typedef TimerWheelNode* Slot;
+
+        void Link(TimerWheelNode* node);
+        void Unlink(TimerWheelNode* node);
+        void LinkInto(TimerWheelNode* node, Slot& slot);
+        void Cascade(Slot& slot);
+        void Tick();
+
+        Slot m_slots[TIMERWHEEL_LEVELS][TIMERWHEEL_SLOTS];
+        Slot m_overflow;
+
+        uint64 m_time;                                      // time handed to expiring timers, end of the running update
+        uint64 m_cursor;                                    // last processed tick, equals m_time outside of Update
+        uint32 m_diff;                                      // interval of the running update
+        uint32 m_count;
+        ACE_Recursive_Thread_Mutex* m_lock;
+
+        TimerWheel(TimerWheel const&);
+        TimerWheel& operator=(TimerWheel const&);
+};
+
+#endif
@@ -55,6 +55,11 @@ double rand_chance()
     return sfmtRand->Random() * 100.0;
 }
 
+void rand_seed(uint32 seed)
+{
+    sfmtRand->RandomInit(int(seed));
+}
+
 Tokens StrSplit(const std::string& src, const std::string& sep)
 {
     Tokens r;
@@ -57,6 +57,9 @@ double rand_norm();
 /* Return a random double from 0.0 to 100.0 (exclusive). */
 double rand_chance();
 
+/* Re-seed the random generator of the calling thread, for reproducible runs. */
+void rand_seed(uint32 seed);
+
 // Return true if a random roll fits in the specified chance (range 0-100).
 inline bool roll_chance_f(float chance)
 {
@@ -21,6 +21,9 @@
 #include "Common.h"
 #include "ByteBuffer.h"
 
+#include <ace/Refcounted_Auto_Ptr.h>
+#include <ace/Thread_Mutex.h>
+
 class WorldPacket : public ByteBuffer
 {
     public:
@@ -33,6 +36,24 @@ class WorldPacket : public ByteBuffer
         WorldPacket(const WorldPacket& packet)              : ByteBuffer(packet), m_opcode(packet.m_opcode)
         {
         }
+        // move constructor
+        WorldPacket(WorldPacket&& packet)                   : ByteBuffer(std::move(packet)), m_opcode(packet.m_opcode)
+        {
+        }
+
+        WorldPacket& operator=(const WorldPacket& packet)
+        {
+            ByteBuffer::operator=(packet);
+            m_opcode = packet.m_opcode;
+            return *this;
+        }
+
+        WorldPacket& operator=(WorldPacket&& packet)
+        {
+            m_opcode = packet.m_opcode;
+            ByteBuffer::operator=(std::move(packet));
+            return *this;
+        }
 
         void Initialize(uint16 opcode, size_t newres = 200)
         {
@@ -53,5 +74,9 @@ class WorldPacket : public ByteBuffer
     protected:
         uint16 m_opcode;
 };
+
+// A packet queued on several sockets at once (broadcasts), shared instead of copied per socket.
+// The reference count is atomic, the packet itself must not be modified once it is shared.
+typedef ACE_Refcounted_Auto_Ptr<WorldPacket, ACE_Thread_Mutex> WorldPacket_AutoPtr;
 #endif
 
@@ -35,6 +35,13 @@
 #include "loadlib/wdt.h"
 #include <fcntl.h>
 
+#include <ace/Task.h>
+#include <ace/Activation_Queue.h>
+#include <ace/Method_Request.h>
+#include <ace/Atomic_Op.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/OS_NS_unistd.h>
+
 #if defined( __GNUC__ )
 #include <unistd.h>
 #define _open   open
@@ -51,7 +58,6 @@
 #else
 #define OPEN_FLAGS (O_RDONLY | O_BINARY)
 #endif
-extern ArchiveSet gOpenArchives;
 
 typedef struct
 {
@@ -91,6 +97,9 @@ float CONF_float_to_int16_limit = 2048.0f;   // Max accuracy = val/65536
 float CONF_flat_height_delta_limit = 0.005f; // If max - min less this value - surface is flat
 float CONF_flat_liquid_delta_limit = 0.001f; // If max - min less this value - liquid surface is flat
 
+// Number of threads converting the map tiles, 0 - one per processor
+int   CONF_threads = 0;
+
 // List MPQ for extract from
 const char *CONF_mpq_list[]={
     "common.MPQ",
@@ -137,6 +146,7 @@ void Usage(char* prg)
         "-o set output path (max %d characters)\n"\
         "-e extract only MAP(1)/DBC(2)/Camera(4) - standard: all(7)\n"\
         "-f height stored as int (less map size but lost some accuracy) 1 by default\n"\
+        "-t number of threads converting the map tiles, one per processor by default\n"\
         "Example: %s -f 0 -i \"c:\\games\\game\"", prg, MAX_PATH_LENGTH - 1, MAX_PATH_LENGTH - 1, prg);
     exit(1);
 }
@@ -150,6 +160,7 @@ void HandleArgs(int argc, char* arg[])
         // e - extract only MAP(1)/DBC(2) - standard both(3)
         // f - use float to int conversion
         // h - limit minimum height
+        // t - number of threads
         if (arg[c][0] != '-')
             Usage(arg[0]);
 
@@ -183,6 +194,16 @@ void HandleArgs(int argc, char* arg[])
             else
                 Usage(arg[0]);
             break;
+        case 't':
+            if (c + 1 < argc)                           // all ok
+            {
+                CONF_threads = atoi(arg[(c++) + 1]);
+                if (CONF_threads < 0)
+                    Usage(arg[0]);
+            }
+            else
+                Usage(arg[0]);
+            break;
         }
     }
 }
@@ -372,20 +393,20 @@ float selectUInt16StepStore(float maxDiff)
 {
     return 65535 / maxDiff;
 }
-// Temporary grid data store
-uint16 area_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+// Temporary grid data store, one per converting thread
+thread_local uint16 area_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
 
-float V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-float V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
-uint16 uint16_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-uint16 uint16_V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
-uint8  uint8_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-uint8  uint8_V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
+thread_local float V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local float V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
+thread_local uint16 uint16_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local uint16 uint16_V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
+thread_local uint8  uint8_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local uint8  uint8_V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
 
-uint16 liquid_entry[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-uint8 liquid_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-bool  liquid_show[ADT_GRID_SIZE][ADT_GRID_SIZE];
-float liquid_height[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
+thread_local uint16 liquid_entry[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+thread_local uint8 liquid_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+thread_local bool  liquid_show[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local float liquid_height[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
 
 bool ConvertADT(char* filename, char* filename2, int /*cell_y*/, int /*cell_x*/, uint32 build)
 {
@@ -940,10 +961,77 @@ bool ConvertADT(char* filename, char* filename2, int /*cell_y*/, int /*cell_x*/,
     return true;
 }
 
-void ExtractMapsFromMpq(uint32 build)
+void LoadLocaleMPQFiles(int const locale, bool verbose = true);
+void LoadCommonMPQFiles(bool verbose = true);
+void CloseMPQFiles();
+
+class ADTConvertRequest : public ACE_Method_Request
+{
+    public:
+        ADTConvertRequest(uint32 map, uint32 x, uint32 y, uint32 build) : _map(map), _x(x), _y(y), _build(build) {}
+
+        virtual int call()
+        {
+            char mpq_filename[1024];
+            char output_filename[1024];
+
+            sprintf(mpq_filename, "World\\Maps\\%s\\%s_%u_%u.adt", map_ids[_map].name, map_ids[_map].name, _x, _y);
+            sprintf(output_filename, "%s/maps/%03u%02u%02u.map", output_path, map_ids[_map].id, _y, _x);
+            return ConvertADT(mpq_filename, output_filename, _y, _x, _build) ? 0 : -1;
+        }
+
+    private:
+        uint32 _map;
+        uint32 _x;
+        uint32 _y;
+        uint32 _build;
+};
+
+// Converts the queued map tiles. Every tile goes to its own .map file, so the
+// output does not depend on the order the threads pick up the tiles.
+class ADTConvertThreads : public ACE_Task_Base
+{
+    public:
+        ADTConvertThreads(int locale, uint32 tiles) : _locale(locale), _tiles(tiles), _done(0) {}
+
+        void Enqueue(ADTConvertRequest* request)
+        {
+            _queue.enqueue(request);
+        }
+
+        int svc()
+        {
+            LoadLocaleMPQFiles(_locale, false);
+            LoadCommonMPQFiles(false);
+
+            // the queue is filled before the threads start, so don't wait on an empty queue
+            ACE_Time_Value timeout = ACE_Time_Value::zero;
+            while (ACE_Method_Request* request = _queue.dequeue(&timeout))
+            {
+                request->call();
+                delete request;
+
+                uint32 done = ++_done;
+                if ((100 * done) / _tiles != (100 * (done - 1)) / _tiles)
+                {
+                    printf("Processing........................%u%%\r", (100 * done) / _tiles);
+                    fflush(stdout);
+                }
+            }
+
+            CloseMPQFiles();
+            return 0;
+        }
+
+    private:
+        ACE_Activation_Queue _queue;
+        int _locale;
+        uint32 _tiles;
+        ACE_Atomic_Op<ACE_Thread_Mutex, uint32> _done;
+};
+
+void ExtractMapsFromMpq(uint32 build, int locale)
 {
-    char mpq_filename[1024];
-    char output_filename[1024];
     char mpq_map_name[1024];
 
     printf("Extracting maps...\n");
@@ -957,10 +1045,10 @@ void ExtractMapsFromMpq(uint32 build)
     path += "/maps/";
     CreateDir(path);
 
-    printf("Convert map files\n");
+    // Collect the tiles of all maps
+    std::vector<ADTConvertRequest*> requests;
     for (uint32 z = 0; z < map_count; ++z)
     {
-        printf("Extract %s (%d/%d)                  \n", map_ids[z].name, z + 1, map_count);
         // Loadup map grid data
         sprintf(mpq_map_name, "World\\Maps\\%s\\%s.wdt", map_ids[z].name, map_ids[z].name);
         WDT_file wdt;
@@ -976,14 +1064,27 @@ void ExtractMapsFromMpq(uint32 build)
             {
                 if (!wdt.main->adt_list[y][x].exist)
                     continue;
-                sprintf(mpq_filename, "World\\Maps\\%s\\%s_%u_%u.adt", map_ids[z].name, map_ids[z].name, x, y);
-                sprintf(output_filename, "%s/maps/%03u%02u%02u.map", output_path, map_ids[z].id, y, x);
-                ConvertADT(mpq_filename, output_filename, y, x, build);
+                requests.push_back(new ADTConvertRequest(z, x, y, build));
             }
-            // draw progress bar
-            printf("Processing........................%d%%\r", (100 * (y + 1)) / WDT_MAP_SIZE);
         }
     }
+
+    int threads = CONF_threads ? CONF_threads : ACE_OS::num_processors_online();
+    if (threads < 1)
+        threads = 1;
+
+    printf("Convert %u map tiles using %d threads\n", uint32(requests.size()), threads);
+    if (!requests.empty())
+    {
+        ADTConvertThreads converter(locale, uint32(requests.size()));
+        for (std::vector<ADTConvertRequest*>::iterator itr = requests.begin(); itr != requests.end(); ++itr)
+            converter.Enqueue(*itr);
+
+        converter.activate(THR_NEW_LWP | THR_JOINABLE, threads);
+        converter.wait();
+    }
+    printf("\n");
+
     delete [] areas;
     delete [] map_ids;
 }
@@ -1101,12 +1202,12 @@ void ExtractCameraFiles(int locale, bool basicLocale)
     printf("Extracted %u camera files\n", count);
 }
 
-void LoadLocaleMPQFiles(int const locale)
+void LoadLocaleMPQFiles(int const locale, bool verbose)
 {
     char filename[512];
 
     sprintf(filename, "%s/Data/%s/locale-%s.MPQ", input_path, langs[locale], langs[locale]);
-    new MPQArchive(filename);
+    new MPQArchive(filename, verbose);
 
     for (int i = 1; i < 5; ++i)
     {
@@ -1116,11 +1217,11 @@ void LoadLocaleMPQFiles(int const locale)
 
         sprintf(filename, "%s/Data/%s/patch-%s%s.MPQ", input_path, langs[locale], langs[locale], ext);
         if (FileExists(filename))
-            new MPQArchive(filename);
+            new MPQArchive(filename, verbose);
     }
 }
 
-void LoadCommonMPQFiles()
+void LoadCommonMPQFiles(bool verbose)
 {
     char filename[512];
     int count = sizeof(CONF_mpq_list) / sizeof(char*);
@@ -1128,11 +1229,11 @@ void LoadCommonMPQFiles()
     {
         sprintf(filename, "%s/Data/%s", input_path, CONF_mpq_list[i]);
         if (FileExists(filename))
-            new MPQArchive(filename);
+            new MPQArchive(filename, verbose);
     }
 }
 
-inline void CloseMPQFiles()
+void CloseMPQFiles()
 {
     for (ArchiveSet::iterator j = gOpenArchives.begin(); j != gOpenArchives.end(); ++j) (*j)->close();
 	gOpenArchives.clear();
@@ -1211,7 +1312,7 @@ int main(int argc, char* arg[])
         LoadCommonMPQFiles();
 
         // Extract maps
-        ExtractMapsFromMpq(build);
+        ExtractMapsFromMpq(build, FirstLocale);
 
         // Close MPQs
         CloseMPQFiles();
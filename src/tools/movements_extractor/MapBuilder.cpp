@@ -20,17 +20,48 @@
 
 #include "MapTree.h"
 #include "ModelInstance.h"
+#include "BoundingIntervalHierarchy.h"
+#include "VMapDefinitions.h"
 
 #include "DetourNavMeshBuilder.h"
 #include "DetourCommon.h"
 
+#include <ace/Guard_T.h>
+
 using namespace VMAP;
 
 namespace MMAP
 {
+// 64 bit FNV-1a, good enough to notice changed input files
+static const uint64 INPUT_HASH_SEED = ACE_UINT64_LITERAL(0xCBF29CE484222325);
+
+static uint64 hashData(const void* data, size_t size, uint64 hash)
+{
+    const uint8* bytes = (const uint8*)data;
+    for (size_t i = 0; i < size; ++i)
+        hash = (hash ^ bytes[i]) * ACE_UINT64_LITERAL(0x100000001B3);
+    return hash;
+}
+
+static uint64 hashFile(const char* fileName, uint64 hash)
+{
+    FILE* file = fopen(fileName, "rb");
+    if (!file)
+        return hashData("missing", 7, hash);
+
+    uint8 buffer[0x4000];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+        hash = hashData(buffer, read, hash);
+
+    fclose(file);
+    return hash;
+}
+
 MapBuilder::MapBuilder(float maxWalkableAngle, bool skipLiquid,
                        bool skipContinents, bool skipJunkMaps, bool skipBattlegrounds,
-                       bool debugOutput, bool bigBaseUnit, const char* offMeshFilePath) :
+                       bool debugOutput, bool bigBaseUnit, const char* offMeshFilePath,
+                       const char* changedModelsFilePath) :
     m_terrainBuilder(NULL),
     m_debugOutput        (debugOutput),
     m_offMeshFilePath    (offMeshFilePath),
@@ -39,12 +70,26 @@ MapBuilder::MapBuilder(float maxWalkableAngle, bool skipLiquid,
     m_skipBattlegrounds  (skipBattlegrounds),
     m_maxWalkableAngle   (maxWalkableAngle),
     m_bigBaseUnit        (bigBaseUnit),
+    m_configHash         (INPUT_HASH_SEED),
+    m_onlyChangedModels  (false),
     m_rcContext          (NULL)
 {
     m_terrainBuilder = new TerrainBuilder(skipLiquid);
 
     m_rcContext = new rcContext(false);
 
+    // everything besides the map data that changes the generated tiles
+    uint32 version = MMAP_VERSION;
+    m_configHash = hashData(&version, sizeof(version), m_configHash);
+    m_configHash = hashData(&m_maxWalkableAngle, sizeof(m_maxWalkableAngle), m_configHash);
+    m_configHash = hashData(&skipLiquid, sizeof(skipLiquid), m_configHash);
+    m_configHash = hashData(&m_bigBaseUnit, sizeof(m_bigBaseUnit), m_configHash);
+    if (m_offMeshFilePath)
+        m_configHash = hashFile(m_offMeshFilePath, m_configHash);
+
+    if (changedModelsFilePath)
+        loadChangedModels(changedModelsFilePath);
+
     discoverTiles();
 }
 
@@ -281,7 +326,13 @@ void MapBuilder::buildSingleTile(uint32 mapID, uint32 tileX, uint32 tileY)
         return;
     }
 
-    buildTile(mapID, tileX, tileY, navMesh);
+    // a single tile is always rebuilt, but keep its header up to date for later runs
+    set<string> mapModels;
+    bool usesChangedModel;
+    uint64 mapHash = getMapInputHash(mapID, mapModels);
+    uint64 inputHash = getTileInputHash(mapID, tileX, tileY, mapHash, mapModels, usesChangedModel);
+
+    buildTile(mapID, tileX, tileY, navMesh, inputHash);
     dtFreeNavMesh(navMesh);
 }
 
@@ -317,6 +368,9 @@ void MapBuilder::buildMap(uint32 mapID)
         return;
     }
 
+    set<string> mapModels;
+    uint64 mapHash = getMapInputHash(mapID, mapModels);
+
     // now start building mmtiles for each tile
     printf("[Map %03i] We have %u tiles.                          \n", mapID, (unsigned int)tiles->size());
     for (set<uint32>::iterator it = tiles->begin(); it != tiles->end(); ++it)
@@ -326,10 +380,14 @@ void MapBuilder::buildMap(uint32 mapID)
         // unpack tile coords
         StaticMapTree::unpackTileID((*it), tileX, tileY);
 
-        if (shouldSkipTile(mapID, tileX, tileY))
+        bool usesChangedModel = false;
+        uint64 inputHash = getTileInputHash(mapID, tileX, tileY, mapHash, mapModels, usesChangedModel);
+
+        // with a list of changed models only the tiles using them are rebuilt
+        if (m_onlyChangedModels ? !usesChangedModel : shouldSkipTile(mapID, tileX, tileY, inputHash))
             continue;
 
-        buildTile(mapID, tileX, tileY, navMesh);
+        buildTile(mapID, tileX, tileY, navMesh, inputHash);
     }
 
     dtFreeNavMesh(navMesh);
@@ -338,7 +396,7 @@ void MapBuilder::buildMap(uint32 mapID)
 }
 
 /**************************************************************************/
-void MapBuilder::buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh)
+void MapBuilder::buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh, uint64 inputHash)
 {
     printf("[Map %03i] Building tile [%02u,%02u]\n", mapID, tileX, tileY);
 
@@ -373,7 +431,7 @@ void MapBuilder::buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh*
     m_terrainBuilder->loadOffMeshConnections(mapID, tileX, tileY, meshData, m_offMeshFilePath);
 
     // build navmesh tile
-    buildMoveMapTile(mapID, tileX, tileY, meshData, bmin, bmax, navMesh);
+    buildMoveMapTile(mapID, tileX, tileY, meshData, bmin, bmax, navMesh, inputHash);
 }
 
 /**************************************************************************/
@@ -458,7 +516,7 @@ void MapBuilder::buildNavMesh(uint32 mapID, dtNavMesh*& navMesh)
 /**************************************************************************/
 void MapBuilder::buildMoveMapTile(uint32 mapID, uint32 tileX, uint32 tileY,
                                   MeshData& meshData, float bmin[3], float bmax[3],
-                                  dtNavMesh* navMesh)
+                                  dtNavMesh* navMesh, uint64 inputHash)
 {
     // console output
     char tileString[10];
@@ -789,6 +847,7 @@ void MapBuilder::buildMoveMapTile(uint32 mapID, uint32 tileX, uint32 tileY,
         MmapTileHeader header;
         header.usesLiquids = m_terrainBuilder->usesLiquids();
         header.size = uint32(navDataSize);
+        header.inputHash = inputHash;
         fwrite(&header, sizeof(MmapTileHeader), 1, file);
 
         // write data
@@ -902,7 +961,7 @@ bool MapBuilder::isTransportMap(uint32 mapID)
 }
 
 /**************************************************************************/
-bool MapBuilder::shouldSkipTile(uint32 mapID, uint32 tileX, uint32 tileY)
+bool MapBuilder::shouldSkipTile(uint32 mapID, uint32 tileX, uint32 tileY, uint64 inputHash)
 {
     char fileName[255];
     sprintf(fileName, "mmaps/%03u%02i%02i.mmtile", mapID, tileY, tileX);
@@ -920,7 +979,163 @@ bool MapBuilder::shouldSkipTile(uint32 mapID, uint32 tileX, uint32 tileY)
     if (header.mmapVersion != MMAP_VERSION)
         return false;
 
+    // map data or build settings changed since the tile was built
+    if (header.inputHash != inputHash)
+        return false;
+
     return true;
 }
 
+/**************************************************************************/
+void MapBuilder::loadChangedModels(const char* listFilePath)
+{
+    FILE* file = fopen(listFilePath, "r");
+    if (!file)
+    {
+        printf("Changed models list %s not found, checking all tiles!\n", listFilePath);
+        return;
+    }
+
+    // one model file name per line, as found in the vmaps directory
+    char line[512];
+    while (fgets(line, sizeof(line), file))
+    {
+        string name = line;
+        name.erase(name.find_last_not_of(" \t\r\n") + 1);
+        if (name.size() > 4 && name.compare(name.size() - 4, 4, ".vmo") == 0)
+            name.erase(name.size() - 4);
+        if (!name.empty())
+            m_changedModels.insert(name);
+    }
+    fclose(file);
+
+    m_onlyChangedModels = true;
+    printf("Rebuilding only tiles using %u changed models\n", uint32(m_changedModels.size()));
+}
+
+/**************************************************************************/
+uint64 MapBuilder::hashModelSpawns(FILE* file, uint32 count, uint64 hash, set<string>& models)
+{
+    ModelSpawn spawn;
+    for (uint32 i = 0; i < count && ModelSpawn::readFromFile(file, spawn); ++i)
+    {
+        // hash the placement only, node indices change whenever anything on the map does
+        hash = hashData(&spawn.flags, sizeof(spawn.flags), hash);
+        hash = hashData(&spawn.adtId, sizeof(spawn.adtId), hash);
+        hash = hashData(&spawn.ID, sizeof(spawn.ID), hash);
+        hash = hashData(&spawn.iPos, sizeof(spawn.iPos), hash);
+        hash = hashData(&spawn.iRot, sizeof(spawn.iRot), hash);
+        hash = hashData(&spawn.iScale, sizeof(spawn.iScale), hash);
+        hash = hashData(spawn.name.c_str(), spawn.name.size(), hash);
+        models.insert(spawn.name);
+    }
+
+    return hash;
+}
+
+/**************************************************************************/
+uint64 MapBuilder::getMapInputHash(uint32 mapID, set<string>& models)
+{
+    uint64 hash = hashData(&mapID, sizeof(mapID), m_configHash);
+
+    // global (WDT) spawns are part of every tile of the map
+    char fileName[255];
+    sprintf(fileName, "vmaps/%03u.vmtree", mapID);
+    FILE* file = fopen(fileName, "rb");
+    if (!file)
+        return hash;
+
+    char chunk[8];
+    BIH tree;
+    if (fread(chunk, sizeof(char), 8, file) == 8 && memcmp(chunk, VMAP_MAGIC, 8) == 0 &&
+        fread(chunk, sizeof(char), 1, file) == 1 &&
+        fread(chunk, sizeof(char), 4, file) == 4 && memcmp(chunk, "NODE", 4) == 0 &&
+        tree.readFromFile(file) &&
+        fread(chunk, sizeof(char), 4, file) == 4 && memcmp(chunk, "GOBJ", 4) == 0)
+        hash = hashModelSpawns(file, UINT_MAX, hash, models);
+
+    fclose(file);
+    return hash;
+}
+
+/**************************************************************************/
+uint64 MapBuilder::getTileInputHash(uint32 mapID, uint32 tileX, uint32 tileY, uint64 mapHash, const set<string>& mapModels, bool& usesChangedModel)
+{
+    uint64 hash = hashData(&tileX, sizeof(tileX), mapHash);
+    hash = hashData(&tileY, sizeof(tileY), hash);
+
+    // terrain of the tile and the borders of its neighbours, see TerrainBuilder::loadMap
+    char fileName[255];
+    sprintf(fileName, "maps/%03u%02u%02u.map", mapID, tileY, tileX);
+    hash = hashFile(fileName, hash);
+    sprintf(fileName, "maps/%03u%02u%02u.map", mapID, tileY, tileX + 1);
+    hash = hashFile(fileName, hash);
+    sprintf(fileName, "maps/%03u%02u%02u.map", mapID, tileY, tileX - 1);
+    hash = hashFile(fileName, hash);
+    sprintf(fileName, "maps/%03u%02u%02u.map", mapID, tileY + 1, tileX);
+    hash = hashFile(fileName, hash);
+    sprintf(fileName, "maps/%03u%02u%02u.map", mapID, tileY - 1, tileX);
+    hash = hashFile(fileName, hash);
+
+    // model spawns of the tile, see TerrainBuilder::loadVMap
+    set<string> models(mapModels);
+    sprintf(fileName, "vmaps/%03u_%02u_%02u.vmtile", mapID, tileX, tileY);
+    if (FILE* file = fopen(fileName, "rb"))
+    {
+        char magic[8];
+        uint32 count;
+        if (fread(magic, sizeof(char), 8, file) == 8 && memcmp(magic, VMAP_MAGIC, 8) == 0 &&
+            fread(&count, sizeof(uint32), 1, file) == 1)
+        {
+            // every spawn is followed by its tree node index
+            uint32 nodeIndex;
+            for (uint32 i = 0; i < count; ++i)
+            {
+                hash = hashModelSpawns(file, 1, hash, models);
+                if (fread(&nodeIndex, sizeof(uint32), 1, file) != 1)
+                    break;
+            }
+        }
+        fclose(file);
+    }
+
+    usesChangedModel = false;
+    for (set<string>::const_iterator itr = models.begin(); itr != models.end() && !usesChangedModel; ++itr)
+        usesChangedModel = m_changedModels.find(*itr) != m_changedModels.end();
+
+    // the tile won't be built, no need to read its models
+    if (m_onlyChangedModels && !usesChangedModel)
+        return hash;
+
+    for (set<string>::const_iterator itr = models.begin(); itr != models.end(); ++itr)
+    {
+        uint64 modelHash = getModelHash(*itr);
+        hash = hashData(&modelHash, sizeof(modelHash), hash);
+    }
+
+    return hash;
+}
+
+/**************************************************************************/
+uint64 MapBuilder::getModelHash(const string& name)
+{
+    {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_modelHashLock, 0);
+
+        map<string, uint64>::iterator itr = m_modelHashes.find(name);
+        if (itr != m_modelHashes.end())
+            return itr->second;
+    }
+
+    // models are shared between many tiles, read each one once. The file is read
+    // unlocked so the other workers are not serialized behind it, two workers
+    // hashing the same model at once get the same value
+    string fileName = "vmaps/" + name + ".vmo";
+    uint64 hash = hashFile(fileName.c_str(), hashData(name.c_str(), name.size(), INPUT_HASH_SEED));
+
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_modelHashLock, hash);
+    m_modelHashes[name] = hash;
+    return hash;
+}
+
 }
@@ -33,6 +33,7 @@
 #include <ace/Task.h>
 #include <ace/Activation_Queue.h>
 #include <ace/Method_Request.h>
+#include <ace/Thread_Mutex.h>
 
 using namespace std;
 using namespace VMAP;
@@ -69,7 +70,8 @@ class MapBuilder
                    bool skipBattlegrounds   = false,
                    bool debugOutput         = false,
                    bool bigBaseUnit         = false,
-                   const char* offMeshFilePath = NULL);
+                   const char* offMeshFilePath = NULL,
+                   const char* changedModelsFilePath = NULL);
 
         ~MapBuilder();
 
@@ -89,7 +91,7 @@ class MapBuilder
 
         void buildNavMesh(uint32 mapID, dtNavMesh*& navMesh);
 
-        void buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh);
+        void buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh, uint64 inputHash);
 
         // move map building
         void buildMoveMapTile(uint32 mapID,
@@ -98,7 +100,8 @@ class MapBuilder
                               MeshData& meshData,
                               float bmin[3],
                               float bmax[3],
-                              dtNavMesh* navMesh);
+                              dtNavMesh* navMesh,
+                              uint64 inputHash);
 
         void getTileBounds(uint32 tileX, uint32 tileY,
                            float* verts, int vertCount,
@@ -107,7 +110,14 @@ class MapBuilder
 
         bool shouldSkipMap(uint32 mapID);
         bool isTransportMap(uint32 mapID);
-        bool shouldSkipTile(uint32 mapID, uint32 tileX, uint32 tileY);
+        bool shouldSkipTile(uint32 mapID, uint32 tileX, uint32 tileY, uint64 inputHash);
+
+        // build cache - tiles store a hash of their input data and are only rebuilt when it changes
+        void loadChangedModels(const char* listFilePath);
+        uint64 getMapInputHash(uint32 mapID, set<string>& models);
+        uint64 getTileInputHash(uint32 mapID, uint32 tileX, uint32 tileY, uint64 mapHash, const set<string>& mapModels, bool& usesChangedModel);
+        uint64 hashModelSpawns(FILE* file, uint32 count, uint64 hash, set<string>& models);
+        uint64 getModelHash(const string& name);
 
         TerrainBuilder* m_terrainBuilder;
         TileList m_tiles;
@@ -122,6 +132,12 @@ class MapBuilder
         float m_maxWalkableAngle;
         bool m_bigBaseUnit;
 
+        uint64 m_configHash;
+        bool m_onlyChangedModels;
+        set<string> m_changedModels;
+        map<string, uint64> m_modelHashes;
+        ACE_Thread_Mutex m_modelHashLock;
+
         // build performance - not really used for now
         rcContext* m_rcContext;
 };
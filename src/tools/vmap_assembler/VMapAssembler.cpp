@@ -17,24 +17,33 @@
 
 #include <string>
 #include <iostream>
+#include <cstdlib>
+
+#include <ace/OS_NS_unistd.h>
 
 #include "TileAssembler.h"
 
 int main(int argc, char* argv[])
 {
-    if (argc != 3)
+    if (argc != 3 && argc != 4)
     {
         //printf("\nusage: %s <raw data dir> <vmap dest dir> [config file name]\n", argv[0]);
-        std::cout << "usage: " << argv[0] << " <raw data dir> <vmap dest dir>" << std::endl;
+        std::cout << "usage: " << argv[0] << " <raw data dir> <vmap dest dir> [threads]" << std::endl;
         return 1;
     }
 
     std::string src = argv[1];
     std::string dest = argv[2];
 
+    // one thread per processor unless told otherwise
+    int threads = argc == 4 ? atoi(argv[3]) : 0;
+    if (threads <= 0)
+        threads = ACE_OS::num_processors_online();
+
     std::cout << "using " << src << " as source directory and writing output to " << dest << std::endl;
 
     VMAP::TileAssembler* ta = new VMAP::TileAssembler(src, dest);
+    ta->setThreads(threads > 0 ? threads : 1);
 
     if (!ta->convertWorld2())
     {
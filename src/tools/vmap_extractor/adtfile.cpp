@@ -17,7 +17,7 @@
 
 #include <algorithm>
 #include <cstdio>
-#include <ACE/OS_NS_strings.h>
+#include <ace/OS_NS_strings.h>
 
 #include "vmapexport.h"
 #include "adtfile.h"
@@ -77,7 +77,7 @@ ADTFile::ADTFile(char* filename): ADT(filename)
     Adtfilename.append(filename);
 }
 
-bool ADTFile::init(uint32 map_num, uint32 tileX, uint32 tileY, StringSet& failedPaths)
+bool ADTFile::init(uint32 map_num, uint32 tileX, uint32 tileY, StringSet& failedPaths, DirFileBuffer& dirfile)
 {
     if (ADT.isEof ())
         return false;
@@ -99,15 +99,6 @@ bool ADTFile::init(uint32 map_num, uint32 tileX, uint32 tileY, StringSet& failed
     //printf("xMap = %s\n", xMap.c_str());
     //printf("yMap = %s\n", yMap.c_str());
 
-    std::string dirname = std::string(szWorkDirWmo) + "/dir_bin";
-    FILE* dirfile;
-    dirfile = fopen(dirname.c_str(), "ab");
-    if (!dirfile)
-    {
-        printf("Can't open dirfile!'%s'\n", dirname.c_str());
-        return false;
-    }
-
     while (!ADT.isEof())
     {
         char fourcc[5];
@@ -203,7 +194,6 @@ bool ADTFile::init(uint32 map_num, uint32 tileX, uint32 tileY, StringSet& failed
         ADT.seek(nextpos);
     }
     ADT.close();
-    fclose(dirfile);
     return true;
 }
 
@@ -115,7 +115,7 @@ class ADTFile
         int nMDX;
         string* WmoInstansName;
         string* ModelInstansName;
-        bool init(uint32 map_num, uint32 tileX, uint32 tileY, StringSet& failedPaths);
+        bool init(uint32 map_num, uint32 tileX, uint32 tileY, StringSet& failedPaths, DirFileBuffer& dirfile);
         //void LoadMapChunks();
 
         //uint32 wmo_count;
@@ -6,6 +6,16 @@
 #include <algorithm>
 #include <stdio.h>
 
+#include <ace/Guard_T.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
+
+// Models used by several map tiles are converted by the first thread asking
+// for them, the others wait until the file is written
+static ACE_Thread_Mutex sModelLock;
+static ACE_Condition_Thread_Mutex sModelConverted(sModelLock);
+static StringSet sModelsInProgress;
+
 bool ExtractSingleModel(std::string& origPath, std::string& fixedName, StringSet& failedPaths)
 {
     char const* ext = GetExtension(GetPlainName(origPath.c_str()));
@@ -26,14 +36,26 @@ bool ExtractSingleModel(std::string& origPath, std::string& fixedName, StringSet
     output += "/";
     output += fixedName;
 
-    if (FileExists(output.c_str()))
-        return true;
+    {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, sModelLock, false);
+
+        while (sModelsInProgress.find(output) != sModelsInProgress.end())
+            sModelConverted.wait();
+
+        if (FileExists(output.c_str()))
+            return true;
+
+        sModelsInProgress.insert(output);
+    }
 
     Model mdl(origPath);                                    // Possible changed fname
-    if (!mdl.open(failedPaths))
-        return false;
+    bool result = mdl.open(failedPaths) && mdl.ConvertToVMAPModel(output.c_str());
+
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, sModelLock, false);
+    sModelsInProgress.erase(output);
+    sModelConverted.broadcast();
 
-    return mdl.ConvertToVMAPModel(output.c_str());
+    return result;
 }
 
 void ExtractGameobjectModels()
@@ -70,7 +70,7 @@ class ModelInstance
         float sc;
 
         ModelInstance() {}
-        ModelInstance(MPQFile& f, const char* ModelInstName, uint32 mapID, uint32 tileX, uint32 tileY, FILE* pDirfile);
+        ModelInstance(MPQFile& f, const char* ModelInstName, uint32 mapID, uint32 tileX, uint32 tileY, DirFileBuffer& pDirfile);
 
 };
 
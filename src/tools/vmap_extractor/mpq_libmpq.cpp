@@ -19,12 +19,13 @@
 #include <deque>
 #include <cstdio>
 
-ArchiveSet gOpenArchives;
+thread_local ArchiveSet gOpenArchives;
 
-MPQArchive::MPQArchive(const char* filename)
+MPQArchive::MPQArchive(const char* filename, bool verbose)
 {
     int result = libmpq__archive_open(&mpq_a, filename, -1);
-    printf("Opening %s\n", filename);
+    if (verbose)
+        printf("Opening %s\n", filename);
     if (result)
     {
         switch (result)
@@ -34,7 +34,7 @@ class MPQArchive
 public:
     mpq_archive_s *mpq_a;
 
-    MPQArchive(const char* filename);
+    MPQArchive(const char* filename, bool verbose = true);
     ~MPQArchive() { close(); }
     void close();
 
@@ -68,6 +68,9 @@ public:
 };
 typedef std::deque<MPQArchive*> ArchiveSet;
 
+// libmpq archive handles are not thread safe, every extractor thread opens its own set
+extern thread_local ArchiveSet gOpenArchives;
+
 class MPQFile
 {
     //MPQHANDLE handle;
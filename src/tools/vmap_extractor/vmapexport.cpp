@@ -48,6 +48,14 @@
 
 #include "vmapexport.h"
 
+#include <ace/Task.h>
+#include <ace/Activation_Queue.h>
+#include <ace/Method_Request.h>
+#include <ace/Atomic_Op.h>
+#include <ace/Guard_T.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/OS_NS_unistd.h>
+
 //------------------------------------------------------------------------------
 // Defines
 
@@ -55,8 +63,6 @@
 
 //-----------------------------------------------------------------------------
 
-extern ArchiveSet gOpenArchives;
-
 typedef struct
 {
     char name[64];
@@ -70,6 +76,8 @@ char output_path[128] = ".";
 char input_path[1024] = ".";
 bool hasInputPathParam = false;
 bool preciseVectorData = false;
+int threads = 0;                                            // 0 - one per processor
+std::vector<std::string> archiveNames;
 
 // Constants
 
@@ -98,6 +106,174 @@ void strToLower(char* str)
     }
 }
 
+void OpenArchives(bool verbose)
+{
+    for (size_t i = 0; i < archiveNames.size(); ++i)
+    {
+        MPQArchive* archive = new MPQArchive(archiveNames[i].c_str(), verbose);
+        if (!gOpenArchives.size() || gOpenArchives.front() != archive)
+            delete archive;
+    }
+}
+
+void CloseArchives()
+{
+    for (ArchiveSet::iterator itr = gOpenArchives.begin(); itr != gOpenArchives.end(); ++itr)
+        delete *itr;
+    gOpenArchives.clear();
+}
+
+// Runs the queued extraction requests, every thread with its own MPQ archive handles
+class ExtractorThreads : public ACE_Task_Base
+{
+    public:
+        ExtractorThreads(uint32 requests) : _requests(requests), _done(0), _errors(0) {}
+
+        void Enqueue(ACE_Method_Request* request)
+        {
+            _queue.enqueue(request);
+        }
+
+        bool Run()
+        {
+            if (_requests)
+            {
+                activate(THR_NEW_LWP | THR_JOINABLE, threads);
+                wait();
+            }
+            printf("\n");
+            return _errors.value() == 0;
+        }
+
+        int svc()
+        {
+            OpenArchives(false);
+
+            // the queue is filled before the threads start, so don't wait on an empty queue
+            ACE_Time_Value timeout = ACE_Time_Value::zero;
+            while (ACE_Method_Request* request = _queue.dequeue(&timeout))
+            {
+                if (request->call() == -1)
+                    ++_errors;
+                delete request;
+
+                uint32 done = ++_done;
+                if ((100 * done) / _requests != (100 * (done - 1)) / _requests)
+                {
+                    printf("Processing........................%u%%\r", (100 * done) / _requests);
+                    fflush(stdout);
+                }
+            }
+
+            CloseArchives();
+            return 0;
+        }
+
+    private:
+        ACE_Activation_Queue _queue;
+        uint32 _requests;
+        ACE_Atomic_Op<ACE_Thread_Mutex, uint32> _done;
+        ACE_Atomic_Op<ACE_Thread_Mutex, uint32> _errors;
+};
+
+// Writes the dir_bin records of the maps and map tiles in the order they were
+// queued, whichever thread finishes them first, so the file does not depend on
+// the number of threads
+class DirFileWriter
+{
+    public:
+        DirFileWriter(FILE* dirfile) : _dirfile(dirfile), _next(0) {}
+
+        uint32 Reserve()
+        {
+            ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, _lock, 0);
+            _slots.push_back(Slot());
+            return uint32(_slots.size() - 1);
+        }
+
+        void Complete(uint32 slot, DirFileBuffer& buffer, StringSet& failedPaths)
+        {
+            ACE_GUARD(ACE_Thread_Mutex, guard, _lock);
+
+            _slots[slot].buffer.swap(buffer);
+            _slots[slot].done = true;
+            _failedPaths.insert(failedPaths.begin(), failedPaths.end());
+
+            for (; _next < _slots.size() && _slots[_next].done; ++_next)
+            {
+                fwrite(_slots[_next].buffer.data(), 1, _slots[_next].buffer.size(), _dirfile);
+                _slots[_next].buffer.clear();
+            }
+        }
+
+        const StringSet& GetFailedPaths() const { return _failedPaths; }
+
+    private:
+        struct Slot
+        {
+            Slot() : done(false) {}
+
+            DirFileBuffer buffer;
+            bool done;
+        };
+
+        FILE* _dirfile;
+        std::deque<Slot> _slots;
+        size_t _next;
+        StringSet _failedPaths;
+        ACE_Thread_Mutex _lock;
+};
+
+class WmoExtractRequest : public ACE_Method_Request
+{
+    public:
+        WmoExtractRequest(const std::string& fname) : _fname(fname) {}
+
+        virtual int call()
+        {
+            return ExtractSingleWmo(_fname) ? 0 : -1;
+        }
+
+    private:
+        std::string _fname;
+};
+
+class ADTExtractRequest : public ACE_Method_Request
+{
+    public:
+        ADTExtractRequest(DirFileWriter& writer, uint32 slot, uint32 map, int x, int y)
+            : _writer(writer), _slot(slot), _map(map), _x(x), _y(y) {}
+
+        virtual int call()
+        {
+            char name[512];
+            sprintf(name, "World\\Maps\\%s\\%s_%d_%d.adt", map_ids[_map].name, map_ids[_map].name, _x, _y);
+
+            DirFileBuffer buffer;
+            StringSet failedPaths;
+            ADTFile ADT(name);
+            ADT.init(map_ids[_map].id, _x, _y, failedPaths, buffer);
+
+            _writer.Complete(_slot, buffer, failedPaths);
+            return 0;
+        }
+
+    private:
+        DirFileWriter& _writer;
+        uint32 _slot;
+        uint32 _map;
+        int _x;
+        int _y;
+};
+
+std::string GetWmoLocalName(const std::string& fname)
+{
+    char szLocalFile[1024];
+    sprintf(szLocalFile, "%s/%s", szWorkDirWmo, GetPlainName(fname.c_str()));
+    fixnamen(szLocalFile, strlen(szLocalFile));
+    return szLocalFile;
+}
+
 // copied from contrib/extractor/System.cpp
 void ReadLiquidTypeTableDBC()
 {
@@ -122,22 +298,30 @@ void ReadLiquidTypeTableDBC()
 
 bool ExtractWmo()
 {
-    bool success = true;
-
     //const char* ParsArchiveNames[] = {"patch-2.MPQ", "patch.MPQ", "common.MPQ", "expansion.MPQ"};
 
-    for (ArchiveSet::const_iterator ar_itr = gOpenArchives.begin(); ar_itr != gOpenArchives.end() && success; ++ar_itr)
+    // collect the wmo files, several names may end up in the same local file
+    std::vector<std::string> wmoFiles;
+    StringSet localFiles;
+    for (ArchiveSet::const_iterator ar_itr = gOpenArchives.begin(); ar_itr != gOpenArchives.end(); ++ar_itr)
     {
         vector<string> filelist;
 
         (*ar_itr)->GetFileListTo(filelist);
-        for (vector<string>::iterator fname = filelist.begin(); fname != filelist.end() && success; ++fname)
+        for (vector<string>::iterator fname = filelist.begin(); fname != filelist.end(); ++fname)
         {
-            if (fname->find(".wmo") != string::npos)
-                success = ExtractSingleWmo(*fname);
+            if (fname->find(".wmo") != string::npos && localFiles.insert(GetWmoLocalName(*fname)).second)
+                wmoFiles.push_back(*fname);
         }
     }
 
+    printf("Extracting %u wmo files using %d threads\n", uint32(wmoFiles.size()), threads);
+    ExtractorThreads extractor(wmoFiles.size());
+    for (std::vector<std::string>::const_iterator fname = wmoFiles.begin(); fname != wmoFiles.end(); ++fname)
+        extractor.Enqueue(new WmoExtractRequest(*fname));
+
+    bool success = extractor.Run();
+
     if (success)
         printf("\nExtract wmo complete (No (fatal) errors)\n");
 
@@ -148,10 +332,9 @@ bool ExtractSingleWmo(std::string& fname)
 {
                 // Copy files from archive
 
-    char szLocalFile[1024];
+    std::string localFile = GetWmoLocalName(fname);
+    const char* szLocalFile = localFile.c_str();
     const char * plain_name = GetPlainName(fname.c_str());
-    sprintf(szLocalFile, "%s/%s", szWorkDirWmo, plain_name);
-                fixnamen(szLocalFile,strlen(szLocalFile));
 
     if (FileExists(szLocalFile))
         return true;
@@ -175,7 +358,7 @@ bool ExtractSingleWmo(std::string& fname)
         return true;
 
     bool file_ok = true;
-    std::cout << "Extracting " << fname << std::endl;
+    printf("Extracting %s\n", fname.c_str());
     WMORoot froot(fname);
     if(!froot.open())
                         {
@@ -230,33 +413,49 @@ void ParsMapFiles()
     char fn[512];
     //char id_filename[64];
     char id[10];
-    StringSet failedPaths;
+
+    std::string dirname = std::string(szWorkDirWmo) + "/dir_bin";
+    FILE* dirfile = fopen(dirname.c_str(), "ab");
+    if (!dirfile)
+    {
+        printf("Can't open dirfile!'%s'\n", dirname.c_str());
+        return;
+    }
+
+    // the global map objects are written right away, the map tiles are queued
+    DirFileWriter writer(dirfile);
+    std::vector<ADTExtractRequest*> requests;
     for (unsigned int i = 0; i < map_count; ++i)
     {
         sprintf(id, "%03u", map_ids[i].id);
         sprintf(fn, "World\\Maps\\%s\\%s.wdt", map_ids[i].name, map_ids[i].name);
         WDTFile WDT(fn, map_ids[i].name);
-        if (WDT.init(id, map_ids[i].id))
+        DirFileBuffer buffer;
+        if (WDT.init(id, map_ids[i].id, buffer))
         {
-            printf("Processing Map %u\n[", map_ids[i].id);
+            StringSet noFailedPaths;
+            writer.Complete(writer.Reserve(), buffer, noFailedPaths);
+
             for (int x = 0; x < 64; ++x)
             {
                 for (int y = 0; y < 64; ++y)
                 {
-                    if (ADTFile* ADT = WDT.GetMap(x, y))
-                    {
-                        //sprintf(id_filename,"%02u %02u %03u",x,y,map_ids[i].id);//!!!!!!!!!
-                        ADT->init(map_ids[i].id, x, y, failedPaths);
-                        delete ADT;
-                    }
+                    if (WDT.HasMap(x, y))
+                        requests.push_back(new ADTExtractRequest(writer, writer.Reserve(), i, x, y));
                 }
-                printf("#");
-                fflush(stdout);
             }
-            printf("]\n");
         }
     }
 
+    printf("Processing %u map tiles using %d threads\n", uint32(requests.size()), threads);
+    ExtractorThreads extractor(requests.size());
+    for (std::vector<ADTExtractRequest*>::const_iterator itr = requests.begin(); itr != requests.end(); ++itr)
+        extractor.Enqueue(*itr);
+    extractor.Run();
+
+    fclose(dirfile);
+
+    const StringSet& failedPaths = writer.GetFailedPaths();
     if (!failedPaths.empty())
     {
         printf("Warning: Some models could not be extracted, see below\n");
@@ -421,6 +620,18 @@ bool processArgv(int argc, char** argv, const char* versionString)
         {
             preciseVectorData = true;
         }
+        else if (strcmp("-t", argv[i]) == 0)
+        {
+            if ((i + 1) < argc && atoi(argv[i + 1]) >= 0)
+            {
+                threads = atoi(argv[i + 1]);
+                ++i;
+            }
+            else
+            {
+                result = false;
+            }
+        }
         else
         {
             result = false;
@@ -430,10 +641,11 @@ bool processArgv(int argc, char** argv, const char* versionString)
     if (!result)
     {
         printf("Extract %s.\n", versionString);
-        printf("%s [-?][-s][-l][-d <path>]\n", argv[0]);
+        printf("%s [-?][-s][-l][-d <path>][-t <threads>]\n", argv[0]);
         printf("   -s : (default) small size (data size optimization), ~500MB less vmap data.\n");
         printf("   -l : large size, ~500MB more vmap data. (might contain more details)\n");
         printf("   -d <path>: Path to the vector data source folder.\n");
+        printf("   -t <threads>: Number of extraction threads, one per processor by default.\n");
         printf("   -? : This message.\n");
     }
     return result;
@@ -484,15 +696,14 @@ int main(int argc, char** argv)
              ))
         success = (errno == EEXIST);
 
+    if (!threads)
+        threads = ACE_OS::num_processors_online();
+    if (threads < 1)
+        threads = 1;
+
     // prepare archive name list
-    std::vector<std::string> archiveNames;
     fillArchiveNameVector(archiveNames);
-    for (size_t i = 0; i < archiveNames.size(); ++i)
-    {
-        MPQArchive* archive = new MPQArchive(archiveNames[i].c_str());
-        if (!gOpenArchives.size() || gOpenArchives.front() != archive)
-            delete archive;
-    }
+    OpenArchives(true);
 
     if (gOpenArchives.empty())
     {
@@ -23,6 +23,24 @@
 
 typedef std::set<std::string> StringSet;
 
+// dir_bin records of one map or map tile
+class DirFileBuffer
+{
+    public:
+        void write(const void* data, size_t size, size_t count)
+        {
+            m_data.append(static_cast<const char*>(data), size * count);
+        }
+
+        const char* data() const { return m_data.data(); }
+        size_t size() const { return m_data.size(); }
+        void swap(DirFileBuffer& other) { m_data.swap(other.m_data); }
+        void clear() { std::string().swap(m_data); }
+
+    private:
+        std::string m_data;
+};
+
 enum ModelFlags
 {
     MOD_M2 = 1,
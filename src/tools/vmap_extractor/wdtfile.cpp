@@ -32,9 +32,10 @@ char* wdtGetPlainName(char* FileName)
 WDTFile::WDTFile(char* file_name, char* file_name1): WDT(file_name)
 {
     filename.append(file_name1, strlen(file_name1));
+    memset(maps, 0, sizeof(maps));
 }
 
-bool WDTFile::init(char* map_id, unsigned int mapID)
+bool WDTFile::init(char* map_id, unsigned int mapID, DirFileBuffer& dirfile)
 {
     if (WDT.isEof())
     {
@@ -45,15 +46,6 @@ bool WDTFile::init(char* map_id, unsigned int mapID)
     char fourcc[5];
     uint32 size;
 
-    std::string dirname = std::string(szWorkDirWmo) + "/dir_bin";
-    FILE* dirfile;
-    dirfile = fopen(dirname.c_str(), "ab");
-    if (!dirfile)
-    {
-        printf("Can't open dirfile!'%s'\n", dirname.c_str());
-        return false;
-    }
-
     while (!WDT.isEof())
     {
         WDT.read(fourcc, 4);
@@ -66,6 +58,19 @@ bool WDTFile::init(char* map_id, unsigned int mapID)
 
         if (!strcmp(fourcc, "MAIN"))
         {
+            // existing map tiles, the entries are stored by rows (file name _x_y)
+            if (size == 64 * 64 * 8)
+            {
+                for (int y = 0; y < 64; ++y)
+                {
+                    for (int x = 0; x < 64; ++x)
+                    {
+                        uint32 flags[2];
+                        WDT.read(flags, 8);
+                        maps[x][y] = (flags[0] & 1) != 0;
+                    }
+                }
+            }
         }
         if (!strcmp(fourcc, "MWMO"))
         {
@@ -112,7 +117,6 @@ bool WDTFile::init(char* map_id, unsigned int mapID)
     }
 
     WDT.close();
-    fclose(dirfile);
     return true;
 }
 
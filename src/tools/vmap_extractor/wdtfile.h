@@ -20,6 +20,7 @@
 
 #include "mpq_libmpq.h"
 #include "wmo.h"
+#include "vmapexport.h"
 #include <string>
 #include "stdlib.h"
 
@@ -30,12 +31,13 @@ class WDTFile
     public:
         WDTFile(char* file_name, char* file_name1);
         ~WDTFile(void);
-        bool init(char* map_id, unsigned int mapID);
+        bool init(char* map_id, unsigned int mapID, DirFileBuffer& dirfile);
 
         string* gWmoInstansName;
         int gnWMO, nMaps;
 
         ADTFile* GetMap(int x, int z);
+        bool HasMap(int x, int z) const { return maps[x][z]; }
 
     private:
         MPQFile WDT;
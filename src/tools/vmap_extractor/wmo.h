@@ -24,6 +24,7 @@
 #include <set>
 #include "vec3d.h"
 #include "loadlib/loadlib.h"
+#include "vmapexport.h"
 
 // MOPY flags
 #define WMO_MATERIAL_NOCAMCOLLIDE    0x01
@@ -131,7 +132,7 @@ class WMOInstance
         uint32 indx, id, d2, d3;
         int doodadset;
 
-        WMOInstance(MPQFile& f, const char* WmoInstName, uint32 mapID, uint32 tileX, uint32 tileY, FILE* pDirfile);
+        WMOInstance(MPQFile& f, const char* WmoInstName, uint32 mapID, uint32 tileX, uint32 tileY, DirFileBuffer& pDirfile);
 
         static void reset();
 };